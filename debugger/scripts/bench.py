@@ -0,0 +1,72 @@
+"""
+Simulator benchmark suite.
+
+Runs every workload in headless mode (appdbg64g --bench) and collects the
+reported metrics into one JSON file for the trend tracking:
+
+    python bench.py <appdbg64g executable> [seconds] [output.json]
+"""
+
+import sys
+import os
+import json
+import subprocess
+import tempfile
+
+REPO = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+TARGETS = os.path.join(REPO, "debugger", "targets")
+EXAMPLES = os.path.join(REPO, "examples")
+
+# [name, target configuration, workload commands]
+SUITE = [
+    ["river_func.dhrystone21", "func_river_x1_gui.json",
+        ["loadelf " + EXAMPLES + "/dhrystone21/makefiles/bin/dhrystone21.elf"]],
+    ["river_func.bootrom_tests", "func_river_x1_gui.json",
+        ["loadelf " + EXAMPLES + "/bootrom_tests/linuxbuild/bin/bootrom_tests.elf"]],
+    ["river_rtl.dhrystone21", "sysc_river_x1_gui.json",
+        ["loadelf " + EXAMPLES + "/dhrystone21/makefiles/bin/dhrystone21.elf"]],
+    ["river_rtl.bootrom_tests", "sysc_river_x1_gui.json",
+        ["loadelf " + EXAMPLES + "/bootrom_tests/linuxbuild/bin/bootrom_tests.elf"]],
+    ["cortex_func.dhrystone21", "func_arm_gui.json", []],
+    ["cortex_func.stm32l476xx_demo", "func_arm_gui.json",
+        ["loadelf " + EXAMPLES + "/stm32l476xx_demo/makefiles/bin/stm32l476xx_demo.elf"]],
+]
+
+
+def run(app, name, target, cmds, seconds):
+    outfile = os.path.join(tempfile.gettempdir(), name + ".json")
+    if os.path.exists(outfile):
+        os.remove(outfile)
+    args = [app, "-c", os.path.join(TARGETS, target),
+            "--bench", str(seconds), "--bench-name", name,
+            "--bench-out", outfile]
+    for cmd in cmds:
+        args += ["--bench-cmd", cmd]
+    subprocess.call(args, stdout=subprocess.DEVNULL)
+    if not os.path.exists(outfile):
+        print("%s: failed" % name)
+        return None
+    with open(outfile) as f:
+        res = json.load(f)
+    print("%s: %.3f MIPS, %d ms startup, %d KB peak RSS"
+          % (name, res["MIPS"], res["StartupMs"], res["PeakRssKb"]))
+    return res
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return
+    seconds = int(sys.argv[2]) if len(sys.argv) > 2 else 10
+    output = sys.argv[3] if len(sys.argv) > 3 else "bench.json"
+    results = []
+    for name, target, cmds in SUITE:
+        res = run(sys.argv[1], name, target, cmds, seconds)
+        if res is not None:
+            results.append(res)
+    with open(output, "w") as f:
+        json.dump(results, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -19,13 +19,181 @@
 #include "coreservices/ilink.h"
 #include "coreservices/ithread.h"
 #include "coreservices/icmdexec.h"
+#include "coreservices/iclock.h"
 #include <stdio.h>
 #include <string>
+#if defined(_WIN32) || defined(__CYGWIN__)
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
 
 using namespace debugger;
 
 static AttributeType Config;
 
+/**
+ * @brief Headless benchmark state.
+ *
+ * Simulation is started after InitCommands and stopped by the single shot
+ * timer. Metrics are computed as the difference between the snapshot
+ * taken on start and the values at the end of the interval.
+ */
+static struct BenchmarkType {
+    AttributeType name;
+    AttributeType outfile;
+    AttributeType cmds;         // workload commands executed after init
+    int seconds;
+    uint64_t t_launch_ms;
+    uint64_t t_ready_ms;
+    uint64_t t_start_ms;
+    AttributeType clocks;       // list of IService with IClock interface
+    AttributeType buses;        // list of IService with transaction counters
+    uint64_t steps[64];
+    uint64_t transactions;
+} Bench;
+
+static uint64_t get_peak_rss_kb() {
+#if defined(_WIN32) || defined(__CYGWIN__)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return 0;
+    }
+    return pmc.PeakWorkingSetSize / 1024;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(usage.ru_maxrss);  // KB on Linux
+#endif
+}
+
+static uint64_t get_bus_transactions() {
+    uint64_t ret = 0;
+    for (unsigned i = 0; i < Bench.buses.size(); i++) {
+        IService *iserv = static_cast<IService *>(Bench.buses[i].to_iface());
+        ret += static_cast<AttributeType *>(
+            iserv->getAttribute("BTransactions"))->to_uint64();
+        ret += static_cast<AttributeType *>(
+            iserv->getAttribute("NbTransactions"))->to_uint64();
+    }
+    return ret;
+}
+
+static void bench_start() {
+    AttributeType list;
+    IService *iserv;
+    IClock *iclk;
+    Bench.clocks.make_list(0);
+    Bench.buses.make_list(0);
+
+    RISCV_get_services_with_iface(IFACE_CLOCK, &list);
+    for (unsigned i = 0; i < list.size() && i < 64; i++) {
+        iserv = static_cast<IService *>(list[i].to_iface());
+        iclk = static_cast<IClock *>(iserv->getInterface(IFACE_CLOCK));
+        Bench.clocks.new_list_item().make_iface(iserv);
+        Bench.steps[i] = iclk->getStepCounter();
+    }
+
+    RISCV_get_services_with_iface(IFACE_MEMORY_OPERATION, &list);
+    for (unsigned i = 0; i < list.size(); i++) {
+        iserv = static_cast<IService *>(list[i].to_iface());
+        if (iserv->getAttribute("BTransactions")
+            && iserv->getAttribute("NbTransactions")) {
+            Bench.buses.new_list_item().make_iface(iserv);
+        }
+    }
+    Bench.transactions = get_bus_transactions();
+    Bench.t_start_ms = RISCV_get_time_ms();
+}
+
+/** Quoted JSON string with the escaped quotes and control characters */
+static std::string bench_json_string(const char *str) {
+    std::string ret("\"");
+    char tstr[8];
+    for (const char *p = str; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            ret += '\\';
+            ret += *p;
+        } else if (static_cast<unsigned char>(*p) < 0x20) {
+            RISCV_sprintf(tstr, sizeof(tstr), "\\u%04x",
+                          static_cast<unsigned char>(*p));
+            ret += tstr;
+        } else {
+            ret += *p;
+        }
+    }
+    ret += '"';
+    return ret;
+}
+
+/** Integers are written in decimal format to be parsed by any JSON reader */
+static void bench_stop(void *) {
+    std::string out;
+    char tstr[512];
+    uint64_t total_steps = 0;
+    uint64_t dt_ms = RISCV_get_time_ms() - Bench.t_start_ms;
+    double dt_sec;
+    if (dt_ms == 0) {
+        dt_ms = 1;
+    }
+    dt_sec = static_cast<double>(dt_ms) / 1000.0;
+
+    out = "{\"Name\":" + bench_json_string(Bench.name.to_string()) + ",";
+    RISCV_sprintf(tstr, sizeof(tstr),
+        "\"Seconds\":%.3f,\"StartupMs\":%" RV_PRI64 "d,"
+        "\"PeakRssKb\":%" RV_PRI64 "d,",
+        dt_sec,
+        Bench.t_ready_ms - Bench.t_launch_ms,
+        get_peak_rss_kb());
+    out += tstr;
+
+    out += "\"Cpu\":[";
+    for (unsigned i = 0; i < Bench.clocks.size(); i++) {
+        IService *iserv = static_cast<IService *>(Bench.clocks[i].to_iface());
+        IClock *iclk = static_cast<IClock *>(iserv->getInterface(IFACE_CLOCK));
+        uint64_t steps = iclk->getStepCounter() - Bench.steps[i];
+        double ns_per_instr = 0;
+        if (steps) {
+            ns_per_instr = 1e6 * static_cast<double>(dt_ms)
+                         / static_cast<double>(steps);
+        }
+        out += i ? ",{\"Name\":" : "{\"Name\":";
+        out += bench_json_string(iserv->getObjName());
+        RISCV_sprintf(tstr, sizeof(tstr),
+            ",\"Steps\":%" RV_PRI64 "d,\"FreqHz\":%.1f,"
+            "\"MIPS\":%.3f,\"HostNsPerInstr\":%.1f}",
+            steps,
+            iclk->getFreqHz(),
+            static_cast<double>(steps) / dt_sec / 1e6,
+            ns_per_instr);
+        out += tstr;
+        total_steps += steps;
+    }
+    RISCV_sprintf(tstr, sizeof(tstr),
+        "],\"MIPS\":%.3f,\"BusTransPerSec\":%.1f}",
+        static_cast<double>(total_steps) / dt_sec / 1e6,
+        static_cast<double>(get_bus_transactions() - Bench.transactions)
+        / dt_sec);
+    out += tstr;
+
+    printf("%s\n", out.c_str());
+    if (Bench.outfile.size()) {
+        FILE *f = fopen(Bench.outfile.to_string(), "wb");
+        if (f) {
+            fwrite(out.c_str(), 1, out.size(), f);
+            fwrite("\n", 1, 1, f);
+            fclose(f);
+        } else {
+            printf("Error: can't write %s\n", Bench.outfile.to_string());
+        }
+    }
+    RISCV_break_simulation();
+}
+
 const AttributeType *getConfigOfService(const AttributeType &cfg,
                                         const char *name) {
     const AttributeType &serv = cfg["Services"];
@@ -41,6 +209,11 @@ const AttributeType *getConfigOfService(const AttributeType &cfg,
 }
 
 int main(int argc, char* argv[]) {
+    Bench.t_launch_ms = RISCV_get_time_ms();
+    Bench.seconds = 0;
+    Bench.name.make_string("");
+    Bench.outfile.make_string("");
+    Bench.cmds.make_list(0);
     RISCV_init();
     RISCV_set_current_dir();
 
@@ -62,6 +235,18 @@ int main(int argc, char* argv[]) {
                 nogui = true;
             } else if (strcmp(argv[i], "--gui") == 0) {
                 gui = true;
+            } else if (strcmp(argv[i], "--bench") == 0) {
+                i++;
+                Bench.seconds = atoi(argv[i]);
+            } else if (strcmp(argv[i], "--bench-name") == 0) {
+                i++;
+                Bench.name.make_string(argv[i]);
+            } else if (strcmp(argv[i], "--bench-out") == 0) {
+                i++;
+                Bench.outfile.make_string(argv[i]);
+            } else if (strcmp(argv[i], "--bench-cmd") == 0) {
+                i++;
+                Bench.cmds.new_list_item().make_string(argv[i]);
             }
         }
     }
@@ -70,13 +255,16 @@ int main(int argc, char* argv[]) {
         printf("Error: Platform script file not defined\n");
         printf("       Use -c key to specify configuration file location:\n");
         printf("Example: appdbg64.exe -c ../../targets/default.json\n");
+        printf("Headless benchmark (JSON metrics after N seconds of run):\n");
+        printf("    --bench <N> [--bench-name <str>] [--bench-out <file>]\n");
+        printf("            [--bench-cmd <workload command>]...\n");
         return 0;
     }
 
     Config.from_config(databuf.to_string());
 	
 	/** Disable GUI using application arguments list */
-    if (nogui) {
+    if (nogui || Bench.seconds) {
         Config["GlobalSettings"]["GUI"].make_boolean(false);
     } else if (gui) {
         Config["GlobalSettings"]["GUI"].make_boolean(true);
@@ -123,6 +311,22 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    /** Benchmark mode: run the workload loaded by InitCommands and stop
+     *  simulator after the specified interval */
+    if (Bench.seconds) {
+        for (unsigned int i = 0; i < Bench.cmds.size(); i++) {
+            iexec_->exec(Bench.cmds[i].to_string(), &res, false);
+        }
+        Bench.t_ready_ms = RISCV_get_time_ms();
+        const AttributeType &descr = Config["GlobalSettings"]["Description"];
+        if (Bench.name.size() == 0 && descr.is_string()) {
+            Bench.name.make_string(descr.to_string());
+        }
+        bench_start();
+        iexec_->exec("c", &res, false);
+        RISCV_register_timer(1000 * Bench.seconds, 1, bench_stop, 0);
+    }
+
     /** Main loop */
     RISCV_dispatcher_start();
     databuf.attr_free();
@@ -317,6 +317,16 @@ void RISCV_memshare_delete(sharemem_def h);
 void *RISCV_malloc(uint64_t sz);
 void RISCV_free(void *p);
 
+/**
+ * @brief Pool of the dictionary keys.
+ * @details Keys are reference counted by the dictionary items. The pool is
+ *          shared by all modules, so a dictionary may be released in the
+ *          other module than it was created.
+ */
+char *RISCV_key_intern(const char *key, unsigned len, uint32_t hash);
+void RISCV_key_addref(const AttributePairType *pairs, unsigned cnt);
+void RISCV_key_release(const AttributePairType *pairs, unsigned cnt);
+
 /** Get absolute directory where core library is placed. */
 int RISCV_get_core_folder(char *out, int sz);
 int RISCV_get_core_folderw(wchar_t* out, int sz);
@@ -20,6 +20,7 @@
 #include <cstdlib>
 #include <string>
 #include <algorithm>
+#include <utility>
 
 namespace debugger {
 
@@ -29,6 +30,206 @@ static AttributeType NilAttribute;
 void attribute_to_string(const AttributeType *attr, AutoBuffer *buf);
 int string_to_attribute(const char *cfg, int &off, AttributeType *out);
 
+/**
+ * Every block has a header word to detect the arena memory on release,
+ * because the block may be freed by another thread or module.
+ */
+static const uint64_t BLOCK_HEAP = 0;
+static const uint64_t BLOCK_ARENA = 0xA4E4A;
+
+static thread_local AttributeArena *curArena_ = 0;
+
+static void *attr_malloc(size_t sz) {
+    uint64_t *p = 0;
+    if (curArena_) {
+        p = static_cast<uint64_t *>(curArena_->alloc(sz + sizeof(uint64_t)));
+    }
+    if (p) {
+        p[0] = BLOCK_ARENA;
+    } else {
+        p = static_cast<uint64_t *>(RISCV_malloc(sz + sizeof(uint64_t)));
+        p[0] = BLOCK_HEAP;
+    }
+    return &p[1];
+}
+
+static void attr_mfree(void *ptr) {
+    uint64_t *p = static_cast<uint64_t *>(ptr) - 1;
+    if (p[0] == BLOCK_HEAP) {
+        RISCV_free(p);
+    }
+}
+
+AttributeArena::AttributeArena() : prev_(0), first_(0), cur_(0) {
+}
+
+AttributeArena::~AttributeArena() {
+    if (curArena_ == this) {
+        deactivate();
+    }
+    ChunkType *p = first_;
+    while (p) {
+        ChunkType *next = p->next;
+        RISCV_free(p);
+        p = next;
+    }
+}
+
+void AttributeArena::activate() {
+    prev_ = curArena_;
+    curArena_ = this;
+}
+
+void AttributeArena::deactivate() {
+    curArena_ = prev_;
+    prev_ = 0;
+}
+
+void AttributeArena::reset() {
+    for (ChunkType *p = first_; p; p = p->next) {
+        p->used = sizeof(ChunkType);
+    }
+    cur_ = first_;
+}
+
+void *AttributeArena::alloc(size_t sz) {
+    sz = (sz + 7) & ~static_cast<size_t>(7);
+    if (sz > CHUNK_SIZE / 4) {
+        return 0;
+    }
+    if (cur_ == 0) {
+        first_ = static_cast<ChunkType *>(RISCV_malloc(CHUNK_SIZE));
+        first_->next = 0;
+        first_->used = sizeof(ChunkType);
+        cur_ = first_;
+    }
+    while (cur_->used + sz > CHUNK_SIZE) {
+        if (cur_->next == 0) {
+            cur_->next = static_cast<ChunkType *>(RISCV_malloc(CHUNK_SIZE));
+            cur_->next->next = 0;
+        }
+        cur_ = cur_->next;
+        cur_->used = sizeof(ChunkType);
+    }
+    void *ret = reinterpret_cast<uint8_t *>(cur_) + cur_->used;
+    cur_->used += sz;
+    return ret;
+}
+
+/** FNV-1a hash of the dictionary key */
+static uint32_t key_hash(const char *key, size_t *len) {
+    uint32_t h = 2166136261u;
+    const char *p = key;
+    while (*p) {
+        h = (h ^ static_cast<uint8_t>(*p++)) * 16777619u;
+    }
+    *len = static_cast<size_t>(p - key);
+    return h;
+}
+
+/**
+ * @brief Open addressing index of the dictionary items.
+ *
+ * Built when the dictionary reaches DICT_INDEX_MIN items and kept up to
+ * date by dict_append(). The pointer is stored just before the items array
+ * so the attribute size doesn't change.
+ */
+struct DictIndexType {
+    unsigned mask;
+    unsigned total;         // indexed items
+    unsigned slot[1];       // item index + 1, 0 is the empty slot
+};
+
+static const unsigned DICT_INDEX_MIN = 16;
+
+static DictIndexType *&dict_index(AttributePairType *items) {
+    return reinterpret_cast<DictIndexType **>(items)[-1];
+}
+
+static DictIndexType *dict_index(const AttributePairType *items) {
+    return reinterpret_cast<DictIndexType *const *>(items)[-1];
+}
+
+static void dict_index_insert(DictIndexType *index,
+                              const AttributePairType *items, unsigned i) {
+    unsigned idx = items[i].hash_ & index->mask;
+    while (index->slot[idx]) {
+        idx = (idx + 1) & index->mask;
+    }
+    index->slot[idx] = i + 1;
+    index->total++;
+}
+
+/** Load factor is kept below 1/2 */
+static void dict_index_build(AttributeType *dict) {
+    AttributePairType *items = dict->u_.dict;
+    unsigned slots = 2 * DICT_INDEX_MIN;
+    while (slots < 4 * dict->size()) {
+        slots <<= 1;
+    }
+    if (dict_index(items)) {
+        attr_mfree(dict_index(items));
+    }
+    DictIndexType *index = static_cast<DictIndexType *>(
+        attr_malloc(offsetof(DictIndexType, slot) + slots * sizeof(unsigned)));
+    index->mask = slots - 1;
+    index->total = 0;
+    memset(index->slot, 0, slots * sizeof(unsigned));
+    for (unsigned i = 0; i < dict->size(); i++) {
+        dict_index_insert(index, items, i);
+    }
+    dict_index(items) = index;
+}
+
+/** @return item index or -1 */
+static int dict_find(const AttributeType *dict, const char *key,
+                     uint32_t hash) {
+    const AttributePairType *items = dict->u_.dict;
+    if (dict->size() == 0) {
+        return -1;
+    }
+    const DictIndexType *index = dict_index(items);
+    if (index && index->total == dict->size()) {
+        unsigned idx = hash & index->mask;
+        while (index->slot[idx]) {
+            const AttributePairType &pair = items[index->slot[idx] - 1];
+            if (pair.hash_ == hash
+                && strcmp(key, pair.key_.u_.string) == 0) {
+                return static_cast<int>(index->slot[idx] - 1);
+            }
+            idx = (idx + 1) & index->mask;
+        }
+        return -1;
+    }
+    for (unsigned i = 0; i < dict->size(); i++) {
+        const AttributePairType &pair = items[i];
+        if (pair.hash_ == hash && strcmp(key, pair.key_.u_.string) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+static AttributeType &dict_append(AttributeType *dict, const char *key,
+                                  size_t len, uint32_t hash) {
+    dict->realloc_dict(dict->size() + 1);
+    unsigned i = dict->size() - 1;
+    AttributePairType &pair = dict->u_.dict[i];
+    pair.key_.kind_ = Attr_String;
+    pair.key_.size_ = static_cast<unsigned>(len);
+    pair.key_.u_.string = RISCV_key_intern(key, static_cast<unsigned>(len), hash);
+    pair.hash_ = hash;
+    pair.value_.make_nil();
+
+    DictIndexType *index = dict_index(dict->u_.dict);
+    if (index && index->total == i && 2 * dict->size() <= index->mask) {
+        dict_index_insert(index, dict->u_.dict, i);
+    } else if (dict->size() >= DICT_INDEX_MIN) {
+        dict_index_build(dict);
+    }
+    return pair.value_;
+}
+
 void AttributeType::allocAttrName(const char *name) {
     size_t len = strlen(name) + 1;
     attr_name_ = static_cast<char *>(RISCV_malloc(len));
@@ -54,22 +255,27 @@ void AttributeType::freeAttrDescription() {
 }
 
 void AttributeType::attr_free() {
-    if (size()) {
-        if (is_string()) {
-            RISCV_free(u_.string);
-        } else if (is_data() && size() > 8) {
-            RISCV_free(u_.data);
+    if (is_string()) {
+        if (u_.string) {
+            attr_mfree(u_.string);
+        }
+    } else if (size()) {
+        if (is_data() && size() > 8) {
+            attr_mfree(u_.data);
         } else if (is_list()) {
             for (unsigned i = 0; i < size(); i++) {
                 u_.list[i].attr_free();
             }
-            RISCV_free(u_.list);
+            attr_mfree(u_.list);
         } else if (is_dict()) {
+            RISCV_key_release(u_.dict, size());
             for (unsigned i = 0; i < size(); i++) {
-                u_.dict[i].key_.attr_free();
                 u_.dict[i].value_.attr_free();
             }
-            RISCV_free(u_.dict);
+            if (dict_index(u_.dict)) {
+                attr_mfree(dict_index(u_.dict));
+            }
+            attr_mfree(&dict_index(u_.dict));
         }
     }
     kind_ = Attr_Invalid;
@@ -92,10 +298,19 @@ void AttributeType::clone(const AttributeType *v) {
     } else if (v->is_dict()) {
         make_dict();
         realloc_dict(v->size());
+        if (v->size()) {
+            RISCV_key_addref(v->u_.dict, v->size());
+        }
         for (unsigned i = 0; i < v->size(); i++) {
-            u_.dict[i].key_.make_string(v->dict_key(i)->to_string());
+            u_.dict[i].key_.kind_ = Attr_String;
+            u_.dict[i].key_.size_ = v->u_.dict[i].key_.size_;
+            u_.dict[i].key_.u_ = v->u_.dict[i].key_.u_;
+            u_.dict[i].hash_ = v->u_.dict[i].hash_;
             u_.dict[i].value_.clone(v->dict_value(i));
         }
+        if (size() >= DICT_INDEX_MIN) {
+            dict_index_build(this);
+        }
     } else {
         this->kind_ = v->kind_;
         this->u_ = v->u_;
@@ -118,6 +333,19 @@ AttributeType &AttributeType::operator=(const AttributeType& other) {
     return *this;
 }
 
+AttributeType &AttributeType::operator=(AttributeType&& other) {
+    if (&other != this) {
+        attr_free();
+        kind_ = other.kind_;
+        size_ = other.size_;
+        u_ = other.u_;
+        other.kind_ = Attr_Invalid;
+        other.size_ = 0;
+        other.u_.integer = 0;
+    }
+    return *this;
+}
+
 
 const AttributeType &AttributeType::operator[](unsigned idx) const {
     if (is_list()) {
@@ -142,28 +370,23 @@ AttributeType &AttributeType::operator[](unsigned idx) {
 }
 
 const AttributeType &AttributeType::operator[](const char *key) const {
-    for (unsigned i = 0; i < size(); i++) {
-        if (strcmp(key, u_.dict[i].key_.to_string()) == 0) {
-            return u_.dict[i].value_;
-        }
+    size_t len;
+    uint32_t hash = key_hash(key, &len);
+    int idx = dict_find(this, key, hash);
+    if (idx >= 0) {
+        return u_.dict[idx].value_;
     }
-    AttributeType *pthis = const_cast<AttributeType*>(this);
-    pthis->realloc_dict(size()+1);
-    pthis->u_.dict[size()-1].key_.make_string(key);
-    pthis->u_.dict[size()-1].value_.make_nil();
-    return u_.dict[size()-1].value_;
+    return dict_append(const_cast<AttributeType *>(this), key, len, hash);
 }
 
 AttributeType &AttributeType::operator[](const char *key) {
-    for (unsigned i = 0; i < size(); i++) {
-        if (strcmp(key, u_.dict[i].key_.to_string()) == 0) {
-            return u_.dict[i].value_;
-        }
+    size_t len;
+    uint32_t hash = key_hash(key, &len);
+    int idx = dict_find(this, key, hash);
+    if (idx >= 0) {
+        return u_.dict[idx].value_;
     }
-    realloc_dict(size()+1);
-    u_.dict[size()-1].key_.make_string(key);
-    u_.dict[size()-1].value_.make_nil();
-    return u_.dict[size()-1].value_;
+    return dict_append(this, key, len, hash);
 }
 
 const uint8_t &AttributeType::operator()(unsigned idx) const {
@@ -178,15 +401,19 @@ const uint8_t &AttributeType::operator()(unsigned idx) const {
 }
 
 void AttributeType::make_string(const char *value) {
-    attr_free();
-    if (value) {
-        kind_ = Attr_String;
-        size_ = (unsigned)strlen(value);
-        u_.string = static_cast<char *>(RISCV_malloc(size_ + 1));
-        memcpy(u_.string, value, size_ + 1);
-    } else {
+    if (value == 0) {
+        attr_free();
         kind_ = Attr_Nil;
+        return;
     }
+    // value may point to the current string
+    unsigned len = static_cast<unsigned>(strlen(value));
+    char *p = static_cast<char *>(attr_malloc(len + 1));
+    memcpy(p, value, len + 1);
+    attr_free();
+    kind_ = Attr_String;
+    size_ = len;
+    u_.string = p;
 }
 
 void AttributeType::make_data(unsigned size) {
@@ -194,7 +421,7 @@ void AttributeType::make_data(unsigned size) {
     kind_ = Attr_Data;
     size_ = size;
     if (size > 8) {
-        u_.data = static_cast<uint8_t *>(RISCV_malloc(size_));
+        u_.data = static_cast<uint8_t *>(attr_malloc(size_));
     }
 }
 
@@ -203,7 +430,7 @@ void AttributeType::make_data(unsigned size, const void *data) {
     kind_ = Attr_Data;
     size_ = size;
     if (size > 8) {
-        u_.data = static_cast<uint8_t *>(RISCV_malloc(size_));
+        u_.data = static_cast<uint8_t *>(attr_malloc(size_));
         memcpy(u_.data, data, size);
     } else {
         memcpy(u_.data_bytes, data, size);
@@ -217,20 +444,20 @@ void AttributeType::realloc_data(unsigned size) {
     if (size <= 8) {    
         if (size_ > 8) {
             uint8_t *pold = u_.data;
-            memcpy(u_.data_bytes, u_.data, size);
-            RISCV_free(pold);
+            memcpy(u_.data_bytes, pold, size);
+            attr_mfree(pold);
         }
         size_ = size;
         return;
     }
-    uint8_t *pnew = static_cast<uint8_t *>(RISCV_malloc(size));
+    uint8_t *pnew = static_cast<uint8_t *>(attr_malloc(size));
     unsigned sz = size;
     if (size_ < sz) {
         sz = size_;
     }
     if (sz > 8) {
         memcpy(pnew, u_.data, sz);
-        RISCV_free(u_.data);
+        attr_mfree(u_.data);
     } else {
         memcpy(pnew, u_.data_bytes, sz);
     }
@@ -258,12 +485,12 @@ void AttributeType::realloc_list(unsigned size) {
                   / MIN_ALLOC_BYTES;
     if (req_sz > cur_sz) {
         AttributeType * t1 = static_cast<AttributeType *>(
-                RISCV_malloc(MIN_ALLOC_BYTES * req_sz));
+                attr_malloc(MIN_ALLOC_BYTES * req_sz));
         memcpy(static_cast<void*>(t1), u_.list, size_ * sizeof(AttributeType));
         memset(static_cast<void*>(&t1[size_]), 0,
                 (MIN_ALLOC_BYTES * req_sz) - size_ * sizeof(AttributeType));
         if (size_) {
-            RISCV_free(u_.list);
+            attr_mfree(u_.list);
         }
         u_.list = t1;
     }
@@ -278,7 +505,7 @@ void AttributeType::insert_to_list(unsigned idx, const AttributeType *item) {
     size_t new_sz = ((size_ + 1) * sizeof(AttributeType) + MIN_ALLOC_BYTES - 1)
                   / MIN_ALLOC_BYTES;
     AttributeType * t1 = static_cast<AttributeType *>(
-                RISCV_malloc(MIN_ALLOC_BYTES * new_sz));
+                attr_malloc(MIN_ALLOC_BYTES * new_sz));
     memset(static_cast<void*>(t1 + idx), 0,
            sizeof(AttributeType));  // Fix bug request #4
 
@@ -289,7 +516,7 @@ void AttributeType::insert_to_list(unsigned idx, const AttributeType *item) {
     memset(static_cast<void*>(&t1[size_ + 1]), 0,
            (MIN_ALLOC_BYTES * new_sz) - (size_ + 1) * sizeof(AttributeType));
     if (size_) {
-        RISCV_free(u_.list);
+        attr_mfree(u_.list);
     }
     u_.list = t1;
     size_++;
@@ -425,13 +652,10 @@ void AttributeType::sort(int idx) {
 }
 
 bool AttributeType::has_key(const char *key) const {
-    for (unsigned i = 0; i < size(); i++) {
-        AttributePairType &pair = u_.dict[i];
-        if (pair.key_.is_equal(key) && !pair.value_.is_nil()) {
-            return true;
-        }
-    }
-    return false;
+    size_t len;
+    uint32_t hash = key_hash(key, &len);
+    int idx = dict_find(this, key, hash);
+    return idx >= 0 && !u_.dict[idx].value_.is_nil();
 }
 
 const AttributeType *AttributeType::dict_key(unsigned idx) const {
@@ -461,14 +685,19 @@ void AttributeType::realloc_dict(unsigned size) {
     size_t cur_sz = (size_ * sizeof(AttributePairType) + MIN_ALLOC_BYTES - 1)
                   / MIN_ALLOC_BYTES;
     if (req_sz > cur_sz) {
-        AttributePairType * t1 = static_cast<AttributePairType *>(
-                RISCV_malloc(MIN_ALLOC_BYTES * req_sz));
+        // Index pointer is placed before the items
+        DictIndexType **t0 = static_cast<DictIndexType **>(
+                attr_malloc(sizeof(DictIndexType *)
+                            + MIN_ALLOC_BYTES * req_sz));
+        AttributePairType * t1 = reinterpret_cast<AttributePairType *>(&t0[1]);
+        t0[0] = 0;
         memcpy(static_cast<void*>(t1), u_.dict,
                size_ * sizeof(AttributePairType));
         memset(static_cast<void*>(&t1[size_]), 0,
                 (MIN_ALLOC_BYTES * req_sz) - size_ * sizeof(AttributePairType));
         if (size_) {
-            RISCV_free(u_.dict);
+            t0[0] = dict_index(u_.dict);
+            attr_mfree(&dict_index(u_.dict));
         }
         u_.dict = t1;
     }
@@ -606,7 +835,7 @@ int string_to_attribute(const char *cfg, int &off,
                 return -1;
             }
             out->realloc_list(out->size() + 1);
-            (*out)[out->size() - 1] = new_item;
+            (*out)[out->size() - 1] = std::move(new_item);
 
             off = skip_special_symbols(cfg, off);
             if (cfg[off] == ',') {
@@ -647,7 +876,7 @@ int string_to_attribute(const char *cfg, int &off,
                 return -1;
             }
 
-            (*out)[new_key.to_string()] = new_value;
+            (*out)[new_key.to_string()] = std::move(new_value);
 
             off = skip_special_symbols(cfg, off);
             if (cfg[off] == ',') {
@@ -18,6 +18,7 @@
 #define __DEBUGGER_ATTRIBUTE_H__
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include <iattr.h>
 
@@ -63,6 +64,16 @@ class AttributeType : public IAttribute {
         clone(&other);
     }
 
+    /** Take ownership of the other's value without copying */
+    AttributeType(AttributeType &&other) {
+        kind_ = other.kind_;
+        size_ = other.size_;
+        u_ = other.u_;
+        other.kind_ = Attr_Invalid;
+        other.size_ = 0;
+        other.u_.integer = 0;
+    }
+
     AttributeType() {
         kind_ = Attr_Invalid;
         size_ = 0;
@@ -81,11 +92,14 @@ class AttributeType : public IAttribute {
     void attr_free();
 
     explicit AttributeType(const char *str) {
+        kind_ = Attr_Invalid;
+        size_ = 0;
         make_string(str);
     }
 
     explicit AttributeType(IFace *mod) {
         kind_ = Attr_Interface;
+        size_ = 0;
         u_.iface = mod;
     }
 
@@ -102,6 +116,8 @@ class AttributeType : public IAttribute {
     }
 
     AttributeType(KindType type, uint64_t v) {
+        kind_ = Attr_Invalid;
+        size_ = 0;
         if (type == Attr_Integer) {
             make_int64(static_cast<int64_t>(v));
         } else if (type == Attr_UInteger) {
@@ -324,6 +340,7 @@ class AttributeType : public IAttribute {
     }
 
     AttributeType& operator=(const AttributeType& other);
+    AttributeType& operator=(AttributeType&& other);
 
     /**
      * @brief Access to the single element of the 'list' attribute:
@@ -348,10 +365,52 @@ class AttributeType : public IAttribute {
     void from_config(const char *str);
 };
 
+/**
+ * @brief Dictionary item.
+ *
+ * Keys are interned into the global reference counted pool, so the key
+ * copy doesn't allocate memory and the key string stays at the same address
+ * when the dictionary grows. Dictionaries with many items get the hash
+ * index, smaller ones compare the hash before comparing strings.
+ */
 class AttributePairType {
  public:
     AttributeType key_;
     AttributeType value_;
+    uint32_t hash_;
+};
+
+/**
+ * @brief Optional allocator for temporary attribute trees.
+ *
+ * While the arena is active all the memory requested by AttributeType in
+ * the current thread is taken from the arena chunks and releasing it is
+ * a no-op. Trees allocated inside of the arena must be freed before reset()
+ * or destruction of the arena; a copy made outside of the active region is
+ * allocated from the heap as usual.
+ */
+class AttributeArena {
+ public:
+    AttributeArena();
+    ~AttributeArena();
+
+    void activate();
+    void deactivate();
+    void reset();
+    /** Returns 0 when the block should be taken from the heap */
+    void *alloc(size_t sz);
+
+ private:
+    static const size_t CHUNK_SIZE = 1 << 16;
+
+    struct ChunkType {
+        ChunkType *next;
+        size_t used;
+    };
+
+    AttributeArena *prev_;
+    ChunkType *first_;
+    ChunkType *cur_;
 };
 
 }  // namespace debugger
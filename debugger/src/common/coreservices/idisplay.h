@@ -39,10 +39,16 @@ class GenericDisplayCmdType : public ICommand {
             "Response 'frame':\n"
             "    List [b0,b1,b1,...],\n"
             "          Bytes of column0,column1,etcn"
+            "Response 'update <seq>':\n"
+            "    List [seq,[[x,y,w,h,data],...]]\n"
+            "          Rectangles modified since the sequence number\n"
+            "          returned by the previous request (0 = full frame).\n"
+            "          Data contains pixels of column x,x+1,etc\n"
             "Usage:\n"
             "    display0 config\n"
             "    display0 frame\n"
-            "    display0 frame encoded");
+            "    display0 frame encoded\n"
+            "    display0 update 0");
     }
 
     /** ICommand */
@@ -71,6 +77,12 @@ class GenericDisplayCmdType : public ICommand {
             if (args->size() > 2 && (*args)[2].is_equal("encoded")) {
                 encode(res);
             }
+        } else if (type.is_equal("update")) {
+            uint64_t seq = 0;
+            if (args->size() > 2 && (*args)[2].is_integer()) {
+                seq = (*args)[2].to_uint64();
+            }
+            getUpdate(res, seq);
         }
     }
 
@@ -79,6 +91,19 @@ class GenericDisplayCmdType : public ICommand {
     virtual int getHeight() = 0;
     virtual uint32_t getBkgColor() = 0;     // distance between pixels
     virtual void getFrame(AttributeType *res, bool diff) = 0;
+    /** Default implementation always returns the full frame */
+    virtual void getUpdate(AttributeType *res, uint64_t seq) {
+        res->make_list(2);
+        (*res)[0u].make_uint64(seq + 1);
+        (*res)[1].make_list(1);
+        AttributeType &rect = (*res)[1][0u];
+        rect.make_list(5);
+        rect[0u].make_int64(0);
+        rect[1].make_int64(0);
+        rect[2].make_int64(getWidth());
+        rect[3].make_int64(getHeight());
+        getFrame(&rect[4], false);
+    }
     virtual void encode(AttributeType *frame) {
         if (!frame->is_data()) {
             return;
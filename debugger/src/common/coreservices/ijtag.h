@@ -486,7 +486,59 @@ class IJtag : public IFace {
         return get_reg(reg2addr(regname), regsize(regname), res);
     }
 
-    virtual uint32_t set_reg(const char *regname, Reg64Type *val) {
+    /**
+     * Read cnt registers with the sequential numbers. The first command uses
+     * aarpostincrement and the following ones are started by reading data1
+     * (abstractauto), so every register costs two DMI reads only. On any
+     * cmderr the whole set is re-read one command per register.
+     */
+    virtual uint32_t get_regs(uint32_t regaddr, uint32_t regsize,
+                              unsigned cnt, Reg64Type *res) {
+        IJtag::dmi_command_type command;
+        uint32_t cmderr;
+        if (cnt < 2) {
+            return cnt ? get_reg(regaddr, regsize, res) : 0;
+        }
+
+        command.u32 = 0;
+        command.regaccess.cmdtype = 0;
+        command.regaccess.aarsize = regsize;
+        command.regaccess.transfer = 1;
+        command.regaccess.aarpostincrement = 1;
+        command.regaccess.regno = regaddr;
+
+        write_dmi(IJtag::DMI_COMMAND, command.u32);
+        cmderr = wait_dmi();
+        if (cmderr) {
+            clear_cmderr();
+            return cmderr;
+        }
+        // data0/1 hold the first register, reading data1 fetches the next
+        write_dmi(IJtag::DMI_ABSTRACTAUTO, 1u << 1);
+        for (unsigned i = 0; i < cnt; i++) {
+            if (i == cnt - 1) {
+                write_dmi(IJtag::DMI_ABSTRACTAUTO, 0);
+            }
+            res[i].buf32[0] = read_dmi(IJtag::DMI_ABSTRACT_DATA0);
+            res[i].buf32[1] = read_dmi(IJtag::DMI_ABSTRACT_DATA1);
+        }
+        cmderr = wait_dmi();
+        if (cmderr == 0) {
+            return 0;
+        }
+
+        clear_cmderr();
+        for (unsigned i = 0; i < cnt; i++) {
+            cmderr = get_reg(regaddr + i, regsize, &res[i]);
+            if (cmderr) {
+                clear_cmderr();
+                break;
+            }
+        }
+        return cmderr;
+    }
+
+    virtual uint32_t set_reg(uint32_t regaddr, uint32_t regsize, Reg64Type *val) {
         IJtag::dmi_command_type command;
         uint32_t cmderr;
 
@@ -495,11 +547,11 @@ class IJtag : public IFace {
 
         command.u32 = 0;
         command.regaccess.cmdtype = 0;
-        command.regaccess.aarsize = regsize(regname);
+        command.regaccess.aarsize = regsize;
         command.regaccess.write = 1;
         command.regaccess.transfer = 1;
         command.regaccess.aarpostincrement = 1;
-        command.regaccess.regno = reg2addr(regname);
+        command.regaccess.regno = regaddr;
 
         write_dmi(IJtag::DMI_COMMAND, command.u32);
         cmderr = wait_dmi();
@@ -509,6 +561,46 @@ class IJtag : public IFace {
         }
         return cmderr;
     }
+
+    virtual uint32_t set_reg(const char *regname, Reg64Type *val) {
+        return set_reg(reg2addr(regname), regsize(regname), val);
+    }
+
+    /** Write cnt sequential registers, each command is started by data1 */
+    virtual uint32_t set_regs(uint32_t regaddr, uint32_t regsize,
+                              unsigned cnt, Reg64Type *val) {
+        uint32_t cmderr;
+        if (cnt < 2) {
+            return cnt ? set_reg(regaddr, regsize, val) : 0;
+        }
+
+        // The first command sets regno with aarpostincrement
+        cmderr = set_reg(regaddr, regsize, &val[0]);
+        if (cmderr) {
+            clear_cmderr();
+            return cmderr;
+        }
+        write_dmi(IJtag::DMI_ABSTRACTAUTO, 1u << 1);
+        for (unsigned i = 1; i < cnt; i++) {
+            write_dmi(IJtag::DMI_ABSTRACT_DATA0, val[i].buf32[0]);
+            write_dmi(IJtag::DMI_ABSTRACT_DATA1, val[i].buf32[1]);
+        }
+        write_dmi(IJtag::DMI_ABSTRACTAUTO, 0);
+        cmderr = wait_dmi();
+        if (cmderr == 0) {
+            return 0;
+        }
+
+        clear_cmderr();
+        for (unsigned i = 1; i < cnt; i++) {
+            cmderr = set_reg(regaddr + i, regsize, &val[i]);
+            if (cmderr) {
+                clear_cmderr();
+                break;
+            }
+        }
+        return cmderr;
+    }
 };
 
 }  // namespace debugger
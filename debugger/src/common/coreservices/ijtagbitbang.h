@@ -42,6 +42,30 @@ class IJtagBitBang : public IFace {
     virtual void resetTAP(char trst, char srst) = 0;
     virtual void setPins(char tck, char tms, char tdi) = 0;
     virtual bool getTDO() = 0;
+
+    /**
+     * Apply a run of the remote-bitbang commands: '0'..'7' pins,
+     * 'r'..'u' reset and 'R' read. TDO of every 'R' is written into obuf
+     * as '0'/'1' character, its count into *osz. Stops on any other
+     * character and returns the number of consumed characters.
+     */
+    virtual int bitbang(const char *ibuf, int isz, char *obuf, int *osz) {
+        int i;
+        *osz = 0;
+        for (i = 0; i < isz; i++) {
+            char c = ibuf[i];
+            if (c >= '0' && c <= '7') {
+                setPins((c >> 2) & 1, (c >> 1) & 1, c & 1);
+            } else if (c >= 'r' && c <= 'u') {
+                resetTAP(((c - 'r') >> 1) & 1, (c - 'r') & 1);
+            } else if (c == 'R') {
+                obuf[(*osz)++] = getTDO() ? '1' : '0';
+            } else {
+                break;
+            }
+        }
+        return i;
+    }
 };
 
 }  // namespace debugger
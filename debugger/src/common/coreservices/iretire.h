@@ -0,0 +1,52 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef __DEBUGGER_COMMON_CORESERVICES_IRETIRE_H__
+#define __DEBUGGER_COMMON_CORESERVICES_IRETIRE_H__
+
+#include <inttypes.h>
+#include <iface.h>
+#include "generic/trace_bin.h"
+
+namespace debugger {
+
+static const char *const IFACE_RETIRE_LISTENER = "IRetireListener";
+
+/** Source of the retirement records */
+enum ERetireSource {
+    RetireSrc_Reference,        // functional model
+    RetireSrc_Dut,              // RTL model
+    RetireSrc_Total
+};
+
+/**
+ * @brief Listener of the retired instructions.
+ * @details Called from the model thread for each retired instruction,
+ *          the call may block the model to keep several models in lockstep.
+ *          Every hart of the model must be the only caller with its
+ *          (src, hartid) pair.
+ */
+class IRetireListener : public IFace {
+ public:
+    IRetireListener() : IFace(IFACE_RETIRE_LISTENER) {}
+
+    virtual void retired(int src, int hartid,
+                         const TraceBinRecordType *rec) = 0;
+};
+
+}  // namespace debugger
+
+#endif  // __DEBUGGER_COMMON_CORESERVICES_IRETIRE_H__
@@ -68,6 +68,15 @@ enum EColumnNames {
 
 static const uint64_t BreakFlag_HW = (1 << 0);
 
+/** Result of the batched symbolization. Strings are owned by the source
+    code service and valid until the symbols or debug info are reloaded. */
+struct SourceLocationType {
+    const char *symbol;     // empty string if not found
+    uint64_t offset;        // offset from the symbol start
+    const char *file;       // empty string if no line information
+    int line;
+};
+
 class ISourceCode : public IFace {
  public:
     ISourceCode() : IFace(IFACE_SOURCE_CODE) {}
@@ -89,6 +98,22 @@ class ISourceCode : public IFace {
 
     virtual int symbol2Address(const char *name, uint64_t *addr) = 0;
 
+    /** Set DWARF sections used for the address to line conversion.
+     *
+     * @param[in] sections Dictionary of the section name ('.debug_line',
+     *                     '.debug_line_str', '.debug_str') to data.
+     */
+    virtual void setDebugLineInfo(AttributeType *sections) = 0;
+
+    /** Batched conversion of addresses into symbol and source line.
+     *
+     * @param[in]  addr Array of addresses
+     * @param[in]  cnt  Number of addresses
+     * @param[out] loc  Array of cnt locations
+     */
+    virtual void addressToSource(const uint64_t *addr, unsigned cnt,
+                                 SourceLocationType *loc) = 0;
+
     /** Disasm input data buffer.
      *
      * @return disassembled instruction length
@@ -23,6 +23,8 @@ BusGeneric::BusGeneric(const char *name) : IService(name),
     IHap(HAP_ConfigDone) {
     registerInterface(static_cast<IMemoryOperation *>(this));
     registerAttribute("AddrWidth", &addrWidth_);
+    registerAttribute("BTransactions", &bTransactions_);
+    registerAttribute("NbTransactions", &nbTransactions_);
     RISCV_mutex_init(&mutexBAccess_);
     RISCV_mutex_init(&mutexNBAccess_);
     RISCV_register_hap(static_cast<IHap *>(this));
@@ -33,6 +35,8 @@ BusGeneric::BusGeneric(const char *name) : IService(name),
         imemtbl_[i].devlist.make_list(0);
     }
     addrWidth_.make_int64(39);      // 39-bits address width for FU740
+    bTransactions_.make_uint64(0);
+    nbTransactions_.make_uint64(0);
 }
 
 BusGeneric::~BusGeneric() {
@@ -96,6 +100,7 @@ ETransStatus BusGeneric::b_transport(Axi4TransactionType *trans) {
     IMemoryOperation *memdev = 0;
 
     RISCV_mutex_lock(&mutexBAccess_);
+    bTransactions_.make_uint64(bTransactions_.to_uint64() + 1);
 
     getMapedDevice(trans, &memdev, &sz);
 
@@ -121,6 +126,7 @@ ETransStatus BusGeneric::nb_transport(Axi4TransactionType *trans,
     uint32_t sz;
 
     RISCV_mutex_lock(&mutexNBAccess_);
+    nbTransactions_.make_uint64(nbTransactions_.to_uint64() + 1);
 
     getMapedDevice(trans, &memdev, &sz);
 
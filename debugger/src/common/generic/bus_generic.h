@@ -54,6 +54,8 @@ class BusGeneric : public IService,
     static const int HASH_ADDR_WIDTH = 14;
     static const int HASH_TBL_SIZE = 1 << HASH_ADDR_WIDTH;
     AttributeType addrWidth_;       // address bits (39 bits for FU740). [63:39] must be equal to [38]
+    AttributeType bTransactions_;   // blocking transactions counter
+    AttributeType nbTransactions_;  // non-blocking transactions counter
     mutex_def mutexBAccess_;
     mutex_def mutexNBAccess_;
     Axi4TransactionType b_tr_;
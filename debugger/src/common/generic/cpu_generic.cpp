@@ -41,11 +41,13 @@ CpuGeneric::CpuGeneric(const char *name)
     registerAttribute("StackTraceSize", &stackTraceSize_);
     registerAttribute("FreqHz", &freqHz_);
     registerAttribute("GenerateTraceFile", &generateTraceFile_);
+    registerAttribute("TraceBinary", &traceBinary_);
     registerAttribute("ResetVector", &resetVector_);
     registerAttribute("SysBusMasterID", &sysBusMasterID_);
     registerAttribute("CacheBaseAddress", &cacheBaseAddr_);
     registerAttribute("CacheAddressMask", &cacheAddrMask_);
     registerAttribute("CoverageTracker", &coverageTracker_);
+    registerAttribute("RetireListener", &retireListener_);
     registerAttribute("TriggersTotal", &triggersTotal_);
     registerAttribute("McontrolMaskmax", &mcontrolMaskmax_);
     registerAttribute("ResetState", &resetState_);
@@ -73,6 +75,8 @@ CpuGeneric::CpuGeneric(const char *name)
 
     ptriggers_ = 0;
     trace_file_ = 0;
+    trace_bin_ = 0;
+    iretire_ = 0;
     trace_data_.step_cnt = 0;
     trace_data_.pc = 0;
     trace_data_.instrbuf.make_data(8);
@@ -112,6 +116,9 @@ CpuGeneric::~CpuGeneric() {
         trace_file_->close();
         delete trace_file_;
     }
+    if (trace_bin_) {
+        delete trace_bin_;
+    }
 }
 
 void CpuGeneric::postinitService() {
@@ -148,6 +155,17 @@ void CpuGeneric::postinitService() {
         }
     }
 
+    iretire_ = 0;
+    if (retireListener_.size()) {
+        iretire_ = static_cast<IRetireListener *>(
+            RISCV_get_service_iface(retireListener_.to_string(),
+                                    IFACE_RETIRE_LISTENER));
+        if (!iretire_) {
+            RISCV_error("IRetireListener interface '%s' not found",
+                        retireListener_.to_string());
+        }
+    }
+
     icmdexec_ = static_cast<ICmdExecutor *>(
        RISCV_get_service_iface(cmdexec_.to_string(), IFACE_CMD_EXECUTOR));
     if (!icmdexec_) {
@@ -177,7 +195,17 @@ void CpuGeneric::postinitService() {
             return;
         }
         if (generateTraceFile_.is_string() && generateTraceFile_.size()) {
-            trace_file_ = new std::ofstream(generateTraceFile_.to_string());
+            if (traceBinary_.to_bool()) {
+                trace_bin_ = new TraceBinWriter();
+                if (!trace_bin_->open(generateTraceFile_.to_string())) {
+                    RISCV_error("Can't open trace file %s",
+                                generateTraceFile_.to_string());
+                    delete trace_bin_;
+                    trace_bin_ = 0;
+                }
+            } else {
+                trace_file_ = new std::ofstream(generateTraceFile_.to_string());
+            }
         }
     }
 
@@ -234,6 +262,8 @@ void CpuGeneric::updatePipeline() {
 
     if (trace_file_) {
         traceOutput();
+    } else if (trace_bin_) {
+        traceOutputBin();
     }
 }
 
@@ -283,8 +313,9 @@ void CpuGeneric::updateQueue() {
     queue_.initProc();
     queue_.pushPreQueued();
 
-    while ((cb = queue_.getNext(step_cnt_)) != 0) {
-        static_cast<IClockListener *>(cb)->stepCallback(step_cnt_);
+    uint64_t t = getStepCounter();
+    while ((cb = queue_.getNext(t)) != 0) {
+        static_cast<IClockListener *>(cb)->stepCallback(t);
     }
 }
 
@@ -357,7 +388,7 @@ void CpuGeneric::flush(uint64_t addr) {
 }
 
 void CpuGeneric::trackContextStart() {
-    if (!trace_file_) {
+    if (!trace_file_ && !trace_bin_ && !iretire_) {
         return;
     }
     trace_data_.action_cnt = 0;
@@ -367,6 +398,11 @@ void CpuGeneric::trackContextStart() {
 }
 
 void CpuGeneric::trackContextEnd() {
+    if (iretire_ && instr_) {
+        TraceBinRecordType rec;
+        traceRecord(&rec);
+        iretire_->retired(RetireSrc_Reference, retireHartId(), &rec);
+    }
     if (do_not_cache_) {
         if (cachable_pc_) {
             icache_[cache_offset_].instr = 0;
@@ -406,9 +442,38 @@ void CpuGeneric::traceMemop(uint64_t addr, int we, uint64_t v, uint32_t sz) {
     p->memop_size = sz;
 }
 
+void CpuGeneric::traceRecord(TraceBinRecordType *rec) {
+    memset(rec, 0, sizeof(TraceBinRecordType));
+    rec->step_cnt = trace_data_.step_cnt;
+    rec->pc = trace_data_.pc;
+    memcpy(&rec->instr, trace_data_.instrbuf.data(), sizeof(uint32_t));
+    for (int i = 0; i < trace_data_.action_cnt; i++) {
+        trace_action_type *pa = &trace_data_.action[i];
+        if (!pa->memop) {
+            if (rec->regcnt < TRACE_BIN_REG_MAX) {
+                rec->reg[rec->regcnt].addr = pa->waddr;
+                rec->reg[rec->regcnt].data = pa->wdata;
+                rec->regcnt++;
+            }
+        } else if (rec->memcnt < TRACE_BIN_MEM_MAX) {
+            rec->mem[rec->memcnt].addr = pa->memop_addr;
+            rec->mem[rec->memcnt].data = pa->memop_data.val;
+            rec->mem[rec->memcnt].store = pa->memop_write;
+            rec->mem[rec->memcnt].size = pa->memop_size;
+            rec->memcnt++;
+        }
+    }
+}
+
+void CpuGeneric::traceOutputBin() {
+    TraceBinRecordType rec;
+    traceRecord(&rec);
+    trace_bin_->write(&rec);
+}
+
 void CpuGeneric::registerStepCallback(IClockListener *cb,
                                                uint64_t t) {
-    if (!isEnabled() && t <= step_cnt_) {
+    if (!isEnabled() && t <= getStepCounter()) {
         cb->stepCallback(t);
         return;
     }
@@ -425,7 +490,7 @@ bool CpuGeneric::moveStepCallback(IClockListener *cb, uint64_t t) {
 
 void CpuGeneric::setReg(int idx, uint64_t val) {
     R[idx] = val;
-    if (trace_file_) {
+    if (trace_file_ || trace_bin_ || iretire_) {
         traceRegister(idx, val);
     }
 }
@@ -493,7 +558,7 @@ ETransStatus CpuGeneric::dma_memop(Axi4TransactionType *tr, int flags) {
         }
     }
 
-    if (trace_file_) {
+    if (trace_file_ || trace_bin_ || iretire_) {
         int we = tr->action == MemAction_Write ? 1 : 0;
         Reg64Type memop_data;
         memop_data.val = 0;
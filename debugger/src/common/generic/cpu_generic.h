@@ -30,7 +30,9 @@
 #include "coreservices/isrccode.h"
 #include "coreservices/icmdexec.h"
 #include "coreservices/icoveragetracker.h"
+#include "coreservices/iretire.h"
 #include "generic/mapreg.h"
+#include "generic/trace_bin.h"
 #include <riscv-isa.h>
 #include <fstream>
 
@@ -112,6 +114,9 @@ class CpuGeneric : public IService,
     virtual void traceRegister(int idx, uint64_t v);
     virtual void traceMemop(uint64_t addr, int we, uint64_t v, uint32_t sz);
     virtual void traceOutput() {}
+    virtual int retireHartId() { return 0; }
+    void traceOutputBin();
+    void traceRecord(TraceBinRecordType *rec);
     virtual bool isStepEnabled() { return false; }
     virtual bool isTriggerICount();
     virtual bool isTriggerInstruction();
@@ -161,17 +166,20 @@ class CpuGeneric : public IService,
     AttributeType sourceCode_;
     AttributeType stackTraceSize_;
     AttributeType generateTraceFile_;
+    AttributeType traceBinary_;
     AttributeType resetVector_;
     AttributeType sysBusMasterID_;
     AttributeType cacheBaseAddr_;
     AttributeType cacheAddrMask_;
     AttributeType coverageTracker_;
+    AttributeType retireListener_;
     AttributeType resetState_;
     AttributeType triggersTotal_;
     AttributeType mcontrolMaskmax_;
 
     ISourceCode *isrc_;
     ICoverageTracker *icovtracker_;
+    IRetireListener *iretire_;
     ICmdExecutor *icmdexec_;
     IMemoryOperation *isysbus_;
     GenericInstruction *instr_;
@@ -281,6 +289,7 @@ class CpuGeneric : public IService,
         int action_cnt;
     } trace_data_;
     std::ofstream *trace_file_;
+    TraceBinWriter *trace_bin_;
 };
 
 }  // namespace debugger
@@ -0,0 +1,237 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "api_core.h"
+#include "hexload.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace debugger {
+
+FileView::FileView() {
+    data_ = 0;
+    size_ = 0;
+    mapped_ = false;
+}
+
+FileView::~FileView() {
+    close();
+}
+
+bool FileView::open(const char *filename) {
+    close();
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *p = mmap(NULL, static_cast<size_t>(st.st_size),
+                       PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+            data_ = static_cast<const char *>(p);
+            size_ = static_cast<uint64_t>(st.st_size);
+            mapped_ = true;
+            ::close(fd);
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+    // Not mappable: read the whole file
+    FILE *fp = fopen(filename, "rb");
+    if (!fp) {
+        return false;
+    }
+    fseek(fp, 0, SEEK_END);
+    long fsz = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (fsz > 0) {
+        char *buf = new char[fsz];
+        size_ = fread(buf, 1, static_cast<size_t>(fsz), fp);
+        data_ = buf;
+    }
+    fclose(fp);
+    return true;
+}
+
+void FileView::close() {
+    if (data_ == 0) {
+        return;
+    }
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+    if (mapped_) {
+        munmap(const_cast<char *>(data_), static_cast<size_t>(size_));
+    }
+#endif
+    if (!mapped_) {
+        delete [] data_;
+    }
+    data_ = 0;
+    size_ = 0;
+    mapped_ = false;
+}
+
+/** Nibble value of the symbol or 0xFF */
+struct HexTable {
+    uint8_t v[256];
+    HexTable() {
+        memset(v, 0xFF, sizeof(v));
+        for (int i = 0; i < 10; i++) {
+            v['0' + i] = static_cast<uint8_t>(i);
+        }
+        for (int i = 0; i < 6; i++) {
+            v['A' + i] = static_cast<uint8_t>(10 + i);
+            v['a' + i] = static_cast<uint8_t>(10 + i);
+        }
+    }
+};
+
+static const HexTable HEX_TABLE;
+
+int HexImage::hexbyte(const char *pair) {
+    uint8_t h = HEX_TABLE.v[static_cast<uint8_t>(pair[0])];
+    uint8_t l = HEX_TABLE.v[static_cast<uint8_t>(pair[1])];
+    if ((h | l) & 0xF0) {
+        return -1;
+    }
+    return (h << 4) | l;
+}
+
+bool HexImage::hex2bin(const char *src, int cnt, uint8_t *dst) {
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i c0 = _mm_set1_epi8('0' - 1);
+    const __m128i c9 = _mm_set1_epi8('9' + 1);
+    const __m128i ca = _mm_set1_epi8('a' - 1);
+    const __m128i cf = _mm_set1_epi8('f' + 1);
+    const __m128i lower = _mm_set1_epi8(0x20);
+    const __m128i off09 = _mm_set1_epi8('0');
+    const __m128i offaf = _mm_set1_epi8('a' - 10);
+    const __m128i lsb = _mm_set1_epi16(0x00FF);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= cnt; i += 8) {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                                    &src[2 * i]));
+        __m128i lc = _mm_or_si128(c, lower);
+        __m128i isdig = _mm_and_si128(_mm_cmpgt_epi8(c, c0),
+                                      _mm_cmplt_epi8(c, c9));
+        __m128i isalp = _mm_and_si128(_mm_cmpgt_epi8(lc, ca),
+                                      _mm_cmplt_epi8(lc, cf));
+        if (_mm_movemask_epi8(_mm_or_si128(isdig, isalp)) != 0xFFFF) {
+            return false;
+        }
+        __m128i nib = _mm_or_si128(
+            _mm_and_si128(isdig, _mm_sub_epi8(c, off09)),
+            _mm_andnot_si128(isdig, _mm_sub_epi8(lc, offaf)));
+        // even symbol is the high nibble: (lane[7:0] << 4) | lane[15:8]
+        __m128i b = _mm_or_si128(
+            _mm_slli_epi16(_mm_and_si128(nib, lsb), 4),
+            _mm_srli_epi16(nib, 8));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(&dst[i]),
+                         _mm_packus_epi16(b, zero));
+    }
+#endif
+    for (; i < cnt; i++) {
+        int t = hexbyte(&src[2 * i]);
+        if (t < 0) {
+            return false;
+        }
+        dst[i] = static_cast<uint8_t>(t);
+    }
+    return true;
+}
+
+int HexImage::readHexLines(const char *filename, uint8_t *buf, int bufsz) {
+    FileView f;
+    if (!f.open(filename)) {
+        RISCV_printf(NULL, LOG_ERROR, "Can't open '%s' file", filename);
+        return 0;
+    }
+
+    const char *s = f.data();
+    const char *end = s + f.size();
+    int ret = 0;
+    while (s < end) {
+        const char *e = static_cast<const char *>(
+                memchr(s, '\n', static_cast<size_t>(end - s)));
+        if (e == 0) {
+            e = end;
+        }
+        const char *le = e;
+        if (le > s && le[-1] == '\r') {
+            le--;
+        }
+        int n = static_cast<int>(le - s);
+        int wrsz;
+        if ((n & 1) == 0 && ret + n / 2 <= bufsz
+            && hex2bin(s, n / 2, &buf[ret])) {
+            std::reverse(&buf[ret], &buf[ret + n / 2]);
+            wrsz = n / 2;
+        } else {
+            wrsz = readHexLinesSlow(s, le, &buf[ret], bufsz - ret);
+        }
+        if (wrsz < 0) {
+            RISCV_printf(NULL, LOG_ERROR, "HEX file tries to write out "
+                         "of allocated array", NULL);
+            break;
+        }
+        ret += wrsz;
+        s = e + 1;
+    }
+    return ret;
+}
+
+/**
+ * Line with odd number of digits or other symbols: every run of digits
+ * is a separate value, the odd most significant digit is dropped.
+ */
+int HexImage::readHexLinesSlow(const char *s, const char *e,
+                               uint8_t *buf, int bufsz) {
+    int ret = 0;
+    while (s < e) {
+        const char *p = s;
+        while (p < e && HEX_TABLE.v[static_cast<uint8_t>(*p)] != 0xFF) {
+            p++;
+        }
+        int n = static_cast<int>(p - s);
+        if (n / 2 > bufsz - ret) {
+            return -1;
+        }
+        hex2bin(s + (n & 1), n / 2, &buf[ret]);
+        std::reverse(&buf[ret], &buf[ret + n / 2]);
+        ret += n / 2;
+        s = p + 1;
+    }
+    return ret;
+}
+
+}  // namespace debugger
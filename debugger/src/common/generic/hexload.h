@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <api_types.h>
+
+namespace debugger {
+
+/**
+ * Read-only view of the whole file: mapped into memory on POSIX systems,
+ * read into the allocated buffer otherwise.
+ */
+class FileView {
+ public:
+    FileView();
+    ~FileView();
+
+    bool open(const char *filename);
+    void close();
+    const char *data() { return data_; }
+    uint64_t size() { return size_; }
+
+ private:
+    const char *data_;
+    uint64_t size_;
+    bool mapped_;
+};
+
+/** Hex text conversion shared by the memory images loaders */
+class HexImage {
+ public:
+    /**
+     * Convert 2 * cnt hex digits into cnt bytes, 16 digits per step when
+     * SSE2 is available.
+     * @return false if a non-hex symbol was found, dst is partly written
+     */
+    static bool hex2bin(const char *src, int cnt, uint8_t *dst);
+
+    /** @return byte value of two hex digits or -1 */
+    static int hexbyte(const char *pair);
+
+    /**
+     * Text image with a single value per line (output of $writememh or
+     * elf2raw), the last digit pair of the line is the lowest address.
+     * @return number of bytes written into buf
+     */
+    static int readHexLines(const char *filename, uint8_t *buf, int bufsz);
+
+ private:
+    static int readHexLinesSlow(const char *s, const char *e,
+                                uint8_t *buf, int bufsz);
+};
+
+}  // namespace debugger
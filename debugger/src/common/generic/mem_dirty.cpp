@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "api_core.h"
+#include "mem_dirty.h"
+
+namespace debugger {
+
+MemDirtyTracker::MemDirtyTracker() {
+    stamp_ = 0;
+    pages_ = 0;
+    log2page_ = 12;
+    gen_ = 1;
+}
+
+MemDirtyTracker::~MemDirtyTracker() {
+    if (stamp_) {
+        delete [] stamp_;
+    }
+}
+
+void MemDirtyTracker::init(uint64_t length, uint64_t pagesz) {
+    if (stamp_) {
+        delete [] stamp_;
+        stamp_ = 0;
+    }
+    pages_ = 0;
+    gen_ = 1;
+    if (pagesz == 0 || length == 0) {
+        return;
+    }
+    log2page_ = 0;
+    while ((2ull << log2page_) <= pagesz) {
+        log2page_++;
+    }
+    pages_ = (length + pageSize() - 1) >> log2page_;
+    stamp_ = new uint64_t[pages_];
+    memset(stamp_, 0, pages_ * sizeof(uint64_t));
+}
+
+uint64_t MemDirtyTracker::changedSince(uint64_t since, AttributeType *res) {
+    AttributeType item;
+    uint64_t start = 0;
+    bool inrange = false;
+
+    res->make_list(0);
+    if (!stamp_) {
+        return 0;
+    }
+    uint64_t ret = gen_ + 1;
+    gen_ = ret;
+
+    for (uint64_t p = 0; p < pages_; p++) {
+        uint64_t t = stamp_[p];
+        bool changed = t != 0 && t >= since;
+        if (changed && !inrange) {
+            start = p;
+            inrange = true;
+        } else if (!changed && inrange) {
+            item.make_list(2);
+            item[0u].make_uint64(start << log2page_);
+            item[1].make_uint64((p - start) << log2page_);
+            res->add_to_list(&item);
+            inrange = false;
+        }
+    }
+    if (inrange) {
+        item.make_list(2);
+        item[0u].make_uint64(start << log2page_);
+        item[1].make_uint64((pages_ - start) << log2page_);
+        res->add_to_list(&item);
+    }
+    return ret;
+}
+
+void MemDirtyCmdType::exec(AttributeType *args, AttributeType *res) {
+    AttributeType ranges;
+    uint64_t since = 0;
+    if (args->size() == 3) {
+        since = (*args)[2].to_uint64();
+    }
+    uint64_t gen = tracker_->changedSince(since, &ranges);
+    for (unsigned i = 0; i < ranges.size(); i++) {
+        ranges[i][0u].make_uint64(base_ + ranges[i][0u].to_uint64());
+    }
+    res->make_dict();
+    (*res)["Generation"].make_uint64(gen);
+    (*res)["PageSize"].make_uint64(tracker_->pageSize());
+    (*res)["Ranges"] = ranges;
+}
+
+}  // namespace debugger
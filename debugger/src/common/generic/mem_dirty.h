@@ -0,0 +1,120 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <api_types.h>
+#include <attribute.h>
+#include "iservice.h"
+#include "coreservices/icommand.h"
+
+namespace debugger {
+
+/**
+ * @brief Page granular write tracking of a memory model.
+ *
+ * Every page keeps the generation number of its last write. The write path
+ * only stores the current generation into the page slot. Reading the list
+ * of changed pages closes the current generation, so the returned number
+ * is the argument of the next differential request.
+ */
+class MemDirtyTracker {
+ public:
+    MemDirtyTracker();
+    ~MemDirtyTracker();
+
+    /** Zero page size disables tracking */
+    void init(uint64_t length, uint64_t pagesz);
+    bool isEnabled() { return stamp_ != 0; }
+    uint64_t pageSize() { return 1ull << log2page_; }
+
+    void mark(uint64_t off, uint64_t sz) {
+        if (!stamp_ || sz == 0) {
+            return;
+        }
+        uint64_t p = off >> log2page_;
+        uint64_t pend = (off + sz - 1) >> log2page_;
+        uint64_t gen = gen_;
+        for (; p <= pend && p < pages_; p++) {
+            stamp_[p] = gen;
+        }
+    }
+
+    /**
+     * @param[in] since  Generation returned by the previous call, 0 to get
+     *                   all pages written after reset
+     * @param[out] res   List of [offset, size] of the contiguous ranges
+     * @return Generation to use in the next request
+     *
+     * The result is exact when the CPU is halted: a write racing with the
+     * scan can be missed.
+     */
+    uint64_t changedSince(uint64_t since, AttributeType *res);
+
+ private:
+    uint64_t *stamp_;
+    uint64_t pages_;
+    int log2page_;
+    volatile uint64_t gen_;
+};
+
+/**
+ * Command named as the memory object:
+ *     <mem> dirty [generation]
+ */
+class MemDirtyCmdType : public ICommand {
+ public:
+    MemDirtyCmdType(IService *parent, const char *name,
+                    MemDirtyTracker *tracker, uint64_t base)
+        : ICommand(parent, name), tracker_(tracker), base_(base) {
+        briefDescr_.make_string("Memory pages changed since generation");
+        detailedDescr_.make_string(
+            "Description:\n"
+            "    List address ranges written since the specified\n"
+            "    generation and start the new generation. Use the\n"
+            "    returned 'Generation' value in the next request to\n"
+            "    read only the difference.\n"
+            "Response:\n"
+            "    Dictionary {'Generation':g, 'PageSize':sz,\n"
+            "    'Ranges':[[addr, size], ...]}\n"
+            "Usage:\n"
+            "    <mem> dirty\n"
+            "    <mem> dirty 5\n");
+    }
+
+    /** ICommand */
+    virtual int isValid(AttributeType *args) {
+        if (!cmdName_.is_equal((*args)[0u].to_string())) {
+            return CMD_INVALID;
+        }
+        if (args->size() < 2 || !(*args)[1].is_equal("dirty")) {
+            return CMD_INVALID;
+        }
+        if (args->size() == 2
+            || (args->size() == 3 && (*args)[2].is_integer())) {
+            return CMD_VALID;
+        }
+        return CMD_WRONG_ARGS;
+    }
+
+    virtual void exec(AttributeType *args, AttributeType *res);
+
+ private:
+    MemDirtyTracker *tracker_;
+    uint64_t base_;
+};
+
+}  // namespace debugger
@@ -24,10 +24,15 @@ MemoryGeneric::MemoryGeneric(const char *name)  : IService(name) {
     registerAttribute("ReadOnly", &readOnly_);
     registerAttribute("DpiClient", &dpiClient_);
     registerAttribute("DpiRoutes", &dpiRoutes_);
+    registerAttribute("CmdExecutor", &cmdexec_);
+    registerAttribute("DirtyPageSize", &dirtyPageSize_);
 
     readOnly_.make_boolean(false);
+    dirtyPageSize_.make_uint64(0);
     mem_ = NULL;
     idpi_ = 0;
+    icmdexec_ = 0;
+    pcmdDirty_ = 0;
 }
 
 MemoryGeneric::~MemoryGeneric() {
@@ -46,6 +51,29 @@ void MemoryGeneric::postinitService() {
             RISCV_error("Can't get IDPi interface %s", dpiClient_.to_string());
         }
     }
+
+    dirty_.init(length_.to_uint64(), dirtyPageSize_.to_uint64());
+    if (dirty_.isEnabled() && cmdexec_.is_string() && cmdexec_.size()) {
+        icmdexec_ = static_cast<ICmdExecutor *>(
+            RISCV_get_service_iface(cmdexec_.to_string(), IFACE_CMD_EXECUTOR));
+        if (!icmdexec_) {
+            RISCV_error("ICmdExecutor interface '%s' not found",
+                        cmdexec_.to_string());
+        } else {
+            pcmdDirty_ = new MemDirtyCmdType(static_cast<IService *>(this),
+                                             getObjName(), &dirty_,
+                                             getBaseAddress());
+            icmdexec_->registerCommand(pcmdDirty_);
+        }
+    }
+}
+
+void MemoryGeneric::predeleteService() {
+    if (icmdexec_ && pcmdDirty_) {
+        icmdexec_->unregisterCommand(pcmdDirty_);
+        delete pcmdDirty_;
+        pcmdDirty_ = 0;
+    }
 }
 
 ETransStatus MemoryGeneric::b_transport(Axi4TransactionType *trans) {
@@ -57,7 +85,9 @@ ETransStatus MemoryGeneric::b_transport(Axi4TransactionType *trans) {
             trans->response = MemResp_Error;
         } else if (((1ul << trans->xsize) - 1) == trans->wstrb) {
             memcpy(&mem_[off], trans->wpayload.b8, trans->xsize);
+            dirty_.mark(off, trans->xsize);
         } else {
+            dirty_.mark(off, trans->xsize);
             for (uint64_t i = 0; i < trans->xsize; i++) {
                 if (((trans->wstrb >> i) & 0x1) == 0) {
                     continue;
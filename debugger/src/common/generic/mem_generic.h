@@ -20,7 +20,9 @@
 #include "iclass.h"
 #include "iservice.h"
 #include "coreservices/imemop.h"
+#include "coreservices/icmdexec.h"
 #include <coreservices/idpi.h>
+#include "mem_dirty.h"
 
 namespace debugger {
 
@@ -32,6 +34,7 @@ class MemoryGeneric : public IService,
 
     /** IService interface */
     virtual void postinitService();
+    virtual void predeleteService();
 
     /** IMemoryOperation */
     virtual ETransStatus b_transport(Axi4TransactionType *trans);
@@ -40,8 +43,13 @@ class MemoryGeneric : public IService,
     AttributeType readOnly_;
     AttributeType dpiClient_;
     AttributeType dpiRoutes_;
+    AttributeType cmdexec_;
+    AttributeType dirtyPageSize_;
 
     IDpi *idpi_;
+    ICmdExecutor *icmdexec_;
+    MemDirtyTracker dirty_;
+    MemDirtyCmdType *pcmdDirty_;
 
     uint8_t *mem_;
 };
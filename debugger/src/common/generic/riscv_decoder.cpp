@@ -0,0 +1,349 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <string.h>
+#include "riscv_decoder.h"
+
+namespace debugger {
+
+// Reserved (HINT) fields of the compressed instructions:
+static const char *const EXCL_RD0   = "????????????????????00000???????";
+static const char *const EXCL_RD2   = "????????????????????00010???????";
+static const char *const EXCL_RS2_0 = "?????????????????????????00000??";
+
+const RiscvEncodingType RISCV_ENCODINGS[] = {
+    // RV64I user level
+    {"ADD",         "0000000??????????000?????0110011", {0, 0}},
+    {"ADDI",        "?????????????????000?????0010011", {0, 0}},
+    {"ADDIW",       "?????????????????000?????0011011", {0, 0}},
+    {"ADDW",        "0000000??????????000?????0111011", {0, 0}},
+    {"AND",         "0000000??????????111?????0110011", {0, 0}},
+    {"ANDI",        "?????????????????111?????0010011", {0, 0}},
+    {"AUIPC",       "?????????????????????????0010111", {0, 0}},
+    {"BEQ",         "?????????????????000?????1100011", {0, 0}},
+    {"BGE",         "?????????????????101?????1100011", {0, 0}},
+    {"BGEU",        "?????????????????111?????1100011", {0, 0}},
+    {"BLT",         "?????????????????100?????1100011", {0, 0}},
+    {"BLTU",        "?????????????????110?????1100011", {0, 0}},
+    {"BNE",         "?????????????????001?????1100011", {0, 0}},
+    {"JAL",         "?????????????????????????1101111", {0, 0}},
+    {"JALR",        "?????????????????000?????1100111", {0, 0}},
+    {"LD",          "?????????????????011?????0000011", {0, 0}},
+    {"LW",          "?????????????????010?????0000011", {0, 0}},
+    {"LWU",         "?????????????????110?????0000011", {0, 0}},
+    {"LH",          "?????????????????001?????0000011", {0, 0}},
+    {"LHU",         "?????????????????101?????0000011", {0, 0}},
+    {"LB",          "?????????????????000?????0000011", {0, 0}},
+    {"LBU",         "?????????????????100?????0000011", {0, 0}},
+    {"LUI",         "?????????????????????????0110111", {0, 0}},
+    {"OR",          "0000000??????????110?????0110011", {0, 0}},
+    {"ORI",         "?????????????????110?????0010011", {0, 0}},
+    {"SLL",         "0000000??????????001?????0110011", {0, 0}},
+    {"SLLI",        "000000???????????001?????0010011", {0, 0}},
+    {"SLLIW",       "0000000??????????001?????0011011", {0, 0}},
+    {"SLLW",        "0000000??????????001?????0111011", {0, 0}},
+    {"SLT",         "0000000??????????010?????0110011", {0, 0}},
+    {"SLTI",        "?????????????????010?????0010011", {0, 0}},
+    {"SLTU",        "0000000??????????011?????0110011", {0, 0}},
+    {"SLTIU",       "?????????????????011?????0010011", {0, 0}},
+    {"SRA",         "0100000??????????101?????0110011", {0, 0}},
+    {"SRAI",        "010000???????????101?????0010011", {0, 0}},
+    {"SRAIW",       "0100000??????????101?????0011011", {0, 0}},
+    {"SRAW",        "0100000??????????101?????0111011", {0, 0}},
+    {"SRL",         "0000000??????????101?????0110011", {0, 0}},
+    {"SRLI",        "000000???????????101?????0010011", {0, 0}},
+    {"SRLIW",       "0000000??????????101?????0011011", {0, 0}},
+    {"SRLW",        "0000000??????????101?????0111011", {0, 0}},
+    {"SUB",         "0100000??????????000?????0110011", {0, 0}},
+    {"SUBW",        "0100000??????????000?????0111011", {0, 0}},
+    {"SD",          "?????????????????011?????0100011", {0, 0}},
+    {"SW",          "?????????????????010?????0100011", {0, 0}},
+    {"SH",          "?????????????????001?????0100011", {0, 0}},
+    {"SB",          "?????????????????000?????0100011", {0, 0}},
+    {"XOR",         "0000000??????????100?????0110011", {0, 0}},
+    {"XORI",        "?????????????????100?????0010011", {0, 0}},
+
+    // RV64I privileged
+    {"CSRRC",       "?????????????????011?????1110011", {0, 0}},
+    {"CSRRCI",      "?????????????????111?????1110011", {0, 0}},
+    {"CSRRS",       "?????????????????010?????1110011", {0, 0}},
+    {"CSRRSI",      "?????????????????110?????1110011", {0, 0}},
+    {"CSRRW",       "?????????????????001?????1110011", {0, 0}},
+    {"CSRRWI",      "?????????????????101?????1110011", {0, 0}},
+    {"URET",        "00000000001000000000000001110011", {0, 0}},
+    {"SRET",        "00010000001000000000000001110011", {0, 0}},
+    {"HRET",        "00100000001000000000000001110011", {0, 0}},
+    {"MRET",        "00110000001000000000000001110011", {0, 0}},
+    {"FENCE",       "?????????????????000?????0001111", {0, 0}},
+    {"FENCE_I",     "?????????????????001?????0001111", {0, 0}},
+    {"SFENCE_VMA",  "0001001??????????000000001110011", {0, 0}},
+    {"ECALL",       "00000000000000000000000001110011", {0, 0}},
+    {"EBREAK",      "00000000000100000000000001110011", {0, 0}},
+
+    // Extension M
+    {"DIV",         "0000001??????????100?????0110011", {0, 0}},
+    {"DIVU",        "0000001??????????101?????0110011", {0, 0}},
+    {"DIVUW",       "0000001??????????101?????0111011", {0, 0}},
+    {"DIVW",        "0000001??????????100?????0111011", {0, 0}},
+    {"MUL",         "0000001??????????000?????0110011", {0, 0}},
+    {"MULH",        "0000001??????????001?????0110011", {0, 0}},
+    {"MULHSU",      "0000001??????????010?????0110011", {0, 0}},
+    {"MULHU",       "0000001??????????011?????0110011", {0, 0}},
+    {"MULW",        "0000001??????????000?????0111011", {0, 0}},
+    {"REM",         "0000001??????????110?????0110011", {0, 0}},
+    {"REMU",        "0000001??????????111?????0110011", {0, 0}},
+    {"REMW",        "0000001??????????110?????0111011", {0, 0}},
+    {"REMUW",       "0000001??????????111?????0111011", {0, 0}},
+
+    // Extension A
+    {"AMOADD_W",    "00000????????????010?????0101111", {0, 0}},
+    {"AMOXOR_W",    "00100????????????010?????0101111", {0, 0}},
+    {"AMOOR_W",     "01000????????????010?????0101111", {0, 0}},
+    {"AMOAND_W",    "01100????????????010?????0101111", {0, 0}},
+    {"AMOMIN_W",    "10000????????????010?????0101111", {0, 0}},
+    {"AMOMAX_W",    "10100????????????010?????0101111", {0, 0}},
+    {"AMOMINU_W",   "11000????????????010?????0101111", {0, 0}},
+    {"AMOMAXU_W",   "11100????????????010?????0101111", {0, 0}},
+    {"AMOSWAP_W",   "00001????????????010?????0101111", {0, 0}},
+    {"LR_W",        "00010??00000?????010?????0101111", {0, 0}},
+    {"SC_W",        "00011????????????010?????0101111", {0, 0}},
+    {"AMOADD_D",    "00000????????????011?????0101111", {0, 0}},
+    {"AMOXOR_D",    "00100????????????011?????0101111", {0, 0}},
+    {"AMOOR_D",     "01000????????????011?????0101111", {0, 0}},
+    {"AMOAND_D",    "01100????????????011?????0101111", {0, 0}},
+    {"AMOMIN_D",    "10000????????????011?????0101111", {0, 0}},
+    {"AMOMAX_D",    "10100????????????011?????0101111", {0, 0}},
+    {"AMOMINU_D",   "11000????????????011?????0101111", {0, 0}},
+    {"AMOMAXU_D",   "11100????????????011?????0101111", {0, 0}},
+    {"AMOSWAP_D",   "00001????????????011?????0101111", {0, 0}},
+    {"LR_D",        "00010??00000?????011?????0101111", {0, 0}},
+    {"SC_D",        "00011????????????011?????0101111", {0, 0}},
+
+    // Extension C (compressed)
+    {"C_ADD",       "????????????????1001??????????10", {EXCL_RD0, EXCL_RS2_0}},
+    {"C_ADDI",      "????????????????000???????????01", {EXCL_RD0, 0}},
+    {"C_ADDI16SP",  "????????????????011?00010?????01", {0, 0}},
+    {"C_ADDI4SPN",  "????????????????000???????????00", {0, 0}},
+    {"C_ADDIW",     "????????????????001???????????01", {EXCL_RD0, 0}},
+    {"C_ADDW",      "????????????????100111???01???01", {0, 0}},
+    {"C_AND",       "????????????????100011???11???01", {0, 0}},
+    {"C_ANDI",      "????????????????100?10????????01", {0, 0}},
+    {"C_BEQZ",      "????????????????110???????????01", {0, 0}},
+    {"C_BNEZ",      "????????????????111???????????01", {0, 0}},
+    {"C_EBREAK",    "????????????????1001000000000010", {0, 0}},
+    {"C_J",         "????????????????101???????????01", {0, 0}},
+    {"C_JAL",       "????????????????001???????????01", {0, 0}},
+    {"C_JALR",      "????????????????1001?????0000010", {EXCL_RD0, 0}},
+    {"C_JR",        "????????????????1000?????0000010", {EXCL_RD0, 0}},
+    {"C_LD",        "????????????????011???????????00", {0, 0}},
+    {"C_LDSP",      "????????????????011???????????10", {EXCL_RD0, 0}},
+    {"C_LWSP",      "????????????????010???????????10", {EXCL_RD0, 0}},
+    {"C_LI",        "????????????????010???????????01", {EXCL_RD0, 0}},
+    {"C_LUI",       "????????????????011???????????01", {EXCL_RD0, EXCL_RD2}},
+    {"C_LW",        "????????????????010???????????00", {0, 0}},
+    {"C_MV",        "????????????????1000??????????10", {EXCL_RD0, EXCL_RS2_0}},
+    {"C_NOP",       "????????????????0000000000000001", {0, 0}},
+    {"C_OR",        "????????????????100011???10???01", {0, 0}},
+    {"C_SD",        "????????????????111???????????00", {0, 0}},
+    {"C_SDSP",      "????????????????111???????????10", {0, 0}},
+    {"C_SLLI",      "????????????????000???????????10", {EXCL_RD0, 0}},
+    {"C_SRAI",      "????????????????100?01????????01", {0, 0}},
+    {"C_SRLI",      "????????????????100?00????????01", {0, 0}},
+    {"C_SUB",       "????????????????100011???00???01", {0, 0}},
+    {"C_SUBW",      "????????????????100111???00???01", {0, 0}},
+    {"C_SW",        "????????????????110???????????00", {0, 0}},
+    {"C_SWSP",      "????????????????110???????????10", {0, 0}},
+    {"C_XOR",       "????????????????100011???01???01", {0, 0}},
+
+    // Extension D
+    {"FADD_D",      "0000001??????????????????1010011", {0, 0}},
+    {"FCVT_D_L",    "110100100010?????????????1010011", {0, 0}},
+    {"FCVT_D_LU",   "110100100011?????????????1010011", {0, 0}},
+    {"FCVT_D_W",    "110100100000?????????????1010011", {0, 0}},
+    {"FCVT_D_WU",   "110100100001?????????????1010011", {0, 0}},
+    {"FCVT_L_D",    "110000100010?????????????1010011", {0, 0}},
+    {"FCVT_LU_D",   "110000100011?????????????1010011", {0, 0}},
+    {"FCVT_W_D",    "110000100000?????????????1010011", {0, 0}},
+    {"FCVT_WU_D",   "110000100001?????????????1010011", {0, 0}},
+    {"FDIV_D",      "0001101??????????????????1010011", {0, 0}},
+    {"FEQ_D",       "1010001??????????010?????1010011", {0, 0}},
+    {"FLD",         "?????????????????011?????0000111", {0, 0}},
+    {"FLE_D",       "1010001??????????000?????1010011", {0, 0}},
+    {"FLT_D",       "1010001??????????001?????1010011", {0, 0}},
+    {"FMAX_D",      "0010101??????????001?????1010011", {0, 0}},
+    {"FMIN_D",      "0010101??????????000?????1010011", {0, 0}},
+    {"FMOV_D_X",    "111100100000?????000?????1010011", {0, 0}},
+    {"FMOV_X_D",    "111000100000?????000?????1010011", {0, 0}},
+    {"FMUL_D",      "0001001??????????????????1010011", {0, 0}},
+    {"FSD",         "?????????????????011?????0100111", {0, 0}},
+    {"FSUB_D",      "0000101??????????????????1010011", {0, 0}},
+    {"FSQRT_D",     "010110100000?????????????1010011", {0, 0}},   // disassembler only
+};
+
+const int RISCV_ENCODINGS_TOTAL =
+    static_cast<int>(sizeof(RISCV_ENCODINGS) / sizeof(RiscvEncodingType));
+
+RiscvDecoder::RiscvDecoder() {
+    enc_.resize(RISCV_ENCODINGS_TOTAL);
+    for (int i = 0; i < RISCV_ENCODINGS_TOTAL; i++) {
+        EncodingType *p = &enc_[i];
+        parseBits(RISCV_ENCODINGS[i].bits, &p->mask, &p->opcode);
+        p->caremask = p->mask;
+        for (int n = 0; n < 2; n++) {
+            p->exclmask[n] = 0;
+            p->exclopcode[n] = 0;
+            if (RISCV_ENCODINGS[i].excl[n]) {
+                parseBits(RISCV_ENCODINGS[i].excl[n],
+                          &p->exclmask[n], &p->exclopcode[n]);
+                p->caremask |= p->exclmask[n];
+            }
+        }
+    }
+
+    // Index 0 is always the root node
+    nodes_.resize(1);
+    leaf_.assign(RISCV_ENCODINGS_TOTAL + 1, 0);
+
+    std::vector<int> all(RISCV_ENCODINGS_TOTAL);
+    for (int i = 0; i < RISCV_ENCODINGS_TOTAL; i++) {
+        all[i] = i;
+    }
+    int root = buildNode(all, 0, 0);
+    nodes_[0] = nodes_[root];
+}
+
+int RiscvDecoder::findIndex(const char *name) const {
+    for (int i = 0; i < RISCV_ENCODINGS_TOTAL; i++) {
+        if (strcmp(RISCV_ENCODINGS[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void RiscvDecoder::parseBits(const char *bits, uint32_t *mask,
+                             uint32_t *opcode) {
+    *mask = 0;
+    *opcode = 0;
+    for (int i = 0; i < 32; i++) {
+        switch (bits[i]) {
+        case '0':
+            *mask |= (1u << (31 - i));
+            break;
+        case '1':
+            *mask |= (1u << (31 - i));
+            *opcode |= (1u << (31 - i));
+            break;
+        default:;
+        }
+    }
+}
+
+/**
+ * Encoding remains a candidate while its known bits are equal to the
+ * value selected by the path from the root and no exclusion pattern was
+ * fully matched.
+ */
+bool RiscvDecoder::isCandidate(int idx, uint32_t known, uint32_t value) {
+    EncodingType *p = &enc_[idx];
+    if ((value ^ p->opcode) & p->mask & known) {
+        return false;
+    }
+    for (int n = 0; n < 2; n++) {
+        if (p->exclmask[n] == 0 || (p->exclmask[n] & ~known)) {
+            continue;
+        }
+        if (((value ^ p->exclopcode[n]) & p->exclmask[n]) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int RiscvDecoder::makeLeaf(int idx) {
+    int &leaf = leaf_[idx + 1];
+    if (leaf == 0) {
+        NodeType n;
+        n.shift = 0;
+        n.mask = 0;
+        n.base = idx;
+        leaf = static_cast<int>(nodes_.size());
+        nodes_.push_back(n);
+    }
+    return leaf;
+}
+
+/**
+ * Take decision using the longest field of bits required by all remaining
+ * candidates or, if there's no such bits, by the highest priority one.
+ */
+int RiscvDecoder::buildNode(std::vector<int> &list, uint32_t known,
+                            uint32_t value) {
+    if (list.size() == 0) {
+        return makeLeaf(-1);
+    }
+    uint32_t need = enc_[list[0]].caremask & ~known;
+    if (need == 0) {
+        return makeLeaf(list[0]);
+    }
+
+    uint32_t common = need;
+    for (unsigned i = 1; i < list.size(); i++) {
+        common &= enc_[list[i]].mask;
+    }
+    if (common == 0) {
+        common = need;
+    }
+
+    // Longest contiguous run of bits limited by the jump table size:
+    int shift = 0;
+    int width = 0;
+    for (int i = 0; i < 32; i++) {
+        int w = 0;
+        while ((i + w) < 32 && w < FIELD_WIDTH_MAX
+                && (common & (1u << (i + w)))) {
+            w++;
+        }
+        if (w > width) {
+            shift = i;
+            width = w;
+        }
+    }
+
+    NodeType node;
+    node.shift = static_cast<uint32_t>(shift);
+    node.mask = (1u << width) - 1;
+    node.base = static_cast<int>(jump_.size());
+    int nodeidx = static_cast<int>(nodes_.size());
+    nodes_.push_back(node);
+    jump_.resize(jump_.size() + (1u << width));
+
+    uint32_t fieldmask = node.mask << shift;
+    for (uint32_t v = 0; v < (1u << width); v++) {
+        uint32_t vnext = (value & ~fieldmask) | (v << shift);
+        std::vector<int> sublist;
+        for (unsigned i = 0; i < list.size(); i++) {
+            if (isCandidate(list[i], known | fieldmask, vnext)) {
+                sublist.push_back(list[i]);
+            }
+        }
+        int child = buildNode(sublist, known | fieldmask, vnext);
+        jump_[nodes_[nodeidx].base + v] = child;
+    }
+    return nodeidx;
+}
+
+}  // namespace debugger
@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef __DEBUGGER_COMMON_GENERIC_RISCV_DECODER_H__
+#define __DEBUGGER_COMMON_GENERIC_RISCV_DECODER_H__
+
+#include <inttypes.h>
+#include <vector>
+
+namespace debugger {
+
+/**
+ * @brief Instruction encoding description.
+ *
+ * Bits are written from bit 31 down to bit 0: '0' or '1' defines the fixed
+ * value and '?' means 'don't care'. Compressed instructions use the lower
+ * 16 bits only. Exclusion patterns use the same notation and reject the
+ * instruction when matched (e.g. c.mv with rs2 = 0).
+ */
+struct RiscvEncodingType {
+    const char *name;
+    const char *bits;
+    const char *excl[2];
+};
+
+/** Single instructions table shared by the functional model and disassembler.
+ *  Order defines priority when the encodings overlap. */
+extern const RiscvEncodingType RISCV_ENCODINGS[];
+extern const int RISCV_ENCODINGS_TOTAL;
+static const int RISCV_ENCODINGS_MAX = 256;
+
+/**
+ * @brief Decision tree generated from the RISCV_ENCODINGS table.
+ *
+ * Each node selects a bit field of the instruction word and jumps through
+ * a table into the child node, so that any instruction is decoded without
+ * iteration over candidates: the leaf contains the index in the table of
+ * the first (highest priority) matching encoding or -1 if none.
+ */
+class RiscvDecoder {
+ public:
+    RiscvDecoder();
+
+    /** Index in RISCV_ENCODINGS or -1 for illegal opcode */
+    int decode(uint32_t code) const {
+        const NodeType *n = &nodes_[0];
+        while (n->mask) {
+            n = &nodes_[jump_[n->base + ((code >> n->shift) & n->mask)]];
+        }
+        return n->base;
+    }
+
+    /** Index of the instruction by name or -1 if not found */
+    int findIndex(const char *name) const;
+    uint32_t getMask(int idx) const { return enc_[idx].mask; }
+    uint32_t getOpcode(int idx) const { return enc_[idx].opcode; }
+    int getNodesTotal() const { return static_cast<int>(nodes_.size()); }
+
+ private:
+    static const int FIELD_WIDTH_MAX = 8;
+
+    struct EncodingType {
+        uint32_t mask;
+        uint32_t opcode;
+        uint32_t exclmask[2];
+        uint32_t exclopcode[2];
+        uint32_t caremask;      // all bits that are needed to take decision
+    };
+
+    struct NodeType {
+        uint32_t shift;
+        uint32_t mask;          // field mask or 0 for the leaf
+        int base;               // jump table offset or encoding index
+    };
+
+    void parseBits(const char *bits, uint32_t *mask, uint32_t *opcode);
+    bool isCandidate(int idx, uint32_t known, uint32_t value);
+    int makeLeaf(int idx);
+    int buildNode(std::vector<int> &list, uint32_t known, uint32_t value);
+
+    std::vector<EncodingType> enc_;
+    std::vector<NodeType> nodes_;
+    std::vector<int> jump_;
+    std::vector<int> leaf_;     // leaf node per encoding index (+1 illegal)
+};
+
+}  // namespace debugger
+
+#endif  // __DEBUGGER_COMMON_GENERIC_RISCV_DECODER_H__
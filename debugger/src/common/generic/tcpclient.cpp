@@ -25,6 +25,8 @@ TcpClient::TcpClient(IService *parent, const char *name) : IService(parent, name
     registerAttribute("RecvTimeout", &recvTimeout_);
     RISCV_mutex_init(&mutexTx_);
     hsock_ = -1;
+    reactor_ = 0;
+    connid_ = 0;
     txcnt_ = 0;
     recvTimeout_.make_int64(500);   //default 500 ms timeout for recv() function
 }
@@ -39,6 +41,44 @@ void TcpClient::postinitService() {
     }
 }
 
+bool TcpClient::run() {
+    if (!reactor_) {
+        return IThread::run();
+    }
+    RISCV_event_set(&loopEnable_);
+    afterThreadStarted();
+    connid_ = reactor_->addConnection(hsock_, this);
+    if (connid_ < 0) {
+        connid_ = 0;
+        stop();
+        closeSocket();
+        return false;
+    }
+    return true;
+}
+
+void TcpClient::stop() {
+    IThread::stop();
+    if (reactor_ && connid_ > 0) {
+        int id = connid_;
+        connid_ = 0;
+        reactor_->remove(id);       // socket is closed by reactor
+        hsock_ = -1;
+        beforeThreadClosing();
+    }
+}
+
+int TcpClient::reactorRecv(const char *buf, int sz) {
+    return processRxBuffer(buf, sz);
+}
+
+void TcpClient::reactorClosed() {
+    IThread::stop();
+    connid_ = 0;
+    hsock_ = -1;
+    beforeThreadClosing();
+}
+
 void TcpClient::busyLoop() {
     int rxbytes;
     afterThreadStarted();
@@ -71,6 +111,9 @@ int TcpClient::writeTxBuffer(const char *buf, int sz) {
     if (!isEnabled()) {
         return ret;
     }
+    if (reactor_) {
+        return connid_ > 0 ? reactor_->write(connid_, buf, sz) : ret;
+    }
 
     RISCV_mutex_lock(&mutexTx_);
     if (txcnt_ + sz >= sizeof(txbuf_)) {
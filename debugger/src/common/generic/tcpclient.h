@@ -19,11 +19,13 @@
 #include <iclass.h>
 #include <iservice.h>
 #include "coreservices/ithread.h"
+#include "tcpreactor.h"
 
 namespace debugger {
 
 class TcpClient : public IService,
-                  public IThread {
+                  public IThread,
+                  public ITcpReactorHandler {
  public:
     explicit TcpClient(IService *parent, const char *name);
     virtual ~TcpClient();
@@ -31,6 +33,14 @@ class TcpClient : public IService,
     /** IService interface */
     virtual void postinitService() override;
 
+    /** IThread interface: attach socket to reactor instead of thread */
+    virtual bool run() override;
+    virtual void stop() override;
+
+    /** ITcpReactorHandler */
+    virtual int reactorRecv(const char *buf, int sz) override;
+    virtual void reactorClosed() override;
+
  protected:
     /** IThread interface */
     virtual void busyLoop();
@@ -54,6 +64,8 @@ class TcpClient : public IService,
 
     struct sockaddr_in sockaddr_ipv4_;
     socket_def hsock_;
+    TcpReactor *reactor_;   // not NULL: socket is owned by reactor
+    int connid_;
 
     mutex_def mutexTx_;
     char rxbuf_[4096];
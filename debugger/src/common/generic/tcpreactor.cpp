@@ -0,0 +1,467 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "tcpreactor.h"
+#include <string.h>
+#include <vector>
+#if defined(_WIN32) || defined(__CYGWIN__)
+#elif defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#else
+#include <poll.h>
+#include <sys/uio.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace debugger {
+
+static const socket_def SOCKET_NONE = static_cast<socket_def>(-1);
+
+static bool is_interrupted() {
+#if defined(_WIN32) || defined(__CYGWIN__)
+    return WSAGetLastError() == WSAEINTR;
+#else
+    return errno == EINTR;
+#endif
+}
+
+static bool is_would_block() {
+#if defined(_WIN32) || defined(__CYGWIN__)
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+/** Gather write of the two ring buffer parts with one system call */
+static int send_chunks(socket_def skt, const char *p0, int sz0,
+                       const char *p1, int sz1) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+    WSABUF v[2];
+    DWORD sent = 0;
+    v[0].buf = const_cast<char *>(p0);
+    v[0].len = static_cast<ULONG>(sz0);
+    v[1].buf = const_cast<char *>(p1);
+    v[1].len = static_cast<ULONG>(sz1);
+    if (WSASend(skt, v, sz1 ? 2 : 1, &sent, 0, NULL, NULL) != 0) {
+        return -1;
+    }
+    return static_cast<int>(sent);
+#else
+    struct iovec v[2];
+    struct msghdr msg;
+    v[0].iov_base = const_cast<char *>(p0);
+    v[0].iov_len = static_cast<size_t>(sz0);
+    v[1].iov_base = const_cast<char *>(p1);
+    v[1].iov_len = static_cast<size_t>(sz1);
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = v;
+    msg.msg_iovlen = sz1 ? 2 : 1;
+    return static_cast<int>(sendmsg(skt, &msg, MSG_NOSIGNAL));
+#endif
+}
+
+
+TcpRingBuffer::TcpRingBuffer(int log2sz) {
+    buf_ = new char[1 << log2sz];
+    mask_ = (1 << log2sz) - 1;
+    rdidx_ = 0;
+    cnt_ = 0;
+}
+
+TcpRingBuffer::~TcpRingBuffer() {
+    delete [] buf_;
+}
+
+bool TcpRingBuffer::put(const char *buf, int sz) {
+    if (sz > space()) {
+        return false;
+    }
+    int wridx = (rdidx_ + cnt_) & mask_;
+    int part = mask_ + 1 - wridx;
+    if (part > sz) {
+        part = sz;
+    }
+    memcpy(&buf_[wridx], buf, part);
+    memcpy(buf_, &buf[part], sz - part);
+    cnt_ += sz;
+    return true;
+}
+
+int TcpRingBuffer::chunks(const char **p0, int *sz0,
+                          const char **p1, int *sz1) {
+    int part = mask_ + 1 - rdidx_;
+    if (part > cnt_) {
+        part = cnt_;
+    }
+    *p0 = &buf_[rdidx_];
+    *sz0 = part;
+    *p1 = buf_;
+    *sz1 = cnt_ - part;
+    if (cnt_ == 0) {
+        return 0;
+    }
+    return *sz1 ? 2 : 1;
+}
+
+void TcpRingBuffer::consume(int sz) {
+    rdidx_ = (rdidx_ + sz) & mask_;
+    cnt_ -= sz;
+}
+
+
+TcpReactor *TcpReactor::instance() {
+    // Initialization of the local static is thread-safe
+    static TcpReactor *p = create();
+    return p;
+}
+
+TcpReactor *TcpReactor::create() {
+    TcpReactor *p = new TcpReactor();
+    if (!p->run()) {
+        RISCV_printf(NULL, LOG_ERROR, "%s", "Can't create reactor thread");
+    }
+    return p;
+}
+
+TcpReactor::TcpReactor() : IThread() {
+    RISCV_mutex_init(&mutex_);
+    nextId_ = 1;
+    dispatching_ = 0;
+    threadId_ = 0;
+#if defined(__linux__)
+    epfd_ = epoll_create1(0);
+#endif
+}
+
+TcpReactor::~TcpReactor() {
+#if defined(__linux__)
+    close(epfd_);
+#endif
+    RISCV_mutex_destroy(&mutex_);
+}
+
+bool TcpReactor::setNonBlocking(socket_def skt) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+    u_long arg = 1;
+    return ioctlsocket(skt, FIONBIO, &arg) != SOCKET_ERROR;
+#else
+    int flags = fcntl(skt, F_GETFL, 0);
+    if (flags < 0) {
+        return false;
+    }
+    return fcntl(skt, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+void TcpReactor::closeSocket(socket_def skt) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+    closesocket(skt);
+#else
+    shutdown(skt, SHUT_RDWR);
+    close(skt);
+#endif
+}
+
+int TcpReactor::addListener(socket_def skt, ITcpReactorHandler *h) {
+    return add(skt, h, true);
+}
+
+int TcpReactor::addConnection(socket_def skt, ITcpReactorHandler *h) {
+    return add(skt, h, false);
+}
+
+int TcpReactor::add(socket_def skt, ITcpReactorHandler *h, bool listener) {
+    if (!setNonBlocking(skt)) {
+        RISCV_printf(NULL, LOG_ERROR, "%s", "Set non-blocking socket failed");
+        return -1;
+    }
+    Connection *c = new Connection;
+    c->skt = skt;
+    c->listener = listener;
+    c->closing = false;
+    c->handler = h;
+    c->tx = listener ? 0 : new TcpRingBuffer(TX_RING_LOG2);
+
+    RISCV_mutex_lock(&mutex_);
+    c->id = nextId_++;
+    conn_[c->id] = c;
+#if defined(__linux__)
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.data.u64 = static_cast<uint64_t>(c->id);
+    ev.events = EPOLLIN | EPOLLET;
+    if (!listener) {
+        ev.events |= EPOLLOUT | EPOLLRDHUP;
+    }
+    if (epoll_ctl(epfd_, EPOLL_CTL_ADD, skt, &ev) < 0) {
+        RISCV_printf(NULL, LOG_ERROR, "epoll_ctl(ADD) failed: %d", errno);
+    }
+#endif
+    RISCV_mutex_unlock(&mutex_);
+    return c->id;
+}
+
+void TcpReactor::remove(int id) {
+    RISCV_mutex_lock(&mutex_);
+    std::map<int, Connection *>::iterator it = conn_.find(id);
+    if (it == conn_.end()) {
+        RISCV_mutex_unlock(&mutex_);
+        return;
+    }
+    Connection *c = it->second;
+    c->closing = true;
+    if (dispatching_ == id) {
+        // dispatch() destroys it after the callback returns
+        RISCV_mutex_unlock(&mutex_);
+        if (!isReactorThread()) {
+            while (dispatching_ == id) {
+                RISCV_sleep_ms(1);
+            }
+        }
+        return;
+    }
+    destroy(c);
+    RISCV_mutex_unlock(&mutex_);
+}
+
+void TcpReactor::destroy(Connection *c) {
+#if defined(__linux__)
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    epoll_ctl(epfd_, EPOLL_CTL_DEL, c->skt, &ev);
+#endif
+    closeSocket(c->skt);
+    conn_.erase(c->id);
+    if (c->tx) {
+        delete c->tx;
+    }
+    delete c;
+}
+
+int TcpReactor::write(int id, const char *buf, int sz) {
+    int ret = sz;
+    int txbytes;
+
+    RISCV_mutex_lock(&mutex_);
+    std::map<int, Connection *>::iterator it = conn_.find(id);
+    if (it == conn_.end() || it->second->closing || it->second->listener) {
+        RISCV_mutex_unlock(&mutex_);
+        return 0;
+    }
+    Connection *c = it->second;
+    if (c->tx->size() == 0) {
+        // Nothing queued: short request/response goes without wake-up
+        while (sz > 0) {
+            txbytes = send(c->skt, buf, sz, MSG_NOSIGNAL);
+            if (txbytes > 0) {
+                buf += txbytes;
+                sz -= txbytes;
+            } else if (txbytes < 0 && is_interrupted()) {
+                continue;
+            } else {
+                if (!is_would_block()) {
+                    ret = -1;       // reported by the reactor thread
+                }
+                break;
+            }
+        }
+    }
+    if (ret > 0 && sz > 0 && !c->tx->put(buf, sz)) {
+        RISCV_printf(NULL, LOG_ERROR, "Tx buffer overflow: %d", sz);
+        ret = 0;
+    }
+    RISCV_mutex_unlock(&mutex_);
+    return ret;
+}
+
+int TcpReactor::flush(Connection *c) {
+    const char *p0, *p1;
+    int sz0, sz1;
+    int txbytes;
+    while (c->tx->chunks(&p0, &sz0, &p1, &sz1)) {
+        txbytes = send_chunks(c->skt, p0, sz0, p1, sz1);
+        if (txbytes > 0) {
+            c->tx->consume(txbytes);
+        } else if (txbytes < 0 && is_interrupted()) {
+            continue;
+        } else if (txbytes < 0 && is_would_block()) {
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void TcpReactor::acceptAll(Connection *c) {
+    socket_def skt;
+    int enable = 1;
+    while (!c->closing) {
+        skt = accept(c->skt, 0, 0);
+        if (skt == SOCKET_NONE) {
+            if (is_interrupted()) {
+                continue;
+            }
+            break;
+        }
+        setNonBlocking(skt);
+        setsockopt(skt, IPPROTO_TCP, TCP_NODELAY,
+                   reinterpret_cast<const char *>(&enable), sizeof(int));
+        c->handler->reactorAccept(skt);
+    }
+}
+
+bool TcpReactor::recvAll(Connection *c, ITcpReactorHandler *h) {
+    int rxbytes;
+    // Edge triggered: read until the socket is drained
+    while (!c->closing) {
+        rxbytes = recv(c->skt, rxbuf_, sizeof(rxbuf_) - 1, 0);
+        if (rxbytes > 0) {
+            rxbuf_[rxbytes] = 0;
+            if (h->reactorRecv(rxbuf_, rxbytes) < 0) {
+                return false;
+            }
+        } else if (rxbytes == 0) {
+            return false;           // connection closed
+        } else if (is_interrupted()) {
+            continue;
+        } else {
+            return is_would_block();
+        }
+    }
+    return true;
+}
+
+void TcpReactor::dispatch(int id, bool rd, bool err) {
+    RISCV_mutex_lock(&mutex_);
+    std::map<int, Connection *>::iterator it = conn_.find(id);
+    if (it == conn_.end() || it->second->closing) {
+        RISCV_mutex_unlock(&mutex_);
+        return;
+    }
+    Connection *c = it->second;
+    ITcpReactorHandler *h = c->handler;
+    dispatching_ = id;
+    RISCV_mutex_unlock(&mutex_);
+
+    bool alive = true;
+    if (c->listener) {
+        acceptAll(c);
+    } else {
+        if (rd || err) {
+            alive = recvAll(c, h);
+        }
+        if (alive) {
+            RISCV_mutex_lock(&mutex_);
+            if (!c->closing && flush(c) < 0) {
+                alive = false;
+            }
+            RISCV_mutex_unlock(&mutex_);
+        }
+    }
+
+    bool notify = false;
+    if (!alive) {
+        RISCV_mutex_lock(&mutex_);
+        notify = !c->closing;       // not removed by the owner
+        c->closing = true;
+        RISCV_mutex_unlock(&mutex_);
+    }
+    if (notify) {
+        h->reactorClosed();
+    }
+
+    RISCV_mutex_lock(&mutex_);
+    dispatching_ = 0;
+    if (c->closing) {
+        destroy(c);
+    }
+    RISCV_mutex_unlock(&mutex_);
+}
+
+#if defined(__linux__)
+void TcpReactor::busyLoop() {
+    struct epoll_event evts[EVENTS_MAX];
+    uint32_t e;
+    int n;
+
+    threadId_ = RISCV_thread_id();
+    while (isEnabled()) {
+        n = epoll_wait(epfd_, evts, EVENTS_MAX, WAIT_TIMEOUT_MS);
+        for (int i = 0; i < n; i++) {
+            e = evts[i].events;
+            dispatch(static_cast<int>(evts[i].data.u64),
+                     (e & EPOLLIN) != 0,
+                     (e & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) != 0);
+        }
+    }
+}
+#else
+void TcpReactor::busyLoop() {
+    std::vector<struct pollfd> fds;
+    std::vector<int> ids;
+    struct pollfd t;
+    int n;
+
+    threadId_ = RISCV_thread_id();
+    while (isEnabled()) {
+        fds.clear();
+        ids.clear();
+        RISCV_mutex_lock(&mutex_);
+        for (std::map<int, Connection *>::iterator it = conn_.begin();
+            it != conn_.end(); ++it) {
+            Connection *c = it->second;
+            if (c->closing) {
+                continue;
+            }
+            t.fd = c->skt;
+            t.events = POLLIN;
+            if (c->tx && c->tx->size()) {
+                t.events |= POLLOUT;
+            }
+            t.revents = 0;
+            fds.push_back(t);
+            ids.push_back(c->id);
+        }
+        RISCV_mutex_unlock(&mutex_);
+
+        if (fds.size() == 0) {
+            RISCV_sleep_ms(POLL_TIMEOUT_MS);
+            continue;
+        }
+#if defined(_WIN32) || defined(__CYGWIN__)
+        n = WSAPoll(&fds[0], static_cast<ULONG>(fds.size()), POLL_TIMEOUT_MS);
+#else
+        n = poll(&fds[0], static_cast<nfds_t>(fds.size()), POLL_TIMEOUT_MS);
+#endif
+        for (unsigned i = 0; n > 0 && i < fds.size(); i++) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            dispatch(ids[i],
+                     (fds[i].revents & POLLIN) != 0,
+                     (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) != 0);
+        }
+    }
+}
+#endif
+
+}  // namespace debugger
@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <api_core.h>
+#include <map>
+#include "coreservices/ithread.h"
+
+namespace debugger {
+
+/**
+ * Callbacks of the sockets owned by TcpReactor. All of them are called
+ * from the reactor thread, so they should not block for long: every other
+ * connection waits meanwhile.
+ */
+class ITcpReactorHandler {
+ public:
+    /** Listening socket: new connection accepted (non-blocking already) */
+    virtual void reactorAccept(socket_def) {}
+    /** Connection: buf is zero terminated. Return negative to close it */
+    virtual int reactorRecv(const char *, int) { return 0; }
+    /** Connection closed by remote side or by reactorRecv() result */
+    virtual void reactorClosed() {}
+};
+
+/** Tx ring buffer of a single connection, size is a power of 2 */
+class TcpRingBuffer {
+ public:
+    explicit TcpRingBuffer(int log2sz);
+    ~TcpRingBuffer();
+
+    int size() { return cnt_; }
+    int space() { return mask_ + 1 - cnt_; }
+    bool put(const char *buf, int sz);
+    /** Contiguous parts of the data, returns number of parts (0..2) */
+    int chunks(const char **p0, int *sz0, const char **p1, int *sz1);
+    void consume(int sz);
+
+ private:
+    char *buf_;
+    int mask_;
+    int rdidx_;
+    int cnt_;
+};
+
+/**
+ * Shared I/O thread of all TCP services: one epoll (Linux) or poll()
+ * loop that owns listening and accepted sockets. Connections are referred
+ * by id, so writer threads never hold a pointer to a closing connection.
+ */
+class TcpReactor : public IThread {
+ public:
+    /** Process wide instance, the thread is started on the first call */
+    static TcpReactor *instance();
+
+    int addListener(socket_def skt, ITcpReactorHandler *h);
+    int addConnection(socket_def skt, ITcpReactorHandler *h);
+    /**
+     * Detach handler and close socket. When called outside of the reactor
+     * thread it waits the end of the callback that is currently running.
+     */
+    void remove(int id);
+    /** Thread-safe. Sends directly when the ring is empty */
+    int write(int id, const char *buf, int sz);
+
+    static bool setNonBlocking(socket_def skt);
+    static void closeSocket(socket_def skt);
+
+ protected:
+    /** IThread interface */
+    virtual void busyLoop();
+
+ private:
+    TcpReactor();
+    virtual ~TcpReactor();
+    static TcpReactor *create();
+
+    static const int TX_RING_LOG2 = 20;     // 1 MB per connection
+    static const int EVENTS_MAX = 64;
+    static const int WAIT_TIMEOUT_MS = 100;
+#if !defined(__linux__)
+    static const int POLL_TIMEOUT_MS = 10;  // no wake-up on tx/add
+#endif
+
+    struct Connection {
+        int id;
+        socket_def skt;
+        bool listener;
+        bool closing;
+        ITcpReactorHandler *handler;
+        TcpRingBuffer *tx;
+    };
+
+    int add(socket_def skt, ITcpReactorHandler *h, bool listener);
+    /** Read and/or flush tx ring of the connection */
+    void dispatch(int id, bool rd, bool err);
+    void acceptAll(Connection *c);
+    bool recvAll(Connection *c, ITcpReactorHandler *h);
+    int flush(Connection *c);
+    void destroy(Connection *c);
+    bool isReactorThread() { return RISCV_thread_id() == threadId_; }
+
+    mutex_def mutex_;
+    std::map<int, Connection *> conn_;
+    int nextId_;
+    volatile int dispatching_;
+    uint64_t threadId_;
+#if defined(__linux__)
+    int epfd_;
+#endif
+    char rxbuf_[4096 + 1];
+};
+
+}  // namespace debugger
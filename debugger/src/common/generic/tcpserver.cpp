@@ -25,6 +25,10 @@ TcpServer::TcpServer(const char *name) : IService(name) {
     registerAttribute("HostIP", &hostIP_);
     registerAttribute("HostPort", &hostPort_);
     registerAttribute("RecvTimeout", &recvTimeout_);
+    registerAttribute("Reactor", &reactorEna_);
+    reactor_ = 0;
+    listenid_ = 0;
+    clientIdx_ = 0;
 }
 
 void TcpServer::postinitService() {
@@ -40,14 +44,45 @@ void TcpServer::postinitService() {
         setBlockingMode(false);
     }
 
-    if (isEnable_.to_bool()) {
-        if (!run()) {
-            RISCV_error("Can't create thread.", NULL);
+    if (!isEnable_.to_bool()) {
+        return;
+    }
+    if (reactorEna_.to_bool()) {
+        // Accepted sockets and client callbacks run in the shared I/O thread
+        reactor_ = TcpReactor::instance();
+        listenid_ = reactor_->addListener(hsock_, this);
+        if (listenid_ < 0) {
+            RISCV_error("Can't attach socket to reactor", NULL);
+            listenid_ = 0;
             return;
         }
+        RISCV_event_set(&loopEnable_);
+    } else if (!run()) {
+        RISCV_error("Can't create thread.", NULL);
+        return;
     }
 }
 
+void TcpServer::stop() {
+    IThread::stop();
+    if (reactor_ && listenid_ > 0) {
+        reactor_->remove(listenid_);    // closes server socket
+        listenid_ = 0;
+        hsock_ = -1;
+    }
+}
+
+void TcpServer::reactorAccept(socket_def skt) {
+    startClient(skt);
+}
+
+void TcpServer::startClient(socket_def skt) {
+    char tname[64];
+    RISCV_sprintf(tname, sizeof(tname), "%s.client%d", getObjName(), clientIdx_++);
+    createClientThread(tname, skt);
+    RISCV_info("TCP %s %p started", tname, skt);
+}
+
 void TcpServer::busyLoop() {
     socket_def client_sock;
     int err;
@@ -57,20 +92,13 @@ void TcpServer::busyLoop() {
     timeout.tv_sec = 0;
     timeout.tv_usec = 400000;   // 400 ms
 
-    int idx = 0;
-    char tname[64];
-
     while (isEnabled()) {
         FD_ZERO(&readSet);
         FD_SET(hsock_, &readSet);
         err = select(static_cast<int>(hsock_) + 1, &readSet, NULL, NULL, &timeout);
         if (err > 0) {
             client_sock = accept(hsock_, 0, 0);
-            RISCV_sprintf(tname, sizeof(tname), "%s.client%d", getObjName(), idx++);
-
-            IThread *ithrd = createClientThread(tname,
-                                               client_sock);
-            RISCV_info("TCP %s %p started", tname, client_sock);
+            startClient(client_sock);
         } else if (err == 0) {
             // timeout
         } else {
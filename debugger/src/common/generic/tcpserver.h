@@ -24,13 +24,20 @@
 namespace debugger {
 
 class TcpServer : public IService,
-                  public IThread {
+                  public IThread,
+                  public ITcpReactorHandler {
  public:
     explicit TcpServer(const char *name);
 
     /** IService interface */
     virtual void postinitService() override;
 
+    /** IThread interface */
+    virtual void stop() override;
+
+    /** ITcpReactorHandler */
+    virtual void reactorAccept(socket_def skt) override;
+
  protected:
     /** IThread interface */
     virtual void busyLoop();
@@ -43,6 +50,7 @@ class TcpServer : public IService,
                             int recvTimeout)
         : TcpClient(parent, name) {
             hsock_ = skt;
+            reactor_ = parent->reactor_;
             recvTimeout_.make_int64(recvTimeout);
             setRecvTimeout(recvTimeout);
         }
@@ -51,6 +59,7 @@ class TcpServer : public IService,
  protected:
     virtual IThread *createClientThread(const char *name, socket_def skt) = 0;
 
+    void startClient(socket_def skt);
     int createServerSocket();
     void closeServerSocket();
     bool setBlockingMode(bool mode);
@@ -61,9 +70,13 @@ class TcpServer : public IService,
     AttributeType hostIP_;
     AttributeType hostPort_;
     AttributeType recvTimeout_;
+    AttributeType reactorEna_;
 
     struct sockaddr_in sockaddr_ipv4_;
     socket_def hsock_;
+    TcpReactor *reactor_;
+    int listenid_;
+    int clientIdx_;
     char rcvbuf[4096];
 };
 
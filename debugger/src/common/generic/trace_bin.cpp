@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <string.h>
+#include "trace_bin.h"
+
+namespace debugger {
+
+TraceBinWriter::TraceBinWriter() : IThread() {
+    fp_ = 0;
+    for (int i = 0; i < BUF_TOTAL; i++) {
+        buf_[i] = 0;
+        filled_[i] = 0;
+    }
+    widx_ = 0;
+    wcnt_ = 0;
+    ridx_ = 0;
+    RISCV_mutex_init(&mutex_);
+    RISCV_event_create(&eventFilled_, "trace_bin_filled");
+    RISCV_event_create(&eventFree_, "trace_bin_free");
+}
+
+TraceBinWriter::~TraceBinWriter() {
+    close();
+    RISCV_event_close(&eventFilled_);
+    RISCV_event_close(&eventFree_);
+    RISCV_mutex_destroy(&mutex_);
+}
+
+bool TraceBinWriter::open(const char *filename) {
+    TraceBinHeaderType hdr;
+    close();
+    fp_ = fopen(filename, "wb");
+    if (!fp_) {
+        return false;
+    }
+    memcpy(hdr.magic, TRACE_BIN_MAGIC, sizeof(hdr.magic));
+    hdr.version = TRACE_BIN_VERSION;
+    hdr.record_size = sizeof(TraceBinRecordType);
+    fwrite(&hdr, 1, sizeof(hdr), fp_);
+
+    for (int i = 0; i < BUF_TOTAL; i++) {
+        buf_[i] = new TraceBinRecordType[BUF_RECORDS];
+        filled_[i] = 0;
+    }
+    widx_ = 0;
+    wcnt_ = 0;
+    ridx_ = 0;
+    RISCV_event_clear(&eventFilled_);
+    RISCV_event_clear(&eventFree_);
+    // enable loop before the thread started to avoid its immediate exit
+    RISCV_event_set(&loopEnable_);
+    run();
+    return true;
+}
+
+void TraceBinWriter::close() {
+    if (!fp_) {
+        return;
+    }
+    if (wcnt_) {
+        commitBuffer();
+    }
+    stop();
+    RISCV_event_set(&eventFilled_);
+    join(1000);
+    drain();        // thread wasn't started or exited by timeout
+
+    fclose(fp_);
+    fp_ = 0;
+    for (int i = 0; i < BUF_TOTAL; i++) {
+        delete [] buf_[i];
+        buf_[i] = 0;
+    }
+}
+
+void TraceBinWriter::write(const TraceBinRecordType *rec) {
+    if (!fp_) {
+        return;
+    }
+    memcpy(&buf_[widx_][wcnt_], rec, sizeof(TraceBinRecordType));
+    if (++wcnt_ == BUF_RECORDS) {
+        commitBuffer();
+    }
+}
+
+void TraceBinWriter::commitBuffer() {
+    bool busy;
+    RISCV_mutex_lock(&mutex_);
+    filled_[widx_] = wcnt_;
+    RISCV_event_set(&eventFilled_);
+    RISCV_mutex_unlock(&mutex_);
+
+    widx_ = (widx_ + 1) % BUF_TOTAL;
+    wcnt_ = 0;
+    do {
+        RISCV_mutex_lock(&mutex_);
+        busy = filled_[widx_] != 0;
+        if (busy) {
+            RISCV_event_clear(&eventFree_);
+        }
+        RISCV_mutex_unlock(&mutex_);
+        if (busy) {
+            RISCV_event_wait(&eventFree_);
+        }
+    } while (busy);
+}
+
+void TraceBinWriter::drain() {
+    int cnt;
+    while (1) {
+        RISCV_mutex_lock(&mutex_);
+        cnt = filled_[ridx_];
+        if (cnt == 0) {
+            RISCV_event_clear(&eventFilled_);
+        }
+        RISCV_mutex_unlock(&mutex_);
+        if (cnt == 0) {
+            break;
+        }
+
+        fwrite(buf_[ridx_], sizeof(TraceBinRecordType), cnt, fp_);
+
+        RISCV_mutex_lock(&mutex_);
+        filled_[ridx_] = 0;
+        RISCV_event_set(&eventFree_);
+        RISCV_mutex_unlock(&mutex_);
+        ridx_ = (ridx_ + 1) % BUF_TOTAL;
+    }
+}
+
+void TraceBinWriter::busyLoop() {
+    while (isEnabled()) {
+        RISCV_event_wait_ms(&eventFilled_, 100);
+        drain();
+    }
+    drain();
+    fflush(fp_);
+}
+
+}  // namespace debugger
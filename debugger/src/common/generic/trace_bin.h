@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef __DEBUGGER_COMMON_GENERIC_TRACE_BIN_H__
+#define __DEBUGGER_COMMON_GENERIC_TRACE_BIN_H__
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "coreservices/ithread.h"
+
+namespace debugger {
+
+/**
+ * Binary instruction trace format common for the functional and RTL models.
+ * File starts with TraceBinHeaderType followed by the fixed size records,
+ * one record per retired instruction. Disassembling is done offline by
+ * the 'tracebin' command.
+ */
+static const char TRACE_BIN_MAGIC[8] = {'R', 'V', 'T', 'R', 'A', 'C', 'E', 0};
+static const uint32_t TRACE_BIN_VERSION = 1;
+static const int TRACE_BIN_REG_MAX = 4;
+static const int TRACE_BIN_MEM_MAX = 2;
+
+struct TraceBinHeaderType {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+
+struct TraceBinRegType {
+    uint64_t data;
+    uint32_t addr;              // register index as in RISCV_IREGS_NAMES
+    uint32_t rsrv;
+};
+
+struct TraceBinMemType {
+    uint64_t addr;
+    uint64_t data;
+    uint32_t store;             // 0=load; 1=store
+    uint32_t size;              // bytes
+};
+
+struct TraceBinRecordType {
+    uint64_t step_cnt;
+    uint64_t pc;
+    uint32_t instr;
+    uint16_t regcnt;
+    uint16_t memcnt;
+    TraceBinRegType reg[TRACE_BIN_REG_MAX];
+    TraceBinMemType mem[TRACE_BIN_MEM_MAX];
+};
+
+/**
+ * @brief Trace file writer with the background drain thread.
+ *
+ * Records are copied into one of the several buffers, the filled buffer is
+ * written to file by the separate thread so the simulation thread never
+ * waits on the file system unless all buffers are busy.
+ */
+class TraceBinWriter : public IThread {
+ public:
+    TraceBinWriter();
+    virtual ~TraceBinWriter();
+
+    bool open(const char *filename);
+    void close();
+    bool isOpened() { return fp_ != 0; }
+
+    void write(const TraceBinRecordType *rec);
+
+ protected:
+    /** IThread interface */
+    virtual void busyLoop() override;
+
+ private:
+    void commitBuffer();
+    void drain();
+
+    static const int BUF_TOTAL = 4;
+    static const int BUF_RECORDS = 4096;
+
+    FILE *fp_;
+    TraceBinRecordType *buf_[BUF_TOTAL];
+    int filled_[BUF_TOTAL];     // records in the committed buffer, 0 = free
+    int widx_;
+    int wcnt_;
+    int ridx_;
+    mutex_def mutex_;
+    event_def eventFilled_;
+    event_def eventFree_;
+};
+
+}  // namespace debugger
+
+#endif  // __DEBUGGER_COMMON_GENERIC_TRACE_BIN_H__
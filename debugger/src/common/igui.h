@@ -26,6 +26,13 @@ namespace debugger {
 static const char *const IFACE_GUI_PLUGIN = "IGui";
 static const char *const IFACE_GUI_CMD_HANDLER = "IGuiCmdHandler";
 
+/** Target changes that make the subscribed response outdated */
+enum EGuiSubscription {
+    GuiSub_Registers,   // any executed instruction
+    GuiSub_Memory,      // write into the specified address range
+    GuiSub_Halt         // halt, resume, single step or context switch
+};
+
 class IGuiCmdHandler : public IFace {
  public:
     IGuiCmdHandler() : IFace(IFACE_GUI_CMD_HANDLER) {}
@@ -46,6 +53,24 @@ class IGui : public IFace {
                                 bool silent) = 0;
     virtual void removeFromQueue(IFace *iface) = 0;
 
+    /**
+     * Subscribe on the command response. Command is executed by the GUI
+     * thread not often than once per 'period_ms' and only if the change
+     * of the 'kind' was detected, user commands and halt events refresh
+     * every subscription. The handler is called only when the response
+     * differs from the previous one. After the response was processed the
+     * handler calls confirmSubscription() to allow the next update.
+     * removeFromQueue() removes subscriptions too. Second call with the
+     * same handler and response replaces the command.
+     * @param addr, sz Memory range of GuiSub_Memory, ignored otherwise
+     */
+    virtual void subscribeCommand(IGuiCmdHandler *iface,
+                                  const char *cmd, AttributeType *resp,
+                                  int period_ms, EGuiSubscription kind,
+                                  uint64_t addr, uint64_t sz) = 0;
+    virtual void confirmSubscription(IGuiCmdHandler *iface,
+                                     AttributeType *resp) = 0;
+
     // External events:
     virtual void externalCommand(AttributeType *req) = 0;
     virtual void *getQGui() = 0;
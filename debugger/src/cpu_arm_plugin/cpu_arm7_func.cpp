@@ -20,8 +20,6 @@
 namespace debugger {
 
 EIsaArmV7 decoder_arm(uint32_t ti, char *errmsg, size_t errsz);
-EIsaArmV7 decoder_thumb(uint32_t ti, uint32_t *tio,
-                        char *errmsg, size_t errsz);
 
 
 CpuCortex_Functional::CpuCortex_Functional(const char *name) :
@@ -29,12 +27,20 @@ CpuCortex_Functional::CpuCortex_Functional(const char *name) :
     registerInterface(static_cast<ICpuArm *>(this));
     registerAttribute("VectorTable", &vectorTable_);
     registerAttribute("DefaultMode", &defaultMode_);
+    registerAttribute("PredecodeBaseAddress", &predecodeBaseAddr_);
+    registerAttribute("PredecodeSize", &predecodeSize_);
     p_psr_ = reinterpret_cast<ProgramStatusRegsiterType *>(
             &R[Reg_cpsr]);
     PC_ = &R[Reg_pc];   // redefine location of PC register in bank
+    predecode_ = 0;
+    predecodeBase_ = 0;
+    predecodeTotal_ = 0;
 }
 
 CpuCortex_Functional::~CpuCortex_Functional() {
+    if (predecode_) {
+        delete [] predecode_;
+    }
 }
 
 void CpuCortex_Functional::postinitService() {
@@ -45,6 +51,13 @@ void CpuCortex_Functional::postinitService() {
     addArm7tmdiIsa();
     addThumb2Isa();
 
+    predecodeBase_ = predecodeBaseAddr_.to_uint64();
+    predecodeTotal_ = predecodeSize_.to_uint64() / 2;
+    if (predecodeTotal_) {
+        predecode_ = new PredecodeType[predecodeTotal_];
+        memset(predecode_, 0, predecodeTotal_*sizeof(PredecodeType));
+    }
+
     CpuGeneric::postinitService();
 
     /*pcmd_br_ = new CmdBrArm(dmibar_.to_uint64(), 0);
@@ -325,9 +338,20 @@ GenericInstruction *CpuCortex_Functional::decodeInstruction(Reg64Type *cache) {
 
     EIsaArmV7 etype;
     if (getInstrMode() == THUMB_mode) {
-        uint32_t tio;
-        etype = decoder_thumb(ti, &tio, errmsg_, sizeof(errmsg_));
-        //cacheline_[0].buf32[0] = tio;
+        uint64_t off = (getPC() - predecodeBase_) >> 1;
+        if (off < predecodeTotal_ && estate_ != CORE_ProgbufExec) {
+            PredecodeType *p = &predecode_[off];
+            if (p->mask && ((ti ^ p->code) & p->mask) == 0) {
+                etype = p->etype;
+            } else {
+                etype = thumbDecoder_.decode(ti);
+                p->code = ti;
+                p->mask = ((ti >> 11) & 0x1F) >= 0x1D ? ~0u : 0xFFFFu;
+                p->etype = etype;
+            }
+        } else {
+            etype = thumbDecoder_.decode(ti);
+        }
     } else {
         etype = decoder_arm(ti, errmsg_, sizeof(errmsg_));
     }
@@ -342,6 +366,38 @@ GenericInstruction *CpuCortex_Functional::decodeInstruction(Reg64Type *cache) {
     return instr;
 }
 
+void CpuCortex_Functional::flush(uint64_t addr) {
+    CpuGeneric::flush(addr);
+    if (predecode_ == 0) {
+        return;
+    }
+    if (addr == ~0ull) {
+        memset(predecode_, 0, predecodeTotal_*sizeof(PredecodeType));
+    } else {
+        invalidatePredecode(addr, 4);
+    }
+}
+
+void CpuCortex_Functional::invalidatePredecode(uint64_t addr, uint64_t sz) {
+    // 32-bits instruction may start one halfword before the modified address
+    uint64_t off = (addr - predecodeBase_) >> 1;
+    uint64_t end = off + ((sz + 1) >> 1) + 1;
+    if (off != 0) {
+        off--;
+    }
+    for (uint64_t i = off; i < end && i < predecodeTotal_; i++) {
+        predecode_[i].mask = 0;
+    }
+}
+
+ETransStatus CpuCortex_Functional::dma_memop(Axi4TransactionType *tr,
+                                             int flags) {
+    if (predecode_ && tr->action == MemAction_Write) {
+        invalidatePredecode(tr->addr, tr->xsize);
+    }
+    return CpuGeneric::dma_memop(tr, flags);
+}
+
 void CpuCortex_Functional::generateIllegalOpcode() {
     //raiseSignal(EXCEPTION_InstrIllegal);
     RISCV_error("Illegal instruction at 0x%08" RV_PRI64 "x", getPC());
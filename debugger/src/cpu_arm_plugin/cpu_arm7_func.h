@@ -19,6 +19,7 @@
 
 #include "arm-isa.h"
 #include "instructions.h"
+#include "decoder_thumb.h"
 #include "generic/cpu_generic.h"
 #include "coreservices/icpuarm.h"
 #include "cmds/cmd_br_arm7.h"
@@ -50,6 +51,11 @@ class CpuCortex_Functional : public CpuGeneric,
     virtual void raiseSoftwareIrq();
     virtual uint64_t getIrqAddress(int idx) { return 0; }
 
+    /** ICpuFunctional */
+    virtual ETransStatus dma_memop(Axi4TransactionType *tr,
+                                   int flags=0) override;
+    virtual void flush(uint64_t addr) override;
+
     /** ICpuArm */
     virtual void setInstrMode(EArmInstructionModes mode) {
         const uint32_t MODE[ArmInstrModes_Total] = {0u, 1u};
@@ -100,15 +106,29 @@ class CpuCortex_Functional : public CpuGeneric,
     void addThumb2Isa();
     unsigned addSupportedInstruction(ArmInstruction *instr);
     uint32_t hash32(uint32_t val) { return (val >> 24) & 0xf; }
+    void invalidatePredecode(uint64_t addr, uint64_t sz);
 
  private:
     AttributeType defaultMode_;
     AttributeType vendorID_;
     AttributeType vectorTable_;
+    AttributeType predecodeBaseAddr_;
+    AttributeType predecodeSize_;
 
     static const int INSTR_HASH_TABLE_SIZE = 1 << 4;
     AttributeType listInstr_[INSTR_HASH_TABLE_SIZE];
     GenericInstruction *isaTableArmV7_[ARMV7_Total];
+    ThumbDecoder thumbDecoder_;
+
+    // Decoded Thumb instructions per halfword address. Entry is valid when
+    // mask is non-zero and fetched code is the same as on decoding.
+    struct PredecodeType {
+        uint32_t code;
+        uint32_t mask;
+        EIsaArmV7 etype;
+    } *predecode_;
+    uint64_t predecodeBase_;
+    uint64_t predecodeTotal_;       // number of halfwords
 
     ProgramStatusRegsiterType *p_psr_;
 
@@ -14,185 +14,122 @@
  *  limitations under the License.
  */
 
-#include "arm-isa.h"
+#include "decoder_thumb.h"
 #include <api_core.h>
 #include <iservice.h>
+#include <map>
 
 namespace debugger {
 
+/**
+ * 32-bits Thumb-2 encodings {mask, value, type} in priority order. Encodings
+ * that aren't implemented yet return ARMV7_Total but still hide the lower
+ * priority entries.
+ */
+struct Thumb2EncodingType {
+    uint32_t mask;
+    uint32_t value;
+    EIsaArmV7 ret;
+};
+
+static const Thumb2EncodingType THUMB2_ENCODINGS[] = {
+    {0xFFF0FFF0, 0xF000E8D0, T1_TBB},
+    {0xF0F0FFF0, 0xF0F0FB90, T1_SDIV},
+    {0xF0F0FFF0, 0xF0F0FBB0, T1_UDIV},
+    {0xF0F0FFF0, 0xF000FB00, T2_MUL},
+    {0x8020FFF0, 0x0000F340, T1_SBFX},
+    {0x8020FFF0, 0x0000F3C0, T1_UBFX},
+    {0x8F00FBF0, 0x0F00F110, ARMV7_Total},        // T3_ADD_I => T1_CMN_I
+    {0x8F00FFF0, 0x0F00EB10, ARMV7_Total},        // T3_ADD_R => T2_CMN_R
+    {0xF0F0FFEF, 0x0000EA4F, ARMV7_Total},        // T3_MOV_R
+    {0x8000FFEF, 0x0000EB0D, ARMV7_Total},        // T3_ADD_R => T3_ADDSP_R
+    {0x8000FBEF, 0x0000F10D, ARMV7_Total},        // T3_ADD_I => T3_ADDSP_I
+    {0x8000FBEF, 0x0000F1AD, ARMV7_Total},        // T2_SUBSP_I
+    {0x0000FF7F, 0x0000F85F, T2_LDR_L},           // highest
+    {0x0F00FFF0, 0x0E00F850, ARMV7_Total},        // T1_LDRT < T2_LDR_L
+    {0x0D00FFF0, 0x0800F850, ARMV7_Total},        // T4_LDR_I: undefined < T2_LDR_L
+    {0xF000FF7F, 0xF000F81F, ARMV7_Total},        // T3_PLD_I highest
+    {0xFF00FFF0, 0xFC00F810, ARMV7_Total},        // T2_PLD_I < T3_PLD_I
+    {0xF000FFF0, 0xF000F890, ARMV7_Total},        // T1_PLD_I < T3_PLD_I
+    {0xFFC0FFF0, 0xF000F810, ARMV7_Total},        // T1_PLD_R < T3_PLD_I
+    {0xF000FF7F, 0xF000F91F, ARMV7_Total},        // T3_PLI_I highest
+    {0xFF00FFF0, 0xFC00F910, ARMV7_Total},        // T2_PLI_I < T3_PLI_I
+    {0xF000FFF0, 0xF000F990, ARMV7_Total},        // T1_PLI_I < T3_PLI_I
+    {0xFFC0FFF0, 0xF000F910, ARMV7_Total},        // T1_PLI_R < T3_PLI_I
+    {0x0FC0FF7F, 0x0000F81F, ARMV7_Total},        // T1_LDRB_L < T3_PLD_I
+    {0x0000FF7F, 0x0000F91F, ARMV7_Total},        // T1_LDRSB_L < T3_PLI_I
+    {0x2000FFFF, 0x0000E8BD, T2_POP},             // highest
+    {0x0FC0FFF0, 0x0000F800, T2_STRB_R},          // highest
+    {0x0FC0FFF0, 0x0000F810, T2_LDRB_R},          // < T1_PLD_R, T1_LDRB_L
+    {0x0000FF7F, 0x0000F83F, ARMV7_Total},        // T1_LDRH_L < Memory hints
+    {0x0FC0FFF0, 0x0000F830, T2_LDRH_R},          // < T1_LDRH_L, Memory hints
+    {0x0FC0FFF0, 0x0000F840, T2_STR_R},           // Highest
+    {0x0FC0FFF0, 0x0000F910, T2_LDRSB_R},         // < T1_PLI_R, T1_LDRSB_L
+    {0x0F00FFF0, 0x0E00F800, ARMV7_Total},        // T1_STRBT Highest
+    {0xF0C0FFFF, 0xF080FA1F, ARMV7_Total},        // T2_UXTH Highest
+    {0xF0C0FFFF, 0xF080FA4F, ARMV7_Total},        // T2_SXTB Highest
+    {0xF0C0FFFF, 0xF080FA5F, ARMV7_Total},        // T2_UXTB Highest
+    {0x8F00FFF0, 0x0F00EA10, ARMV7_Total},        // T2_TST_R Highest
+    {0x8F00FFF0, 0x0F00EBB0, ARMV7_Total},        // T3_CMP_R Highest
+    {0xF0C0FFF0, 0xF080FA10, T1_UXTAH},           // < T2_UXTH
+    {0xF0C0FFF0, 0xF080FA40, T1_SXTAB},           // < T2_SXTB
+    {0xF0C0FFF0, 0xF080FA50, T1_UXTAB},           // < T2_UXTB
+    {0x00F0FFF0, 0x0010FB00, T1_MLS},             // Highest
+    {0x0F00FFF0, 0x0E00F810, ARMV7_Total},        // T1_LDRBT < T1_LDRB_L
+    {0x0F00FFF0, 0x0E00F820, ARMV7_Total},        // T1_STRHT Highest
+    {0x0800FFF0, 0x0800F800, T3_STRB_I},          // < T1_STRBT
+    {0x0800FFF0, 0x0800F810, T3_LDRB_I},          // < T1_LDRB_L, T3_PLD_I, T1_LDRBT
+    {0x0800FFF0, 0x0800F820, T3_STRH_I},          // < T1_STRHT
+    {0x0800FFF0, 0x0800F850, T4_LDR_I},           // < T2_LDR_L, T1_LDRT
+    {0x0FC0FFF0, 0x0000F850, T2_LDR_R},           // < T2_LDR_L
+    {0x00F0FFF0, 0x0000FB00, T1_MLA},
+    {0x00F0FFF0, 0x0000FB80, T1_SMULL},
+    {0x00F0FFF0, 0x0000FBA0, T1_UMULL},
+    {0xF0F0FFE0, 0xF000FA00, T2_LSL_R},
+    {0xF0F0FFE0, 0xF000FA20, T2_LSR_R},
+    {0x8F00FBF0, 0x0F00F010, T1_TST_I},
+    {0x8F00FBF0, 0x0F00F1B0, T2_CMP_I},
+    {0x2000FFD0, 0x0000E890, T2_LDMIA},
+    {0xA000FFD0, 0x0000E900, T1_STMDB},
+    {0x0000FFF0, 0x0000F880, T2_STRB_I},          // Highest
+    {0x0000FFF0, 0x0000F890, T2_LDRB_I},          // < T3_PLD_I, T1_LDRB_L
+    {0x0000FFF0, 0x0000F8A0, T2_STRH_I},          // Highest
+    {0x0000FFF0, 0x0000F8D0, T3_LDR_I},           // < T2_LDR_L
+    {0x0000FFF0, 0x0000F990, T1_LDRSB_I},         // < T3_PLI_I, T1_LDRSB_L
+    {0x8000FFE0, 0x0000EA00, T2_AND_R},
+    {0x8000FFE0, 0x0000EA40, T2_ORR_R},
+    {0x8000FFE0, 0x0000EB00, T3_ADD_R},
+    {0x8000FFEF, 0x0000EBAD, ARMV7_Total},        // T1_SUBSP_R
+    {0x8000FFE0, 0x0000EBA0, T2_SUB_R},
+    {0x8000FFE0, 0x0000EBC0, T1_RSB_R},
+    {0x8000FBF0, 0x0000F240, T3_MOV_I},
+    {0x8000FBE0, 0x0000F000, T1_AND_I},
+    {0x8F00FBE0, 0x0F00F080, ARMV7_Total},        // T1_TEQ_I
+    {0x8000FBE0, 0x0000F080, T1_EOR_I},
+    {0x8000FBE0, 0x0000F100, T3_ADD_I},
+    {0x8000FBE0, 0x0000F140, T1_ADC_I},
+    {0x8000FBE0, 0x0000F1A0, T3_SUB_I},
+    {0x8000FBE0, 0x0000F1C0, T2_RSB_I},
+    {0x8000FBEF, 0x0000F04F, T2_MOV_I},
+    {0x8000FBE0, 0x0000F040, T1_ORR_I},
+    {0x8000FBE0, 0x0000F020, T1_BIC_I},
+    {0x0000FF70, 0x0000E840, ARMV7_Total},        // see Load/Store double and exclusive, and table branch on page 3-28
+    {0x0000FE50, 0x0000E840, T1_STRD_I},
+    {0xD000F800, 0x8000F000, T3_B},
+    {0xD000F800, 0x9000F000, T4_B},
+};
+
+static const int THUMB2_ENCODINGS_TOTAL =
+    static_cast<int>(sizeof(THUMB2_ENCODINGS) / sizeof(Thumb2EncodingType));
+
 static EIsaArmV7 decoder_w(uint32_t ti, uint32_t *tio,
                          char *errmsg, size_t errsz) {
-    EIsaArmV7 ret = ARMV7_Total;
-    if ((ti & 0xFFF0FFF0) == 0xF000E8D0) {
-        ret = T1_TBB;
-    } else if ((ti & 0xF0F0FFF0) == 0xF0F0FB90) {
-        ret = T1_SDIV;
-    } else if ((ti & 0xF0F0FFF0) == 0xF0F0FBB0) {
-        ret = T1_UDIV;
-    } else if ((ti & 0xF0F0FFF0) == 0xF000FB00) {
-        ret = T2_MUL;
-    } else if ((ti & 0x8020FFF0) == 0x0000F340) {
-        ret = T1_SBFX;
-    } else if ((ti & 0x8020FFF0) == 0x0000F3C0) {
-        ret = T1_UBFX;
-    } else if ((ti & 0x8F00FBF0) == 0x0F00F110) {
-        // T3_ADD_I => T1_CMN_I
-    } else if ((ti & 0x8F00FFF0) == 0x0F00EB10) {
-        // T3_ADD_R => T2_CMN_R
-    } else if ((ti & 0xF0F0FFEF) == 0x0000EA4F) {
-        // T3_MOV_R
-    } else if ((ti & 0x8000FFEF) == 0x0000EB0D) {
-        // T3_ADD_R => T3_ADDSP_R
-    } else if ((ti & 0x8000FBEF) == 0x0000F10D) {
-        // T3_ADD_I => T3_ADDSP_I
-    } else if ((ti & 0x8000FBEF) == 0x0000F1AD) {
-        // T2_SUBSP_I
-    } else if ((ti & 0x0000FF7F) == 0x0000F85F) { // highest
-        ret = T2_LDR_L;
-    } else if ((ti & 0x0F00FFF0) == 0x0E00F850) { // < T2_LDR_L
-        // T1_LDRT
-    } else if ((ti & 0x0D00FFF0) == 0x0800F850) { // < T2_LDR_L
-        // T4_LDR_I: undefined
-    } else if ((ti & 0xF000FF7F) == 0xF000F81F) { // highest
-        // T3_PLD_I
-    } else if ((ti & 0xFF00FFF0) == 0xFC00F810) { // < T3_PLD_I
-        // T2_PLD_I
-    } else if ((ti & 0xF000FFF0) == 0xF000F890) { // < T3_PLD_I
-        // T1_PLD_I
-    } else if ((ti & 0xFFC0FFF0) == 0xF000F810) { // < T3_PLD_I
-        // T1_PLD_R
-    } else if ((ti & 0xF000FF7F) == 0xF000F91F) { // highest
-        // T3_PLI_I
-    } else if ((ti & 0xFF00FFF0) == 0xFC00F910) { // < T3_PLI_I
-        // T2_PLI_I
-    } else if ((ti & 0xF000FFF0) == 0xF000F990) { // < T3_PLI_I
-        // T1_PLI_I
-    } else if ((ti & 0xFFC0FFF0) == 0xF000F910) { // < T3_PLI_I
-        // T1_PLI_R
-    } else if ((ti & 0x0FC0FF7F) == 0x0000F81F) { // < T3_PLD_I
-        // T1_LDRB_L
-    } else if ((ti & 0x0000FF7F) == 0x0000F91F) { // < T3_PLI_I
-        // T1_LDRSB_L
-    } else if ((ti & 0x2000FFFF) == 0x0000E8BD) { // highest
-        ret = T2_POP;
-    } else if ((ti & 0x0FC0FFF0) == 0x0000F800) { // highest
-        ret = T2_STRB_R;
-    } else if ((ti & 0x0FC0FFF0) == 0x0000F810) { // < T1_PLD_R, T1_LDRB_L
-        ret = T2_LDRB_R;
-    } else if ((ti & 0x0000FF7F) == 0x0000F83F) { // < Memory hints
-        // T1_LDRH_L;
-    } else if ((ti & 0x0FC0FFF0) == 0x0000F830) { // < T1_LDRH_L, Memory hints
-        ret = T2_LDRH_R;
-    } else if ((ti & 0x0FC0FFF0) == 0x0000F840) { // Highest
-        ret = T2_STR_R;
-    } else if ((ti & 0x0FC0FFF0) == 0x0000F910) { // < T1_PLI_R, T1_LDRSB_L
-        ret = T2_LDRSB_R;
-    } else if ((ti & 0x0F00FFF0) == 0x0E00F800) { // Highest
-        // T1_STRBT
-    } else if ((ti & 0xF0C0FFFF) == 0xF080FA1F) { // Highest
-        // T2_UXTH;
-    } else if ((ti & 0xF0C0FFFF) == 0xF080FA4F) { // Highest
-        // T2_SXTB;
-    } else if ((ti & 0xF0C0FFFF) == 0xF080FA5F) { // Highest
-        // T2_UXTB;
-    } else if ((ti & 0x8F00FFF0) == 0x0F00EA10) { // Highest
-        // T2_TST_R
-    } else if ((ti & 0x8F00FFF0) == 0x0F00EBB0) { // Highest
-        // T3_CMP_R
-    } else if ((ti & 0xF0C0FFF0) == 0xF080FA10) { // < T2_UXTH
-        ret = T1_UXTAH;
-    } else if ((ti & 0xF0C0FFF0) == 0xF080FA40) { // < T2_SXTB
-        ret = T1_SXTAB;
-    } else if ((ti & 0xF0C0FFF0) == 0xF080FA50) { // < T2_UXTB
-        ret = T1_UXTAB;
-    } else if ((ti & 0x00F0FFF0) == 0x0010FB00) { // Highest
-        ret = T1_MLS;
-    } else if ((ti & 0x0F00FFF0) == 0x0E00F810) { // < T1_LDRB_L
-        // T1_LDRBT
-    } else if ((ti & 0x0F00FFF0) == 0x0E00F820) { // Highest
-        // T1_STRHT;
-    } else if ((ti & 0x0800FFF0) == 0x0800F800) { // < T1_STRBT
-        ret = T3_STRB_I;
-    } else if ((ti & 0x0800FFF0) == 0x0800F810) { // < T1_LDRB_L, T3_PLD_I, T1_LDRBT
-        ret = T3_LDRB_I;
-    } else if ((ti & 0x0800FFF0) == 0x0800F820) { // < T1_STRHT
-        ret = T3_STRH_I;
-    } else if ((ti & 0x0800FFF0) == 0x0800F850) { // < T2_LDR_L, T1_LDRT
-        ret = T4_LDR_I;
-    } else if ((ti & 0x0FC0FFF0) == 0x0000F850) { // < T2_LDR_L
-        ret = T2_LDR_R;
-    } else if ((ti & 0x00F0FFF0) == 0x0000FB00) {
-        ret = T1_MLA;
-    } else if ((ti & 0x00F0FFF0) == 0x0000FB80) {
-        ret = T1_SMULL;
-    } else if ((ti & 0x00F0FFF0) == 0x0000FBA0) {
-        ret = T1_UMULL;
-    } else if ((ti & 0xF0F0FFE0) == 0xF000FA00) {
-        ret = T2_LSL_R;
-    } else if ((ti & 0xF0F0FFE0) == 0xF000FA20) {
-        ret = T2_LSR_R;
-    } else if ((ti & 0x8F00FBF0) == 0x0F00F010) {
-        ret = T1_TST_I;
-    } else if ((ti & 0x8F00FBF0) == 0x0F00F1B0) {
-        ret = T2_CMP_I;
-    } else if ((ti & 0x2000FFD0) == 0x0000E890) {
-        ret = T2_LDMIA;
-    } else if ((ti & 0xA000FFD0) == 0x0000E900) {
-        ret = T1_STMDB;
-    } else if ((ti & 0x0000FFF0) == 0x0000F880) { // Highest
-        ret = T2_STRB_I;
-    } else if ((ti & 0x0000FFF0) == 0x0000F890) { // < T3_PLD_I, T1_LDRB_L
-        ret = T2_LDRB_I;
-    } else if ((ti & 0x0000FFF0) == 0x0000F8A0) { // Highest
-        ret = T2_STRH_I;
-    } else if ((ti & 0x0000FFF0) == 0x0000F8D0) { // < T2_LDR_L
-        ret = T3_LDR_I;
-    } else if ((ti & 0x0000FFF0) == 0x0000F990) { // < T3_PLI_I, T1_LDRSB_L
-        ret = T1_LDRSB_I;
-    } else if ((ti & 0x8000FFE0) == 0x0000EA00) {
-        ret = T2_AND_R;
-    } else if ((ti & 0x8000FFE0) == 0x0000EA40) {
-        ret = T2_ORR_R;
-    } else if ((ti & 0x8000FFE0) == 0x0000EB00) {
-        ret = T3_ADD_R;
-    } else if ((ti & 0x8000FFEF) == 0x0000EBAD) {
-        // T1_SUBSP_R;
-    } else if ((ti & 0x8000FFE0) == 0x0000EBA0) {
-        ret = T2_SUB_R;
-    } else if ((ti & 0x8000FFE0) == 0x0000EBC0) {
-        ret = T1_RSB_R;
-    } else if ((ti & 0x8000FBF0) == 0x0000F240) {
-        ret = T3_MOV_I;
-    } else if ((ti & 0x8000FBE0) == 0x0000F000) {
-        ret = T1_AND_I;
-    } else if ((ti & 0x8F00FBE0) == 0x0F00F080) {
-        // T1_TEQ_I;
-    } else if ((ti & 0x8000FBE0) == 0x0000F080) {
-        ret = T1_EOR_I;
-    } else if ((ti & 0x8000FBE0) == 0x0000F100) {
-        ret = T3_ADD_I;
-    } else if ((ti & 0x8000FBE0) == 0x0000F140) {
-        ret = T1_ADC_I;
-    } else if ((ti & 0x8000FBE0) == 0x0000F1A0) {
-        ret = T3_SUB_I;
-    } else if ((ti & 0x8000FBE0) == 0x0000F1C0) {
-        ret = T2_RSB_I;
-    } else if ((ti & 0x8000FBEF) == 0x0000F04F) {
-        ret = T2_MOV_I;
-    } else if ((ti & 0x8000FBE0) == 0x0000F040) {
-        ret = T1_ORR_I;
-    } else if ((ti & 0x8000FBE0) == 0x0000F020) {
-        ret = T1_BIC_I;
-    } else if ((ti & 0x0000FF70) == 0x0000E840) {
-        // see Load/Store double and exclusive, and table branch on page 3-28
-    } else if ((ti & 0x0000FE50) == 0x0000E840) {
-        ret = T1_STRD_I;
-    } else if ((ti & 0xD000F800) == 0x8000F000) {
-        ret = T3_B;
-    } else if ((ti & 0xD000F800) == 0x9000F000) {
-        ret = T4_B;
+    for (int i = 0; i < THUMB2_ENCODINGS_TOTAL; i++) {
+        if ((ti & THUMB2_ENCODINGS[i].mask) == THUMB2_ENCODINGS[i].value) {
+            return THUMB2_ENCODINGS[i].ret;
+        }
     }
-    return ret;
+    return ARMV7_Total;
 }
 
 EIsaArmV7 decoder_thumb(uint32_t ti, uint32_t *tio,
@@ -339,4 +276,83 @@ EIsaArmV7 decoder_thumb(uint32_t ti, uint32_t *tio,
     return ret;
 }
 
+/** BL, BLX is the only 32-bits encoding checked after the 16-bits ones */
+static const uint32_t T1_BL_I_MASK = 0xD000F800;
+static const uint32_t T1_BL_I_VALUE = 0xD000F000;
+
+ThumbDecoder::ThumbDecoder() {
+    std::map<std::vector<uint64_t>, uint32_t> lists;
+    std::vector<PatternType> list;
+    std::vector<uint64_t> key;
+    char errmsg[256];
+    uint32_t tio;
+
+    l1_.resize(1 << 16);
+    for (uint32_t hw1 = 0; hw1 < (1u << 16); hw1++) {
+        if ((hw1 >> 11) < 0x1D) {
+            // 16-bits instruction: second halfword doesn't affect decoding
+            l1_[hw1] = decoder_thumb(hw1, &tio, errmsg, sizeof(errmsg));
+            continue;
+        }
+
+        bool bl = (hw1 & T1_BL_I_MASK) == (T1_BL_I_VALUE & 0xFFFF);
+        list.clear();
+        for (int i = 0; i < THUMB2_ENCODINGS_TOTAL; i++) {
+            const Thumb2EncodingType *p = &THUMB2_ENCODINGS[i];
+            if ((hw1 & p->mask & 0xFFFF) != (p->value & 0xFFFF)) {
+                continue;
+            }
+            PatternType t;
+            t.mask = static_cast<uint16_t>(p->mask >> 16);
+            t.value = static_cast<uint16_t>(p->value >> 16);
+            t.ret = static_cast<uint16_t>(p->ret);
+            if (p->ret == ARMV7_Total && bl) {
+                // Not implemented encoding doesn't hide BL
+                uint32_t blmask = T1_BL_I_MASK >> 16;
+                uint32_t blvalue = T1_BL_I_VALUE >> 16;
+                if (((t.value ^ blvalue) & t.mask & blmask) == 0) {
+                    PatternType tbl;
+                    tbl.mask = static_cast<uint16_t>(t.mask | blmask);
+                    tbl.value = static_cast<uint16_t>(t.value | blvalue);
+                    tbl.ret = static_cast<uint16_t>(T1_BL_I);
+                    list.push_back(tbl);
+                }
+            }
+            list.push_back(t);
+            if (t.mask == 0) {
+                break;
+            }
+        }
+        if (list.size() == 0 || list.back().mask != 0) {
+            PatternType t;
+            if (bl) {
+                t.mask = static_cast<uint16_t>(T1_BL_I_MASK >> 16);
+                t.value = static_cast<uint16_t>(T1_BL_I_VALUE >> 16);
+                t.ret = static_cast<uint16_t>(T1_BL_I);
+                list.push_back(t);
+            }
+            t.mask = 0;
+            t.value = 0;
+            t.ret = static_cast<uint16_t>(ARMV7_Total);
+            list.push_back(t);
+        }
+
+        // The same lists are shared between different first halfwords
+        key.clear();
+        for (size_t i = 0; i < list.size(); i++) {
+            key.push_back((static_cast<uint64_t>(list[i].mask) << 32)
+                        | (static_cast<uint64_t>(list[i].value) << 16)
+                        | list[i].ret);
+        }
+        std::map<std::vector<uint64_t>, uint32_t>::iterator it =
+            lists.find(key);
+        if (it == lists.end()) {
+            uint32_t off = static_cast<uint32_t>(l2_.size());
+            l2_.insert(l2_.end(), list.begin(), list.end());
+            it = lists.insert(std::make_pair(key, off)).first;
+        }
+        l1_[hw1] = LIST_FLAG + it->second;
+    }
+}
+
 }  // debugger
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef __DEBUGGER_SRC_CPU_ARM_PLUGIN_DECODER_THUMB_H__
+#define __DEBUGGER_SRC_CPU_ARM_PLUGIN_DECODER_THUMB_H__
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <vector>
+#include "arm-isa.h"
+
+namespace debugger {
+
+/** Reference decoder: checks encodings one by one in priority order */
+EIsaArmV7 decoder_thumb(uint32_t ti, uint32_t *tio,
+                        char *errmsg, size_t errsz);
+
+/**
+ * @brief Two-level Thumb/Thumb-2 lookup table generated from decoder_thumb.
+ *
+ * The first level is indexed by the first halfword. For 16-bits encodings
+ * it contains the instruction type, for 32-bits encodings it contains the
+ * offset of the short list of second halfword patterns that may follow the
+ * first halfword. The list is always terminated by an 'any' pattern.
+ */
+class ThumbDecoder {
+ public:
+    ThumbDecoder();
+
+    EIsaArmV7 decode(uint32_t ti) const {
+        uint32_t t = l1_[ti & 0xFFFF];
+        if (t < LIST_FLAG) {
+            return static_cast<EIsaArmV7>(t);
+        }
+        const PatternType *p = &l2_[t - LIST_FLAG];
+        uint32_t hw2 = ti >> 16;
+        while ((hw2 & p->mask) != p->value) {
+            p++;
+        }
+        return static_cast<EIsaArmV7>(p->ret);
+    }
+
+    int getListsSize() const { return static_cast<int>(l2_.size()); }
+
+ private:
+    static const uint32_t LIST_FLAG = 1u << 16;
+
+    struct PatternType {
+        uint16_t mask;
+        uint16_t value;
+        uint16_t ret;
+    };
+
+    std::vector<uint32_t> l1_;
+    std::vector<PatternType> l2_;
+};
+
+}  // namespace debugger
+
+#endif  // __DEBUGGER_SRC_CPU_ARM_PLUGIN_DECODER_THUMB_H__
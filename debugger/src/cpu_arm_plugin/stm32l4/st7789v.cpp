@@ -37,6 +37,55 @@ void ST7789VCmdType::getFrame(AttributeType *res, bool diff) {
     memcpy(res->data(), p->frame_, sizeof(p->frame_));
 }
 
+void ST7789VCmdType::getUpdate(AttributeType *res, uint64_t seq) {
+    ST7789V *p = static_cast<ST7789V *>(cmdParent_);
+    // Close current sequence: pixels written while copying go into the
+    // next one, so tiles of the closed sequence are sent once more.
+    uint32_t cur = p->frameSeq_;
+    p->frameSeq_ = cur + 1;
+    RISCV_memory_barrier();
+
+    res->make_list(2);
+    (*res)[0u].make_uint64(cur);
+    AttributeType &rects = (*res)[1];
+    rects.make_list(0);
+
+    // Vertically adjacent modified tiles are merged into one rectangle
+    for (int tx = 0; tx < ST7789V_TILES_X; tx++) {
+        int ty = 0;
+        while (ty < ST7789V_TILES_Y) {
+            const uint32_t *pseq = &p->tileSeq_[tx * ST7789V_TILES_Y];
+            if (seq != 0 && pseq[ty] < seq) {
+                ty++;
+                continue;
+            }
+            int ty_end = ty + 1;
+            while (ty_end < ST7789V_TILES_Y
+                && (seq == 0 || pseq[ty_end] >= seq)) {
+                ty_end++;
+            }
+
+            int x = tx * ST7789V_TILE;
+            int y = ty * ST7789V_TILE;
+            int h = (ty_end - ty) * ST7789V_TILE;
+            AttributeType &rect = rects.new_list_item();
+            rect.make_list(5);
+            rect[0u].make_int64(x);
+            rect[1].make_int64(y);
+            rect[2].make_int64(ST7789V_TILE);
+            rect[3].make_int64(h);
+            rect[4].make_data(ST7789V_TILE * h * sizeof(uint32_t));
+            uint32_t *dst = reinterpret_cast<uint32_t *>(rect[4].data());
+            for (int i = 0; i < ST7789V_TILE; i++) {
+                memcpy(&dst[i * h],
+                       &p->frame_[(x + i) * ST7789V_HEIGHT + y],
+                       h * sizeof(uint32_t));
+            }
+            ty = ty_end;
+        }
+    }
+}
+
 ST7789V::ST7789V(const char *name) :
     IService(name),
     pinRD_(this),
@@ -59,6 +108,8 @@ ST7789V::ST7789V(const char *name) :
     m_x = 0;
     m_y = 0;
     last_modified_pixel_ = 0;
+    memset(tileSeq_, 0, sizeof(tileSeq_));
+    frameSeq_ = 1;
 }
 
 void ST7789V::postinitService() {
@@ -198,9 +249,17 @@ void ST7789V::madctl() {
 }
 
 void ST7789V::iled_setpixel(uint32_t rgb) {
-    int pix_idx = m_y*ST7789V_HEIGHT + ST7789V_HEIGHT-m_x-1;
+    if (m_x >= ST7789V_HEIGHT || m_y >= ST7789V_WIDTH) {
+        return;
+    }
+    // Frame is stored by columns: m_y is the column, m_x inverted row
+    int col = m_y;
+    int row = ST7789V_HEIGHT - m_x - 1;
+    int pix_idx = col*ST7789V_HEIGHT + row;
     if (frame_[pix_idx] != rgb) {
         last_modified_pixel_ = pix_idx;
+        tileSeq_[(col / ST7789V_TILE) * ST7789V_TILES_Y
+                 + row / ST7789V_TILE] = frameSeq_;
     }
     frame_[pix_idx] = rgb;
 }
@@ -32,6 +32,10 @@ namespace debugger {
 
 static const int ST7789V_WIDTH  = 320;
 static const int ST7789V_HEIGHT = 240;
+/** Modified regions are tracked in tiles of 16x16 pixels */
+static const int ST7789V_TILE = 16;
+static const int ST7789V_TILES_X = ST7789V_WIDTH / ST7789V_TILE;
+static const int ST7789V_TILES_Y = ST7789V_HEIGHT / ST7789V_TILE;
 
 class ST7789VCmdType : public GenericDisplayCmdType {
  public:
@@ -43,6 +47,7 @@ class ST7789VCmdType : public GenericDisplayCmdType {
     virtual int getHeight() { return ST7789V_HEIGHT; }
     virtual uint32_t getBkgColor() { return 0; }
     virtual void getFrame(AttributeType *res, bool diff);
+    virtual void getUpdate(AttributeType *res, uint64_t seq);
 
  protected:
     int last_pixel_;
@@ -180,6 +185,10 @@ class ST7789V : public IService,
     uint8_t cmdBufPos_;
     uint32_t frame_[ST7789V_HEIGHT * ST7789V_WIDTH];
     int last_modified_pixel_;
+    // Sequence number of the last modification of each tile. CPU thread
+    // only marks tiles, so it never waits for the GUI copying the frame.
+    uint32_t tileSeq_[ST7789V_TILES_X * ST7789V_TILES_Y];
+    volatile uint32_t frameSeq_;
 };
 /*----------------------------------------------------------------------------*/
 
@@ -31,20 +31,30 @@ CpuRiver_Functional::CpuRiver_Functional(const char *name) :
     registerAttribute("CLINT", &clint_);
     registerAttribute("PLIC", &plic_);
     registerAttribute("PmpTotal", &pmpTotal_);
-
+    registerAttribute("TimingModel", &timingModel_);
+    registerAttribute("ICacheGeometry", &icacheGeometry_);
+    registerAttribute("DCacheGeometry", &dcacheGeometry_);
+    registerAttribute("L2CacheGeometry", &l2cacheGeometry_);
+    registerAttribute("L2Latency", &l2Latency_);
+    registerAttribute("MemLatency", &memLatency_);
+
+    timingEna_ = false;
     mmuReservatedAddr_ = 0;
     mmuReservedAddrWatchdog_ = 0;
     memset(&pmpTable_, 0, sizeof(pmpTable_));
+    memset(instrTable_, 0, sizeof(instrTable_));
 }
 
 CpuRiver_Functional::~CpuRiver_Functional() {
+    for (int i = 0; i < RISCV_ENCODINGS_MAX; i++) {
+        if (instrTable_[i]) {
+            delete instrTable_[i];
+        }
+    }
 }
 
 void CpuRiver_Functional::postinitService() {
     // Supported instruction sets:
-    for (int i = 0; i < INSTR_HASH_TABLE_SIZE; i++) {
-        listInstr_[i].make_list(0);
-    }
     addIsaUserRV64I();
     addIsaPrivilegedRV64I();
     for (unsigned i = 0; i < listExtISA_.size(); i++) {
@@ -61,6 +71,28 @@ void CpuRiver_Functional::postinitService() {
         }
     }
 
+    if (timingModel_.to_bool()) {
+        // Default geometry of River L1 and L2 caches (config_target.h)
+        int icache[2] = {2, 7};
+        int dcache[2] = {2, 7};
+        int l2cache[2] = {4, 9};
+        for (unsigned i = 0; i < 2; i++) {
+            if (icacheGeometry_.size() == 2) {
+                icache[i] = icacheGeometry_[i].to_int();
+            }
+            if (dcacheGeometry_.size() == 2) {
+                dcache[i] = dcacheGeometry_[i].to_int();
+            }
+            if (l2cacheGeometry_.size() == 2) {
+                l2cache[i] = l2cacheGeometry_[i].to_int();
+            }
+        }
+        timing_.configure(icache, dcache, l2cache,
+                          l2Latency_.is_integer() ? l2Latency_.to_int() : 8,
+                          memLatency_.is_integer() ? memLatency_.to_int() : 30);
+        timingEna_ = true;
+    }
+
     // Power-on
     reset(0);
 
@@ -87,8 +119,13 @@ void CpuRiver_Functional::predeleteService() {
 
 unsigned CpuRiver_Functional::addSupportedInstruction(
                                     RiscvInstruction *instr) {
-    AttributeType tmp(instr);
-    listInstr_[instr->hash()].add_to_list(&tmp);
+    int idx = decoder_.findIndex(instr->name());
+    if (idx < 0) {
+        RISCV_error("Encoding of %s not defined", instr->name());
+        delete instr;
+        return 1;
+    }
+    instrTable_[idx] = instr;
     return 0;
 }
 
@@ -220,30 +257,17 @@ void CpuRiver_Functional::reset(IFace *isource) {
 
     cur_prv_level = PRV_M;           // Current privilege level
     mmuReservedAddrWatchdog_ = 0;
+    timing_.reset();
 }
 
 GenericInstruction *CpuRiver_Functional::decodeInstruction(Reg64Type *cache) {
     RiscvInstruction *instr = NULL;
-    int hash_idx = hash32(cacheline_[0].buf32[0]);
-    for (unsigned i = 0; i < listInstr_[hash_idx].size(); i++) {
-        instr = static_cast<RiscvInstruction *>(
-                        listInstr_[hash_idx][i].to_iface());
-        if (instr->parse(cacheline_[0].buf32)) {
-            break;
-        }
-        instr = NULL;
-    }
-    // Check compressed instructions:
-    if (instr == NULL) {
-        hash_idx = hash16(cacheline_[0].buf16[0]);
-        for (unsigned i = 0; i < listInstr_[hash_idx].size(); i++) {
-            instr = static_cast<RiscvInstruction *>(
-                            listInstr_[hash_idx][i].to_iface());
-            if (instr->parse(cacheline_[0].buf32)) {
-                break;
-            }
-            instr = NULL;
-        }
+    int idx = decoder_.decode(cacheline_[0].buf32[0]);
+    if (idx >= 0) {
+        instr = instrTable_[idx];
+    }
+    if (timingEna_ && estate_ == CORE_Normal) {
+        timing_.instruction(getPC(), cacheline_[0].buf32[0], idx, R[Reg_ra]);
     }
     if (mmuReservedAddrWatchdog_) {
         mmuReservedAddrWatchdog_--;
@@ -390,13 +414,13 @@ uint64_t CpuRiver_Functional::readCSR(uint32_t regno) {
     uint64_t ret = 0;
     uint64_t trigidx;
     if (regno == CSR_mcycle) {
-        ret = step_cnt_;
+        ret = getStepCounter();
     } else if (regno == CSR_minsret) {
         ret = step_cnt_;
     } else if (regno == CSR_cycle) {
-        ret = step_cnt_;
+        ret = getStepCounter();
     } else if (regno == CSR_time) {
-        ret = step_cnt_;
+        ret = getStepCounter();
     } else if (regno == CSR_insret) {
         ret = step_cnt_;
     } else if (regno == CSR_dpc) {
@@ -654,5 +678,22 @@ uint64_t CpuRiver_Functional::translateMmu(uint64_t va) {
 void CpuRiver_Functional::flushMmu() {
 }
 
+ETransStatus CpuRiver_Functional::dma_memop(Axi4TransactionType *tr,
+                                            int flags) {
+    ETransStatus ret = CpuGeneric::dma_memop(tr, flags);
+    // Instruction fetching is accounted in decodeInstruction()
+    if (timingEna_ && !(flags & 0x1) && estate_ == CORE_Normal) {
+        timing_.dataAccess(tr->addr, tr->action == MemAction_Write);
+    }
+    return ret;
+}
+
+void CpuRiver_Functional::flush(uint64_t addr) {
+    CpuGeneric::flush(addr);
+    if (timingEna_ && addr == ~0ull) {
+        timing_.flushICache();
+    }
+}
+
 }  // namespace debugger
 
@@ -19,7 +19,9 @@
 
 #include <riscv-isa.h>
 #include "instructions.h"
+#include "river_timing.h"
 #include "generic/cpu_generic.h"
+#include "generic/riscv_decoder.h"
 #include "coreservices/icpuriscv.h"
 #include "coreservices/iirq.h"
 
@@ -59,7 +61,16 @@ class CpuRiver_Functional : public CpuGeneric,
     virtual bool isMmuEnabled() override;
     virtual uint64_t translateMmu(uint64_t addr) override;
     virtual void flushMmu() override;
+    virtual ETransStatus dma_memop(Axi4TransactionType *tr, int flags=0) override;
+    virtual void flush(uint64_t addr) override;
 
+    /** IClock interface */
+    virtual uint64_t getStepCounter() override {
+        if (timingEna_) {
+            return timing_.getCycles();
+        }
+        return step_cnt_;
+    }
 
     /** DPort interface */
     virtual int dportReadReg(uint32_t regno, uint64_t *val) override;
@@ -98,6 +109,7 @@ class CpuRiver_Functional : public CpuGeneric,
     virtual void trackContextStart();
     /** // Stop tracking and write trace file */
     virtual void traceOutput() override;
+    virtual int retireHartId() override { return hartid_.to_int(); }
     virtual bool isStepEnabled() override;
     virtual void checkStackProtection() override;
 
@@ -109,12 +121,6 @@ class CpuRiver_Functional : public CpuGeneric,
     void addIsaExtensionF();
     void addIsaExtensionM();
     unsigned addSupportedInstruction(RiscvInstruction *instr);
-    uint32_t hash32(uint32_t val) { return (val >> 2) & 0x1f; }
-    /** Compressed instruction */
-    uint32_t hash16(uint16_t val) {
-        uint32_t t1 = val & 0x3;
-        return 0x20 | ((val >> 13) << 2) | t1;
-    }
 
  private:
     void switchContext(uint32_t prvnxt);
@@ -134,9 +140,19 @@ class CpuRiver_Functional : public CpuGeneric,
     AttributeType clint_;       // Core-local interruptor
     AttributeType plic_;        // External interrupt controller
     AttributeType pmpTotal_;    // Total number of enabled PMP regions < 64
-
-    static const int INSTR_HASH_TABLE_SIZE = 1 << 6;
-    AttributeType listInstr_[INSTR_HASH_TABLE_SIZE];
+    AttributeType timingModel_; // Enable cycle-approximate timing
+    AttributeType icacheGeometry_;  // [log2(ways), log2(lines per way)]
+    AttributeType dcacheGeometry_;
+    AttributeType l2cacheGeometry_;
+    AttributeType l2Latency_;   // L2 hit latency in clocks
+    AttributeType memLatency_;  // DDR line access latency in clocks
+
+    RiscvDecoder decoder_;
+    // Implemented instructions indexed by RISCV_ENCODINGS position
+    RiscvInstruction *instrTable_[RISCV_ENCODINGS_MAX];
+
+    bool timingEna_;
+    RiverTimingModel timing_;
 
     IIrqController *iirqloc_;
     IIrqController *iirqext_;
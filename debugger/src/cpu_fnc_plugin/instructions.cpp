@@ -21,28 +21,12 @@
 
 namespace debugger {
 
-RiscvInstruction::RiscvInstruction(CpuRiver_Functional *icpu, const char *name,
-                                    const char *bits) {
+RiscvInstruction::RiscvInstruction(CpuRiver_Functional *icpu,
+                                   const char *name) {
     icpu_ = icpu;
     R = icpu->getpRegs();
     RF = &icpu->getpRegs()[ICpuRiscV::RegFpu_Offset];
     name_.make_string(name);
-    mask_ = 0;
-    opcode_ = 0;
-    for (int i = 0; i < 32; i++) {
-        switch (bits[i]) {
-        case '0':
-            break;
-        case '1':
-            opcode_ |= (1 << (31 - i));
-            break;
-        case '?':
-            mask_ |= (1 << (31 - i));
-            break;
-        default:;
-        }
-    }
-    mask_ ^= ~0;
 }
 
 }  // namespace debugger
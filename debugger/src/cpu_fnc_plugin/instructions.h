@@ -26,44 +26,23 @@ class CpuRiver_Functional;
 
 class RiscvInstruction : public GenericInstruction {
 public:
-    RiscvInstruction(CpuRiver_Functional *icpu, const char *name,
-                    const char *bits);
+    /** Encoding is taken from the shared RISCV_ENCODINGS table by name */
+    RiscvInstruction(CpuRiver_Functional *icpu, const char *name);
 
     // IInstruction interface:
     virtual const char *name() { return name_.to_string(); }
 
-    virtual bool parse(uint32_t *payload) {
-        return ((payload[0] & mask_) == opcode_);
-    }
-
-    virtual uint32_t hash() {
-        return (opcode_ >> 2) & 0x1F;
-    }
-
-    uint16_t hash16() {
-        uint16_t t1 = static_cast<uint16_t>(opcode_) & 0x3;
-        return 0x20 | ((static_cast<uint16_t>(opcode_) >> 13) << 2) | t1;
-    }
-
 protected:
     AttributeType name_;
     CpuRiver_Functional *icpu_;
-    uint32_t mask_;
-    uint32_t opcode_;
     uint64_t *R;
     uint64_t *RF;
 };
 
 class RiscvInstruction16 : public RiscvInstruction {
 public:
-    RiscvInstruction16(CpuRiver_Functional *icpu, const char *name,
-                    const char *bits) : RiscvInstruction(icpu, name, bits) {}
-
-    // IInstruction interface:
-    virtual uint32_t hash() {
-        uint16_t t1 = static_cast<uint16_t>(opcode_) & 0x3;
-        return 0x20 | ((static_cast<uint16_t>(opcode_) >> 13) << 2) | t1;
-    }
+    RiscvInstruction16(CpuRiver_Functional *icpu, const char *name)
+        : RiscvInstruction(icpu, name) {}
 };
 
 
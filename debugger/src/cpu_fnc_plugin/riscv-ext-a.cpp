@@ -38,8 +38,8 @@ namespace debugger {
 class RiscvAmoGeneric : public RiscvInstruction {
 public:
     RiscvAmoGeneric(CpuRiver_Functional *icpu, const char *name,
-                    const char *bits, int rvbytes) :
-        RiscvInstruction(icpu, name, bits), rvbytes_(rvbytes) {}
+                    int rvbytes) :
+        RiscvInstruction(icpu, name), rvbytes_(rvbytes) {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -88,7 +88,7 @@ public:
 class AMOADD_W : public RiscvAmoGeneric {
  public:
     AMOADD_W(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOADD_W", "00000????????????010?????0101111", 4) {}
+        RiscvAmoGeneric(icpu, "AMOADD_W", 4) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -99,7 +99,7 @@ class AMOADD_W : public RiscvAmoGeneric {
 class AMOXOR_W : public RiscvAmoGeneric {
 public:
     AMOXOR_W(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOXOR_W", "00100????????????010?????0101111", 4) {}
+        RiscvAmoGeneric(icpu, "AMOXOR_W", 4) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -110,7 +110,7 @@ public:
 class AMOOR_W : public RiscvAmoGeneric {
 public:
     AMOOR_W(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOOR_W", "01000????????????010?????0101111", 4) {}
+        RiscvAmoGeneric(icpu, "AMOOR_W", 4) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -121,7 +121,7 @@ public:
 class AMOAND_W : public RiscvAmoGeneric {
 public:
     AMOAND_W(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOAND_W", "01100????????????010?????0101111", 4) {}
+        RiscvAmoGeneric(icpu, "AMOAND_W", 4) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -132,7 +132,7 @@ public:
 class AMOMIN_W : public RiscvAmoGeneric {
 public:
     AMOMIN_W(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOMIN_W", "10000????????????010?????0101111", 4) {}
+        RiscvAmoGeneric(icpu, "AMOMIN_W", 4) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -145,7 +145,7 @@ public:
 class AMOMAX_W : public RiscvAmoGeneric {
 public:
     AMOMAX_W(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOMAX_W", "10100????????????010?????0101111", 4) {}
+        RiscvAmoGeneric(icpu, "AMOMAX_W", 4) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -158,7 +158,7 @@ public:
 class AMOMINU_W : public RiscvAmoGeneric {
 public:
     AMOMINU_W(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOMINU_W", "11000????????????010?????0101111", 4) {}
+        RiscvAmoGeneric(icpu, "AMOMINU_W", 4) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -169,7 +169,7 @@ public:
 class AMOMAXU_W : public RiscvAmoGeneric {
 public:
     AMOMAXU_W(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOMAXU_W", "11100????????????010?????0101111", 4) {}
+        RiscvAmoGeneric(icpu, "AMOMAXU_W", 4) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -180,7 +180,7 @@ public:
 class AMOSWAP_W : public RiscvAmoGeneric {
 public:
     AMOSWAP_W(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOSWAP_W", "00001????????????010?????0101111", 4) {}
+        RiscvAmoGeneric(icpu, "AMOSWAP_W", 4) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -193,7 +193,7 @@ public:
 class AMOADD_D : public RiscvAmoGeneric {
  public:
     AMOADD_D(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOADD_D", "00000????????????011?????0101111", 8) {}
+        RiscvAmoGeneric(icpu, "AMOADD_D", 8) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -204,7 +204,7 @@ class AMOADD_D : public RiscvAmoGeneric {
 class AMOXOR_D : public RiscvAmoGeneric {
 public:
     AMOXOR_D(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOXOR_D", "00100????????????011?????0101111", 8) {}
+        RiscvAmoGeneric(icpu, "AMOXOR_D", 8) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -215,7 +215,7 @@ public:
 class AMOOR_D : public RiscvAmoGeneric {
 public:
     AMOOR_D(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOOR_D", "01000????????????011?????0101111", 8) {}
+        RiscvAmoGeneric(icpu, "AMOOR_D", 8) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -226,7 +226,7 @@ public:
 class AMOAND_D : public RiscvAmoGeneric {
 public:
     AMOAND_D(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOAND_D", "01100????????????011?????0101111", 8) {}
+        RiscvAmoGeneric(icpu, "AMOAND_D", 8) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -237,7 +237,7 @@ public:
 class AMOMIN_D : public RiscvAmoGeneric {
 public:
     AMOMIN_D(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOMIN_D", "10000????????????011?????0101111", 8) {}
+        RiscvAmoGeneric(icpu, "AMOMIN_D", 8) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -250,7 +250,7 @@ public:
 class AMOMAX_D : public RiscvAmoGeneric {
 public:
     AMOMAX_D(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOMAX_D", "10100????????????011?????0101111", 8) {}
+        RiscvAmoGeneric(icpu, "AMOMAX_D", 8) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -263,7 +263,7 @@ public:
 class AMOMINU_D : public RiscvAmoGeneric {
 public:
     AMOMINU_D(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOMINU_D", "11000????????????011?????0101111", 8) {}
+        RiscvAmoGeneric(icpu, "AMOMINU_D", 8) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -274,7 +274,7 @@ public:
 class AMOMAXU_D : public RiscvAmoGeneric {
 public:
     AMOMAXU_D(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOMAXU_D", "11100????????????011?????0101111", 8) {}
+        RiscvAmoGeneric(icpu, "AMOMAXU_D", 8) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -285,7 +285,7 @@ public:
 class AMOSWAP_D : public RiscvAmoGeneric {
 public:
     AMOSWAP_D(CpuRiver_Functional *icpu) :
-        RiscvAmoGeneric(icpu, "AMOSWAP_D", "00001????????????011?????0101111", 8) {}
+        RiscvAmoGeneric(icpu, "AMOSWAP_D", 8) {}
 
  protected:
     virtual uint64_t amo_op(uint64_t a, uint64_t b) {
@@ -305,7 +305,7 @@ public:
 class LR_W : public RiscvInstruction {
 public:
     LR_W(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "LR_W", "00010??00000?????010?????0101111") {}
+        RiscvInstruction(icpu, "LR_W") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -337,7 +337,7 @@ public:
 class LR_D : public RiscvInstruction {
 public:
     LR_D(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "LR_D", "00010??00000?????011?????0101111") {}
+        RiscvInstruction(icpu, "LR_D") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -364,7 +364,7 @@ public:
 class SC_W : public RiscvInstruction {
 public:
     SC_W(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SC_W", "00011????????????010?????0101111") {}
+        RiscvInstruction(icpu, "SC_W") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -395,7 +395,7 @@ public:
 class SC_D : public RiscvInstruction {
 public:
     SC_D(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SC_D", "00011????????????011?????0101111") {}
+        RiscvInstruction(icpu, "SC_D") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -31,14 +31,7 @@ namespace debugger {
 class C_ADD : public RiscvInstruction16 {
 public:
     C_ADD(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_ADD", "????????????????1001??????????10") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload)
-                && u.bits.rdrs1 && u.bits.rs2;
-    }
+        "C_ADD") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CR_type u;
@@ -62,13 +55,7 @@ public:
 class C_ADDI : public RiscvInstruction16 {
 public:
     C_ADDI(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_ADDI", "????????????????000???????????01") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload) && u.bits.rdrs1;
-    }
+        "C_ADDI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CI_type u;
@@ -96,7 +83,7 @@ public:
 class C_ADDI16SP : public RiscvInstruction16 {
 public:
     C_ADDI16SP(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_ADDI16SP", "????????????????011?00010?????01") {}
+        "C_ADDI16SP") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CI_type u;
@@ -125,7 +112,7 @@ public:
 class C_ADDI4SPN : public RiscvInstruction16 {
 public:
     C_ADDI4SPN(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_ADDI4SPN", "????????????????000???????????00") {}
+        "C_ADDI4SPN") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CIW_type u;
@@ -150,13 +137,7 @@ public:
 class C_ADDIW : public RiscvInstruction16 {
 public:
     C_ADDIW(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_ADDIW", "????????????????001???????????01") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload) && u.bits.rdrs1;
-    }
+        "C_ADDIW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CI_type u;
@@ -186,7 +167,7 @@ public:
 class C_ADDW : public RiscvInstruction16 {
 public:
     C_ADDW(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_ADDW", "????????????????100111???01???01") {}
+        "C_ADDW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CS_type u;
@@ -213,7 +194,7 @@ public:
 class C_AND : public RiscvInstruction16 {
 public:
     C_AND(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_AND", "????????????????100011???11???01") {}
+        "C_AND") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CS_type u;
@@ -235,7 +216,7 @@ public:
 class C_ANDI : public RiscvInstruction16 {
 public:
     C_ANDI(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_ANDI", "????????????????100?10????????01") {}
+        "C_ANDI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CB_type u;
@@ -263,7 +244,7 @@ public:
 class C_BEQZ : public RiscvInstruction16 {
 public:
     C_BEQZ(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_BEQZ", "????????????????110???????????01") {}
+        "C_BEQZ") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CB_type u;
@@ -292,7 +273,7 @@ public:
 class C_BNEZ : public RiscvInstruction16 {
 public:
     C_BNEZ(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_BNEZ", "????????????????111???????????01") {}
+        "C_BNEZ") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CB_type u;
@@ -320,7 +301,7 @@ public:
 class C_EBREAK : public RiscvInstruction16 {
 public:
     C_EBREAK(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_EBREAK", "????????????????1001000000000010") {}
+        "C_EBREAK") {}
 
     virtual int exec(Reg64Type *payload) {
         icpu_->generateException(ICpuRiscV::EXCEPTION_Breakpoint, icpu_->getPC());
@@ -340,7 +321,7 @@ public:
 class C_J : public RiscvInstruction16 {
 public:
     C_J(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_J", "????????????????101???????????01") {}
+        "C_J") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CJ_type u;
@@ -369,7 +350,7 @@ public:
 class C_JAL : public RiscvInstruction16 {
 public:
     C_JAL(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_JAL", "????????????????001???????????01") {}
+        "C_JAL") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CJ_type u;
@@ -400,13 +381,7 @@ public:
 class C_JALR : public RiscvInstruction16 {
 public:
     C_JALR(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_JALR", "????????????????1001?????0000010") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload) && u.bits.rdrs1;
-    }
+        "C_JALR") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CR_type u;
@@ -427,13 +402,7 @@ public:
 class C_JR : public RiscvInstruction16 {
 public:
     C_JR(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_JR", "????????????????1000?????0000010") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload) && u.bits.rdrs1;
-    }
+        "C_JR") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CR_type u;
@@ -457,7 +426,7 @@ public:
 class C_LD : public RiscvInstruction16 {
 public:
     C_LD(CpuRiver_Functional *icpu) :
-        RiscvInstruction16(icpu, "C_LD", "????????????????011???????????00") {}
+        RiscvInstruction16(icpu, "C_LD") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -493,13 +462,7 @@ public:
 class C_LDSP : public RiscvInstruction16 {
 public:
     C_LDSP(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_LDSP", "????????????????011???????????10") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload) && u.bits.rdrs1;
-    }
+        "C_LDSP") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -533,13 +496,7 @@ public:
 class C_LI : public RiscvInstruction16 {
 public:
     C_LI(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_LI", "????????????????010???????????01") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload) && u.bits.rdrs1;
-    }
+        "C_LI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CI_type u;
@@ -564,7 +521,7 @@ public:
 class C_LW : public RiscvInstruction16 {
 public:
     C_LW(CpuRiver_Functional *icpu) :
-        RiscvInstruction16(icpu, "C_LW", "????????????????010???????????00") {}
+        RiscvInstruction16(icpu, "C_LW") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -604,13 +561,7 @@ public:
 class C_LWSP : public RiscvInstruction16 {
 public:
     C_LWSP(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_LWSP", "????????????????010???????????10") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload) && u.bits.rdrs1;
-    }
+        "C_LWSP") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -652,14 +603,7 @@ public:
 class C_LUI : public RiscvInstruction16 {
 public:
     C_LUI(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_LUI", "????????????????011???????????01") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload) && u.bits.rdrs1
-            && u.bits.rdrs1 != ICpuRiscV::Reg_sp;
-    }
+        "C_LUI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CI_type u;
@@ -684,14 +628,7 @@ public:
 class C_MV : public RiscvInstruction16 {
 public:
     C_MV(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_MV", "????????????????1000??????????10") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload)
-            && u.bits.rs2 && u.bits.rdrs1;
-    }
+        "C_MV") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CR_type u;
@@ -707,11 +644,7 @@ public:
 class C_NOP : public RiscvInstruction16 {
 public:
     C_NOP(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_NOP", "????????????????0000000000000001") {}
-
-    virtual bool parse(uint32_t *payload) {
-        return RiscvInstruction::parse(payload);
-    }
+        "C_NOP") {}
 
     virtual int exec(Reg64Type *payload) {
         return 2;
@@ -728,7 +661,7 @@ public:
 class C_OR : public RiscvInstruction16 {
 public:
     C_OR(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_OR", "????????????????100011???10???01") {}
+        "C_OR") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CS_type u;
@@ -751,7 +684,7 @@ public:
 class C_SD : public RiscvInstruction16 {
 public:
     C_SD(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_SD", "????????????????111???????????00") {}
+        "C_SD") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -786,7 +719,7 @@ public:
 class C_SDSP : public RiscvInstruction16 {
 public:
     C_SDSP(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_SDSP", "????????????????111???????????10") {}
+        "C_SDSP") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -824,13 +757,7 @@ public:
 class C_SLLI : public RiscvInstruction16 {
 public:
     C_SLLI(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_SLLI", "????????????????000???????????10") {}
-
-    virtual bool parse(uint32_t *payload) {
-        ISA_CR_type u;
-        u.value = static_cast<uint16_t>(payload[0]);
-        return RiscvInstruction::parse(payload) && u.bits.rdrs1;
-    }
+        "C_SLLI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CB_type u;
@@ -851,7 +778,7 @@ public:
 class C_SRAI : public RiscvInstruction16 {
 public:
     C_SRAI(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_SRAI", "????????????????100?01????????01") {}
+        "C_SRAI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CB_type u;
@@ -879,7 +806,7 @@ public:
 class C_SRLI : public RiscvInstruction16 {
 public:
     C_SRLI(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_SRLI", "????????????????100?00????????01") {}
+        "C_SRLI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CB_type u;
@@ -900,7 +827,7 @@ public:
 class C_SUB : public RiscvInstruction16 {
 public:
     C_SUB(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_SUB", "????????????????100011???00???01") {}
+        "C_SUB") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CS_type u;
@@ -921,7 +848,7 @@ public:
 class C_SUBW : public RiscvInstruction16 {
 public:
     C_SUBW(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_SUBW", "????????????????100111???00???01") {}
+        "C_SUBW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CS_type u;
@@ -948,7 +875,7 @@ public:
 class C_SW : public RiscvInstruction16 {
 public:
     C_SW(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_SW", "????????????????110???????????00") {}
+        "C_SW") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -982,7 +909,7 @@ public:
 class C_SWSP : public RiscvInstruction16 {
 public:
     C_SWSP(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_SWSP", "????????????????110???????????10") {}
+        "C_SWSP") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -1015,7 +942,7 @@ public:
 class C_XOR : public RiscvInstruction16 {
 public:
     C_XOR(CpuRiver_Functional *icpu) : RiscvInstruction16(icpu,
-        "C_XOR", "????????????????100011???01???01") {}
+        "C_XOR") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_CS_type u;
@@ -26,8 +26,8 @@ namespace debugger {
 
 class FpuInstruction : public RiscvInstruction {
  public:
-    FpuInstruction(CpuRiver_Functional *icpu, const char *name, const char *bits)
-        : RiscvInstruction(icpu, name, bits) {
+    FpuInstruction(CpuRiver_Functional *icpu, const char *name)
+        : RiscvInstruction(icpu, name) {
     }
 
  protected:
@@ -914,7 +914,7 @@ class FpuInstruction : public RiscvInstruction {
 class FADD_D : public FpuInstruction {
  public:
     FADD_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FADD_D", "0000001??????????????????1010011") {}
+        "FADD_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -937,7 +937,7 @@ class FADD_D : public FpuInstruction {
 class FCVT_D_L: public FpuInstruction {
  public:
     FCVT_D_L(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FCVT_D_L", "110100100010?????????????1010011") {}
+        "FCVT_D_L") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -957,7 +957,7 @@ class FCVT_D_L: public FpuInstruction {
 class FCVT_D_LU: public FpuInstruction {
  public:
     FCVT_D_LU(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FCVT_D_LU", "110100100011?????????????1010011") {}
+        "FCVT_D_LU") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -977,7 +977,7 @@ class FCVT_D_LU: public FpuInstruction {
 class FCVT_D_W: public FpuInstruction {
  public:
     FCVT_D_W(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FCVT_D_W", "110100100000?????????????1010011") {}
+        "FCVT_D_W") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -997,7 +997,7 @@ class FCVT_D_W: public FpuInstruction {
 class FCVT_D_WU: public FpuInstruction {
  public:
     FCVT_D_WU(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FCVT_D_WU", "110100100001?????????????1010011") {}
+        "FCVT_D_WU") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1017,7 +1017,7 @@ class FCVT_D_WU: public FpuInstruction {
 class FCVT_L_D: public FpuInstruction {
  public:
     FCVT_L_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FCVT_L_D", "110000100010?????????????1010011") {}
+        "FCVT_L_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1038,7 +1038,7 @@ class FCVT_L_D: public FpuInstruction {
 class FCVT_LU_D : public FpuInstruction {
  public:
     FCVT_LU_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FCVT_LU_D", "110000100011?????????????1010011") {}
+        "FCVT_LU_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1059,7 +1059,7 @@ class FCVT_LU_D : public FpuInstruction {
 class FCVT_W_D : public FpuInstruction {
  public:
     FCVT_W_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FCVT_W_D", "110000100000?????????????1010011") {}
+        "FCVT_W_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1080,7 +1080,7 @@ class FCVT_W_D : public FpuInstruction {
 class FCVT_WU_D : public FpuInstruction {
  public:
     FCVT_WU_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FCVT_WU_D", "110000100001?????????????1010011") {}
+        "FCVT_WU_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1101,7 +1101,7 @@ class FCVT_WU_D : public FpuInstruction {
 class FDIV_D : public FpuInstruction {
  public:
     FDIV_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FDIV_D", "0001101??????????????????1010011") {}
+        "FDIV_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1254,7 +1254,7 @@ class FDIV_D : public FpuInstruction {
 class FEQ_D : public FpuInstruction {
  public:
     FEQ_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FEQ_D", "1010001??????????010?????1010011") {}
+        "FEQ_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1286,7 +1286,7 @@ class FEQ_D : public FpuInstruction {
 class FLD : public FpuInstruction {
 public:
     FLD(CpuRiver_Functional *icpu) :
-        FpuInstruction(icpu, "FLD", "?????????????????011?????0000111") {}
+        FpuInstruction(icpu, "FLD") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -1320,7 +1320,7 @@ public:
 class FLE_D : public FpuInstruction {
  public:
     FLE_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FLE_D", "1010001??????????000?????1010011") {}
+        "FLE_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1352,7 +1352,7 @@ class FLE_D : public FpuInstruction {
 class FLT_D : public FpuInstruction {
  public:
     FLT_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FLT_D", "1010001??????????001?????1010011") {}
+        "FLT_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1384,7 +1384,7 @@ class FLT_D : public FpuInstruction {
 class FMAX_D : public FpuInstruction {
  public:
     FMAX_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FMAX_D", "0010101??????????001?????1010011") {}
+        "FMAX_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1406,7 +1406,7 @@ class FMAX_D : public FpuInstruction {
 class FMIN_D : public FpuInstruction {
  public:
     FMIN_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FMIN_D", "0010101??????????000?????1010011") {}
+        "FMIN_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1428,7 +1428,7 @@ class FMIN_D : public FpuInstruction {
 class FMOV_D_X : public FpuInstruction {
  public:
     FMOV_D_X(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FMOV_D_X", "111100100000?????000?????1010011") {}
+        "FMOV_D_X") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1446,7 +1446,7 @@ class FMOV_D_X : public FpuInstruction {
 class FMOV_X_D : public FpuInstruction {
  public:
     FMOV_X_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FMOV_X_D", "111000100000?????000?????1010011") {}
+        "FMOV_X_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1464,7 +1464,7 @@ class FMOV_X_D : public FpuInstruction {
 class FMUL_D : public FpuInstruction {
  public:
     FMUL_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FMUL_D", "0001001??????????????????1010011") {}
+        "FMUL_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1605,7 +1605,7 @@ class FMUL_D : public FpuInstruction {
 class FSD : public FpuInstruction {
 public:
     FSD(CpuRiver_Functional *icpu) :
-        FpuInstruction(icpu, "FSD", "?????????????????011?????0100111") {}
+        FpuInstruction(icpu, "FSD") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -1637,7 +1637,7 @@ public:
 class FSUB_D : public FpuInstruction {
  public:
     FSUB_D(CpuRiver_Functional *icpu) : FpuInstruction(icpu,
-        "FSUB_D", "0000101??????????????????1010011") {}
+        "FSUB_D") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -28,7 +28,7 @@ namespace debugger {
 class DIV : public RiscvInstruction {
  public:
     DIV(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "DIV", "0000001??????????100?????0110011") {}
+        : RiscvInstruction(icpu, "DIV") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -58,7 +58,7 @@ class DIV : public RiscvInstruction {
 class DIVU : public RiscvInstruction {
  public:
     DIVU(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "DIVU", "0000001??????????101?????0110011") {}
+        : RiscvInstruction(icpu, "DIVU") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -81,7 +81,7 @@ class DIVU : public RiscvInstruction {
 class DIVUW : public RiscvInstruction {
  public:
     DIVUW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "DIVUW", "0000001??????????101?????0111011") {}
+        RiscvInstruction(icpu, "DIVUW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -107,7 +107,7 @@ class DIVUW : public RiscvInstruction {
 class DIVW : public RiscvInstruction {
  public:
     DIVW(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "DIVW", "0000001??????????100?????0111011") {}
+        : RiscvInstruction(icpu, "DIVW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -144,7 +144,7 @@ class DIVW : public RiscvInstruction {
 class MUL : public RiscvInstruction {
  public:
     MUL(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "MUL", "0000001??????????000?????0110011") {}
+        : RiscvInstruction(icpu, "MUL") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -167,7 +167,7 @@ class MUL : public RiscvInstruction {
 class MULH : public RiscvInstruction {
  public:
     MULH(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "MULH", "0000001??????????001?????0110011") {}
+        : RiscvInstruction(icpu, "MULH") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -293,7 +293,7 @@ class MULH : public RiscvInstruction {
 class MULHSU : public RiscvInstruction {
  public:
     MULHSU(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "MULHSU", "0000001??????????010?????0110011") {}
+        : RiscvInstruction(icpu, "MULHSU") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -411,7 +411,7 @@ class MULHSU : public RiscvInstruction {
 class MULHU : public RiscvInstruction {
  public:
     MULHU(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "MULHU", "0000001??????????011?????0110011") {}
+        : RiscvInstruction(icpu, "MULHU") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -524,7 +524,7 @@ class MULHU : public RiscvInstruction {
 class MULW : public RiscvInstruction {
  public:
     MULW(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "MULW", "0000001??????????000?????0111011") {}
+        : RiscvInstruction(icpu, "MULW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -547,7 +547,7 @@ class MULW : public RiscvInstruction {
 class REM : public RiscvInstruction {
 public:
     REM(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "REM", "0000001??????????110?????0110011") {}
+        : RiscvInstruction(icpu, "REM") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -577,7 +577,7 @@ public:
 class REMU : public RiscvInstruction {
 public:
     REMU(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "REMU", "0000001??????????111?????0110011") {}
+        : RiscvInstruction(icpu, "REMU") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -604,7 +604,7 @@ public:
 class REMW : public RiscvInstruction {
 public:
     REMW(CpuRiver_Functional *icpu)
-        : RiscvInstruction(icpu, "REMW", "0000001??????????110?????0111011") {}
+        : RiscvInstruction(icpu, "REMW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -632,7 +632,7 @@ public:
 class REMUW : public RiscvInstruction {
 public:
     REMUW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "REMUW", "0000001??????????111?????0111011") {}
+        RiscvInstruction(icpu, "REMUW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
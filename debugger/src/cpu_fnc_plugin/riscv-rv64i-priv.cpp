@@ -34,7 +34,7 @@ namespace debugger {
 class CSRRC : public RiscvInstruction {
 public:
     CSRRC(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "CSRRC", "?????????????????011?????1110011") {}
+        RiscvInstruction(icpu, "CSRRC") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -60,7 +60,7 @@ public:
 class CSRRCI : public RiscvInstruction {
 public:
     CSRRCI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "CSRRCI", "?????????????????111?????1110011") {}
+        RiscvInstruction(icpu, "CSRRCI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -90,7 +90,7 @@ public:
 class CSRRS : public RiscvInstruction {
 public:
     CSRRS(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "CSRRS", "?????????????????010?????1110011") {}
+        RiscvInstruction(icpu, "CSRRS") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -116,7 +116,7 @@ public:
 class CSRRSI : public RiscvInstruction {
 public:
     CSRRSI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "CSRRSI", "?????????????????110?????1110011") {}
+        RiscvInstruction(icpu, "CSRRSI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -144,7 +144,7 @@ public:
 class CSRRW : public RiscvInstruction {
 public:
     CSRRW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "CSRRW", "?????????????????001?????1110011") {}
+        RiscvInstruction(icpu, "CSRRW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -169,7 +169,7 @@ public:
 class CSRRWI : public RiscvInstruction {
 public:
     CSRRWI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "CSRRWI", "?????????????????101?????1110011") {}
+        RiscvInstruction(icpu, "CSRRWI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -201,7 +201,7 @@ public:
 class URET : public RiscvInstruction {
 public:
     URET(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "URET", "00000000001000000000000001110011") {}
+        RiscvInstruction(icpu, "URET") {}
 
     virtual int exec(Reg64Type *payload) {
         if (icpu_->getPrvLevel() != ICpuRiscV::PRV_U) {
@@ -226,7 +226,7 @@ public:
 class SRET : public RiscvInstruction {
 public:
     SRET(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SRET", "00010000001000000000000001110011") {}
+        RiscvInstruction(icpu, "SRET") {}
 
     virtual int exec(Reg64Type *payload) {
         if (icpu_->getPrvLevel() != ICpuRiscV::PRV_S) {
@@ -255,7 +255,7 @@ public:
 class HRET : public RiscvInstruction {
 public:
     HRET(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "HRET", "00100000001000000000000001110011") {}
+        RiscvInstruction(icpu, "HRET") {}
 
     virtual int exec(Reg64Type *payload) {
         icpu_->generateException(ICpuRiscV::EXCEPTION_InstrIllegal, icpu_->getPC());
@@ -269,7 +269,7 @@ public:
 class MRET : public RiscvInstruction {
 public:
     MRET(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "MRET", "00110000001000000000000001110011") {}
+        RiscvInstruction(icpu, "MRET") {}
 
     virtual int exec(Reg64Type *payload) {
         if (icpu_->getPrvLevel() != ICpuRiscV::PRV_M) {
@@ -301,7 +301,7 @@ public:
 class FENCE : public RiscvInstruction {
 public:
     FENCE(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "FENCE", "?????????????????000?????0001111") {}
+        RiscvInstruction(icpu, "FENCE") {}
 
     virtual int exec(Reg64Type *payload) {
         return 4;
@@ -316,7 +316,7 @@ public:
 class FENCE_I : public RiscvInstruction {
 public:
     FENCE_I(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "FENCE_I", "?????????????????001?????0001111") {}
+        RiscvInstruction(icpu, "FENCE_I") {}
 
     virtual int exec(Reg64Type *payload) {
         return 4;
@@ -330,7 +330,7 @@ public:
 class SFENCE_VMA : public RiscvInstruction {
 public:
     SFENCE_VMA(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SFENCE_VMA", "0001001??????????000000001110011") {}
+        RiscvInstruction(icpu, "SFENCE_VMA") {}
 
     virtual int exec(Reg64Type *payload) {
         icpu_->flushMmu();
@@ -347,7 +347,7 @@ public:
 class EBREAK : public RiscvInstruction {
 public:
     EBREAK(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "EBREAK", "00000000000100000000000001110011") {}
+        RiscvInstruction(icpu, "EBREAK") {}
 
     virtual int exec(Reg64Type *payload) {
         icpu_->generateException(ICpuRiscV::EXCEPTION_Breakpoint, icpu_->getPC());
@@ -367,7 +367,7 @@ public:
 class ECALL : public RiscvInstruction {
 public:
     ECALL(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "ECALL", "00000000000000000000000001110011") {}
+        RiscvInstruction(icpu, "ECALL") {}
 
     virtual int exec(Reg64Type *payload) {
         switch (icpu_->getPrvLevel()) {
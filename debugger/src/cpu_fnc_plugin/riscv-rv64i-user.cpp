@@ -28,7 +28,7 @@ namespace debugger {
 class ADD : public RiscvInstruction {
 public:
     ADD(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "ADD", "0000000??????????000?????0110011") {}
+        RiscvInstruction(icpu, "ADD") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -49,7 +49,7 @@ public:
 class ADDI : public RiscvInstruction {
 public:
     ADDI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "ADDI", "?????????????????000?????0010011") {}
+        RiscvInstruction(icpu, "ADDI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -77,7 +77,7 @@ public:
 class ADDIW : public RiscvInstruction {
 public:
     ADDIW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "ADDIW", "?????????????????000?????0011011") {}
+        RiscvInstruction(icpu, "ADDIW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -107,7 +107,7 @@ public:
 class ADDW : public RiscvInstruction {
 public:
     ADDW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "ADDW", "0000000??????????000?????0111011") {}
+        RiscvInstruction(icpu, "ADDW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -128,7 +128,7 @@ public:
 class AND : public RiscvInstruction {
 public:
     AND(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "AND", "0000000??????????111?????0110011") {}
+        RiscvInstruction(icpu, "AND") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -148,7 +148,7 @@ public:
 class ANDI : public RiscvInstruction {
 public:
     ANDI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "ANDI", "?????????????????111?????0010011") {}
+        RiscvInstruction(icpu, "ANDI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -174,7 +174,7 @@ public:
 class AUIPC : public RiscvInstruction {
 public:
     AUIPC(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "AUIPC", "?????????????????????????0010111") {}
+        RiscvInstruction(icpu, "AUIPC") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_U_type u;
@@ -195,7 +195,7 @@ public:
 class BEQ : public RiscvInstruction {
 public:
     BEQ(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "BEQ", "?????????????????000?????1100011") {}
+        RiscvInstruction(icpu, "BEQ") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_SB_type u;
@@ -224,7 +224,7 @@ public:
 class BGE : public RiscvInstruction {
 public:
     BGE(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "BGE", "?????????????????101?????1100011") {}
+        RiscvInstruction(icpu, "BGE") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_SB_type u;
@@ -250,7 +250,7 @@ public:
 class BGEU : public RiscvInstruction {
 public:
     BGEU(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "BGEU", "?????????????????111?????1100011") {}
+        RiscvInstruction(icpu, "BGEU") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_SB_type u;
@@ -274,7 +274,7 @@ public:
 class BLT : public RiscvInstruction {
 public:
     BLT(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "BLT", "?????????????????100?????1100011") {}
+        RiscvInstruction(icpu, "BLT") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_SB_type u;
@@ -299,7 +299,7 @@ public:
 class BLTU : public RiscvInstruction {
 public:
     BLTU(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "BLTU", "?????????????????110?????1100011") {}
+        RiscvInstruction(icpu, "BLTU") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_SB_type u;
@@ -323,7 +323,7 @@ public:
 class BNE : public RiscvInstruction {
 public:
     BNE(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "BNE", "?????????????????001?????1100011") {}
+        RiscvInstruction(icpu, "BNE") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_SB_type u;
@@ -355,7 +355,7 @@ public:
 class JAL : public RiscvInstruction {
 public:
     JAL(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "JAL", "?????????????????????????1101111") {}
+        RiscvInstruction(icpu, "JAL") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_UJ_type u;
@@ -390,7 +390,7 @@ public:
 class JALR : public RiscvInstruction {
 public:
     JALR(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "JALR", "?????????????????000?????1100111") {}
+        RiscvInstruction(icpu, "JALR") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -429,7 +429,7 @@ public:
 class LD : public RiscvInstruction {
 public:
     LD(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "LD", "?????????????????011?????0000011") {}
+        RiscvInstruction(icpu, "LD") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -461,7 +461,7 @@ public:
 class LW : public RiscvInstruction {
 public:
     LW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "LW", "?????????????????010?????0000011") {}
+        RiscvInstruction(icpu, "LW") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -498,7 +498,7 @@ public:
 class LWU : public RiscvInstruction {
 public:
     LWU(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "LWU", "?????????????????110?????0000011") {}
+        RiscvInstruction(icpu, "LWU") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -531,7 +531,7 @@ public:
 class LH : public RiscvInstruction {
 public:
     LH(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "LH", "?????????????????001?????0000011") {}
+        RiscvInstruction(icpu, "LH") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -568,7 +568,7 @@ public:
 class LHU : public RiscvInstruction {
 public:
     LHU(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "LHU", "?????????????????101?????0000011") {}
+        RiscvInstruction(icpu, "LHU") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -601,7 +601,7 @@ public:
 class LB : public RiscvInstruction {
 public:
     LB(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "LB", "?????????????????000?????0000011") {}
+        RiscvInstruction(icpu, "LB") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -633,7 +633,7 @@ public:
 class LBU : public RiscvInstruction {
 public:
     LBU(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "LBU", "?????????????????100?????0000011") {}
+        RiscvInstruction(icpu, "LBU") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -665,7 +665,7 @@ public:
 class LUI : public RiscvInstruction {
 public:
     LUI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "LUI", "?????????????????????????0110111") {}
+        RiscvInstruction(icpu, "LUI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_U_type u;
@@ -685,7 +685,7 @@ public:
 class OR : public RiscvInstruction {
 public:
     OR(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "OR", "0000000??????????110?????0110011") {}
+        RiscvInstruction(icpu, "OR") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -701,7 +701,7 @@ public:
 class ORI : public RiscvInstruction {
 public:
     ORI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "ORI", "?????????????????110?????0010011") {}
+        RiscvInstruction(icpu, "ORI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -722,7 +722,7 @@ public:
 class SLLI : public RiscvInstruction {
 public:
     SLLI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SLLI", "000000???????????001?????0010011") {}
+        RiscvInstruction(icpu, "SLLI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -741,7 +741,7 @@ public:
 class SLT : public RiscvInstruction {
 public:
     SLT(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SLT", "0000000??????????010?????0110011") {}
+        RiscvInstruction(icpu, "SLT") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -768,7 +768,7 @@ public:
 class SLTI : public RiscvInstruction {
 public:
     SLTI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SLTI", "?????????????????010?????0010011") {}
+        RiscvInstruction(icpu, "SLTI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -800,7 +800,7 @@ public:
 class SLTU : public RiscvInstruction {
 public:
     SLTU(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SLTU", "0000000??????????011?????0110011") {}
+        RiscvInstruction(icpu, "SLTU") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -827,7 +827,7 @@ public:
 class SLTIU : public RiscvInstruction {
 public:
     SLTIU(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SLTIU", "?????????????????011?????0010011") {}
+        RiscvInstruction(icpu, "SLTIU") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -854,7 +854,7 @@ public:
 class SLL : public RiscvInstruction {
 public:
     SLL(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SLL", "0000000??????????001?????0110011") {}
+        RiscvInstruction(icpu, "SLL") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -870,7 +870,7 @@ public:
 class SLLW : public RiscvInstruction {
 public:
     SLLW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SLLW", "0000000??????????001?????0111011") {}
+        RiscvInstruction(icpu, "SLLW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -896,7 +896,7 @@ public:
 class SLLIW : public RiscvInstruction {
 public:
     SLLIW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SLLIW", "0000000??????????001?????0011011") {}
+        RiscvInstruction(icpu, "SLLIW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -922,7 +922,7 @@ public:
 class SRA : public RiscvInstruction {
 public:
     SRA(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SRA", "0100000??????????101?????0110011") {}
+        RiscvInstruction(icpu, "SRA") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -939,7 +939,7 @@ public:
 class SRAW : public RiscvInstruction {
 public:
     SRAW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SRAW", "0100000??????????101?????0111011") {}
+        RiscvInstruction(icpu, "SRAW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -960,7 +960,7 @@ public:
 class SRAI : public RiscvInstruction {
 public:
     SRAI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SRAI", "010000???????????101?????0010011") {}
+        RiscvInstruction(icpu, "SRAI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -977,7 +977,7 @@ public:
 class SRAIW : public RiscvInstruction {
 public:
     SRAIW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SRAIW", "0100000??????????101?????0011011") {}
+        RiscvInstruction(icpu, "SRAIW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -999,7 +999,7 @@ public:
 class SRL : public RiscvInstruction {
 public:
     SRL(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SRL", "0000000??????????101?????0110011") {}
+        RiscvInstruction(icpu, "SRL") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1015,7 +1015,7 @@ public:
 class SRLI : public RiscvInstruction {
 public:
     SRLI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SRLI", "000000???????????101?????0010011") {}
+        RiscvInstruction(icpu, "SRLI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -1032,7 +1032,7 @@ public:
 class SRLIW : public RiscvInstruction {
 public:
     SRLIW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SRLIW", "0000000??????????101?????0011011") {}
+        RiscvInstruction(icpu, "SRLIW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -1051,7 +1051,7 @@ public:
 class SRLW : public RiscvInstruction {
 public:
     SRLW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SRLW", "0000000??????????101?????0111011") {}
+        RiscvInstruction(icpu, "SRLW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1079,7 +1079,7 @@ public:
 class SD : public RiscvInstruction {
 public:
     SD(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SD", "?????????????????011?????0100011") {}
+        RiscvInstruction(icpu, "SD") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -1111,7 +1111,7 @@ public:
 class SW : public RiscvInstruction {
 public:
     SW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SW", "?????????????????010?????0100011") {}
+        RiscvInstruction(icpu, "SW") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -1144,7 +1144,7 @@ public:
 class SH : public RiscvInstruction {
 public:
     SH(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SH", "?????????????????001?????0100011") {}
+        RiscvInstruction(icpu, "SH") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -1177,7 +1177,7 @@ public:
 class SB : public RiscvInstruction {
 public:
     SB(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SB", "?????????????????000?????0100011") {}
+        RiscvInstruction(icpu, "SB") {}
 
     virtual int exec(Reg64Type *payload) {
         Axi4TransactionType trans;
@@ -1206,7 +1206,7 @@ public:
 class SUB : public RiscvInstruction {
 public:
     SUB(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SUB", "0100000??????????000?????0110011") {}
+        RiscvInstruction(icpu, "SUB") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1227,7 +1227,7 @@ public:
 class SUBW : public RiscvInstruction {
 public:
     SUBW(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "SUBW", "0100000??????????000?????0111011") {}
+        RiscvInstruction(icpu, "SUBW") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1249,7 +1249,7 @@ public:
 class XOR : public RiscvInstruction {
 public:
     XOR(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "XOR", "0000000??????????100?????0110011") {}
+        RiscvInstruction(icpu, "XOR") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_R_type u;
@@ -1268,7 +1268,7 @@ public:
 class XORI : public RiscvInstruction {
 public:
     XORI(CpuRiver_Functional *icpu) :
-        RiscvInstruction(icpu, "XORI", "?????????????????100?????0010011") {}
+        RiscvInstruction(icpu, "XORI") {}
 
     virtual int exec(Reg64Type *payload) {
         ISA_I_type u;
@@ -0,0 +1,362 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <string.h>
+#include "river_timing.h"
+
+namespace debugger {
+
+void CacheTagModel::configure(int log2_nways, int log2_lines_per_way,
+                              int lnbits) {
+    log2_lines_ = log2_lines_per_way;
+    nways_ = 1 << log2_nways;
+    lnbits_ = lnbits;
+    tags_.resize(static_cast<size_t>(nways_) << log2_lines_);
+    invalidate();
+}
+
+void CacheTagModel::invalidate() {
+    for (size_t i = 0; i < tags_.size(); i++) {
+        tags_[i] = 0;
+    }
+}
+
+bool CacheTagModel::access(uint64_t addr, bool write, bool *evict_dirty) {
+    uint64_t line = addr >> lnbits_;
+    uint64_t set = line & ((1ull << log2_lines_) - 1);
+    uint64_t tag = ((line >> log2_lines_) << 2) | 0x1;
+    uint64_t *p = &tags_[set * nways_];
+    bool hit = false;
+    int i;
+
+    *evict_dirty = false;
+    for (i = 0; i < nways_; i++) {
+        if ((p[i] | 0x2) == (tag | 0x2)) {
+            hit = true;
+            tag = p[i];
+            break;
+        }
+    }
+    if (!hit) {
+        // Replace the least recently used way
+        i = nways_ - 1;
+        *evict_dirty = (p[i] & 0x3) == 0x3;
+    }
+    if (write) {
+        tag |= 0x2;
+    }
+    memmove(&p[1], &p[0], i * sizeof(uint64_t));
+    p[0] = tag;
+    return hit;
+}
+
+RiverTimingModel::RiverTimingModel() {
+    latency_[Class_Alu] = 1;
+    latency_[Class_Mul] = 4;
+    latency_[Class_Div] = 34;
+    latency_[Class_Load] = 1;
+    latency_[Class_Store] = 1;
+    latency_[Class_Amo] = 4;
+    latency_[Class_Csr] = 4;
+    latency_[Class_Fence] = 4;
+    latency_[Class_FenceI] = 8;
+    latency_[Class_Branch] = 1;
+    latency_[Class_Jal] = 1;
+    latency_[Class_Jalr] = 1;
+    latency_[Class_Fpu] = 6;
+    latency_[Class_FpuLong] = 60;
+    latency_[Class_FpuShort] = 2;
+    l2latency_ = 8;
+    memlatency_ = 30;
+    cycles_ = 0;
+    classify();
+    reset();
+}
+
+void RiverTimingModel::configure(const int icache[2], const int dcache[2],
+                                 const int l2cache[2],
+                                 int l2latency, int memlatency) {
+    icache_.configure(icache[0], icache[1], LINE_BITS);
+    dcache_.configure(dcache[0], dcache[1], LINE_BITS);
+    l2cache_.configure(l2cache[0], l2cache[1], LINE_BITS);
+    l2latency_ = l2latency;
+    memlatency_ = memlatency;
+}
+
+void RiverTimingModel::reset() {
+    btbTotal_ = 0;
+    prevValid_ = false;
+    prevPc_ = 0;
+    prevNpcSeq_ = 0;
+    prevNpcPredicted_ = 0;
+    loadRd_ = 0;
+    icache_.invalidate();
+    dcache_.invalidate();
+    l2cache_.invalidate();
+}
+
+static const char *const LOAD_LIST[] = {
+    "LD", "LW", "LWU", "LH", "LHU", "LB", "LBU",
+    "C_LD", "C_LDSP", "C_LW", "C_LWSP", "FLD", 0
+};
+
+static const char *const STORE_LIST[] = {
+    "SD", "SW", "SH", "SB", "C_SD", "C_SDSP", "C_SW", "C_SWSP", "FSD", 0
+};
+
+static const char *const CSR_LIST[] = {
+    "CSRRC", "CSRRCI", "CSRRS", "CSRRSI", "CSRRW", "CSRRWI",
+    "URET", "SRET", "HRET", "MRET", "ECALL", "EBREAK", "C_EBREAK", 0
+};
+
+static bool is_in_list(const char *name, const char *const *list) {
+    for (; *list; list++) {
+        if (strcmp(name, *list) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RiverTimingModel::classify() {
+    for (int i = 0; i < RISCV_ENCODINGS_MAX; i++) {
+        iclass_[i] = Class_Alu;
+    }
+    for (int i = 0; i < RISCV_ENCODINGS_TOTAL; i++) {
+        const char *s = RISCV_ENCODINGS[i].name;
+        uint8_t c = Class_Alu;
+        if (is_in_list(s, LOAD_LIST)) {
+            c = Class_Load;
+        } else if (is_in_list(s, STORE_LIST)) {
+            c = Class_Store;
+        } else if (is_in_list(s, CSR_LIST)) {
+            c = Class_Csr;
+        } else if (strncmp(s, "MUL", 3) == 0) {
+            c = Class_Mul;
+        } else if (strncmp(s, "DIV", 3) == 0 || strncmp(s, "REM", 3) == 0) {
+            c = Class_Div;
+        } else if (strncmp(s, "AMO", 3) == 0 || strncmp(s, "LR_", 3) == 0
+                || strncmp(s, "SC_", 3) == 0) {
+            c = Class_Amo;
+        } else if (strcmp(s, "FENCE_I") == 0) {
+            c = Class_FenceI;
+        } else if (strcmp(s, "FENCE") == 0 || strcmp(s, "SFENCE_VMA") == 0) {
+            c = Class_Fence;
+        } else if (s[0] == 'B' || strcmp(s, "C_BEQZ") == 0
+                || strcmp(s, "C_BNEZ") == 0) {
+            c = Class_Branch;
+        } else if (strcmp(s, "JAL") == 0 || strcmp(s, "C_J") == 0
+                || strcmp(s, "C_JAL") == 0) {
+            c = Class_Jal;
+        } else if (strcmp(s, "JALR") == 0 || strcmp(s, "C_JR") == 0
+                || strcmp(s, "C_JALR") == 0) {
+            c = Class_Jalr;
+        } else if (strcmp(s, "FDIV_D") == 0 || strcmp(s, "FSQRT_D") == 0) {
+            c = Class_FpuLong;
+        } else if (strncmp(s, "FADD", 4) == 0 || strncmp(s, "FSUB", 4) == 0
+                || strncmp(s, "FMUL", 4) == 0 || strncmp(s, "FCVT", 4) == 0) {
+            c = Class_Fpu;
+        } else if (s[0] == 'F') {
+            c = Class_FpuShort;
+        }
+        iclass_[i] = c;
+    }
+}
+
+bool RiverTimingModel::isCached(uint64_t addr) {
+    // Hardcoded uncached regions of the River PMA: CLINT, PLIC, IO1
+    if ((addr & ~0xFFFFull) == 0x02000000ull
+        || (addr & ~0x03FFFFFFull) == 0x0C000000ull
+        || (addr & ~0xFFFFFull) == 0x10000000ull) {
+        return false;
+    }
+    return true;
+}
+
+uint64_t RiverTimingModel::memAccess(uint64_t addr, bool write) {
+    bool evict;
+    uint64_t t = l2latency_;
+    if (!l2cache_.access(addr, write, &evict)) {
+        t += memlatency_;
+        if (evict) {
+            t += memlatency_;
+        }
+    }
+    return t;
+}
+
+void RiverTimingModel::dataAccess(uint64_t addr, bool write) {
+    bool evict;
+    if (!isCached(addr)) {
+        cycles_ += IO_LATENCY;
+        return;
+    }
+    if (!dcache_.access(addr, write, &evict)) {
+        cycles_ += memAccess(addr, false);
+        if (evict) {
+            cycles_ += l2latency_;
+        }
+    }
+}
+
+uint64_t RiverTimingModel::predict(uint64_t pc, uint32_t code, uint64_t ra) {
+    uint64_t off;
+    for (int i = 0; i < btbTotal_; i++) {
+        if (btb_[i].pc == pc) {
+            return btb_[i].npc;
+        }
+    }
+    // Pre-decoder: jal, backward branches, c.j and c.ret
+    if ((code & 0x3) == 0x3) {
+        if ((code & 0x7F) == 0x6F) {
+            off = ((code >> 20) & 0x7FE) | ((code >> 9) & 0x800)
+                | (code & 0xFF000);
+            if (code & 0x80000000) {
+                off |= ~0xFFFFFull;
+            }
+            return pc + off;
+        }
+        if ((code & 0x7F) == 0x63 && (code & 0x80000000)) {
+            off = ((code >> 20) & 0x7E0) | ((code >> 7) & 0x1E)
+                | ((code << 4) & 0x800) | ~0xFFFull;
+            return pc + off;
+        }
+        return pc + 4;
+    }
+    if (((code >> 13) & 0x7) == 0x5 && (code & 0x3) == 0x1) {
+        off = ((code >> 1) & 0x800) | ((code << 2) & 0x400)
+            | ((code >> 1) & 0x300) | ((code << 1) & 0x80)
+            | ((code >> 1) & 0x40) | ((code << 3) & 0x20)
+            | ((code >> 7) & 0x10) | ((code >> 2) & 0xE);
+        if (off & 0x800) {
+            off |= ~0x7FFull;
+        }
+        return pc + off;
+    }
+    if ((code & 0xFFFF) == 0x8082) {
+        return ra;
+    }
+    return pc + 2;
+}
+
+void RiverTimingModel::updateBtb(uint64_t pc, uint64_t npc) {
+    int i;
+    for (i = 0; i < btbTotal_; i++) {
+        if (btb_[i].pc == pc) {
+            break;
+        }
+    }
+    if (i == btbTotal_) {
+        if (btbTotal_ < BTB_SIZE) {
+            btbTotal_++;
+        } else {
+            i = BTB_SIZE - 1;
+        }
+    }
+    memmove(&btb_[1], &btb_[0], i * sizeof(BtbEntryType));
+    btb_[0].pc = pc;
+    btb_[0].npc = npc;
+}
+
+bool RiverTimingModel::readsReg(uint32_t code, int r) {
+    uint32_t op = code & 0x7F;
+    int rs1 = (code >> 15) & 0x1F;
+    int rs2 = (code >> 20) & 0x1F;
+    int f3 = (code >> 13) & 0x7;
+    if ((code & 0x3) == 0x3) {
+        if (op == 0x37 || op == 0x17 || op == 0x6F) {
+            return false;
+        }
+        if (op == 0x33 || op == 0x3B || op == 0x23
+            || op == 0x63 || op == 0x2F) {
+            return rs1 == r || rs2 == r;
+        }
+        return rs1 == r;
+    }
+    int c_rd = (code >> 7) & 0x1F;
+    int c_rs2 = (code >> 2) & 0x1F;
+    int c_rs1p = 8 + ((code >> 7) & 0x7);
+    int c_rs2p = 8 + ((code >> 2) & 0x7);
+    switch (code & 0x3) {
+    case 0:
+        return c_rs1p == r || (f3 >= 5 && c_rs2p == r) || (f3 == 0 && r == 2);
+    case 1:
+        if (f3 <= 3) {
+            return c_rd == r;
+        }
+        if (f3 == 4) {
+            return c_rs1p == r || c_rs2p == r;
+        }
+        return f3 != 5 && c_rs1p == r;
+    default:
+        if (f3 == 0 || f3 == 4) {
+            return c_rd == r || c_rs2 == r;
+        }
+        return r == 2 || (f3 >= 5 && c_rs2 == r);
+    }
+}
+
+void RiverTimingModel::instruction(uint64_t pc, uint32_t code, int idx,
+                                   uint64_t ra) {
+    bool evict;
+    int cls = Class_Alu;
+    uint64_t len = (code & 0x3) == 0x3 ? 4 : 2;
+
+    if (prevValid_) {
+        if (pc != prevNpcPredicted_) {
+            cycles_ += MISPREDICT_PENALTY;
+        }
+        if (pc != prevNpcSeq_) {
+            updateBtb(prevPc_, pc);
+        }
+    }
+
+    if (!isCached(pc)) {
+        cycles_ += IO_LATENCY;
+    } else if (!icache_.access(pc, false, &evict)) {
+        cycles_ += memAccess(pc, false);
+    }
+
+    if (idx >= 0) {
+        cls = iclass_[idx];
+    }
+    if (loadRd_ && readsReg(code, loadRd_)) {
+        cycles_ += LOAD_USE_PENALTY;
+    }
+    cycles_ += latency_[cls];
+
+    loadRd_ = 0;
+    if (cls == Class_Load) {
+        if (len == 4) {
+            if ((code & 0x7F) == 0x03) {
+                loadRd_ = (code >> 7) & 0x1F;
+            }
+        } else if ((code & 0x3) == 0) {
+            loadRd_ = 8 + ((code >> 2) & 0x7);
+        } else {
+            loadRd_ = (code >> 7) & 0x1F;
+        }
+    } else if (cls == Class_FenceI) {
+        icache_.invalidate();
+    }
+
+    prevValid_ = true;
+    prevPc_ = pc;
+    prevNpcSeq_ = pc + len;
+    prevNpcPredicted_ = predict(pc, code, ra);
+}
+
+}  // namespace debugger
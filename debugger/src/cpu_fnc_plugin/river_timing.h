@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef __DEBUGGER_SRC_CPU_FNC_PLUGIN_RIVER_TIMING_H__
+#define __DEBUGGER_SRC_CPU_FNC_PLUGIN_RIVER_TIMING_H__
+
+#include <inttypes.h>
+#include <vector>
+#include "generic/riscv_decoder.h"
+
+namespace debugger {
+
+/**
+ * @brief Tags only model of the set-associative cache with LRU replacement.
+ */
+class CacheTagModel {
+ public:
+    CacheTagModel() : log2_lines_(0), nways_(0), lnbits_(5) {}
+
+    void configure(int log2_nways, int log2_lines_per_way, int lnbits);
+    void invalidate();
+    /** @return true on hit, *evict_dirty is set when dirty line was replaced */
+    bool access(uint64_t addr, bool write, bool *evict_dirty);
+
+ private:
+    int log2_lines_;
+    int nways_;
+    int lnbits_;
+    std::vector<uint64_t> tags_;    // [set][way] in MRU order, bit[0] valid, bit[1] dirty
+};
+
+/**
+ * @brief Cycle-approximate model of the River pipeline.
+ *
+ * Instructions are accounted at the decode stage: the previous instruction
+ * branch prediction is checked against the current pc, the current
+ * instruction is fetched via I$ model and its latency is added. Data
+ * accesses go through the D$ and L2 models. Latencies approximate the
+ * River RTL with the default configuration (river_cfg.h).
+ */
+class RiverTimingModel {
+ public:
+    RiverTimingModel();
+
+    void configure(const int icache[2], const int dcache[2],
+                   const int l2cache[2], int l2latency, int memlatency);
+    /** Clear caches and predictor, cycles counter is a time base and continues */
+    void reset();
+
+    void instruction(uint64_t pc, uint32_t code, int idx, uint64_t ra);
+    void dataAccess(uint64_t addr, bool write);
+    void flushICache() { icache_.invalidate(); }
+    void addCycles(uint64_t t) { cycles_ += t; }
+
+    uint64_t getCycles() { return cycles_; }
+
+ private:
+    enum EInstrClass {
+        Class_Alu,
+        Class_Mul,
+        Class_Div,
+        Class_Load,
+        Class_Store,
+        Class_Amo,
+        Class_Csr,
+        Class_Fence,
+        Class_FenceI,
+        Class_Branch,
+        Class_Jal,
+        Class_Jalr,
+        Class_Fpu,
+        Class_FpuLong,
+        Class_FpuShort,
+        Class_Total
+    };
+
+    static const int BTB_SIZE = 8;              // CFG_BTB_SIZE
+    static const int LINE_BITS = 5;             // 32 bytes per L1/L2 line
+    static const int MISPREDICT_PENALTY = 4;    // refetch through the pipeline
+    static const int LOAD_USE_PENALTY = 2;      // memaccess writeback latency
+    static const int IO_LATENCY = 10;           // uncached access via System Bus
+
+    void classify();
+    uint64_t memAccess(uint64_t addr, bool write);
+    bool isCached(uint64_t addr);
+    uint64_t predict(uint64_t pc, uint32_t code, uint64_t ra);
+    void updateBtb(uint64_t pc, uint64_t npc);
+    bool readsReg(uint32_t code, int r);
+
+    uint64_t cycles_;
+    uint8_t iclass_[RISCV_ENCODINGS_MAX];
+    int latency_[Class_Total];
+    int l2latency_;
+    int memlatency_;
+
+    CacheTagModel icache_;
+    CacheTagModel dcache_;
+    CacheTagModel l2cache_;
+
+    struct BtbEntryType {
+        uint64_t pc;
+        uint64_t npc;
+    } btb_[BTB_SIZE];
+    int btbTotal_;
+
+    bool prevValid_;
+    uint64_t prevPc_;
+    uint64_t prevNpcSeq_;       // pc + instruction length
+    uint64_t prevNpcPredicted_;
+    int loadRd_;                // destination of previous load or 0
+};
+
+}  // namespace debugger
+
+#endif  // __DEBUGGER_SRC_CPU_FNC_PLUGIN_RIVER_TIMING_H__
@@ -82,7 +82,7 @@ void BusSlave::registers() {
     }
 
     if (i_apbo.read().pready) {
-        i_apbo.read().prdata;
+        bus_resp_data_ = i_apbo.read().prdata;
         // We cannot get here without valid request no need additional checks
         lasttrans_.rpayload.b32[0] = bus_resp_data_;
         lastcb_->nb_response(&lasttrans_);
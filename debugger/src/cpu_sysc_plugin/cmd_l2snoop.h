@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "api_core.h"
+#include "iservice.h"
+#include "coreservices/icommand.h"
+#include "riverlib/workgroup.h"
+
+namespace debugger {
+
+/** Console access to the L2 snoop filter counters */
+class CmdL2Snoop : public ICommand {
+ public:
+    CmdL2Snoop(IService *parent, Workgroup *group)
+        : ICommand(parent, "l2snoop"), group_(group) {
+        briefDescr_.make_string("L2 snoop statistic per L1 slot");
+        detailedDescr_.make_string(
+            "Description:\n"
+            "    Read or clear snoop counters of the L2 destination: snoop\n"
+            "    requests sent to L1, responses with and without data,\n"
+            "    invalidations of the unique requests, data written back\n"
+            "    through the snoop channel and requests removed by the\n"
+            "    snoop filter.\n"
+            "Response:\n"
+            "    List of dictionaries, one per L1 slot\n"
+            "Usage:\n"
+            "    l2snoop\n"
+            "    l2snoop clear\n");
+    }
+
+    /** ICommand */
+    virtual int isValid(AttributeType *args) {
+        if (!cmdName_.is_equal((*args)[0u].to_string())) {
+            return CMD_INVALID;
+        }
+        if (args->size() == 1
+            || (args->size() == 2 && (*args)[1].is_equal("clear"))) {
+            return CMD_VALID;
+        }
+        return CMD_WRONG_ARGS;
+    }
+
+    virtual void exec(AttributeType *args, AttributeType *res) {
+        L2Destination::SnoopStatType st;
+        res->make_nil();
+        if (args->size() == 2) {
+            group_->clearSnoopStat();
+            return;
+        }
+        res->make_list(0);
+        for (int i = 0; i < CFG_SLOT_L1_TOTAL; i++) {
+            if (!group_->getSnoopStat(i, &st)) {
+                break;
+            }
+            AttributeType item;
+            item.make_dict();
+            item["Slot"].make_int64(i);
+            item["Requests"].make_uint64(st.requests);
+            item["Hits"].make_uint64(st.hits);
+            item["Misses"].make_uint64(st.misses);
+            item["Invalidations"].make_uint64(st.invalidations);
+            item["Writebacks"].make_uint64(st.writebacks);
+            item["Filtered"].make_uint64(st.filtered);
+            res->add_to_list(&item);
+        }
+    }
+
+ private:
+    Workgroup *group_;
+};
+
+}  // namespace debugger
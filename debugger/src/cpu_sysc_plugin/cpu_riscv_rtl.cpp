@@ -36,11 +36,33 @@ CpuRiscV_RTL::CpuRiscV_RTL(const char *name)
     registerAttribute("FreqHz", &freqHz_);
     registerAttribute("InVcdFile", &InVcdFile_);
     registerAttribute("OutVcdFile", &OutVcdFile_);
+    registerAttribute("VcdFilter", &vcdFilter_);
+    registerAttribute("VcdStart", &vcdStart_);
+    registerAttribute("VcdStop", &vcdStop_);
+    registerAttribute("VcdPreTrigger", &vcdPreTrigger_);
+    registerAttribute("VcdPostTrigger", &vcdPostTrigger_);
+    registerAttribute("MemRegions", &memRegions_);
+    registerAttribute("MemDdr", &memDdr_);
+    registerAttribute("MemOutstanding", &memOutstanding_);
+    registerAttribute("MemBandwidthWindow", &memBandwidthWindow_);
 
     bus_.make_string("");
     freqHz_.make_uint64(1);
     InVcdFile_.make_string("");
     OutVcdFile_.make_string("");
+    vcdFilter_.make_list(0);
+    vcdStart_.make_list(0);
+    vcdStop_.make_list(0);
+    vcdPreTrigger_.make_int64(0);
+    vcdPostTrigger_.make_int64(0);
+    memRegions_.make_list(0);
+    memDdr_.make_list(0);
+    memOutstanding_.make_int64(4);
+    memBandwidthWindow_.make_int64(1000);
+    vcdcap_ = 0;
+    memtiming_ = 0;
+    pcmdMemTiming_ = 0;
+    pcmdL2Snoop_ = 0;
     RISCV_event_create(&config_done_, "riscv_sysc_config_done");
     RISCV_register_hap(static_cast<IHap *>(this));
 }
@@ -95,13 +117,47 @@ void CpuRiscV_RTL::postinitService() {
         i_vcd_ = 0;
     }
 
-    if (OutVcdFile_.size()) {
+    if (vcdcap_) {
+        vcdcap_->setFilter(&vcdFilter_);
+        if (!vcdcap_->setStartTrigger(&vcdStart_)) {
+            RISCV_error("Wrong VcdStart trigger format", NULL);
+        }
+        if (!vcdcap_->setStopTrigger(&vcdStop_)) {
+            RISCV_error("Wrong VcdStop trigger format", NULL);
+        }
+        vcdcap_->setPreTrigger(vcdPreTrigger_.to_int());
+        vcdcap_->setPostTrigger(vcdPostTrigger_.to_int());
+        if (vcdcap_->open(OutVcdFile_.to_string())) {
+            o_vcd_ = vcdcap_;
+        } else {
+            RISCV_error("Can't open '%s'", OutVcdFile_.to_string());
+            o_vcd_ = 0;
+        }
+    } else if (OutVcdFile_.size()) {
         o_vcd_ = sc_create_vcd_trace_file(OutVcdFile_.to_string());
         o_vcd_->set_time_unit(1, SC_PS);
     } else {
         o_vcd_ = 0;
     }
 
+    if (memRegions_.size() || memDdr_.size()) {
+        memtiming_ = new MemTiming();
+        if (!memtiming_->setRegions(&memRegions_)) {
+            RISCV_error("Wrong MemRegions format", NULL);
+        }
+        if (!memtiming_->setDdr(&memDdr_)) {
+            RISCV_error("Wrong MemDdr format", NULL);
+        }
+        memtiming_->setBandwidthWindow(memBandwidthWindow_.to_uint64());
+        wrapper_->setMemTiming(memtiming_, memOutstanding_.to_uint32());
+        pcmdMemTiming_ = new CmdMemTiming(this, memtiming_);
+        icmdexec_->registerCommand(pcmdMemTiming_);
+    }
+    if (l2CacheEnable_.to_bool()) {
+        pcmdL2Snoop_ = new CmdL2Snoop(this, group0_);
+        icmdexec_->registerCommand(pcmdL2Snoop_);
+    }
+
     wrapper_->setBus(ibus_);
     wrapper_->setCLINT(iirqloc_);
     wrapper_->setPLIC(iirqext_);
@@ -118,6 +174,12 @@ void CpuRiscV_RTL::postinitService() {
 }
 
 void CpuRiscV_RTL::predeleteService() {
+    if (pcmdMemTiming_) {
+        icmdexec_->unregisterCommand(pcmdMemTiming_);
+    }
+    if (pcmdL2Snoop_) {
+        icmdexec_->unregisterCommand(pcmdL2Snoop_);
+    }
 }
 
 void CpuRiscV_RTL::createSystemC() {
@@ -187,6 +249,10 @@ void CpuRiscV_RTL::createSystemC() {
     group0_->o_dmi_apbo(wb_dmi_apbo);
     group0_->o_dmreset(w_ndmreset);
 
+    if (isVcdCapture()) {
+        vcdcap_ = new VcdCapture("vcdcap");
+        vcdcap_->i_clk(wrapper_->o_clk);
+    }
 
 #ifdef DBG_ICACHE_LRU_TB
     ICacheLru_tb *tb = new ICacheLru_tb("tb");
@@ -202,8 +268,31 @@ void CpuRiscV_RTL::createSystemC() {
     sc_initialize();
 }
 
+bool CpuRiscV_RTL::isVcdCapture() {
+    const char *ext = ".gz";
+    size_t len = OutVcdFile_.size();
+    if (len == 0) {
+        return false;
+    }
+    if (len > 3 && strcmp(&OutVcdFile_.to_string()[len - 3], ext) == 0) {
+        return true;
+    }
+    return vcdFilter_.size() || vcdStart_.size() || vcdStop_.size()
+        || vcdPreTrigger_.to_int() || vcdPostTrigger_.to_int();
+}
+
 void CpuRiscV_RTL::deleteSystemC() {
+    if (vcdcap_) {
+        delete vcdcap_;
+    }
     delete wrapper_;
+    if (memtiming_) {
+        delete pcmdMemTiming_;
+        delete memtiming_;
+    }
+    if (pcmdL2Snoop_) {
+        delete pcmdL2Snoop_;
+    }
     delete tapbb_;
     delete dmislv_;
     delete group0_;
@@ -228,7 +317,9 @@ void CpuRiscV_RTL::busyLoop() {
     if (i_vcd_) {
         sc_close_vcd_trace_file(i_vcd_);
     }
-    if (o_vcd_) {
+    if (vcdcap_) {
+        vcdcap_->close();
+    } else if (o_vcd_) {
         sc_close_vcd_trace_file(o_vcd_);
     }
 }
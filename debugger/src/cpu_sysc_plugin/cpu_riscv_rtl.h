@@ -18,6 +18,28 @@
  *                           trace files to compare them with functional model
  *             InVcdFile   - Stimulus VCD file
  *             OutVcdFile  - Reference VCD file with any number of signals
+ *             VcdFilter   - List of hierarchical name patterns of OutVcdFile
+ *             VcdStart    - Capture start trigger: ['pc',addr],
+ *                           ['cycle',cnt] or ['halt']
+ *             VcdStop     - Capture stop trigger in the same format
+ *             VcdPreTrigger  - Cycles kept in memory before the start
+ *             VcdPostTrigger - Cycles written after the start
+ *             MemRegions  - Memory timing: list of [base, size, latency,
+ *                           bytes_per_cycle, 'ddr'|'sram']
+ *             MemDdr      - DDR approximation of 'ddr' regions:
+ *                           [banks, row_bytes, tRP, tRCD, tCL]
+ *             MemOutstanding - Outstanding reads and writes per direction
+ *             MemBandwidthWindow - Cycles per bandwidth histogram sample
+ *
+ * @note       L2CacheEnable adds 'l2snoop' command with the snoop filter
+ *             counters of each L1 slot.
+ *
+ * @note       Non-empty MemRegions or MemDdr enables memory timing
+ *             stage with out of order responses and 'memtiming' command.
+ *
+ * @note       Any of Vcd* attributes or '.gz' extension of OutVcdFile
+ *             enables the cycle based VcdCapture instead of the
+ *             SystemC VCD file.
  *
  * @note       When GenerateRef is true Core uses step counter instead 
  *             of clock counter to generate callbacks.
@@ -38,6 +60,9 @@
 #include "rtl_wrapper.h"
 #include "tap_bitbang.h"
 #include "bus_slv.h"
+#include "vcd_capture.h"
+#include "mem_timing.h"
+#include "cmd_l2snoop.h"
 #include "ambalib/types_amba.h"
 #include "riverlib/workgroup.h"
 #include <systemc.h>
@@ -89,6 +114,7 @@ class CpuRiscV_RTL : public IService,
  private:
     void createSystemC();
     void deleteSystemC();
+    bool isVcdCapture();
 
  private:
     AttributeType hartid_;
@@ -103,6 +129,15 @@ class CpuRiscV_RTL : public IService,
     AttributeType freqHz_;
     AttributeType InVcdFile_;
     AttributeType OutVcdFile_;
+    AttributeType vcdFilter_;
+    AttributeType vcdStart_;
+    AttributeType vcdStop_;
+    AttributeType vcdPreTrigger_;
+    AttributeType vcdPostTrigger_;
+    AttributeType memRegions_;
+    AttributeType memDdr_;
+    AttributeType memOutstanding_;
+    AttributeType memBandwidthWindow_;
     event_def config_done_;
 
     IIrqController *iirqloc_;
@@ -148,6 +183,10 @@ class CpuRiscV_RTL : public IService,
 
     sc_trace_file *i_vcd_;      // stimulus pattern
     sc_trace_file *o_vcd_;      // reference pattern for comparision
+    VcdCapture *vcdcap_;        // triggered o_vcd_ or 0
+    MemTiming *memtiming_;      // bus timing stage or 0
+    CmdMemTiming *pcmdMemTiming_;
+    CmdL2Snoop *pcmdL2Snoop_;
     RtlWrapper *wrapper_;
     TapBitBang *tapbb_;
     BusSlave *dmislv_;
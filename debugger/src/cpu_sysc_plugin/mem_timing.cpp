@@ -0,0 +1,232 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "mem_timing.h"
+#include "ambalib/types_amba.h"
+
+namespace debugger {
+
+MemTiming::MemTiming() {
+    // Not described address: the next cycle response without limits
+    defaultRegion_.base = 0;
+    defaultRegion_.size = 0;
+    defaultRegion_.latency = 1;
+    defaultRegion_.bytesPerCycle = 0;
+    defaultRegion_.ddr = false;
+    defaultRegion_.busyUntil = 0;
+    rowBytes_ = 0;
+    tRP_ = 0;
+    tRCD_ = 0;
+    tCL_ = 0;
+    bwWindow_ = 1000;
+    lastT_ = 0;
+    clearStats();
+}
+
+bool MemTiming::setRegions(AttributeType *cfg) {
+    RegionType r;
+    regions_.clear();
+    for (unsigned i = 0; i < cfg->size(); i++) {
+        AttributeType &item = (*cfg)[i];
+        if (!item.is_list() || item.size() < 4) {
+            return false;
+        }
+        r.base = item[0u].to_uint64();
+        r.size = item[1].to_uint64();
+        r.latency = item[2].to_uint64();
+        r.bytesPerCycle = item[3].to_uint64();
+        r.ddr = item.size() > 4 && item[4].is_equal("ddr");
+        r.busyUntil = 0;
+        regions_.push_back(r);
+    }
+    return true;
+}
+
+bool MemTiming::setDdr(AttributeType *cfg) {
+    banks_.clear();
+    if (cfg->size() == 0) {
+        return true;
+    }
+    if (cfg->size() != 5 || (*cfg)[0u].to_uint64() == 0
+        || (*cfg)[1].to_uint64() == 0) {
+        return false;
+    }
+    BankType b;
+    b.open = false;
+    b.row = 0;
+    b.busyUntil = 0;
+    banks_.assign((*cfg)[0u].to_uint32(), b);
+    rowBytes_ = (*cfg)[1].to_uint64();
+    tRP_ = (*cfg)[2].to_uint64();
+    tRCD_ = (*cfg)[3].to_uint64();
+    tCL_ = (*cfg)[4].to_uint64();
+    return true;
+}
+
+void MemTiming::setBandwidthWindow(uint64_t cycles) {
+    if (cycles) {
+        bwWindow_ = cycles;
+    }
+}
+
+MemTiming::RegionType *MemTiming::findRegion(uint64_t addr) {
+    for (size_t i = 0; i < regions_.size(); i++) {
+        if (addr >= regions_[i].base
+            && addr < regions_[i].base + regions_[i].size) {
+            return &regions_[i];
+        }
+    }
+    return &defaultRegion_;
+}
+
+uint64_t MemTiming::request(uint64_t t, uint64_t addr, unsigned bytes,
+                            bool write) {
+    RegionType *r = findRegion(addr);
+    uint64_t start = t;
+    uint64_t lat = r->latency;
+    uint64_t xfer = 0;
+
+    if (r->bytesPerCycle) {
+        xfer = (bytes + r->bytesPerCycle - 1) / r->bytesPerCycle;
+        if (r->busyUntil > start) {
+            start = r->busyUntil;
+        }
+        r->busyUntil = start + xfer;
+    }
+
+    if (r->ddr && banks_.size()) {
+        uint64_t rowidx = addr / rowBytes_;
+        BankType &b = banks_[rowidx % banks_.size()];
+        uint64_t row = rowidx / banks_.size();
+        if (b.busyUntil > start) {
+            start = b.busyUntil;
+        }
+        if (b.open && b.row == row) {
+            lat += tCL_;
+            rowHits_++;
+        } else if (!b.open) {
+            lat += tRCD_ + tCL_;
+            rowEmpty_++;
+        } else {
+            lat += tRP_ + tRCD_ + tCL_;
+            rowConflicts_++;
+        }
+        b.open = true;
+        b.row = row;
+        b.busyUntil = start + lat + xfer;
+    }
+
+    uint64_t ready = start + lat;
+    if (write) {
+        // Response after the last beat stored
+        ready += xfer;
+        writes_++;
+    } else {
+        reads_++;
+    }
+
+    uint64_t total = ready - t;
+    int idx = 0;
+    while (idx < HIST_SIZE - 1 && (total >> (idx + 1)) != 0) {
+        idx++;
+    }
+    latencyHist_[idx]++;
+    latencySum_ += total;
+    if (total > latencyMax_) {
+        latencyMax_ = total;
+    }
+    bytes_ += bytes;
+    accountBandwidth(t, bytes);
+    return ready;
+}
+
+void MemTiming::accountBandwidth(uint64_t t, unsigned bytes) {
+    lastT_ = t;
+    if (t >= bwWindowStart_ + bwWindow_) {
+        // Close the current window and all idle windows before t
+        uint64_t peak = bwWindow_ * CFG_SYSBUS_DATA_BYTES;
+        uint64_t idx = (bwWindowBytes_ * HIST_SIZE) / peak;
+        if (idx >= HIST_SIZE) {
+            idx = HIST_SIZE - 1;
+        }
+        bandwidthHist_[idx]++;
+        uint64_t windows = (t - bwWindowStart_) / bwWindow_;
+        bandwidthHist_[0] += windows - 1;
+        bwWindowStart_ += windows * bwWindow_;
+        bwWindowBytes_ = 0;
+    }
+    bwWindowBytes_ += bytes;
+}
+
+void MemTiming::clearStats() {
+    reads_ = 0;
+    writes_ = 0;
+    bytes_ = 0;
+    latencySum_ = 0;
+    latencyMax_ = 0;
+    rowHits_ = 0;
+    rowEmpty_ = 0;
+    rowConflicts_ = 0;
+    // Restart from the current cycle window, not from the cycle 0
+    bwWindowStart_ = lastT_ - lastT_ % bwWindow_;
+    bwWindowBytes_ = 0;
+    for (int i = 0; i < HIST_SIZE; i++) {
+        latencyHist_[i] = 0;
+        bandwidthHist_[i] = 0;
+    }
+}
+
+void MemTiming::histToList(const uint64_t *hist, int sz, bool log2,
+                           AttributeType *res) {
+    AttributeType item;
+    res->make_list(0);
+    for (int i = 0; i < sz; i++) {
+        if (hist[i] == 0) {
+            continue;
+        }
+        item.make_list(3);
+        if (log2) {
+            item[0u].make_uint64(i == 0 ? 0 : 1ull << i);
+            item[1].make_uint64((2ull << i) - 1);
+        } else {
+            // Percent of the peak bus bandwidth
+            item[0u].make_uint64((100 * i) / sz);
+            item[1].make_uint64((100 * (i + 1)) / sz);
+        }
+        item[2].make_uint64(hist[i]);
+        res->add_to_list(&item);
+    }
+}
+
+void MemTiming::getStats(AttributeType *res) {
+    uint64_t total = reads_ + writes_;
+    res->make_dict();
+    (*res)["Reads"].make_uint64(reads_);
+    (*res)["Writes"].make_uint64(writes_);
+    (*res)["Bytes"].make_uint64(bytes_);
+    (*res)["LatencyAvg"].make_floating(
+        total ? static_cast<double>(latencySum_) / total : 0.0);
+    (*res)["LatencyMax"].make_uint64(latencyMax_);
+    if (banks_.size()) {
+        (*res)["RowHits"].make_uint64(rowHits_);
+        (*res)["RowEmpty"].make_uint64(rowEmpty_);
+        (*res)["RowConflicts"].make_uint64(rowConflicts_);
+    }
+    histToList(latencyHist_, HIST_SIZE, true, &(*res)["LatencyHist"]);
+    histToList(bandwidthHist_, HIST_SIZE, false, &(*res)["BandwidthHist"]);
+}
+
+}  // namespace debugger
@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "api_core.h"
+#include "iservice.h"
+#include "coreservices/icommand.h"
+#include <vector>
+
+namespace debugger {
+
+/**
+ * @brief Memory timing stage of the system bus.
+ *
+ * Computes the completion cycle of each burst. Every region has its own
+ * access latency and bandwidth, the next burst into the region starts
+ * when the previous one has been transferred. Regions marked as 'ddr'
+ * additionally use bank/row-buffer approximation: row hit costs tCL,
+ * access to the closed bank tRCD + tCL and row conflict tRP + tRCD + tCL.
+ * Bank stays busy until its access is done, so the bursts into different
+ * banks overlap and may complete out of order.
+ */
+class MemTiming {
+ public:
+    MemTiming();
+
+    /** List of [base, size, latency, bytes_per_cycle, 'ddr'|'sram'] */
+    bool setRegions(AttributeType *cfg);
+    /** [banks, row_bytes, tRP, tRCD, tCL] in clock cycles */
+    bool setDdr(AttributeType *cfg);
+    void setBandwidthWindow(uint64_t cycles);
+
+    /**
+     * @param[in] t     Accept cycle
+     * @param[in] addr  Burst start address
+     * @param[in] bytes Burst size
+     * @return Cycle when read data or write response are ready
+     */
+    uint64_t request(uint64_t t, uint64_t addr, unsigned bytes, bool write);
+
+    void clearStats();
+    void getStats(AttributeType *res);
+
+ private:
+    struct RegionType {
+        uint64_t base;
+        uint64_t size;
+        uint64_t latency;
+        uint64_t bytesPerCycle;
+        bool ddr;
+        uint64_t busyUntil;     // channel occupancy
+    };
+
+    struct BankType {
+        bool open;
+        uint64_t row;
+        uint64_t busyUntil;
+    };
+
+    RegionType *findRegion(uint64_t addr);
+    void accountBandwidth(uint64_t t, unsigned bytes);
+    static void histToList(const uint64_t *hist, int sz, bool log2,
+                           AttributeType *res);
+
+    static const int HIST_SIZE = 16;
+
+    std::vector<RegionType> regions_;
+    RegionType defaultRegion_;
+    std::vector<BankType> banks_;
+    uint64_t rowBytes_;
+    uint64_t tRP_;
+    uint64_t tRCD_;
+    uint64_t tCL_;
+
+    uint64_t bwWindow_;
+    uint64_t bwWindowStart_;
+    uint64_t bwWindowBytes_;
+    uint64_t lastT_;            // last accepted request cycle
+
+    uint64_t reads_;
+    uint64_t writes_;
+    uint64_t bytes_;
+    uint64_t latencySum_;
+    uint64_t latencyMax_;
+    uint64_t rowHits_;
+    uint64_t rowEmpty_;
+    uint64_t rowConflicts_;
+    uint64_t latencyHist_[HIST_SIZE];      // log2 of cycles
+    uint64_t bandwidthHist_[HIST_SIZE];    // bus utilization of windows
+};
+
+/** Console access to the timing statistic */
+class CmdMemTiming : public ICommand {
+ public:
+    CmdMemTiming(IService *parent, MemTiming *timing)
+        : ICommand(parent, "memtiming"), timing_(timing) {
+        briefDescr_.make_string("Memory timing model statistic");
+        detailedDescr_.make_string(
+            "Description:\n"
+            "    Read or clear statistic of the system bus memory timing\n"
+            "    model: number of transactions, DDR row buffer hits and\n"
+            "    misses, latency histogram with log2 buckets in clock\n"
+            "    cycles and histogram of the bus utilization.\n"
+            "Response:\n"
+            "    Dictionary with the counters and histograms as lists\n"
+            "    of [from, to, count]\n"
+            "Usage:\n"
+            "    memtiming\n"
+            "    memtiming clear\n");
+    }
+
+    /** ICommand */
+    virtual int isValid(AttributeType *args) {
+        if (!cmdName_.is_equal((*args)[0u].to_string())) {
+            return CMD_INVALID;
+        }
+        if (args->size() == 1
+            || (args->size() == 2 && (*args)[1].is_equal("clear"))) {
+            return CMD_VALID;
+        }
+        return CMD_WRONG_ARGS;
+    }
+
+    virtual void exec(AttributeType *args, AttributeType *res) {
+        res->make_nil();
+        if (args->size() == 2) {
+            timing_->clearStats();
+            return;
+        }
+        timing_->getStats(res);
+    }
+
+ private:
+    MemTiming *timing_;
+};
+
+}  // namespace debugger
@@ -58,6 +58,11 @@ RtlWrapper::RtlWrapper(IFace *parent, sc_module_name name) : sc_module(name),
     w_seip = 0;
     iirqloc_ = 0;
     iirqext_ = 0;
+    memtiming_ = 0;
+    outstanding_ = 1;
+    rsel_ = -1;
+    wsel_ = -1;
+    bsel_ = -1;
 
     SC_METHOD(comb);
     sensitive << w_interrupt;
@@ -197,7 +202,10 @@ void RtlWrapper::comb() {
     if (w_req_mem_ready == 1) {
         v.r_error = 0;
         v.w_error = 0;
-        if (i_msto.read().ar_valid) {
+        if (memtiming_) {
+            // Bursts are accepted by the timing stage
+            v.state = State_Idle;
+        } else if (i_msto.read().ar_valid) {
             v.state = State_Read;
             v.req_addr = i_msto.read().ar_bits.addr;
             v.req_burst = i_msto.read().ar_bits.burst;
@@ -237,6 +245,21 @@ void RtlWrapper::comb() {
     vmsti.r_last = v_r_last;
     vmsti.r_id = 0;
     vmsti.r_user = 0;
+
+    if (memtiming_) {
+        bool v_idle = r.state.read() == State_Idle;
+        vmsti.aw_ready = v_idle && mto_.aw_ready;
+        vmsti.w_ready = v_idle && mto_.w_ready;
+        vmsti.b_valid = v_idle && mto_.b_valid;
+        vmsti.b_resp = mto_.b_resp;
+        vmsti.b_id = mto_.b_id;
+        vmsti.ar_ready = v_idle && mto_.ar_ready;
+        vmsti.r_valid = v_idle && mto_.r_valid;
+        vmsti.r_resp = mto_.r_resp;
+        vmsti.r_data = mto_.r_data;
+        vmsti.r_last = mto_.r_last;
+        vmsti.r_id = mto_.r_id;
+    }
     o_msti = vmsti;     // to trigger event;
 
     vb_msip[0] = w_msip;
@@ -279,6 +302,9 @@ void RtlWrapper::registers() {
         }
     }
 
+    if (memtiming_) {
+        timingRegisters();
+    }
     r = v;
 }
 
@@ -341,6 +367,170 @@ void RtlWrapper::sys_bus_proc() {
     }
 }
 
+/**
+ * Data are read or written into the bus at the moment of the burst
+ * acceptance or W-beat, the timing stage only delays the responses.
+ * R-bursts and B-responses with different IDs are returned in the order
+ * of their completion, with the same ID in the order of requests.
+ */
+void RtlWrapper::timingRegisters() {
+    uint64_t t = r.clk_cnt.read();
+    axi4_master_out_type msto = i_msto.read();
+
+    if (r.state.read() == State_Reset) {
+        rdq_.clear();
+        wrq_.clear();
+    } else if (r.state.read() == State_Idle) {
+        if (mto_.r_valid && msto.r_ready) {
+            MemTxnType &tr = rdq_[rsel_];
+            if (++tr.beat == tr.len) {
+                rdq_.erase(rdq_.begin() + rsel_);
+            }
+        }
+        if (mto_.w_ready && msto.w_valid) {
+            timingWriteBeat(msto, t);
+        }
+        if (mto_.b_valid && msto.b_ready) {
+            wrq_.erase(wrq_.begin() + bsel_);
+        }
+        if (mto_.ar_ready && msto.ar_valid) {
+            timingReadBurst(msto, t);
+        }
+        if (mto_.aw_ready && msto.aw_valid) {
+            MemTxnType tr;
+            tr.id = static_cast<uint32_t>(msto.aw_id.to_uint());
+            tr.addr = msto.aw_bits.addr.to_uint64();
+            tr.len = msto.aw_bits.len.to_uint() + 1;
+            tr.beat = 0;
+            tr.incr = msto.aw_bits.burst == AXI_BURST_INCR;
+            tr.error = false;
+            tr.t_req = t;
+            tr.t_ready = ~0ull;
+            wrq_.push_back(tr);
+        }
+    }
+    timingOutputs(t + 1);
+}
+
+void RtlWrapper::timingReadBurst(const axi4_master_out_type &msto,
+                                 uint64_t t) {
+    Axi4TransactionType tr;
+    MemTxnType rd;
+    rd.id = static_cast<uint32_t>(msto.ar_id.to_uint());
+    rd.addr = msto.ar_bits.addr.to_uint64();
+    rd.len = msto.ar_bits.len.to_uint() + 1;
+    rd.beat = 0;
+    rd.incr = msto.ar_bits.burst == AXI_BURST_INCR;
+    rd.error = false;
+    rd.t_req = t;
+    rd.data.resize(rd.len);
+
+    uint64_t addr = rd.addr;
+    tr.source_idx = trans.source_idx;
+    tr.action = MemAction_Read;
+    tr.xsize = 8;
+    tr.wstrb = 0;
+    for (unsigned i = 0; i < rd.len; i++) {
+        tr.addr = addr;
+        tr.wpayload.b64[0] = 0;
+        if (ibus_->b_transport(&tr) == TRANS_ERROR) {
+            rd.error = true;
+        }
+        uint64_t toff = addr & ((1 << CFG_LOG2_SYSBUS_DATA_BYTES) - 1);
+        rd.data[i] = tr.rpayload.b64[0] << (8*toff);
+        if (rd.incr) {
+            addr += 8;
+        }
+    }
+    rd.t_ready = memtiming_->request(t, rd.addr, 8 * rd.len, false);
+    rdq_.push_back(rd);
+}
+
+void RtlWrapper::timingWriteBeat(const axi4_master_out_type &msto,
+                                 uint64_t t) {
+    Axi4TransactionType tr;
+    MemTxnType &wr = wrq_[wsel_];
+    uint64_t addr = wr.addr;
+    if (wr.incr) {
+        addr += 8 * wr.beat;
+    }
+    uint8_t strob = static_cast<uint8_t>(msto.w_strb.to_uint());
+    uint64_t offset = mask2offset(strob);
+    tr.source_idx = trans.source_idx;
+    tr.action = MemAction_Write;
+    tr.addr = (addr & ~((1ull << CFG_LOG2_SYSBUS_DATA_BYTES) - 1)) + offset;
+    tr.xsize = mask2size(strob >> offset);
+    tr.wstrb = (1 << tr.xsize) - 1;
+    tr.wpayload.b64[0] = msto.w_data.to_uint64() >> (8*offset);
+    if (ibus_->b_transport(&tr) == TRANS_ERROR) {
+        wr.error = true;
+    }
+    if (++wr.beat == wr.len) {
+        wr.t_ready = memtiming_->request(t, wr.addr, 8 * wr.len, true);
+    }
+}
+
+bool RtlWrapper::isOldestId(const std::deque<MemTxnType> &q, size_t idx) {
+    for (size_t i = 0; i < idx; i++) {
+        if (q[i].id == q[idx].id) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RtlWrapper::timingOutputs(uint64_t t) {
+    // Continue started burst, AXI4 doesn't interleave read data
+    rsel_ = -1;
+    for (size_t i = 0; i < rdq_.size(); i++) {
+        if (rdq_[i].beat) {
+            rsel_ = static_cast<int>(i);
+            break;
+        }
+        if (rsel_ < 0 && rdq_[i].t_ready <= t && isOldestId(rdq_, i)) {
+            rsel_ = static_cast<int>(i);
+        }
+    }
+    mto_.r_valid = rsel_ >= 0;
+    if (rsel_ >= 0) {
+        MemTxnType &rd = rdq_[rsel_];
+        mto_.r_data = rd.data[rd.beat];
+        mto_.r_last = rd.beat + 1 == rd.len;
+        mto_.r_id = rd.id;
+        mto_.r_resp = rd.error ? 0x2 : 0x0;
+    } else {
+        mto_.r_data = 0;
+        mto_.r_last = 0;
+        mto_.r_id = 0;
+        mto_.r_resp = 0;
+    }
+
+    // Write data in the order of the accepted addresses
+    wsel_ = -1;
+    bsel_ = -1;
+    for (size_t i = 0; i < wrq_.size(); i++) {
+        if (wsel_ < 0 && wrq_[i].beat < wrq_[i].len) {
+            wsel_ = static_cast<int>(i);
+        }
+        if (bsel_ < 0 && wrq_[i].beat == wrq_[i].len
+            && wrq_[i].t_ready <= t && isOldestId(wrq_, i)) {
+            bsel_ = static_cast<int>(i);
+        }
+    }
+    mto_.w_ready = wsel_ >= 0;
+    mto_.b_valid = bsel_ >= 0;
+    if (bsel_ >= 0) {
+        mto_.b_id = wrq_[bsel_].id;
+        mto_.b_resp = wrq_[bsel_].error ? 0x2 : 0x0;
+    } else {
+        mto_.b_id = 0;
+        mto_.b_resp = 0;
+    }
+
+    mto_.ar_ready = rdq_.size() < outstanding_;
+    mto_.aw_ready = wrq_.size() < outstanding_;
+}
+
 uint64_t RtlWrapper::mask2offset(uint8_t mask) {
     for (int i = 0; i < CFG_SYSBUS_DATA_BYTES; i++) {
         if (mask & 0x1) {
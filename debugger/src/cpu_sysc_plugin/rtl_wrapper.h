@@ -26,7 +26,9 @@
 #include "ambalib/types_amba.h"
 #include "riverlib/river_cfg.h"
 #include "riverlib/types_river.h"
+#include "mem_timing.h"
 #include <systemc.h>
+#include <deque>
 
 namespace debugger {
 
@@ -109,6 +111,11 @@ class RtlWrapper : public sc_module,
     void setCLINT(IIrqController *v) { iirqloc_ = v; }
     void setPLIC(IIrqController *v) { iirqext_ = v; }
     void setBus(IMemoryOperation *v) { ibus_ = v; }
+    /** Enable timing stage with multiple outstanding transactions */
+    void setMemTiming(MemTiming *v, unsigned outstanding) {
+        memtiming_ = v;
+        outstanding_ = outstanding ? outstanding : 1;
+    }
     /** Default time resolution 1 picosecond. */
     void setClockHz(double hz);
    
@@ -136,9 +143,27 @@ class RtlWrapper : public sc_module,
 
 
  private:
+    /** Accepted bursts of the timing stage */
+    struct MemTxnType {
+        uint32_t id;
+        uint64_t addr;
+        unsigned len;           // number of beats
+        unsigned beat;          // transmitted R or received W beats
+        bool incr;
+        bool error;
+        uint64_t t_req;
+        uint64_t t_ready;       // data or response ready cycle
+        std::vector<uint64_t> data;
+    };
+
     IFace *getInterface(const char *name) { return iparent_; }
     uint64_t mask2offset(uint8_t mask);
     uint32_t mask2size(uint8_t mask);       // nask with removed offset
+    void timingRegisters();
+    void timingOutputs(uint64_t t);
+    void timingReadBurst(const axi4_master_out_type &msto, uint64_t t);
+    void timingWriteBeat(const axi4_master_out_type &msto, uint64_t t);
+    bool isOldestId(const std::deque<MemTxnType> &q, size_t idx);
 
  private:
     IIrqController *iirqloc_;
@@ -150,6 +175,15 @@ class RtlWrapper : public sc_module,
 
     sc_uint<32> t_trans_idx_up;
     sc_uint<32> t_trans_idx_down;
+
+    MemTiming *memtiming_;
+    unsigned outstanding_;
+    std::deque<MemTxnType> rdq_;
+    std::deque<MemTxnType> wrq_;
+    int rsel_;                  // R beat source or -1
+    int wsel_;                  // W beat destination or -1
+    int bsel_;                  // B response source or -1
+    axi4_master_in_type mto_;   // timing stage outputs
 };
 
 }  // namespace debugger
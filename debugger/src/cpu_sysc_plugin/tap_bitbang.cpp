@@ -28,6 +28,11 @@ TapBitBang::TapBitBang(sc_module_name name) : sc_module(name),
 
     dtm_scaler_cnt_ = 0;
     trst_ = 0;
+    batch_ = 0;
+    batchsz_ = 0;
+    batchidx_ = 0;
+    batchtdo_ = 0;
+    batchtdocnt_ = 0;
     char tstr[256];
     RISCV_sprintf(tstr, sizeof(tstr), "%s_event_dtm_ready", name);
     RISCV_event_create(&event_dtm_ready_, tstr);
@@ -62,15 +67,75 @@ bool TapBitBang::getTDO() {
     return i_tdi.read();
 }
 
+int TapBitBang::bitbang(const char *ibuf, int isz, char *obuf, int *osz) {
+    int cnt = 0;
+    char c;
+    // Only the supported commands are passed into simulation
+    while (cnt < isz) {
+        c = ibuf[cnt];
+        if ((c < '0' || c > '7') && (c < 'r' || c > 'u') && c != 'R') {
+            break;
+        }
+        cnt++;
+    }
+    *osz = 0;
+    if (cnt == 0) {
+        return 0;
+    }
+
+    batch_ = ibuf;
+    batchsz_ = cnt;
+    batchidx_ = 0;
+    batchtdo_ = obuf;
+    batchtdocnt_ = 0;
+
+    // The first command is applied here, like setPins() does, the rest
+    // by the simulation thread: one hand-off per buffer instead of one
+    // per TCK edge.
+    RISCV_event_clear(&event_dtm_ready_);
+    if (applyBatch()) {
+        dtm_scaler_cnt_ = 0;
+        RISCV_event_wait(&event_dtm_ready_);
+    }
+
+    *osz = batchtdocnt_;
+    batchsz_ = 0;
+    return cnt;
+}
+
+bool TapBitBang::applyBatch() {
+    char c;
+    while (batchidx_ < batchsz_) {
+        c = batch_[batchidx_++];
+        if (c == 'R') {
+            // Previous pins state was held HOLD_CLOCKS already
+            batchtdo_[batchtdocnt_++] = i_tdi.read() ? '1' : '0';
+        } else if (c >= 'r' && c <= 'u') {
+            trst_ = ((c - 'r') >> 1) & 1;
+            return true;
+        } else {
+            tck_ = (c >> 2) & 1;
+            tms_ = (c >> 1) & 1;
+            tdo_ = c & 1;
+            return true;
+        }
+    }
+    return false;
+}
+
 
 void TapBitBang::registers() {
     o_trst = trst_;
     o_tck = tck_;
     o_tms = tms_;
     o_tdo = tdo_;
-    if (dtm_scaler_cnt_ < 3) {
-        if (++dtm_scaler_cnt_ == 3) {
-            RISCV_event_set(&event_dtm_ready_);
+    if (dtm_scaler_cnt_ < HOLD_CLOCKS) {
+        if (++dtm_scaler_cnt_ == HOLD_CLOCKS) {
+            if (batchsz_ && applyBatch()) {
+                dtm_scaler_cnt_ = 0;
+            } else {
+                RISCV_event_set(&event_dtm_ready_);
+            }
         }
     }
 }
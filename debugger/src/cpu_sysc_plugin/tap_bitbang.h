@@ -43,11 +43,23 @@ class TapBitBang : public sc_module,
     virtual void resetTAP(char trst, char srst);
     virtual void setPins(char tck, char tms, char tdi);
     virtual bool getTDO();
+    virtual int bitbang(const char *ibuf, int isz, char *obuf, int *osz);
 
  private:
+    static const int HOLD_CLOCKS = 3;   // pins state hold time
+
+    // Apply commands up to the next pins change, return false on end
+    bool applyBatch();
 
     event_def event_dtm_ready_;
 
+    // Batch is accessed by the simulation thread while the caller waits
+    const char *batch_;
+    int batchsz_;
+    int batchidx_;
+    char *batchtdo_;
+    int batchtdocnt_;
+
     char trst_;
     char tck_;
     char tms_;
@@ -0,0 +1,753 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "vcd_capture.h"
+#include <string.h>
+#include <algorithm>
+
+namespace debugger {
+
+/** Signals used by the 'pc' and 'halt' triggers, the first matched hart */
+static const char *const TRIG_PC_VALID_NAME = "exec0.o_valid";
+static const char *const TRIG_PC_NAME = "exec0.o_pc";
+static const char *const TRIG_HALT_NAME = "proc0.o_halted";
+
+/** Ring of changes is allocated as average changed words per cycle */
+static const int RING_CHANGES_PER_CYCLE = 64;
+
+class VcdEntry {
+ public:
+    VcdEntry(const std::string &name, int width)
+        : name_(name), width_(width), widx_(0), real_(false) {}
+    virtual ~VcdEntry() {}
+
+    virtual void read(uint64_t *v) = 0;
+
+    int nwords() { return width_ <= 64 ? 1 : (width_ + 63) / 64; }
+    uint64_t mask() {
+        return width_ >= 64 ? ~0ull : (1ull << width_) - 1;
+    }
+
+ public:
+    std::string name_;
+    std::string id_;
+    int width_;
+    int widx_;
+    bool real_;
+};
+
+/** Integer types, bool, sc_bit, sc_int_base and sc_uint_base */
+template <class T> class VcdEntryInt : public VcdEntry {
+ public:
+    VcdEntryInt(const T &obj, const std::string &name, int width)
+        : VcdEntry(name, width), obj_(obj) {}
+
+    virtual void read(uint64_t *v) {
+        v[0] = static_cast<uint64_t>(obj_) & mask();
+    }
+
+ private:
+    const T &obj_;
+};
+
+class VcdEntryLogic : public VcdEntry {
+ public:
+    VcdEntryLogic(const sc_dt::sc_logic &obj, const std::string &name)
+        : VcdEntry(name, 1), obj_(obj) {}
+
+    virtual void read(uint64_t *v) {
+        v[0] = obj_.value() == sc_dt::Log_1 ? 1 : 0;
+    }
+
+ private:
+    const sc_dt::sc_logic &obj_;
+};
+
+template <class T> class VcdEntryReal : public VcdEntry {
+ public:
+    VcdEntryReal(const T &obj, const std::string &name)
+        : VcdEntry(name, 64), obj_(obj) {
+        real_ = true;
+    }
+
+    virtual void read(uint64_t *v) {
+        double d = static_cast<double>(obj_);
+        memcpy(v, &d, sizeof(uint64_t));
+    }
+
+ private:
+    const T &obj_;
+};
+
+/** sc_signed and sc_unsigned of any width */
+template <class T> class VcdEntryBig : public VcdEntry {
+ public:
+    VcdEntryBig(const T &obj, const std::string &name)
+        : VcdEntry(name, obj.length()), obj_(obj) {}
+
+    virtual void read(uint64_t *v) {
+        memset(v, 0, nwords() * sizeof(uint64_t));
+        for (int i = 0; i < width_; i++) {
+            if (obj_.test(i)) {
+                v[i >> 6] |= 1ull << (i & 0x3F);
+            }
+        }
+    }
+
+ private:
+    const T &obj_;
+};
+
+/** sc_bv_base and sc_lv_base, 'x' and 'z' are read as data bits */
+template <class T> class VcdEntryVector : public VcdEntry {
+ public:
+    VcdEntryVector(const T &obj, const std::string &name)
+        : VcdEntry(name, obj.length()), obj_(obj) {}
+
+    virtual void read(uint64_t *v) {
+        int n32 = (width_ + 31) / 32;
+        memset(v, 0, nwords() * sizeof(uint64_t));
+        for (int i = 0; i < n32; i++) {
+            v[i >> 1] |= static_cast<uint64_t>(obj_.get_word(i))
+                            << (32 * (i & 1));
+        }
+        if (width_ & 0x3F) {
+            v[nwords() - 1] &= (1ull << (width_ & 0x3F)) - 1;
+        }
+    }
+
+ private:
+    const T &obj_;
+};
+
+
+VcdCapture::VcdCapture(sc_module_name name) : sc_module(name),
+    i_clk("i_clk") {
+    fp_ = 0;
+    pipe_ = false;
+    state_ = State_Armed;
+    initialized_ = false;
+    cycles_ = 0;
+    startCycle_ = 0;
+    filter_.make_list(0);
+    start_.type = Trig_None;
+    start_.value = 0;
+    start_.active = false;
+    stop_ = start_;
+    preTrigger_ = 0;
+    postTrigger_ = 0;
+    trigPcValid_ = 0;
+    trigPc_ = 0;
+    trigHalt_ = 0;
+    nwords_ = 0;
+    baseTime_ = 0;
+    lastTime_ = 0;
+    frameHead_ = 0;
+    frameCnt_ = 0;
+    chgHead_ = 0;
+    chgTail_ = 0;
+
+    SC_METHOD(posedge);
+    sensitive << i_clk.pos();
+
+    SC_METHOD(negedge);
+    sensitive << i_clk.neg();
+}
+
+VcdCapture::~VcdCapture() {
+    close();
+    for (unsigned i = 0; i < entries_.size(); i++) {
+        delete entries_[i];
+    }
+    for (unsigned i = 0; i < hidden_.size(); i++) {
+        delete hidden_[i];
+    }
+}
+
+bool VcdCapture::open(const char *filename) {
+    size_t len = strlen(filename);
+    close();
+    if (len > 3 && strcmp(&filename[len - 3], ".gz") == 0) {
+        std::string cmd = std::string("gzip -c > \"") + filename + "\"";
+#if defined(_WIN32) || defined(__CYGWIN__)
+        fp_ = _popen(cmd.c_str(), "wb");
+#else
+        fp_ = popen(cmd.c_str(), "w");
+#endif
+        pipe_ = true;
+    } else {
+        fp_ = fopen(filename, "wb");
+        pipe_ = false;
+    }
+    return fp_ != 0;
+}
+
+void VcdCapture::close() {
+    if (!fp_) {
+        return;
+    }
+    if (state_ == State_Capture) {
+        stopCapture(static_cast<uint64_t>(sc_time_stamp() / sc_time(1, SC_PS)));
+    }
+    if (pipe_) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+        _pclose(fp_);
+#else
+        pclose(fp_);
+#endif
+    } else {
+        fclose(fp_);
+    }
+    fp_ = 0;
+    state_ = State_Done;
+}
+
+void VcdCapture::setFilter(AttributeType *patterns) {
+    filter_.make_list(0);
+    if (!patterns->is_list()) {
+        return;
+    }
+    for (unsigned i = 0; i < patterns->size(); i++) {
+        if ((*patterns)[i].is_string()) {
+            filter_.add_to_list(&(*patterns)[i]);
+        }
+    }
+}
+
+bool VcdCapture::setStartTrigger(AttributeType *cfg) {
+    return parseTrigger(cfg, &start_);
+}
+
+bool VcdCapture::setStopTrigger(AttributeType *cfg) {
+    return parseTrigger(cfg, &stop_);
+}
+
+bool VcdCapture::parseTrigger(AttributeType *cfg, TriggerType *trig) {
+    trig->type = Trig_None;
+    trig->value = 0;
+    trig->active = false;
+    if (!cfg->is_list() || cfg->size() == 0) {
+        return true;
+    }
+    AttributeType &type = (*cfg)[0u];
+    if (type.is_equal("halt")) {
+        trig->type = Trig_Halt;
+        return true;
+    }
+    if (cfg->size() != 2 || !(*cfg)[1].is_integer()) {
+        return false;
+    }
+    trig->value = (*cfg)[1].to_uint64();
+    if (type.is_equal("pc")) {
+        trig->type = Trig_Pc;
+    } else if (type.is_equal("cycle")) {
+        trig->type = Trig_Cycle;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/** Trigger fires once when its condition becomes true */
+bool VcdCapture::checkTrigger(TriggerType *trig) {
+    bool cond = false;
+    uint64_t v;
+    switch (trig->type) {
+    case Trig_Pc:
+        if (trigPcValid_ && trigPc_) {
+            trigPcValid_->read(&v);
+            if (v) {
+                trigPc_->read(&v);
+                cond = v == trig->value;
+            }
+        }
+        break;
+    case Trig_Cycle:
+        cond = cycles_ >= trig->value;
+        break;
+    case Trig_Halt:
+        if (trigHalt_) {
+            trigHalt_->read(&v);
+            cond = v != 0;
+        }
+        break;
+    default:;
+    }
+    bool ret = cond && !trig->active;
+    trig->active = cond;
+    return ret;
+}
+
+static bool glob_match(const char *pattern, const char *str) {
+    if (*pattern == '\0') {
+        return *str == '\0';
+    }
+    if (*pattern == '*') {
+        do {
+            if (glob_match(pattern + 1, str)) {
+                return true;
+            }
+        } while (*str++);
+        return false;
+    }
+    if (*str == '\0') {
+        return false;
+    }
+    if (*pattern == '?' || *pattern == *str) {
+        return glob_match(pattern + 1, str + 1);
+    }
+    return false;
+}
+
+static bool ends_with(const std::string &name, const char *suffix) {
+    size_t len = strlen(suffix);
+    return name.size() >= len
+        && name.compare(name.size() - len, len, suffix) == 0;
+}
+
+bool VcdCapture::matchFilter(const char *name) {
+    if (filter_.size() == 0) {
+        return true;
+    }
+    for (unsigned i = 0; i < filter_.size(); i++) {
+        if (glob_match(filter_[i].to_string(), name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void VcdCapture::addEntry(VcdEntry *e) {
+    if (initialized_) {
+        // signals registered after the simulation started are ignored
+        delete e;
+        return;
+    }
+    entries_.push_back(e);
+}
+
+static bool entry_less(const VcdEntry *a, const VcdEntry *b) {
+    return a->name_ < b->name_;
+}
+
+void VcdCapture::initLayout() {
+    std::vector<VcdEntry *> all;
+    char id[8];
+    int cnt;
+
+    // Filter is applied when all signals are registered
+    all.swap(entries_);
+    for (unsigned i = 0; i < all.size(); i++) {
+        VcdEntry *e = all[i];
+        bool used = matchFilter(e->name_.c_str());
+        if (used) {
+            entries_.push_back(e);
+        }
+        if (!trigPcValid_ && ends_with(e->name_, TRIG_PC_VALID_NAME)) {
+            trigPcValid_ = e;
+        } else if (!trigPc_ && ends_with(e->name_, TRIG_PC_NAME)) {
+            trigPc_ = e;
+        } else if (!trigHalt_ && ends_with(e->name_, TRIG_HALT_NAME)) {
+            trigHalt_ = e;
+        } else if (!used) {
+            delete e;
+            continue;
+        }
+        if (!used) {
+            hidden_.push_back(e);
+        }
+    }
+    std::sort(entries_.begin(), entries_.end(), entry_less);
+
+    nwords_ = 0;
+    for (unsigned i = 0; i < entries_.size(); i++) {
+        VcdEntry *e = entries_[i];
+        e->widx_ = nwords_;
+        for (int n = 0; n < e->nwords(); n++) {
+            word2entry_.push_back(i);
+        }
+        nwords_ += e->nwords();
+
+        // Identifier from printable characters '!'..'~'
+        cnt = 0;
+        unsigned t = i;
+        do {
+            id[cnt++] = static_cast<char>('!' + (t % 94));
+            t /= 94;
+        } while (t && cnt < 7);
+        id[cnt] = '\0';
+        e->id_ = id;
+    }
+    cur_.assign(nwords_, 0);
+    smp_.assign(nwords_, 0);
+    base_.assign(nwords_, 0);
+    dirty_.assign(entries_.size(), 0);
+
+    if (preTrigger_ > 0) {
+        frames_.resize(preTrigger_);
+        changes_.resize(static_cast<size_t>(preTrigger_)
+                        * RING_CHANGES_PER_CYCLE + nwords_);
+    }
+    initialized_ = true;
+}
+
+void VcdCapture::readAll(uint64_t *buf) {
+    for (unsigned i = 0; i < entries_.size(); i++) {
+        entries_[i]->read(&buf[entries_[i]->widx_]);
+    }
+}
+
+void VcdCapture::sampleToRing(uint64_t t) {
+    readAll(smp_.data());
+    tmpChanges_.clear();
+    for (unsigned i = 0; i < nwords_; i++) {
+        if (smp_[i] != cur_[i]) {
+            ChangeType c;
+            c.widx = i;
+            c.val = smp_[i];
+            tmpChanges_.push_back(c);
+            cur_[i] = smp_[i];
+        }
+    }
+
+    if (tmpChanges_.size() > changes_.size()) {
+        // Too many changes to keep history: the frame becomes the base
+        while (frameCnt_) {
+            dropFrame();
+        }
+        base_ = cur_;
+        baseTime_ = t;
+        return;
+    }
+    while (frameCnt_ == frames_.size()
+        || (chgTail_ - chgHead_ + tmpChanges_.size()) > changes_.size()) {
+        dropFrame();
+    }
+
+    FrameType &f = frames_[(frameHead_ + frameCnt_) % frames_.size()];
+    f.t = t;
+    f.start = chgTail_;
+    f.cnt = static_cast<unsigned>(tmpChanges_.size());
+    frameCnt_++;
+    for (unsigned i = 0; i < tmpChanges_.size(); i++) {
+        changes_[(chgTail_ + i) % changes_.size()] = tmpChanges_[i];
+    }
+    chgTail_ += tmpChanges_.size();
+}
+
+void VcdCapture::dropFrame() {
+    FrameType &f = frames_[frameHead_];
+    for (unsigned i = 0; i < f.cnt; i++) {
+        ChangeType &c = changes_[(f.start + i) % changes_.size()];
+        base_[c.widx] = c.val;
+    }
+    baseTime_ = f.t;
+    chgHead_ += f.cnt;
+    frameHead_ = (frameHead_ + 1) % frames_.size();
+    frameCnt_--;
+}
+
+void VcdCapture::startCapture(uint64_t t) {
+    if (frames_.size()) {
+        sampleToRing(t);
+    } else {
+        readAll(cur_.data());
+        base_ = cur_;
+        baseTime_ = t;
+    }
+
+    writeHeader();
+    fprintf(fp_, "#%" RV_PRI64 "d\n$dumpvars\n", baseTime_);
+    lastTime_ = baseTime_;
+    for (unsigned i = 0; i < entries_.size(); i++) {
+        writeValue(entries_[i], base_.data());
+    }
+    fprintf(fp_, "$end\n");
+
+    // Pre-trigger history
+    for (unsigned n = 0; n < frameCnt_; n++) {
+        FrameType &f = frames_[(frameHead_ + n) % frames_.size()];
+        if (f.cnt == 0) {
+            continue;
+        }
+        for (unsigned i = 0; i < f.cnt; i++) {
+            ChangeType &c = changes_[(f.start + i) % changes_.size()];
+            base_[c.widx] = c.val;
+            dirty_[word2entry_[c.widx]] = 1;
+        }
+        fprintf(fp_, "#%" RV_PRI64 "d\n", f.t);
+        lastTime_ = f.t;
+        for (unsigned i = 0; i < entries_.size(); i++) {
+            if (dirty_[i]) {
+                writeValue(entries_[i], base_.data());
+                dirty_[i] = 0;
+            }
+        }
+    }
+    frameCnt_ = 0;
+    chgHead_ = chgTail_;
+    startCycle_ = cycles_;
+    state_ = State_Capture;
+}
+
+void VcdCapture::captureCycle(uint64_t t) {
+    bool stamp = false;
+    readAll(smp_.data());
+    for (unsigned i = 0; i < entries_.size(); i++) {
+        VcdEntry *e = entries_[i];
+        if (memcmp(&smp_[e->widx_], &cur_[e->widx_],
+                   e->nwords() * sizeof(uint64_t)) == 0) {
+            continue;
+        }
+        if (!stamp) {
+            fprintf(fp_, "#%" RV_PRI64 "d\n", t);
+            lastTime_ = t;
+            stamp = true;
+        }
+        memcpy(&cur_[e->widx_], &smp_[e->widx_],
+               e->nwords() * sizeof(uint64_t));
+        writeValue(e, cur_.data());
+    }
+}
+
+void VcdCapture::stopCapture(uint64_t t) {
+    if (t != lastTime_) {
+        fprintf(fp_, "#%" RV_PRI64 "d\n", t);
+    }
+    fflush(fp_);
+    state_ = State_Done;
+}
+
+void VcdCapture::writeHeader() {
+    std::vector<std::string> scope;
+    std::vector<std::string> path;
+    size_t b, e;
+
+    fprintf(fp_, "$version\n    riscvdebugger VcdCapture\n$end\n");
+    fprintf(fp_, "$timescale\n    1 ps\n$end\n");
+    for (unsigned i = 0; i < entries_.size(); i++) {
+        VcdEntry *ent = entries_[i];
+        path.clear();
+        b = 0;
+        while ((e = ent->name_.find('.', b)) != std::string::npos) {
+            path.push_back(ent->name_.substr(b, e - b));
+            b = e + 1;
+        }
+        unsigned same = 0;
+        while (same < scope.size() && same < path.size()
+            && scope[same] == path[same]) {
+            same++;
+        }
+        while (scope.size() > same) {
+            fprintf(fp_, "$upscope $end\n");
+            scope.pop_back();
+        }
+        while (scope.size() < path.size()) {
+            scope.push_back(path[scope.size()]);
+            fprintf(fp_, "$scope module %s $end\n", scope.back().c_str());
+        }
+        fprintf(fp_, "$var %s %d %s %s $end\n",
+                ent->real_ ? "real" : "wire", ent->width_,
+                ent->id_.c_str(), ent->name_.substr(b).c_str());
+    }
+    while (scope.size()) {
+        fprintf(fp_, "$upscope $end\n");
+        scope.pop_back();
+    }
+    fprintf(fp_, "$enddefinitions $end\n");
+}
+
+void VcdCapture::writeValue(VcdEntry *e, const uint64_t *buf) {
+    const uint64_t *v = &buf[e->widx_];
+    if (e->real_) {
+        double d;
+        memcpy(&d, v, sizeof(double));
+        fprintf(fp_, "r%.16g %s\n", d, e->id_.c_str());
+        return;
+    }
+    if (e->width_ == 1) {
+        fprintf(fp_, "%c%s\n", v[0] ? '1' : '0', e->id_.c_str());
+        return;
+    }
+    char tstr[1024];
+    int cnt = 0;
+    int bit = e->width_ - 1;
+    // skip leading zeros
+    while (bit > 0 && ((v[bit >> 6] >> (bit & 0x3F)) & 1) == 0) {
+        bit--;
+    }
+    tstr[cnt++] = 'b';
+    for (; bit >= 0; bit--) {
+        tstr[cnt++] = ((v[bit >> 6] >> (bit & 0x3F)) & 1) ? '1' : '0';
+        if (cnt == sizeof(tstr) - 1) {
+            tstr[cnt] = '\0';
+            fputs(tstr, fp_);
+            cnt = 0;
+        }
+    }
+    tstr[cnt] = '\0';
+    fprintf(fp_, "%s %s\n", tstr, e->id_.c_str());
+}
+
+void VcdCapture::posedge() {
+    tpos_ = sc_time_stamp();
+}
+
+void VcdCapture::negedge() {
+    if (!fp_ || state_ == State_Done) {
+        return;
+    }
+    if (!initialized_) {
+        initLayout();
+    }
+    uint64_t t = static_cast<uint64_t>(tpos_ / sc_time(1, SC_PS));
+    cycles_++;
+
+    switch (state_) {
+    case State_Armed:
+        if (start_.type == Trig_None || checkTrigger(&start_)) {
+            startCapture(t);
+        } else if (frames_.size()) {
+            sampleToRing(t);
+        }
+        break;
+    case State_Capture:
+        captureCycle(t);
+        if (checkTrigger(&stop_)
+            || (postTrigger_ && (cycles_ - startCycle_) >=
+                static_cast<uint64_t>(postTrigger_))) {
+            stopCapture(t);
+        }
+        break;
+    default:;
+    }
+}
+
+void VcdCapture::trace(const bool &object, const std::string &name) {
+    addEntry(new VcdEntryInt<bool>(object, name, 1));
+}
+
+void VcdCapture::trace(const sc_dt::sc_bit &object, const std::string &name) {
+    addEntry(new VcdEntryInt<sc_dt::sc_bit>(object, name, 1));
+}
+
+void VcdCapture::trace(const sc_dt::sc_logic &object,
+                       const std::string &name) {
+    addEntry(new VcdEntryLogic(object, name));
+}
+
+void VcdCapture::trace(const unsigned char &object,
+                       const std::string &name, int width) {
+    addEntry(new VcdEntryInt<unsigned char>(object, name, width));
+}
+
+void VcdCapture::trace(const unsigned short &object,
+                       const std::string &name, int width) {
+    addEntry(new VcdEntryInt<unsigned short>(object, name, width));
+}
+
+void VcdCapture::trace(const unsigned int &object,
+                       const std::string &name, int width) {
+    addEntry(new VcdEntryInt<unsigned int>(object, name, width));
+}
+
+void VcdCapture::trace(const unsigned long &object,
+                       const std::string &name, int width) {
+    addEntry(new VcdEntryInt<unsigned long>(object, name, width));
+}
+
+void VcdCapture::trace(const char &object,
+                       const std::string &name, int width) {
+    addEntry(new VcdEntryInt<char>(object, name, width));
+}
+
+void VcdCapture::trace(const short &object,
+                       const std::string &name, int width) {
+    addEntry(new VcdEntryInt<short>(object, name, width));
+}
+
+void VcdCapture::trace(const int &object,
+                       const std::string &name, int width) {
+    addEntry(new VcdEntryInt<int>(object, name, width));
+}
+
+void VcdCapture::trace(const long &object,
+                       const std::string &name, int width) {
+    addEntry(new VcdEntryInt<long>(object, name, width));
+}
+
+void VcdCapture::trace(const sc_dt::int64 &object,
+                       const std::string &name, int width) {
+    addEntry(new VcdEntryInt<sc_dt::int64>(object, name, width));
+}
+
+void VcdCapture::trace(const sc_dt::uint64 &object,
+                       const std::string &name, int width) {
+    addEntry(new VcdEntryInt<sc_dt::uint64>(object, name, width));
+}
+
+void VcdCapture::trace(const float &object, const std::string &name) {
+    addEntry(new VcdEntryReal<float>(object, name));
+}
+
+void VcdCapture::trace(const double &object, const std::string &name) {
+    addEntry(new VcdEntryReal<double>(object, name));
+}
+
+void VcdCapture::trace(const sc_dt::sc_int_base &object,
+                       const std::string &name) {
+    addEntry(new VcdEntryInt<sc_dt::sc_int_base>(object, name,
+                                                 object.length()));
+}
+
+void VcdCapture::trace(const sc_dt::sc_uint_base &object,
+                       const std::string &name) {
+    addEntry(new VcdEntryInt<sc_dt::sc_uint_base>(object, name,
+                                                  object.length()));
+}
+
+void VcdCapture::trace(const sc_dt::sc_signed &object,
+                       const std::string &name) {
+    addEntry(new VcdEntryBig<sc_dt::sc_signed>(object, name));
+}
+
+void VcdCapture::trace(const sc_dt::sc_unsigned &object,
+                       const std::string &name) {
+    addEntry(new VcdEntryBig<sc_dt::sc_unsigned>(object, name));
+}
+
+void VcdCapture::trace(const sc_dt::sc_bv_base &object,
+                       const std::string &name) {
+    addEntry(new VcdEntryVector<sc_dt::sc_bv_base>(object, name));
+}
+
+void VcdCapture::trace(const sc_dt::sc_lv_base &object,
+                       const std::string &name) {
+    addEntry(new VcdEntryVector<sc_dt::sc_lv_base>(object, name));
+}
+
+void VcdCapture::trace(const unsigned int &object, const std::string &name,
+                       const char **enum_literals) {
+    addEntry(new VcdEntryInt<unsigned int>(object, name, 32));
+}
+
+void VcdCapture::write_comment(const std::string &comment) {
+    if (fp_ && state_ == State_Capture) {
+        fprintf(fp_, "$comment\n%s\n$end\n", comment.c_str());
+    }
+}
+
+}  // namespace debugger
@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "api_core.h"
+#include <systemc.h>
+#include <string>
+#include <vector>
+
+namespace debugger {
+
+class VcdEntry;
+
+/**
+ * @brief Triggered and filtered waveform capture.
+ *
+ * Implements sc_trace_file interface so the modules register signals with
+ * the same generateVCD() methods. Signals are sampled once per clock on
+ * the falling edge and stamped with the time of the rising edge, so
+ * the output is cycle based without delta cycles and 'x'/'z' states.
+ *
+ * Only signals matching the hierarchical filter are written. Capture
+ * starts on the start trigger: values of the last PreTrigger cycles kept
+ * in the ring buffer are written first, then the signals are written
+ * directly until the stop trigger or PostTrigger cycles. File name with
+ * '.gz' extension is compressed by the gzip pipe.
+ */
+class VcdCapture : public sc_module,
+                   public sc_trace_file {
+ public:
+    sc_in<bool> i_clk;
+
+    void posedge();
+    void negedge();
+
+    SC_HAS_PROCESS(VcdCapture);
+
+    VcdCapture(sc_module_name name);
+    virtual ~VcdCapture();
+
+    enum ETriggerType {
+        Trig_None,
+        Trig_Pc,        // executed instruction pointer equals value
+        Trig_Cycle,     // clock cycles from the simulation start
+        Trig_Halt,      // CPU halted via debug interface
+    };
+
+    bool open(const char *filename);
+    void close();
+    /** List of patterns with '*' and '?' wildcards, empty list is all */
+    void setFilter(AttributeType *patterns);
+    /** Trigger format: [], ['pc',addr], ['cycle',cnt] or ['halt'] */
+    bool setStartTrigger(AttributeType *cfg);
+    bool setStopTrigger(AttributeType *cfg);
+    void setPreTrigger(int cycles) { preTrigger_ = cycles; }
+    void setPostTrigger(int cycles) { postTrigger_ = cycles; }
+
+    /** sc_trace_file interface */
+    using sc_object::trace;
+    virtual void trace(const bool &object, const std::string &name);
+    virtual void trace(const sc_dt::sc_bit &object, const std::string &name);
+    virtual void trace(const sc_dt::sc_logic &object, const std::string &name);
+    virtual void trace(const unsigned char &object, const std::string &name, int width);
+    virtual void trace(const unsigned short &object, const std::string &name, int width);
+    virtual void trace(const unsigned int &object, const std::string &name, int width);
+    virtual void trace(const unsigned long &object, const std::string &name, int width);
+    virtual void trace(const char &object, const std::string &name, int width);
+    virtual void trace(const short &object, const std::string &name, int width);
+    virtual void trace(const int &object, const std::string &name, int width);
+    virtual void trace(const long &object, const std::string &name, int width);
+    virtual void trace(const sc_dt::int64 &object, const std::string &name, int width);
+    virtual void trace(const sc_dt::uint64 &object, const std::string &name, int width);
+    virtual void trace(const float &object, const std::string &name);
+    virtual void trace(const double &object, const std::string &name);
+    virtual void trace(const sc_dt::sc_int_base &object, const std::string &name);
+    virtual void trace(const sc_dt::sc_uint_base &object, const std::string &name);
+    virtual void trace(const sc_dt::sc_signed &object, const std::string &name);
+    virtual void trace(const sc_dt::sc_unsigned &object, const std::string &name);
+    virtual void trace(const sc_dt::sc_fxval &object, const std::string &name) {}
+    virtual void trace(const sc_dt::sc_fxval_fast &object, const std::string &name) {}
+    virtual void trace(const sc_dt::sc_fxnum &object, const std::string &name) {}
+    virtual void trace(const sc_dt::sc_fxnum_fast &object, const std::string &name) {}
+    virtual void trace(const sc_dt::sc_bv_base &object, const std::string &name);
+    virtual void trace(const sc_dt::sc_lv_base &object, const std::string &name);
+    virtual void trace(const unsigned int &object, const std::string &name,
+                       const char **enum_literals);
+    virtual void write_comment(const std::string &comment);
+    virtual void set_time_unit(double v, sc_time_unit tu) {}
+
+ protected:
+    /** Not registered in simulation context, sampled by clock instead */
+    virtual void cycle(bool delta_cycle) {}
+
+ private:
+    struct TriggerType {
+        int type;
+        uint64_t value;
+        bool active;
+    };
+
+    struct FrameType {
+        uint64_t t;
+        uint64_t start;     // absolute index in the changes ring
+        unsigned cnt;
+    };
+
+    struct ChangeType {
+        uint32_t widx;
+        uint64_t val;
+    };
+
+    bool parseTrigger(AttributeType *cfg, TriggerType *trig);
+    bool checkTrigger(TriggerType *trig);
+    bool matchFilter(const char *name);
+    void addEntry(VcdEntry *e);
+    void initLayout();
+    void readAll(uint64_t *buf);
+    void sampleToRing(uint64_t t);
+    void dropFrame();
+    void startCapture(uint64_t t);
+    void captureCycle(uint64_t t);
+    void stopCapture(uint64_t t);
+    void writeHeader();
+    void writeValue(VcdEntry *e, const uint64_t *buf);
+
+    enum EState {
+        State_Armed,
+        State_Capture,
+        State_Done
+    };
+
+    FILE *fp_;
+    bool pipe_;
+    int state_;
+    bool initialized_;
+    uint64_t cycles_;
+    uint64_t startCycle_;
+    sc_time tpos_;
+    AttributeType filter_;
+    TriggerType start_;
+    TriggerType stop_;
+    int preTrigger_;
+    int postTrigger_;
+
+    std::vector<VcdEntry *> entries_;       // registered, then written signals
+    std::vector<VcdEntry *> hidden_;        // trigger only signals
+    VcdEntry *trigPcValid_;
+    VcdEntry *trigPc_;
+    VcdEntry *trigHalt_;
+
+    unsigned nwords_;
+    std::vector<uint64_t> cur_;             // last sampled values
+    std::vector<uint64_t> smp_;             // current sample
+    std::vector<uint64_t> base_;            // values before the oldest frame
+    std::vector<uint32_t> word2entry_;
+    std::vector<char> dirty_;
+    uint64_t baseTime_;
+    uint64_t lastTime_;
+
+    std::vector<FrameType> frames_;
+    unsigned frameHead_;
+    unsigned frameCnt_;
+    std::vector<ChangeType> changes_;
+    uint64_t chgHead_;
+    uint64_t chgTail_;
+    std::vector<ChangeType> tmpChanges_;
+};
+
+}  // namespace debugger
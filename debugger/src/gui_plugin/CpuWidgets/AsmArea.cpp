@@ -24,7 +24,8 @@ AsmArea::AsmArea(IGui *gui, QWidget *parent, uint64_t fixaddr)
     hideLineIdx_ = 0;
     selRowIdx = -1;
     fixaddr_ = fixaddr;
-    waitRegNpc_ = false;
+    subscribed_ = false;
+    pollingMs_ = (*igui_->getpConfig())["PollingMs"].to_int();
 
     clear();
     QFont font("Courier");
@@ -153,19 +154,24 @@ void AsmArea::wheelEvent(QWheelEvent * ev) {
 }
 
 void AsmArea::slotUpdateByTimer() {
-    if (waitRegNpc_) {
+    if (subscribed_) {
         return;
     }
-    waitRegNpc_ = true;
-    igui_->registerCommand(static_cast<IGuiCmdHandler *>(this),
-                            reqNpc_.to_string(), &respNpc_, true);
+    subscribed_ = true;
+    igui_->subscribeCommand(static_cast<IGuiCmdHandler *>(this),
+                            reqNpc_.to_string(), &respNpc_, pollingMs_,
+                            GuiSub_Halt, 0, 0);
 }
 
 void AsmArea::handleResponse(const char *cmd) {
     if (reqNpc_.is_equal(cmd)) {
-        waitRegNpc_ = false;
-        if (!respNpc_.is_nil()) {
+        bool valid = !respNpc_.is_nil();
+        if (valid) {
             npc_ = respNpc_.to_uint64();
+        }
+        igui_->confirmSubscription(static_cast<IGuiCmdHandler *>(this),
+                                   &respNpc_);
+        if (valid) {
             emit signalNpcChanged();
         }
     } else if (strstr(cmd, "br ")) {
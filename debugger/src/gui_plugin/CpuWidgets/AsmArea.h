@@ -94,7 +94,8 @@ class AsmArea : public QTableWidget,
     int visibleLinesTotal_;
     uint64_t startAddr_;
     uint64_t endAddr_;
-    bool waitRegNpc_;
+    bool subscribed_;
+    int pollingMs_;
 };
 
 }  // namespace debugger
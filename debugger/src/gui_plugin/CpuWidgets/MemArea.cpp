@@ -18,11 +18,13 @@ MemArea::MemArea(IGui *gui, QWidget *parent, uint64_t addr, uint64_t sz)
     igui_ = gui;
     reqAddr_ = addr;
     reqBytes_ = sz;
+    reqAddrZ_ = ~0ull;
+    reqBytesZ_ = 0;
     cmdRead_.make_string("read 0x80000000 20");
     data_.make_data(0);
     tmpBuf_.make_data(1024);
     dataText_.make_string("");
-    waitingResponse_ = false;
+    pollingMs_ = (*igui_->getpConfig())["PollingMs"].to_int();
 
     clear();
     QFont font("Courier");
@@ -46,21 +48,26 @@ MemArea::~MemArea() {
 void MemArea::slotAddressChanged(AttributeType *cmd) {
     reqAddr_ = (*cmd)[0u].to_uint64();
     reqBytes_ = static_cast<unsigned>((*cmd)[1].to_int());
+    subscribe();
 }
 
 void MemArea::slotUpdateByTimer() {
-    char tstr[128];
-    if (waitingResponse_) {
-        waitingResponse_ = true;
+    if (reqAddr_ != reqAddrZ_ || reqBytes_ != reqBytesZ_) {
+        subscribe();
     }
+}
+
+void MemArea::subscribe() {
+    char tstr[128];
     RISCV_sprintf(tstr, sizeof(tstr), "read 0x%08" RV_PRI64 "x %d",
                                         reqAddr_, reqBytes_);
     cmdRead_.make_string(tstr);
 
     reqAddrZ_ = reqAddr_;
     reqBytesZ_ = reqBytes_;
-    igui_->registerCommand(static_cast<IGuiCmdHandler *>(this),
-                           cmdRead_.to_string(), &respRead_, true);
+    igui_->subscribeCommand(static_cast<IGuiCmdHandler *>(this),
+                            cmdRead_.to_string(), &respRead_, pollingMs_,
+                            GuiSub_Memory, reqAddr_, reqBytes_);
 }
 
 void MemArea::slotUpdateData() {
@@ -69,12 +76,15 @@ void MemArea::slotUpdateData() {
     QTextCursor cursor = textCursor();
     cursor.insertText(tr(dataText_.to_string()));
     update();
+    igui_->confirmSubscription(static_cast<IGuiCmdHandler *>(this),
+                               &respRead_);
 }
 
 void MemArea::handleResponse(const char *cmd) {
     bool changed = false;
-    waitingResponse_ = false;
     if (respRead_.is_nil()) {
+        igui_->confirmSubscription(static_cast<IGuiCmdHandler *>(this),
+                                   &respRead_);
         return;
     }
     if (respRead_.size() != data_.size()) {
@@ -88,6 +98,8 @@ void MemArea::handleResponse(const char *cmd) {
         }
     }
     if (!changed) {
+        igui_->confirmSubscription(static_cast<IGuiCmdHandler *>(this),
+                                   &respRead_);
         return;
     }
 
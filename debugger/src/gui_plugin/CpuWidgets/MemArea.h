@@ -46,6 +46,7 @@ class MemArea : public QPlainTextEdit,
     void slotUpdateData();
 
  private:
+    void subscribe();
     void to_string(uint64_t addr, unsigned bytes, AttributeType *out);
 
  private:
@@ -62,7 +63,7 @@ class MemArea : public QPlainTextEdit,
     unsigned reqBytes_;
     uint64_t reqAddrZ_;
     unsigned reqBytesZ_;
-    bool waitingResponse_;
+    int pollingMs_;
 };
 
 }  // namespace debugger
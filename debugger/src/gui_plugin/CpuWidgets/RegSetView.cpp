@@ -33,8 +33,9 @@ RegSetView::RegSetView(IGui *igui, QWidget *parent, int cpucontext)
     gridLayout->setVerticalSpacing(0);
     gridLayout->setContentsMargins(4, 4, 4, 4);
     setLayout(gridLayout);
-    waitingResp_ = false;
+    subscribed_ = false;
     contextSwitchInProgress_ = false;
+    pollingMs_ = (*igui_->getpConfig())["PollingMs"].to_int();
 
     const AttributeType &cfg = (*igui_->getpConfig())["RegsViewWidget"];
     if (!cfg.is_dict()) {
@@ -94,22 +95,24 @@ void RegSetView::handleResponse(const char *cmd) {
 
 void RegSetView::slotHandleResponse(AttributeType *resp) {
     // To avoid resp_ overwiting before register views udpated:
-    waitingResp_ = false;
+    igui_->confirmSubscription(static_cast<IGuiCmdHandler *>(this),
+                               &respReg_);
 }
 
 void RegSetView::slotUpdateByTimer() {
-    if (!isVisible()) {
+    // Registers are read only while visible and when target state changed
+    bool ena = isVisible() && !contextSwitchInProgress_;
+    if (ena == subscribed_) {
         return;
     }
-    if (waitingResp_) {
-        return;
-    }
-    if (contextSwitchInProgress_) {
-        return;
+    if (ena) {
+        igui_->subscribeCommand(static_cast<IGuiCmdHandler *>(this),
+                                cmdReg_.to_string(), &respReg_, pollingMs_,
+                                GuiSub_Registers, 0, 0);
+    } else {
+        igui_->removeFromQueue(static_cast<IGuiCmdHandler *>(this));
     }
-    igui_->registerCommand(static_cast<IGuiCmdHandler *>(this), 
-                           cmdReg_.to_string(), &respReg_, true);
-    waitingResp_ = true;
+    subscribed_ = ena;
 }
 
 void RegSetView::slotRegChanged(const char *wrcmd) {
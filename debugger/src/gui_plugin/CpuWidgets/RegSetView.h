@@ -64,9 +64,10 @@ class RegSetView : public QWidget,
     QGridLayout *gridLayout;
     
     IGui *igui_;
-    bool waitingResp_;
+    bool subscribed_;
     bool contextSwitchInProgress_;
     int curContextIdx_;
+    int pollingMs_;
 };
 
 }  // namespace debugger
@@ -61,7 +61,8 @@ StackTraceArea::StackTraceArea(IGui *gui, QWidget *parent)
     connect(this, SIGNAL(cellDoubleClicked(int, int)),
             this, SLOT(slotCellDoubleClicked(int, int)));
 
-    requested_ = false;
+    subscribed_ = false;
+    pollingMs_ = (*igui_->getpConfig())["PollingMs"].to_int();
 }
 
 StackTraceArea::~StackTraceArea() {
@@ -69,12 +70,13 @@ StackTraceArea::~StackTraceArea() {
 }
 
 void StackTraceArea::slotUpdateByTimer() {
-    if (requested_) {
+    if (subscribed_) {
         return;
     }
-    requested_ = true;
-    igui_->registerCommand(static_cast<IGuiCmdHandler *>(this),
-                           "stack", &symbolList_, true);
+    subscribed_ = true;
+    igui_->subscribeCommand(static_cast<IGuiCmdHandler *>(this),
+                            "stack", &symbolList_, pollingMs_,
+                            GuiSub_Halt, 0, 0);
 }
 
 void StackTraceArea::setListSize(int sz) {
@@ -117,6 +119,8 @@ void StackTraceArea::handleResponse(const char *cmd) {
 
 void StackTraceArea::slotHandleResponse() {
     if (!symbolList_.is_list()) {
+        igui_->confirmSubscription(static_cast<IGuiCmdHandler *>(this),
+                                   &symbolList_);
         return;
     }
     QTableWidgetItem *pw;
@@ -146,8 +150,8 @@ void StackTraceArea::slotHandleResponse() {
     }
     symbolList_.attr_free();
     symbolList_.make_nil();
-    RISCV_memory_barrier();
-    requested_ = false;
+    igui_->confirmSubscription(static_cast<IGuiCmdHandler *>(this),
+                               &symbolList_);
 }
 
 QString StackTraceArea::makeSymbolQString(uint64_t addr, AttributeType &info) {
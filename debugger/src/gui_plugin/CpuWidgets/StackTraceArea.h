@@ -59,7 +59,8 @@ class StackTraceArea : public QTableWidget,
 
     AttributeType symbolList_;
     AttributeType symbolAddr_;
-    bool requested_;
+    bool subscribed_;
+    int pollingMs_;
     IGui *igui_;
     int lineHeight_;
     int hideLineIdx_;
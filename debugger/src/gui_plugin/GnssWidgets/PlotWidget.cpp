@@ -199,18 +199,21 @@ void PlotWidget::renderAxis(QPainter &p) {
 
 void PlotWidget::renderLine(QPainter &p, LineCommon *pline) {
     bool draw_line = false;
-    int x, y;
+    int x, y, ymin, ymax;
     QPoint ptA, ptB;
     QRect box(0, 0, 4, 4);
     p.setPen(QColor(pline->getColor()));
+    /** Number of drawn columns is limited by the plot width */
     pline->selectData(epochStart, epochTotal);
-    for (int i = epochStart; i < epochStart + epochTotal; i++) {
-        if (!pline->getNext(x, y)) {
-            draw_line = false;
-            continue;
+    bool draw_box = !pline->isDecimated();
+    while (pline->getNext(x, y, ymin, ymax)) {
+        if (draw_box) {
+            box.moveTo(x - 2, y - 2);
+            p.drawRect(box);
+        }
+        if (ymin != ymax) {
+            p.drawLine(QPoint(x, ymin), QPoint(x, ymax));
         }
-        box.moveTo(x - 2, y - 2);
-        p.drawRect(box);
 
         if (!draw_line) {
             draw_line = true;
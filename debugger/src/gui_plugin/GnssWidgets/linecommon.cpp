@@ -32,7 +32,12 @@ LineCommon::LineCommon(AttributeType &descr) {
     dx = 0;
     dy = 0;
     sel_start_idx = 0;
-    sel_cnt = 0;
+    total_ = 0;
+    levels_ = 0;
+    sel_level_ = 0;
+    sel_astart_ = 0;
+    sel_cur_ = 0;
+    sel_last_ = -1;
 
     is_ring_ = false;
     len_ = 1024;
@@ -51,12 +56,21 @@ LineCommon::LineCommon(AttributeType &descr) {
     }
 }
 
+LineCommon::~LineCommon() {
+    for (int i = 0; i < 2; i++) {
+        delete [] axis_[i].data;
+    }
+    for (int i = 0; i < levels_; i++) {
+        delete [] level_[i].buf;
+    }
+}
+
 const AttributeType &LineCommon::getDescription() {
     return descr_;
 }
     
 unsigned LineCommon::size() {
-    return cnt_;
+    return static_cast<unsigned>(total_ - first());
 }
 void LineCommon::append(double y) {
     append(size(), y);
@@ -125,6 +139,113 @@ void LineCommon::append(double x, double y) {
     if (y > axis_[1].maxVal && !descr_["FixedMaxY"].to_bool()) {
         axis_[1].maxVal = y;
     }
+
+    // Min/max pyramid
+    BucketType v;
+    v.ymin = y;
+    v.ymax = y;
+    v.ysum = y;
+    for (int k = 0; k < levels_; k++) {
+        addToLevel(k, total_ >> levelShift(k + 1), v);
+    }
+    total_++;
+
+    /** The next level is built from the top level before it wraps */
+    if (levels_ < PYRAMID_LEVELS_MAX) {
+        int64_t top_cnt;
+        int64_t top_len = PYRAMID_LEN_MIN;
+        if (levels_ == 0) {
+            top_cnt = total_;
+            if (is_ring_ && len_ < top_len) {
+                top_len = len_;
+            }
+        } else {
+            top_cnt = level_[levels_ - 1].cnt;
+        }
+        if (top_cnt == top_len) {
+            addLevel();
+        }
+    }
+}
+
+int64_t LineCommon::levelFirst(int lvl) {
+    if (lvl == 0) {
+        return total_ - cnt_;
+    }
+    LevelType &L = level_[lvl - 1];
+    int64_t b = 0;
+    if (L.cnt > L.len) {
+        b = L.cnt - L.len;
+    }
+    return b << levelShift(lvl);
+}
+
+bool LineCommon::readBucket(int lvl, int64_t b, BucketType &out) {
+    if (lvl == 0) {
+        int64_t raw_first = total_ - cnt_;
+        if (b < raw_first || b >= total_) {
+            return false;
+        }
+        int n = static_cast<int>((start_ + (b - raw_first)) % len_);
+        out.ymin = axis_[1].data[n];
+        out.ymax = out.ymin;
+        out.ysum = out.ymin;
+        return true;
+    }
+    LevelType &L = level_[lvl - 1];
+    if (b < (levelFirst(lvl) >> levelShift(lvl)) || b >= L.cnt) {
+        return false;
+    }
+    out = L.buf[b % L.len];
+    return true;
+}
+
+int64_t LineCommon::bucketSize(int lvl, int64_t b) {
+    int64_t sz = 1LL << levelShift(lvl);
+    int64_t rest = total_ - (b << levelShift(lvl));
+    return rest < sz ? rest : sz;
+}
+
+void LineCommon::addToLevel(int k, int64_t b, const BucketType &v) {
+    LevelType &L = level_[k];
+    if (b < L.cnt) {
+        BucketType &d = L.buf[b % L.len];
+        if (v.ymin < d.ymin) {
+            d.ymin = v.ymin;
+        }
+        if (v.ymax > d.ymax) {
+            d.ymax = v.ymax;
+        }
+        d.ysum += v.ysum;
+        return;
+    }
+    if (!is_ring_ && b >= L.len) {
+        BucketType *tbuf = new BucketType[2 * L.len];
+        memcpy(tbuf, L.buf, L.len * sizeof(BucketType));
+        delete [] L.buf;
+        L.buf = tbuf;
+        L.len *= 2;
+    }
+    L.buf[b % L.len] = v;
+    L.cnt = b + 1;
+}
+
+void LineCommon::addLevel() {
+    LevelType &L = level_[levels_];
+    L.len = PYRAMID_LEN_MIN;
+    if (is_ring_ && len_ > L.len) {
+        L.len = len_;
+    }
+    L.buf = new BucketType[L.len];
+    L.cnt = 0;
+
+    BucketType v;
+    int64_t b = levelFirst(levels_) >> levelShift(levels_);
+    while (readBucket(levels_, b, v)) {
+        addToLevel(levels_, b >> PYRAMID_SHIFT, v);
+        b++;
+    }
+    levels_++;
 }
 
 void LineCommon::setPlotSize(int w, int h) {
@@ -135,8 +256,10 @@ void LineCommon::setPlotSize(int w, int h) {
 
 void LineCommon::selectData(int start_idx, int total) {
     sel_start_idx = start_idx;
-    sel_cnt = start_idx;
-    if (plot_w == 0 || plot_h == 0) {
+    sel_level_ = 0;
+    sel_cur_ = 0;
+    sel_last_ = -1;
+    if (plot_w == 0 || plot_h == 0 || total <= 0) {
         dx = 0;
         dy = 0;
         return;
@@ -152,16 +275,62 @@ void LineCommon::selectData(int start_idx, int total) {
     } else {
         dy = 0;
     }
+
+    /** The coarsest level with at least one bucket per pixel that
+        still contains the first selected sample */
+    double samples_per_pix = static_cast<double>(total) / plot_w;
+    while (sel_level_ < levels_
+        && static_cast<double>(1LL << levelShift(sel_level_ + 1))
+            <= samples_per_pix) {
+        sel_level_++;
+    }
+    sel_astart_ = first() + start_idx;
+    while (sel_level_ < levels_ && levelFirst(sel_level_) > sel_astart_) {
+        sel_level_++;
+    }
+    sel_cur_ = sel_astart_ >> levelShift(sel_level_);
+    sel_last_ = (sel_astart_ + total - 1) >> levelShift(sel_level_);
 }
 
-bool LineCommon::getNext(int &x, int &y) {
-    double val;
-    if (!getAxisValue(1, sel_cnt, val)) {
+bool LineCommon::getNext(int &x, int &y, int &ymin, int &ymax) {
+    BucketType v;
+    BucketType col;
+    int64_t col_cnt = 0;
+    while (sel_cur_ <= sel_last_) {
+        if (!readBucket(sel_level_, sel_cur_, v)) {
+            sel_cur_++;
+            continue;
+        }
+        int64_t pos = sel_cur_ << levelShift(sel_level_);
+        if (pos < sel_astart_) {
+            pos = sel_astart_;
+        }
+        int bx = static_cast<int>((pos - sel_astart_) * dx + 0.5);
+        if (col_cnt && bx != x) {
+            break;
+        }
+        if (col_cnt == 0) {
+            x = bx;
+            col = v;
+        } else {
+            if (v.ymin < col.ymin) {
+                col.ymin = v.ymin;
+            }
+            if (v.ymax > col.ymax) {
+                col.ymax = v.ymax;
+            }
+            col.ysum += v.ysum;
+        }
+        col_cnt += bucketSize(sel_level_, sel_cur_);
+        sel_cur_++;
+    }
+    if (col_cnt == 0) {
         return false;
     }
-    x = static_cast<int>((sel_cnt - sel_start_idx) * dx + 0.5);
-    y = static_cast<int>((axis_[1].maxVal - val) * dy + 0.5);
-    sel_cnt++;
+    double mean = col.ysum / static_cast<double>(col_cnt);
+    y = static_cast<int>((axis_[1].maxVal - mean) * dy + 0.5);
+    ymin = static_cast<int>((axis_[1].maxVal - col.ymin) * dy + 0.5);
+    ymax = static_cast<int>((axis_[1].maxVal - col.ymax) * dy + 0.5);
     return true;
 }
 
@@ -184,22 +353,38 @@ int LineCommon::getNearestByX(int x) {
 }
 
 bool LineCommon::getAxisValue(int axis, int idx, double &outval) {
-    if (idx >= 0 && idx < cnt_) {
-        int n = (start_ + idx) % len_;
+    int64_t a = first() + idx;
+    int64_t raw_first = total_ - cnt_;
+    if (idx < 0 || a >= total_) {
+        return false;
+    }
+    if (a >= raw_first) {
+        int n = static_cast<int>((start_ + (a - raw_first)) % len_);
         outval = axis_[axis].data[n];
         return true;
     }
+    if (axis != 1) {
+        return false;
+    }
+    // Mean value of the finest bucket when sample was dropped from the ring
+    BucketType v;
+    for (int lvl = 1; lvl <= levels_; lvl++) {
+        int64_t b = a >> levelShift(lvl);
+        if (readBucket(lvl, b, v)) {
+            outval = v.ysum / static_cast<double>(bucketSize(lvl, b));
+            return true;
+        }
+    }
     return false;
 }
 
 bool LineCommon::getAxisValue(int axis, int idx, char *outbuf, size_t bufsz) {
-    if (idx >= 0 && idx < cnt_) {
-        int n = (start_ + idx) % len_;
-        double outval = axis_[axis].data[n];
-        RISCV_sprintf(outbuf, bufsz, format_, outval);
-        return true;
+    double outval;
+    if (!getAxisValue(axis, idx, outval)) {
+        return false;
     }
-    return false;
+    RISCV_sprintf(outbuf, bufsz, format_, outval);
+    return true;
 }
 
 void LineCommon::getAxisMin(int axis, char *outbuf, size_t bufsz) {
@@ -10,9 +10,18 @@
 
 namespace debugger {
 
+/**
+ * Samples are stored in the ring buffer and additionally in the min/max
+ * pyramid: each level keeps buckets of 4 buckets of the previous level.
+ * Rendering reads the coarsest level that still gives one bucket per
+ * pixel so that cost depends on the plot width only. Levels are rings
+ * too, so with 'RingLength' set the old history is kept with the lower
+ * resolution in the bounded memory.
+ */
 class LineCommon {
 public:
     LineCommon(AttributeType &descr);
+    ~LineCommon();
 
     const AttributeType &getDescription();
     unsigned size();
@@ -23,7 +32,11 @@ public:
 
     void setPlotSize(int w, int h);
     void selectData(int start_idx, int total);
-    bool getNext(int &x, int &y);
+    /** Next plot column of the selected data: y is the mean value,
+        ymin/ymax are the extreme values inside of the column */
+    bool getNext(int &x, int &y, int &ymin, int &ymax);
+    /** Column contains more than one sample */
+    bool isDecimated() { return sel_level_ > 0; }
     bool getXY(int idx, int &x, int &y);
     bool getAxisValue(int axis, int idx, double &outval);
     bool getAxisValue(int axis, int idx, char *outbuf, size_t bufsz);
@@ -31,6 +44,31 @@ public:
     void getAxisMax(int axis, char *outbuf, size_t bufsz);
     int getNearestByX(int x);
 
+private:
+    static const int PYRAMID_SHIFT = 2;         // 4 buckets per upper bucket
+    static const int PYRAMID_LEVELS_MAX = 16;
+    static const int PYRAMID_LEN_MIN = 1024;
+
+    struct BucketType {
+        double ymin;
+        double ymax;
+        double ysum;
+    };
+
+    struct LevelType {
+        BucketType *buf;
+        int len;
+        int64_t cnt;        // buckets started from the beginning
+    };
+
+    int levelShift(int lvl) { return PYRAMID_SHIFT * lvl; }
+    int64_t levelFirst(int lvl);
+    int64_t first() { return levelFirst(levels_); }
+    bool readBucket(int lvl, int64_t b, BucketType &out);
+    int64_t bucketSize(int lvl, int64_t b);
+    void addToLevel(int k, int64_t b, const BucketType &v);
+    void addLevel();
+
 private:
     AttributeType descr_;
     struct AxisType {
@@ -50,7 +88,14 @@ private:
     double dx;
     double dy;
     int sel_start_idx;
-    int sel_cnt;
+
+    int64_t total_;         // samples appended from the beginning
+    int levels_;            // pyramid levels above the raw samples
+    LevelType level_[PYRAMID_LEVELS_MAX];
+    int sel_level_;
+    int64_t sel_astart_;
+    int64_t sel_cur_;
+    int64_t sel_last_;
 };
 
 }  // namespace debugger
@@ -28,13 +28,15 @@ namespace debugger {
 LedDisplay::LedDisplay(IGui *gui, QWidget *parent, const char *objname) 
     : QWidget(parent) {
     igui_ = gui;
+    objname_.make_string(objname);
 
     char tstr[256];
     RISCV_sprintf(tstr, sizeof(tstr), "%s config", objname);
     cmdconfig_.make_string(tstr);
 
-    RISCV_sprintf(tstr, sizeof(tstr), "%s frame diff", objname);
+    RISCV_sprintf(tstr, sizeof(tstr), "%s update 0", objname);
     cmdframe_.make_string(tstr);
+    frameSeq_ = 0;
 
     const AttributeType &cfgDisplay = 
         (*igui_->getpConfig())["DemoM4Widgets"]["Display"];
@@ -78,10 +80,14 @@ void LedDisplay::handleResponse(const char *cmd) {
     if (strcmp(cmd, cmdconfig_.to_string()) == 0) {
         emit signalConfigurate();
     } else if (strcmp(cmd, cmdframe_.to_string()) == 0) {
-        if (respFrame_.is_data()) {
-            emit signalHandleResponse();
-        } else {
+        if (!respFrame_.is_list() || respFrame_.size() != 2) {
             requested_ = false;
+        } else if (respFrame_[1].size() == 0) {
+            frameSeq_ = respFrame_[0u].to_uint64();
+            RISCV_memory_barrier();
+            requested_ = false;
+        } else {
+            emit signalHandleResponse();
         }
     }
 }
@@ -108,6 +114,10 @@ void LedDisplay::slotUpdateByTimer() {
     if (requested_) {
         return;
     }
+    char tstr[256];
+    RISCV_sprintf(tstr, sizeof(tstr), "%s update %" RV_PRI64 "d",
+                  objname_.to_string(), frameSeq_);
+    cmdframe_.make_string(tstr);
     igui_->registerCommand(static_cast<IGuiCmdHandler *>(this),
                           cmdframe_.to_string(), &respFrame_, true);
     requested_ = true;
@@ -119,16 +129,25 @@ void LedDisplay::slotHandleResponse() {
     p.setRenderHint(QPainter::Antialiasing, false);
     p2.setRenderHint(QPainter::Antialiasing, false);
 
-    uint32_t *pframe = reinterpret_cast<uint32_t *>(respFrame_.data());
-    unsigned sz = respFrame_.size() / sizeof(uint32_t);
+    const AttributeType &rects = respFrame_[1];
     FrameItemType pix;
-    for (unsigned i = 0; i < sz; i++) {
-        pix.x = i / height_;
-        pix.y = i - height_ * pix.x;
-        pix.rgb = pframe[i];
-        drawPixel(&p, &pix, scale_);
-        drawPixel(&p2, &pix, screenshot_scale_);
+    for (unsigned n = 0; n < rects.size(); n++) {
+        const AttributeType &rect = rects[n];
+        int x0 = rect[0u].to_int();
+        int y0 = rect[1].to_int();
+        int h = rect[3].to_int();
+        const uint32_t *pframe =
+            reinterpret_cast<const uint32_t *>(rect[4].data());
+        unsigned sz = rect[4].size() / sizeof(uint32_t);
+        for (unsigned i = 0; i < sz; i++) {
+            pix.x = x0 + i / h;
+            pix.y = y0 + i % h;
+            pix.rgb = pframe[i];
+            drawPixel(&p, &pix, scale_);
+            drawPixel(&p2, &pix, screenshot_scale_);
+        }
     }
+    frameSeq_ = respFrame_[0u].to_uint64();
     p2.end();
     p.end();
     update();
@@ -63,6 +63,7 @@ class LedDisplay : public QWidget,
 
 private:
     IGui *igui_;
+    AttributeType objname_;
     AttributeType cmdconfig_;
     AttributeType cmdframe_;
     AttributeType respConfig_;
@@ -78,6 +79,7 @@ private:
     int screenshot_scale_;
 
     bool requested_;
+    uint64_t frameSeq_;     // sequence number of the last received update
 };
 
 }  // namespace debugger
@@ -18,12 +18,14 @@
 #include "gui_plugin.h"
 #include "coreservices/iserial.h"
 #include "coreservices/irawlistener.h"
+#include "coreservices/iclock.h"
+#include "coreservices/imemop.h"
 #include <string>
 
 namespace debugger {
 
 GuiPlugin::GuiPlugin(const char *name) 
-    : IService(name), IHap(HAP_ConfigDone) {
+    : IService(name), IHap(HAP_All) {
     registerInterface(static_cast<IGui *>(this));
     registerInterface(static_cast<IThread *>(this));
     registerInterface(static_cast<IHap *>(this));
@@ -53,6 +55,18 @@ GuiPlugin::GuiPlugin(const char *name)
     cmdwrcnt_ = 0;
     cmdrdcnt_ = 0;
     pcmdwr_ = cmdbuf_;
+    userCmdCnt_ = 0;
+    subsTotal_ = 0;
+    subsSeq_ = 0;
+    RISCV_mutex_init(&mutexSubs_);
+    inflight_ = 0;
+    hapCnt_ = 0;
+    eventCnt_ = 0;
+    steps_ = 0;
+    stepsZ_ = 0;
+    running_ = false;
+    trackersTotal_ = 0;
+    dirtyRanges_.make_list(0);
 
     // Adding path to platform libraries:
     char core_path[1024];
@@ -74,6 +88,7 @@ GuiPlugin::GuiPlugin(const char *name)
 
 GuiPlugin::~GuiPlugin() {
     RISCV_event_close(&config_done_);
+    RISCV_mutex_destroy(&mutexSubs_);
 }
 
 void GuiPlugin::postinitService() {
@@ -126,6 +141,74 @@ void GuiPlugin::removeFromQueue(IFace *iface) {
         }
         ++rd;
     }
+
+    RISCV_mutex_lock(&mutexSubs_);
+    int i = 0;
+    while (i < subsTotal_) {
+        if (subs_[i].iface == iface) {
+            subs_[i] = subs_[--subsTotal_];
+        } else {
+            i++;
+        }
+    }
+    RISCV_mutex_unlock(&mutexSubs_);
+
+    // Handler may be called right now by the GUI thread
+    while (inflight_ == iface) {
+        RISCV_sleep_ms(1);
+    }
+}
+
+void GuiPlugin::subscribeCommand(IGuiCmdHandler *iface,
+                                 const char *cmd,
+                                 AttributeType *resp,
+                                 int period_ms,
+                                 EGuiSubscription kind,
+                                 uint64_t addr,
+                                 uint64_t sz) {
+    SubscriptionType *p = 0;
+    RISCV_mutex_lock(&mutexSubs_);
+    for (int i = 0; i < subsTotal_; i++) {
+        if (subs_[i].iface == iface && subs_[i].resp == resp) {
+            p = &subs_[i];
+            break;
+        }
+    }
+    if (p == 0) {
+        if (subsTotal_ >= SUBSCRIPTION_MAX) {
+            RISCV_mutex_unlock(&mutexSubs_);
+            RISCV_error("Subscriptions limit reached: %s", cmd);
+            return;
+        }
+        p = &subs_[subsTotal_++];
+        p->iface = iface;
+        p->resp = resp;
+        p->pending = false;
+    }
+    RISCV_sprintf(p->req, sizeof(p->req), "%s", cmd);
+    p->period_ms = period_ms;
+    p->kind = kind;
+    p->addr = addr;
+    p->sz = sz;
+    p->next_ms = 0;
+    p->generation = 0;
+    p->steps = 0;
+    p->hash = 0;
+    p->seq = ++subsSeq_;
+    p->forced = true;
+    p->dirty = false;
+    RISCV_mutex_unlock(&mutexSubs_);
+}
+
+void GuiPlugin::confirmSubscription(IGuiCmdHandler *iface,
+                                    AttributeType *resp) {
+    RISCV_mutex_lock(&mutexSubs_);
+    for (int i = 0; i < subsTotal_; i++) {
+        if (subs_[i].iface == iface && subs_[i].resp == resp) {
+            subs_[i].pending = false;
+        }
+    }
+    RISCV_mutex_unlock(&mutexSubs_);
 }
 
 void GuiPlugin::externalCommand(AttributeType *req) {
@@ -135,15 +218,28 @@ void GuiPlugin::externalCommand(AttributeType *req) {
 void GuiPlugin::hapTriggered(EHapType type,
                              uint64_t param,
                              const char *descr) {
-    RISCV_event_set(&config_done_);
+    switch (type) {
+    case HAP_ConfigDone:
+        RISCV_event_set(&config_done_);
+        break;
+    case HAP_Halt:
+    case HAP_Resume:
+    case HAP_CpuContextChanged:
+        hapCnt_++;
+        break;
+    default:;
+    }
 }
 
 void GuiPlugin::busyLoop() {
     RISCV_event_wait(&config_done_);
+    RISCV_get_iface_list(IFACE_CLOCK, &clocks_);
+    discoverDirtyTrackers();
 
     while (isEnabled()) {
+        processSubscriptions();
         if (cmdwrcnt_ == cmdrdcnt_) {
-            RISCV_sleep_ms(50);
+            RISCV_sleep_ms(SUBSCRIPTION_TICK_MS);
             continue;
         }
 
@@ -161,6 +257,11 @@ bool GuiPlugin::processCmdQueue() {
         if (pcmd->resp) {
             iexec_->exec(pcmd->req, pcmd->resp, pcmd->silent);
         }
+        // Console commands and requests without handler (writes) may
+        // modify the target state.
+        if (!pcmd->silent || !pcmd->iface) {
+            userCmdCnt_++;
+        }
         if (pcmd->iface) {
             pcmd->iface->handleResponse(pcmd->req);
         }
@@ -170,6 +271,238 @@ bool GuiPlugin::processCmdQueue() {
     return false;
 }
 
+void GuiPlugin::discoverDirtyTrackers() {
+    AttributeType list;
+    RISCV_get_services_with_iface(IFACE_MEMORY_OPERATION, &list);
+    for (unsigned i = 0; i < list.size(); i++) {
+        IService *iserv = static_cast<IService *>(list[i].to_iface());
+        AttributeType *pagesz = static_cast<AttributeType *>(
+            iserv->getAttribute("DirtyPageSize"));
+        if (!pagesz || pagesz->to_uint64() == 0) {
+            continue;
+        }
+        if (trackersTotal_ >= DIRTY_TRACKER_MAX) {
+            break;
+        }
+        IMemoryOperation *imem = static_cast<IMemoryOperation *>(
+            iserv->getInterface(IFACE_MEMORY_OPERATION));
+        DirtyTrackerType *p = &trackers_[trackersTotal_++];
+        RISCV_sprintf(p->name, sizeof(p->name), "%s", iserv->getObjName());
+        p->base = imem->getBaseAddress();
+        p->length = imem->getLength();
+        p->gen = 0;
+    }
+}
+
+/** Collect memory ranges written since the previous tick */
+void GuiPlugin::readDirtyRanges() {
+    char tstr[128];
+    dirtyRanges_.make_list(0);
+    for (int i = 0; i < trackersTotal_; i++) {
+        DirtyTrackerType *p = &trackers_[i];
+        RISCV_sprintf(tstr, sizeof(tstr), "%s dirty %" RV_PRI64 "d",
+                      p->name, p->gen);
+        iexec_->exec(tstr, &dirtyResp_, true);
+        if (!dirtyResp_.is_dict()) {
+            continue;
+        }
+        p->gen = dirtyResp_["Generation"].to_uint64();
+        const AttributeType &ranges = dirtyResp_["Ranges"];
+        for (unsigned n = 0; n < ranges.size(); n++) {
+            dirtyRanges_.new_list_item() = ranges[n];
+        }
+    }
+}
+
+bool GuiPlugin::isMemoryTracked(uint64_t addr, uint64_t sz) {
+    for (int i = 0; i < trackersTotal_; i++) {
+        if (addr >= trackers_[i].base
+            && addr + sz <= trackers_[i].base + trackers_[i].length) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Overlap with the ranges written since the previous tick */
+bool GuiPlugin::isMemoryChanged(uint64_t addr, uint64_t sz) {
+    for (unsigned i = 0; i < dirtyRanges_.size(); i++) {
+        uint64_t a = dirtyRanges_[i][0u].to_uint64();
+        uint64_t asz = dirtyRanges_[i][1].to_uint64();
+        if (a < addr + sz && addr < a + asz) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Run/stop transitions are detected by the step counters */
+void GuiPlugin::updateTargetState() {
+    steps_ = 0;
+    for (unsigned i = 0; i < clocks_.size(); i++) {
+        steps_ +=
+            static_cast<IClock *>(clocks_[i].to_iface())->getStepCounter();
+    }
+    bool running = steps_ != stepsZ_;
+    if (running != running_) {
+        running_ = running;
+        eventCnt_++;
+    }
+    stepsZ_ = steps_;
+}
+
+/** FNV-1a of the response to skip handlers when nothing was changed */
+uint64_t GuiPlugin::hashAttribute(const AttributeType *attr, uint64_t h) {
+    const uint64_t FNV_PRIME = 0x100000001b3ull;
+    const uint8_t *p = 0;
+    unsigned sz = 0;
+    uint64_t v = 0;
+    if (attr->is_string()) {
+        p = reinterpret_cast<const uint8_t *>(attr->to_string());
+        sz = attr->size();
+    } else if (attr->is_data()) {
+        p = attr->data();
+        sz = attr->size();
+    } else if (attr->is_list()) {
+        for (unsigned i = 0; i < attr->size(); i++) {
+            h = hashAttribute(&(*attr)[i], h);
+        }
+        v = attr->size();
+    } else if (attr->is_dict()) {
+        for (unsigned i = 0; i < attr->size(); i++) {
+            h = hashAttribute(attr->dict_key(i), h);
+            h = hashAttribute(&(*attr)[i], h);
+        }
+        v = attr->size();
+    } else if (attr->is_floating()) {
+        double f = attr->to_float();
+        memcpy(&v, &f, sizeof(v));
+    } else if (attr->is_bool()) {
+        v = attr->to_bool() ? 1 : 0;
+    } else if (attr->is_int64() || attr->is_uint64()) {
+        v = attr->to_uint64();
+    }
+    p = p ? p : reinterpret_cast<const uint8_t *>(&v);
+    sz = sz ? sz : static_cast<unsigned>(sizeof(v));
+    for (unsigned i = 0; i < sz; i++) {
+        h = (h ^ p[i]) * FNV_PRIME;
+    }
+    return h;
+}
+
+/**
+ * Due subscriptions are copied under the lock and executed without it, so
+ * the Qt thread isn't blocked by the subscribe/confirm/remove calls.
+ */
+void GuiPlugin::processSubscriptions() {
+    SubscriptionType due[SUBSCRIPTION_MAX];
+    int dueTotal = 0;
+    uint64_t t = RISCV_get_time_ms();
+    SubscriptionType *p;
+    bool hasMemory = false;
+
+    updateTargetState();
+    uint64_t evgen = eventCnt_ + hapCnt_ + userCmdCnt_;
+
+    RISCV_mutex_lock(&mutexSubs_);
+    for (int i = 0; i < subsTotal_; i++) {
+        hasMemory = hasMemory || subs_[i].kind == GuiSub_Memory;
+    }
+    RISCV_mutex_unlock(&mutexSubs_);
+
+    // Ranges are read on each tick and accumulated by the subscriptions
+    // because the next request returns only the new writes.
+    if (hasMemory && trackersTotal_) {
+        readDirtyRanges();
+    }
+
+    RISCV_mutex_lock(&mutexSubs_);
+    for (int i = 0; i < subsTotal_; i++) {
+        p = &subs_[i];
+        if (p->kind == GuiSub_Memory && dirtyRanges_.size()
+            && isMemoryChanged(p->addr, p->sz)) {
+            p->dirty = true;
+        }
+        if (!p->pending && t >= p->next_ms) {
+            due[dueTotal++] = *p;
+        }
+    }
+    RISCV_mutex_unlock(&mutexSubs_);
+
+    for (int i = 0; i < dueTotal; i++) {
+        p = &due[i];
+        bool changed = p->forced || p->generation != evgen;
+        if (!changed && p->kind == GuiSub_Memory) {
+            changed = p->dirty;
+            if (!isMemoryTracked(p->addr, p->sz)) {
+                changed = p->steps != steps_;
+            }
+        } else if (!changed && p->kind == GuiSub_Registers) {
+            changed = p->steps != steps_;
+        }
+        if (!changed) {
+            p->iface = 0;       // nothing to write back
+            continue;
+        }
+
+        // removeFromQueue() waits the handler marked as in-flight
+        inflight_ = p->iface;
+        RISCV_mutex_lock(&mutexSubs_);
+        SubscriptionType *s = findSubscription(p);
+        RISCV_mutex_unlock(&mutexSubs_);
+        if (s == 0) {
+            inflight_ = 0;
+            p->iface = 0;
+            continue;
+        }
+
+        iexec_->exec(p->req, p->resp, true);
+        uint64_t hash = hashAttribute(p->resp, 0xcbf29ce484222325ull);
+        if (p->forced || hash != p->hash) {
+            // Set before the handler: confirmation may come at any moment
+            RISCV_mutex_lock(&mutexSubs_);
+            s = findSubscription(p);
+            if (s) {
+                s->pending = true;
+            }
+            RISCV_mutex_unlock(&mutexSubs_);
+            if (s) {
+                p->iface->handleResponse(p->req);
+            }
+        }
+        inflight_ = 0;
+        p->hash = hash;
+    }
+
+    RISCV_mutex_lock(&mutexSubs_);
+    for (int i = 0; i < dueTotal; i++) {
+        p = &due[i];
+        SubscriptionType *s = p->iface ? findSubscription(p) : 0;
+        if (s == 0) {
+            continue;
+        }
+        s->forced = false;
+        s->dirty = false;
+        s->generation = evgen;
+        s->steps = steps_;
+        s->hash = p->hash;
+        s->next_ms = t + s->period_ms;
+    }
+    RISCV_mutex_unlock(&mutexSubs_);
+}
+
+/** Entry of the copied subscription, call with locked mutexSubs_ */
+GuiPlugin::SubscriptionType *GuiPlugin::findSubscription(
+                                const SubscriptionType *p) {
+    for (int i = 0; i < subsTotal_; i++) {
+        if (subs_[i].iface == p->iface && subs_[i].resp == p->resp
+            && subs_[i].seq == p->seq) {
+            return &subs_[i];
+        }
+    }
+    return 0;
+}
+
 void GuiPlugin::stop() {
     IThread::stop();
 }
@@ -25,6 +25,7 @@
 #include "coreservices/icmdexec.h"
 #include "MainWindow/DbgMainWindow.h"
 #include "qt_wrapper.h"
+#include <atomic>
 
 namespace debugger {
 
@@ -50,6 +51,12 @@ public:
                                  const char *cmd, AttributeType *resp,
                                  bool silent);
     virtual void removeFromQueue(IFace *iface);
+    virtual void subscribeCommand(IGuiCmdHandler *iface,
+                                  const char *cmd, AttributeType *resp,
+                                  int period_ms, EGuiSubscription kind,
+                                  uint64_t addr, uint64_t sz);
+    virtual void confirmSubscription(IGuiCmdHandler *iface,
+                                     AttributeType *resp);
     virtual void externalCommand(AttributeType *req);
     virtual void *getQGui() { return ui_; }
 
@@ -60,9 +67,21 @@ protected:
 
 private:
     bool processCmdQueue();
+    void processSubscriptions();
+    void updateTargetState();
+    void discoverDirtyTrackers();
+    void readDirtyRanges();
+    bool isMemoryTracked(uint64_t addr, uint64_t sz);
+    bool isMemoryChanged(uint64_t addr, uint64_t sz);
+    struct SubscriptionType;
+    SubscriptionType *findSubscription(const SubscriptionType *p);
+    static uint64_t hashAttribute(const AttributeType *attr, uint64_t h);
 
 private:
     static const int CMD_QUEUE_SIZE = 256;
+    static const int SUBSCRIPTION_MAX = 64;
+    static const int SUBSCRIPTION_TICK_MS = 20;
+    static const int DIRTY_TRACKER_MAX = 16;
 
     AttributeType guiConfig_;
     AttributeType cmdexec_;
@@ -82,6 +101,47 @@ private:
     } cmds_[CMD_QUEUE_SIZE];
     uint8_t cmdwrcnt_;
     uint8_t cmdrdcnt_;
+    uint64_t userCmdCnt_;       // commands that may modify target state
+
+    struct SubscriptionType {
+        IGuiCmdHandler *iface;
+        AttributeType *resp;
+        char req[256];
+        int period_ms;
+        EGuiSubscription kind;
+        uint64_t addr;          // GuiSub_Memory range
+        uint64_t sz;
+        uint64_t next_ms;
+        uint64_t generation;    // halt/resume/user events on last execution
+        uint64_t steps;         // executed instructions on last execution
+        uint64_t hash;          // last response passed to the handler
+        uint32_t seq;           // changed on each subscribeCommand() call
+        bool forced;            // execute even if target wasn't changed
+        bool dirty;             // memory range was written
+        bool pending;           // waiting confirmation from handler
+    } subs_[SUBSCRIPTION_MAX];
+    int subsTotal_;
+    uint32_t subsSeq_;
+    mutex_def mutexSubs_;
+    std::atomic<IFace *> inflight_;     // handler executed without lock
+
+    AttributeType clocks_;      // IClock list to detect target changes
+    std::atomic<uint64_t> hapCnt_;
+    uint64_t eventCnt_;         // run/stop transitions and haps
+    uint64_t steps_;            // sum of step counters on current tick
+    uint64_t stepsZ_;
+    bool running_;
+
+    /** Memories with write tracking, see MemDirtyTracker */
+    struct DirtyTrackerType {
+        char name[64];
+        uint64_t base;
+        uint64_t length;
+        uint64_t gen;
+    } trackers_[DIRTY_TRACKER_MAX];
+    int trackersTotal_;
+    AttributeType dirtyRanges_;     // [[addr, size], ...] of current tick
+    AttributeType dirtyResp_;
 };
 
 DECLARE_CLASS(GuiPlugin)
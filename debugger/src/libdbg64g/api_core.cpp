@@ -15,11 +15,14 @@
  */
 
 #include "core.h"
+#include "keypool.h"
 #include "coreservices/ithread.h"
 #include "coreservices/iclock.h"
 #include "generic/bus_generic.h"
 #include "services/debug/cpumonitor.h"
 #include "services/debug/codecov_generic.h"
+#include "services/debug/lockstep.h"
+#include "services/debug/sampling.h"
 #include "services/debug/openocdwrap.h"
 #include "services/elfloader/elfreader.h"
 #include "services/exec/cmdexec.h"
@@ -81,6 +84,8 @@ extern "C" int RISCV_init() {
     REGISTER_CLASS_IDX(TcpServerJtagBitBang, 13);
     REGISTER_CLASS_IDX(OpenOcdWrapper, 14);
     REGISTER_CLASS_IDX(DpiClient, 15);
+    REGISTER_CLASS_IDX(LockstepService, 16);
+    REGISTER_CLASS_IDX(SamplingService, 17);
 
     pcore_->load_plugins();
     return 0;
@@ -361,9 +366,7 @@ extern "C" int RISCV_printf(void *iface, int level,
                     "[%" RV_PRI64 "d, \"%s\", \"", cur_t, "unknown");
     } else if (strcmp(iout->getFaceName(), IFACE_SERVICE) == 0) {
         IService *iserv = static_cast<IService *>(iout);
-        AttributeType *local_level = 
-                static_cast<AttributeType *>(iserv->getAttribute("LogLevel"));
-        if (level > static_cast<int>(local_level->to_int64())) {
+        if (level > iserv->getLogLevel()) {
             pcore_->unlockPrintf();
             return 0;
         }
@@ -702,6 +705,26 @@ extern "C" void RISCV_free(void *p) {
     }
 }
 
+static KeyPoolType &keypool() {
+    static KeyPoolType pool;
+    return pool;
+}
+
+extern "C" char *RISCV_key_intern(const char *key, unsigned len,
+                                  uint32_t hash) {
+    return keypool().intern(key, len, hash);
+}
+
+extern "C" void RISCV_key_addref(const AttributePairType *pairs,
+                                 unsigned cnt) {
+    keypool().addref(pairs, cnt);
+}
+
+extern "C" void RISCV_key_release(const AttributePairType *pairs,
+                                  unsigned cnt) {
+    keypool().release(pairs, cnt);
+}
+
 extern "C" int RISCV_get_core_folder(char *out, int sz) {
 #if defined(_WIN32) || defined(__CYGWIN__)
     HMODULE hm = NULL;
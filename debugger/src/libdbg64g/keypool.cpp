@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2018 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "keypool.h"
+#include <string.h>
+#include <stddef.h>
+
+namespace debugger {
+
+KeyPoolType::KeyPoolType() : tblsz_(0), total_(0), tbl_(0) {
+    RISCV_mutex_init(&mutex_);
+    resize(1024);
+}
+
+char *KeyPoolType::intern(const char *key, unsigned len, uint32_t hash) {
+    RISCV_mutex_lock(&mutex_);
+    unsigned idx = hash & (tblsz_ - 1);
+    while (tbl_[idx]) {
+        if (tbl_[idx]->hash == hash && strcmp(tbl_[idx]->str, key) == 0) {
+            tbl_[idx]->refs++;
+            RISCV_mutex_unlock(&mutex_);
+            return tbl_[idx]->str;
+        }
+        idx = (idx + 1) & (tblsz_ - 1);
+    }
+    KeyType *p = static_cast<KeyType *>(
+                RISCV_malloc(offsetof(KeyType, str) + len + 1));
+    p->refs = 1;
+    p->hash = hash;
+    memcpy(p->str, key, len + 1);
+    tbl_[idx] = p;
+    if (2 * (++total_) > tblsz_) {
+        resize(2 * tblsz_);
+    }
+    RISCV_mutex_unlock(&mutex_);
+    return p->str;
+}
+
+void KeyPoolType::addref(const AttributePairType *pairs, unsigned cnt) {
+    RISCV_mutex_lock(&mutex_);
+    for (unsigned i = 0; i < cnt; i++) {
+        entry(pairs[i].key_.to_string())->refs++;
+    }
+    RISCV_mutex_unlock(&mutex_);
+}
+
+void KeyPoolType::release(const AttributePairType *pairs, unsigned cnt) {
+    RISCV_mutex_lock(&mutex_);
+    for (unsigned i = 0; i < cnt; i++) {
+        KeyType *p = entry(pairs[i].key_.to_string());
+        if (--p->refs == 0) {
+            remove(p);
+        }
+    }
+    RISCV_mutex_unlock(&mutex_);
+}
+
+KeyPoolType::KeyType *KeyPoolType::entry(const char *str) {
+    return reinterpret_cast<KeyType *>(
+        const_cast<char *>(str) - offsetof(KeyType, str));
+}
+
+/** Linear probing without tombstones: the tail of the cluster is
+ *  shifted into the released slot */
+void KeyPoolType::remove(KeyType *p) {
+    unsigned mask = tblsz_ - 1;
+    unsigned idx = p->hash & mask;
+    while (tbl_[idx] != p) {
+        if (tbl_[idx] == 0) {
+            // Not found: the key wasn't interned by this pool
+            return;
+        }
+        idx = (idx + 1) & mask;
+    }
+    RISCV_free(p);
+    tbl_[idx] = 0;
+    total_--;
+    unsigned n = idx;
+    while (tbl_[n = (n + 1) & mask]) {
+        unsigned home = tbl_[n]->hash & mask;
+        if (((n - home) & mask) >= ((n - idx) & mask)) {
+            tbl_[idx] = tbl_[n];
+            tbl_[n] = 0;
+            idx = n;
+        }
+    }
+}
+
+void KeyPoolType::resize(unsigned sz) {
+    KeyType **old = tbl_;
+    unsigned oldsz = tblsz_;
+    tbl_ = static_cast<KeyType **>(RISCV_malloc(sz * sizeof(KeyType *)));
+    memset(tbl_, 0, sz * sizeof(KeyType *));
+    tblsz_ = sz;
+    for (unsigned i = 0; i < oldsz; i++) {
+        if (old[i] == 0) {
+            continue;
+        }
+        unsigned idx = old[i]->hash & (tblsz_ - 1);
+        while (tbl_[idx]) {
+            idx = (idx + 1) & (tblsz_ - 1);
+        }
+        tbl_[idx] = old[i];
+    }
+    RISCV_free(old);
+}
+
+}  // namespace debugger
@@ -0,0 +1,59 @@
+/*
+ *  Copyright 2018 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "api_core.h"
+
+namespace debugger {
+
+/**
+ * @brief Pool of the dictionary keys.
+ *
+ * Every key is stored once with the number of dictionary items that refer
+ * to it, so keys from the configuration are shared by all the copies and
+ * keys of the temporary trees (RPC requests) are freed with the last
+ * dictionary that uses them. The only instance lives in the core library:
+ * a dictionary created by one plugin may be released by another one.
+ */
+class KeyPoolType {
+ public:
+    KeyPoolType();
+
+    char *intern(const char *key, unsigned len, uint32_t hash);
+    /** Keys of the copied dictionary items */
+    void addref(const AttributePairType *pairs, unsigned cnt);
+    void release(const AttributePairType *pairs, unsigned cnt);
+
+ private:
+    struct KeyType {
+        unsigned refs;
+        uint32_t hash;
+        char str[1];
+    };
+
+    static KeyType *entry(const char *str);
+    void remove(KeyType *p);
+    void resize(unsigned sz);
+
+ private:
+    mutex_def mutex_;
+    unsigned tblsz_;
+    unsigned total_;
+    KeyType **tbl_;
+};
+
+}  // namespace debugger
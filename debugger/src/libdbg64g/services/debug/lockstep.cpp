@@ -0,0 +1,400 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <string.h>
+#include "lockstep.h"
+#include "coreservices/ijtag.h"
+
+namespace debugger {
+
+int LockstepCmdType::isValid(AttributeType *args) {
+    if (!(*args)[0u].is_equal("lockstep")) {
+        return CMD_INVALID;
+    }
+    if (args->size() == 1
+        || (args->size() == 2 && (*args)[1].is_equal("release"))) {
+        return CMD_VALID;
+    }
+    return CMD_WRONG_ARGS;
+}
+
+void LockstepCmdType::exec(AttributeType *args, AttributeType *res) {
+    LockstepService *p = static_cast<LockstepService *>(cmdParent_);
+    if (args->size() == 2) {
+        p->release();
+    }
+    p->getStatus(res);
+}
+
+
+LockstepService::LockstepService(const char *name) : IService(name) {
+    registerInterface(static_cast<IThread *>(this));
+    registerInterface(static_cast<IRetireListener *>(this));
+    registerInterface(static_cast<IAxi4NbResponse *>(this));
+    registerAttribute("Enable", &isEnable_);
+    registerAttribute("CmdExecutor", &cmdexec_);
+    registerAttribute("QueueSize", &queueSize_);
+    registerAttribute("HartsTotal", &hartsTotal_);
+    registerAttribute("FunctionalCpu", &fncCpu_);
+    registerAttribute("RtlCpu", &rtlCpu_);
+
+    isEnable_.make_boolean(true);
+    hartsTotal_.make_int64(1);
+    fncCpu_.make_list(0);
+    iexec_ = 0;
+    pcmd_ = 0;
+    irtldmi_ = 0;
+    qsize_ = 0;
+    harts_ = 0;
+    dmiRData_ = 0;
+    diverged_ = false;
+    released_ = false;
+    compared_ = 0;
+    divergedHart_ = 0;
+    memset(history_, 0, sizeof(history_));
+    memset(divergence_, 0, sizeof(divergence_));
+    memset(&dmitr_, 0, sizeof(dmitr_));
+    for (int i = 0; i < RetireSrc_Total; i++) {
+        queue_[i] = 0;
+    }
+    RISCV_event_create(&eventPushed_, "lockstep_pushed");
+    RISCV_event_create(&eventDmi_, "lockstep_dmi");
+}
+
+LockstepService::~LockstepService() {
+    for (int i = 0; i < RetireSrc_Total; i++) {
+        if (!queue_[i]) {
+            continue;
+        }
+        for (int n = 0; n < harts_; n++) {
+            delete [] queue_[i][n].buf;
+            RISCV_event_close(&queue_[i][n].eventFree);
+        }
+        delete [] queue_[i];
+    }
+    RISCV_event_close(&eventPushed_);
+    RISCV_event_close(&eventDmi_);
+}
+
+void LockstepService::postinitService() {
+    if (!queueSize_.is_integer() || queueSize_.to_int() <= 0) {
+        queueSize_.make_int64(256);
+    }
+    if (!hartsTotal_.is_integer() || hartsTotal_.to_int() <= 0) {
+        hartsTotal_.make_int64(1);
+    }
+    qsize_ = queueSize_.to_uint64();
+    harts_ = hartsTotal_.to_int();
+    for (int i = 0; i < RetireSrc_Total; i++) {
+        queue_[i] = new RetireQueueType[harts_];
+        for (int n = 0; n < harts_; n++) {
+            queue_[i][n].buf = new TraceBinRecordType[qsize_];
+            queue_[i][n].wcnt = 0;
+            queue_[i][n].rcnt = 0;
+            RISCV_event_create(&queue_[i][n].eventFree, "lockstep_free");
+        }
+    }
+
+    iexec_ = static_cast<ICmdExecutor *>
+        (RISCV_get_service_iface(cmdexec_.to_string(), IFACE_CMD_EXECUTOR));
+    if (!iexec_) {
+        RISCV_error("Can't get ICmdExecutor interface %s",
+                    cmdexec_.to_string());
+    } else {
+        pcmd_ = new LockstepCmdType(static_cast<IService *>(this));
+        iexec_->registerCommand(static_cast<ICommand *>(pcmd_));
+    }
+
+    if (rtlCpu_.size()) {
+        irtldmi_ = static_cast<IMemoryOperation *>(
+            RISCV_get_service_port_iface(rtlCpu_.to_string(), "dmi",
+                                         IFACE_MEMORY_OPERATION));
+        if (!irtldmi_) {
+            RISCV_error("Can't get DMI port of %s", rtlCpu_.to_string());
+        }
+    }
+    for (unsigned i = 0; i < fncCpu_.size(); i++) {
+        if (!RISCV_get_service_iface(fncCpu_[i].to_string(), IFACE_DPORT)) {
+            RISCV_error("Can't get IDPort interface %s",
+                        fncCpu_[i].to_string());
+        }
+    }
+
+    if (!isEnable_.to_bool()) {
+        released_ = true;
+        return;
+    }
+    if (!run()) {
+        RISCV_error("Can't create thread.", NULL);
+        released_ = true;
+    }
+}
+
+void LockstepService::predeleteService() {
+    release();
+    if (iexec_ && pcmd_) {
+        iexec_->unregisterCommand(static_cast<ICommand *>(pcmd_));
+        delete pcmd_;
+    }
+}
+
+void LockstepService::stop() {
+    // Models threads may wait in retired() and have to be released first
+    release();
+    IThread::stop();
+}
+
+void LockstepService::release() {
+    released_ = true;
+    for (int i = 0; i < RetireSrc_Total && queue_[i]; i++) {
+        for (int n = 0; n < harts_; n++) {
+            RISCV_event_set(&queue_[i][n].eventFree);
+        }
+    }
+    RISCV_event_set(&eventDmi_);
+}
+
+void LockstepService::retired(int src, int hartid,
+                              const TraceBinRecordType *rec) {
+    if (released_ || diverged_ || hartid < 0 || hartid >= harts_) {
+        // Retired while the debug halt request is in progress
+        return;
+    }
+    RetireQueueType *q = &queue_[src][hartid];
+    // Stall the model while queue is full
+    while (!released_ && !diverged_ && (q->wcnt - q->rcnt) >= qsize_) {
+        RISCV_event_clear(&q->eventFree);
+        if ((q->wcnt - q->rcnt) < qsize_) {
+            break;
+        }
+        RISCV_event_wait_ms(&q->eventFree, 10);
+    }
+    if (released_ || diverged_) {
+        return;
+    }
+    uint64_t wcnt = q->wcnt.load(std::memory_order_relaxed);
+    memcpy(&q->buf[wcnt % qsize_], rec, sizeof(TraceBinRecordType));
+    q->wcnt.store(wcnt + 1, std::memory_order_release);
+    RISCV_event_set(&eventPushed_);
+}
+
+void LockstepService::busyLoop() {
+    while (isEnabled() && !released_) {
+        RISCV_event_clear(&eventPushed_);
+        bool processed = false;
+        for (int n = 0; n < harts_ && !diverged_; n++) {
+            processed |= compare(n);
+        }
+        if (diverged_) {
+            haltModels();
+            break;
+        }
+        if (!processed) {
+            RISCV_event_wait_ms(&eventPushed_, 10);
+        }
+    }
+}
+
+bool LockstepService::compare(int hartid) {
+    RetireQueueType *qref = &queue_[RetireSrc_Reference][hartid];
+    RetireQueueType *qdut = &queue_[RetireSrc_Dut][hartid];
+    TraceBinRecordType *ref;
+    TraceBinRecordType *dut;
+    bool processed = false;
+    uint64_t rref = qref->rcnt.load(std::memory_order_relaxed);
+    uint64_t rdut = qdut->rcnt.load(std::memory_order_relaxed);
+
+    while (rref != qref->wcnt.load(std::memory_order_acquire)
+        && rdut != qdut->wcnt.load(std::memory_order_acquire)) {
+        ref = &qref->buf[rref % qsize_];
+        dut = &qdut->buf[rdut % qsize_];
+        if (!isEqual(ref, dut)) {
+            memcpy(&divergence_[RetireSrc_Reference], ref, sizeof(*ref));
+            memcpy(&divergence_[RetireSrc_Dut], dut, sizeof(*dut));
+            divergedHart_ = hartid;
+            diverged_ = true;
+            RISCV_error("Hart %d divergence after %" RV_PRI64 "d "
+                        "instructions: ref pc=%08" RV_PRI64 "x instr=%08x, "
+                        "dut pc=%08" RV_PRI64 "x instr=%08x",
+                        hartid, compared_.load(),
+                        ref->pc, ref->instr, dut->pc, dut->instr);
+            break;
+        }
+        uint64_t cnt = compared_.load(std::memory_order_relaxed);
+        history_[cnt % HISTORY_SIZE] = ref->pc;
+        compared_.store(cnt + 1);
+        qref->rcnt.store(++rref, std::memory_order_release);
+        qdut->rcnt.store(++rdut, std::memory_order_release);
+        RISCV_event_set(&qref->eventFree);
+        RISCV_event_set(&qdut->eventFree);
+        processed = true;
+    }
+    return processed;
+}
+
+/**
+ * Debug halt of all harts of both models, the same request as the
+ * debugger sends. Stalled producers are released first so that the RTL
+ * thread can process the DMI transactions.
+ */
+void LockstepService::haltModels() {
+    for (int i = 0; i < RetireSrc_Total; i++) {
+        for (int n = 0; n < harts_; n++) {
+            RISCV_event_set(&queue_[i][n].eventFree);
+        }
+    }
+
+    for (unsigned i = 0; i < fncCpu_.size(); i++) {
+        IDPort *idport = static_cast<IDPort *>(
+            RISCV_get_service_iface(fncCpu_[i].to_string(), IFACE_DPORT));
+        if (idport && !idport->isHalted()) {
+            idport->haltreq();
+        }
+    }
+
+    if (!irtldmi_) {
+        return;
+    }
+    IJtag::dmi_dmcontrol_type dmcontrol;
+    IJtag::dmi_dmstatus_type dmstatus;
+    for (int n = 0; n < harts_; n++) {
+        dmcontrol.u32 = 0;
+        dmcontrol.bits.dmactive = 1;
+        dmcontrol.bits.hartsello = n;
+        if (!dmiWrite(IJtag::DMI_DMCONTROL, dmcontrol.u32)
+            || !dmiRead(IJtag::DMI_DMSTATUS, &dmstatus.u32)) {
+            return;
+        }
+        if (dmstatus.bits.allhalted) {
+            // haltreq on halted hart is an error
+            continue;
+        }
+        dmcontrol.bits.haltreq = 1;
+        if (!dmiWrite(IJtag::DMI_DMCONTROL, dmcontrol.u32)) {
+            return;
+        }
+        do {
+            if (!dmiRead(IJtag::DMI_DMSTATUS, &dmstatus.u32)) {
+                return;
+            }
+        } while (!dmstatus.bits.allhalted && !released_);
+        dmcontrol.bits.haltreq = 0;
+        dmiWrite(IJtag::DMI_DMCONTROL, dmcontrol.u32);
+    }
+}
+
+void LockstepService::nb_response(Axi4TransactionType *trans) {
+    dmiRData_ = trans->rpayload.b32[0];
+    RISCV_event_set(&eventDmi_);
+}
+
+bool LockstepService::dmiRead(uint32_t regidx, uint32_t *val) {
+    dmitr_.action = MemAction_Read;
+    dmitr_.addr = irtldmi_->getBaseAddress() + 4 * regidx;
+    dmitr_.xsize = 4;
+    dmitr_.wstrb = 0;
+    RISCV_event_clear(&eventDmi_);
+    irtldmi_->nb_transport(&dmitr_, static_cast<IAxi4NbResponse *>(this));
+    if (RISCV_event_wait_ms(&eventDmi_, 500) != 0 || released_) {
+        RISCV_error("DMI read %02x timeout", regidx);
+        return false;
+    }
+    *val = dmiRData_;
+    return true;
+}
+
+bool LockstepService::dmiWrite(uint32_t regidx, uint32_t val) {
+    dmitr_.action = MemAction_Write;
+    dmitr_.addr = irtldmi_->getBaseAddress() + 4 * regidx;
+    dmitr_.xsize = 4;
+    dmitr_.wstrb = 0xF;
+    dmitr_.wpayload.b32[0] = val;
+    RISCV_event_clear(&eventDmi_);
+    irtldmi_->nb_transport(&dmitr_, static_cast<IAxi4NbResponse *>(this));
+    if (RISCV_event_wait_ms(&eventDmi_, 500) != 0 || released_) {
+        RISCV_error("DMI write %02x timeout", regidx);
+        return false;
+    }
+    return true;
+}
+
+bool LockstepService::isEqual(const TraceBinRecordType *a,
+                              const TraceBinRecordType *b) {
+    if (a->pc != b->pc || a->instr != b->instr
+        || a->regcnt != b->regcnt || a->memcnt != b->memcnt) {
+        return false;
+    }
+    for (int i = 0; i < a->regcnt && i < TRACE_BIN_REG_MAX; i++) {
+        if (a->reg[i].addr != b->reg[i].addr
+            || a->reg[i].data != b->reg[i].data) {
+            return false;
+        }
+    }
+    for (int i = 0; i < a->memcnt && i < TRACE_BIN_MEM_MAX; i++) {
+        if (a->mem[i].addr != b->mem[i].addr
+            || a->mem[i].data != b->mem[i].data
+            || a->mem[i].store != b->mem[i].store) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LockstepService::record2attr(const TraceBinRecordType *rec,
+                                  AttributeType *res) {
+    res->make_dict();
+    (*res)["pc"].make_uint64(rec->pc);
+    (*res)["instr"].make_uint64(rec->instr);
+    (*res)["reg"].make_list(0);
+    for (int i = 0; i < rec->regcnt && i < TRACE_BIN_REG_MAX; i++) {
+        AttributeType item;
+        item.make_list(2);
+        item[0u].make_uint64(rec->reg[i].addr);
+        item[1].make_uint64(rec->reg[i].data);
+        (*res)["reg"].add_to_list(&item);
+    }
+    (*res)["mem"].make_list(0);
+    for (int i = 0; i < rec->memcnt && i < TRACE_BIN_MEM_MAX; i++) {
+        AttributeType item;
+        item.make_list(3);
+        item[0u].make_uint64(rec->mem[i].addr);
+        item[1].make_uint64(rec->mem[i].data);
+        item[2].make_boolean(rec->mem[i].store != 0);
+        (*res)["mem"].add_to_list(&item);
+    }
+}
+
+void LockstepService::getStatus(AttributeType *res) {
+    uint64_t cnt = compared_;
+    bool diverged = diverged_;
+    res->make_dict();
+    (*res)["Compared"].make_uint64(cnt);
+    (*res)["Diverged"].make_boolean(diverged);
+    (*res)["Released"].make_boolean(released_);
+    (*res)["History"].make_list(0);
+    for (uint64_t i = cnt > HISTORY_SIZE ? cnt - HISTORY_SIZE : 0; i < cnt; i++) {
+        AttributeType pc;
+        pc.make_uint64(history_[i % HISTORY_SIZE]);
+        (*res)["History"].add_to_list(&pc);
+    }
+    if (diverged) {
+        (*res)["Hart"].make_int64(divergedHart_);
+        record2attr(&divergence_[RetireSrc_Reference], &(*res)["Reference"]);
+        record2attr(&divergence_[RetireSrc_Dut], &(*res)["Dut"]);
+    }
+}
+
+}  // namespace debugger
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <iclass.h>
+#include <iservice.h>
+#include "coreservices/ithread.h"
+#include "coreservices/icmdexec.h"
+#include "coreservices/iretire.h"
+#include "coreservices/imemop.h"
+#include "coreservices/idport.h"
+#include <atomic>
+
+namespace debugger {
+
+class LockstepCmdType : public ICommand {
+ public:
+    LockstepCmdType(IService *parent) : ICommand(parent, "lockstep") {
+        briefDescr_.make_string("Lockstep comparator status.");
+        detailedDescr_.make_string(
+            "Description:\n"
+            "    Functional and RTL models stream retired instructions into\n"
+            "    the comparator, each hart separately. Both models are\n"
+            "    halted through their debug interfaces on the first\n"
+            "    divergence, this command returns the number of compared\n"
+            "    instructions, pc history and the mismatching records.\n"
+            "    'release' disables the comparison, models stay halted.\n"
+            "Usage:\n"
+            "    lockstep\n"
+            "    lockstep release\n"
+            "Example:\n"
+            "    lockstep\n"
+            "    lockstep release");
+    }
+
+    /** ICommand */
+    virtual int isValid(AttributeType *args);
+    virtual void exec(AttributeType *args, AttributeType *res);
+};
+
+
+class LockstepService : public IService,
+                        public IThread,
+                        public IRetireListener,
+                        public IAxi4NbResponse {
+ public:
+    explicit LockstepService(const char *name);
+    virtual ~LockstepService();
+
+    /** IService interface */
+    virtual void postinitService() override;
+    virtual void predeleteService() override;
+
+    /** IThread */
+    virtual void stop() override;
+
+    /** IRetireListener */
+    virtual void retired(int src, int hartid,
+                         const TraceBinRecordType *rec) override;
+
+    /** IAxi4NbResponse */
+    virtual void nb_response(Axi4TransactionType *trans) override;
+
+    /** Common commands access methods */
+    void getStatus(AttributeType *res);
+    void release();
+
+ protected:
+    /** IThread interface */
+    virtual void busyLoop() override;
+
+ private:
+    bool compare(int hartid);
+    bool isEqual(const TraceBinRecordType *a, const TraceBinRecordType *b);
+    void record2attr(const TraceBinRecordType *rec, AttributeType *res);
+    void haltModels();
+    bool dmiRead(uint32_t regidx, uint32_t *val);
+    bool dmiWrite(uint32_t regidx, uint32_t val);
+
+    static const int HISTORY_SIZE = 8;
+
+    // Single producer/single consumer ring, producer is the hart of a model
+    struct RetireQueueType {
+        TraceBinRecordType *buf;
+        std::atomic<uint64_t> wcnt;
+        std::atomic<uint64_t> rcnt;
+        event_def eventFree;
+    };
+
+    AttributeType isEnable_;
+    AttributeType cmdexec_;
+    AttributeType queueSize_;
+    AttributeType hartsTotal_;
+    AttributeType fncCpu_;
+    AttributeType rtlCpu_;
+
+    ICmdExecutor *iexec_;
+    LockstepCmdType *pcmd_;
+    IMemoryOperation *irtldmi_;
+
+    uint64_t qsize_;
+    int harts_;
+    RetireQueueType *queue_[RetireSrc_Total];   // harts_ entries per model
+    event_def eventPushed_;
+    event_def eventDmi_;
+    Axi4TransactionType dmitr_;
+    uint32_t dmiRData_;
+    std::atomic<bool> diverged_;
+    std::atomic<bool> released_;
+    std::atomic<uint64_t> compared_;
+    int divergedHart_;
+    uint64_t history_[HISTORY_SIZE];    // pc of the last matched instructions
+    TraceBinRecordType divergence_[RetireSrc_Total];
+};
+
+DECLARE_CLASS(LockstepService)
+
+}  // namespace debugger
@@ -35,7 +35,13 @@ OpenOcdWrapper::OpenOcdWrapper(const char *name)
     cmdRead_(this, static_cast<IJtag *>(this)),
     cmdWrite_(this, static_cast<IJtag *>(this)),
     cmdExit_(this, static_cast<IJtag *>(this)),
-    cmdLog_(this, static_cast<IJtag *>(this)) {
+    cmdLog_(this, static_cast<IJtag *>(this)),
+    cmdPerf_(this, static_cast<IJtag *>(this)),
+    cmdMemJob_(this),
+    cmdMemDump_(this, static_cast<IJtag *>(this), &cmdMemJob_),
+    cmdLoadBin_(this, static_cast<IJtag *>(this), &cmdMemJob_),
+    cmdLoadSrec_(this, static_cast<IJtag *>(this), &cmdMemJob_),
+    cmdLoadH86_(this, static_cast<IJtag *>(this), &cmdMemJob_) {
     registerInterface(static_cast<IJtag *>(this));
     registerAttribute("CmdExecutor", &cmdexec_);
     registerAttribute("PollingMs", &pollingMs_);
@@ -76,6 +82,12 @@ void OpenOcdWrapper::postinitService() {
         icmdexec_->registerCommand(&cmdRead_);
         icmdexec_->registerCommand(&cmdWrite_);
         icmdexec_->registerCommand(&cmdExit_);
+        icmdexec_->registerCommand(&cmdPerf_);
+        icmdexec_->registerCommand(&cmdMemJob_);
+        icmdexec_->registerCommand(&cmdMemDump_);
+        icmdexec_->registerCommand(&cmdLoadBin_);
+        icmdexec_->registerCommand(&cmdLoadSrec_);
+        icmdexec_->registerCommand(&cmdLoadH86_);
     }
 
     // Run openocd as an external process using execv
@@ -95,6 +107,9 @@ void OpenOcdWrapper::postinitService() {
 }
 
 void OpenOcdWrapper::predeleteService() {
+    // background memory job uses the command executor
+    cmdMemJob_.stop();
+    cmdMemJob_.join(1000);
     if (icmdexec_) {
         icmdexec_->unregisterCommand(&cmdInit_);
         icmdexec_->unregisterCommand(&cmdReset_);
@@ -105,6 +120,12 @@ void OpenOcdWrapper::predeleteService() {
         icmdexec_->unregisterCommand(&cmdRead_);
         icmdexec_->unregisterCommand(&cmdWrite_);
         icmdexec_->unregisterCommand(&cmdExit_);
+        icmdexec_->unregisterCommand(&cmdPerf_);
+        icmdexec_->unregisterCommand(&cmdMemJob_);
+        icmdexec_->unregisterCommand(&cmdMemDump_);
+        icmdexec_->unregisterCommand(&cmdLoadBin_);
+        icmdexec_->unregisterCommand(&cmdLoadSrec_);
+        icmdexec_->unregisterCommand(&cmdLoadH86_);
     }
 }
 
@@ -35,12 +35,14 @@
 #include "../exec/cmd/cmd_write.h"
 #include "../exec/cmd/cmd_exit.h"
 #include "../exec/cmd/cmd_log.h"
+#include "../exec/cmd/cmd_perf.h"
+#include "../exec/cmd/memstream.h"
+#include "../exec/cmd/cmd_loadh86.h"
+#include "../exec/cmd/cmd_loadsrec.h"
+#include "../exec/cmd/cmd_memdump.h"
+#include "../exec/cmd/cmd_loadbin.h"
 //#include "cmd/cmd_loadelf.h"
-//#include "cmd/cmd_loadh86.h"
-//#include "cmd/cmd_loadsrec.h"
-//#include "cmd/cmd_memdump.h"
 //#include "cmd/cmd_cpi.h"
-//#include "cmd/cmd_loadbin.h"
 //#include "cmd/cmd_elf2raw.h"
 //#include "cmd/cmd_cpucontext.h"
 #include <string>
@@ -130,6 +132,12 @@ class OpenOcdWrapper : public TcpClient,
     CmdWrite cmdWrite_;
     CmdExit cmdExit_;
     CmdLog cmdLog_;
+    CmdPerf cmdPerf_;
+    CmdMemJob cmdMemJob_;
+    CmdMemDump cmdMemDump_;
+    CmdLoadBin cmdLoadBin_;
+    CmdLoadSrec cmdLoadSrec_;
+    CmdLoadH86 cmdLoadH86_;
 
     event_def config_done_;
     event_def eventJtagScanEnd_;
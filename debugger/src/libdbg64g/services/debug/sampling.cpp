@@ -0,0 +1,656 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <string.h>
+#include <math.h>
+#include "sampling.h"
+#include "coreservices/ijtag.h"
+#include "riscv-isa.h"
+
+namespace debugger {
+
+int SamplingCmdType::isValid(AttributeType *args) {
+    if (!(*args)[0u].is_equal("sample")) {
+        return CMD_INVALID;
+    }
+    if (args->size() == 1
+        || (args->size() == 2 && ((*args)[1].is_equal("start")
+                                 || (*args)[1].is_equal("stop")))) {
+        return CMD_VALID;
+    }
+    return CMD_WRONG_ARGS;
+}
+
+void SamplingCmdType::exec(AttributeType *args, AttributeType *res) {
+    SamplingService *p = static_cast<SamplingService *>(cmdParent_);
+    if (args->size() == 2 && (*args)[1].is_equal("start")) {
+        if (!p->isConfigured()) {
+            generateError(res, "Wrong configuration, see log");
+            return;
+        }
+        if (!p->start()) {
+            generateError(res, "Sampling is already running");
+            return;
+        }
+    } else if (args->size() == 2) {
+        p->abort();
+    }
+    p->getStatus(res);
+}
+
+
+/** Transferred CSRs. mstatus goes first to enable FPU before fcsr write */
+const uint32_t SamplingService::CSR_LIST[] = {
+    ICpuRiscV::CSR_mstatus,
+    ICpuRiscV::CSR_medeleg,
+    ICpuRiscV::CSR_mideleg,
+    ICpuRiscV::CSR_mie,
+    ICpuRiscV::CSR_mtvec,
+    0x306,                          // mcounteren
+    ICpuRiscV::CSR_mscratch,
+    ICpuRiscV::CSR_mepc,
+    ICpuRiscV::CSR_mcause,
+    ICpuRiscV::CSR_mtval,
+    0x105,                          // stvec
+    0x106,                          // scounteren
+    0x140,                          // sscratch
+    ICpuRiscV::CSR_sepc,
+    0x142,                          // scause
+    0x143,                          // stval
+    ICpuRiscV::CSR_satp,
+    ICpuRiscV::CSR_pmpcfg0,
+    ICpuRiscV::CSR_pmpcfg0 + 2,
+    ICpuRiscV::CSR_pmpaddr0 + 0,
+    ICpuRiscV::CSR_pmpaddr0 + 1,
+    ICpuRiscV::CSR_pmpaddr0 + 2,
+    ICpuRiscV::CSR_pmpaddr0 + 3,
+    ICpuRiscV::CSR_pmpaddr0 + 4,
+    ICpuRiscV::CSR_pmpaddr0 + 5,
+    ICpuRiscV::CSR_pmpaddr0 + 6,
+    ICpuRiscV::CSR_pmpaddr0 + 7,
+    ICpuRiscV::CSR_pmpaddr0 + 8,
+    ICpuRiscV::CSR_pmpaddr0 + 9,
+    ICpuRiscV::CSR_pmpaddr0 + 10,
+    ICpuRiscV::CSR_pmpaddr0 + 11,
+    ICpuRiscV::CSR_pmpaddr0 + 12,
+    ICpuRiscV::CSR_pmpaddr0 + 13,
+    ICpuRiscV::CSR_pmpaddr0 + 14,
+    ICpuRiscV::CSR_pmpaddr0 + 15,
+    0
+};
+
+SamplingService::SamplingService(const char *name) : IService(name) {
+    registerInterface(static_cast<IThread *>(this));
+    registerInterface(static_cast<IClockListener *>(this));
+    registerInterface(static_cast<IAxi4NbResponse *>(this));
+    registerAttribute("CmdExecutor", &cmdexec_);
+    registerAttribute("FunctionalCpu", &fncCpu_);
+    registerAttribute("RtlCpu", &rtlCpu_);
+    registerAttribute("FunctionalBus", &fncBus_);
+    registerAttribute("RtlBus", &rtlBus_);
+    registerAttribute("MemoryRegions", &memRegions_);
+    registerAttribute("StartStep", &startStep_);
+    registerAttribute("StartPC", &startPC_);
+    registerAttribute("Period", &period_);
+    registerAttribute("Samples", &samples_);
+    registerAttribute("WarmupCycles", &warmupCycles_);
+    registerAttribute("DetailCycles", &detailCycles_);
+
+    memRegions_.make_list(0);
+    startStep_.make_uint64(0);
+    startPC_.make_list(0);
+    period_.make_uint64(1000000);
+    samples_.make_uint64(1);
+    warmupCycles_.make_uint64(10000);
+    detailCycles_.make_uint64(10000);
+    iexec_ = 0;
+    pcmd_ = 0;
+    ifncclk_ = 0;
+    ifncdport_ = 0;
+    ifncriscv_ = 0;
+    ifnccpu_ = 0;
+    irtlclk_ = 0;
+    irtldmi_ = 0;
+    ifncbus_ = 0;
+    irtlbus_ = 0;
+    dmiRData_ = 0;
+    stage_ = Stage_Idle;
+    startReq_ = false;
+    abortReq_ = false;
+    targetPC_ = 0;
+    targetInstret_ = 0;
+    usePC_ = false;
+    memset(&dmitr_, 0, sizeof(dmitr_));
+    RISCV_event_create(&eventStart_, "sampling_start");
+    RISCV_event_create(&eventClock_, "sampling_clock");
+    RISCV_event_create(&eventDmi_, "sampling_dmi");
+    RISCV_mutex_init(&mutexResults_);
+}
+
+SamplingService::~SamplingService() {
+    RISCV_event_close(&eventStart_);
+    RISCV_event_close(&eventClock_);
+    RISCV_event_close(&eventDmi_);
+    RISCV_mutex_destroy(&mutexResults_);
+}
+
+void SamplingService::postinitService() {
+    iexec_ = static_cast<ICmdExecutor *>
+        (RISCV_get_service_iface(cmdexec_.to_string(), IFACE_CMD_EXECUTOR));
+    if (!iexec_) {
+        RISCV_error("Can't get ICmdExecutor interface %s",
+                    cmdexec_.to_string());
+    } else {
+        pcmd_ = new SamplingCmdType(static_cast<IService *>(this));
+        iexec_->registerCommand(static_cast<ICommand *>(pcmd_));
+    }
+
+    const char *fnc = fncCpu_.to_string();
+    ifncclk_ = static_cast<IClock *>(RISCV_get_service_iface(fnc, IFACE_CLOCK));
+    ifncdport_ = static_cast<IDPort *>(RISCV_get_service_iface(fnc, IFACE_DPORT));
+    ifncriscv_ = static_cast<ICpuRiscV *>(
+        RISCV_get_service_iface(fnc, IFACE_CPU_RISCV));
+    ifnccpu_ = static_cast<ICpuFunctional *>(
+        RISCV_get_service_iface(fnc, IFACE_CPU_FUNCTIONAL));
+    if (!ifncclk_ || !ifncdport_ || !ifncriscv_ || !ifnccpu_) {
+        RISCV_error("Can't get functional CPU interfaces %s", fnc);
+        return;
+    }
+
+    const char *rtl = rtlCpu_.to_string();
+    irtlclk_ = static_cast<IClock *>(RISCV_get_service_iface(rtl, IFACE_CLOCK));
+    irtldmi_ = static_cast<IMemoryOperation *>(
+        RISCV_get_service_port_iface(rtl, "dmi", IFACE_MEMORY_OPERATION));
+    if (!irtlclk_ || !irtldmi_) {
+        RISCV_error("Can't get RTL CPU interfaces %s", rtl);
+        return;
+    }
+
+    // RTL windows execute stores ahead of the functional model, so they
+    // must not modify the memory that the functional model continues with
+    if (!fncBus_.size() || !rtlBus_.size()
+        || strcmp(fncBus_.to_string(), rtlBus_.to_string()) == 0) {
+        RISCV_error("RTL model requires a separate bus and memory, "
+                    "FunctionalBus='%s' RtlBus='%s'",
+                    fncBus_.to_string(), rtlBus_.to_string());
+        return;
+    }
+    ifncbus_ = static_cast<IMemoryOperation *>(RISCV_get_service_iface(
+        fncBus_.to_string(), IFACE_MEMORY_OPERATION));
+    irtlbus_ = static_cast<IMemoryOperation *>(RISCV_get_service_iface(
+        rtlBus_.to_string(), IFACE_MEMORY_OPERATION));
+    if (!ifncbus_ || !irtlbus_) {
+        RISCV_error("Can't get bus interfaces %s, %s",
+                    fncBus_.to_string(), rtlBus_.to_string());
+        ifncbus_ = 0;
+        irtlbus_ = 0;
+        return;
+    }
+
+    if (!run()) {
+        RISCV_error("Can't create thread.", NULL);
+    }
+}
+
+void SamplingService::predeleteService() {
+    abort();
+    if (iexec_ && pcmd_) {
+        iexec_->unregisterCommand(static_cast<ICommand *>(pcmd_));
+        delete pcmd_;
+    }
+}
+
+void SamplingService::stop() {
+    abort();
+    IThread::stop();
+    RISCV_event_set(&eventStart_);
+}
+
+bool SamplingService::start() {
+    if (!irtlbus_) {
+        return false;
+    }
+    if (startReq_ || stage_ == Stage_FastForward || stage_ == Stage_Detail) {
+        return false;
+    }
+    abortReq_ = false;
+    startReq_ = true;
+    RISCV_event_set(&eventStart_);
+    return true;
+}
+
+void SamplingService::abort() {
+    abortReq_ = true;
+    RISCV_event_set(&eventClock_);
+    RISCV_event_set(&eventDmi_);
+}
+
+void SamplingService::busyLoop() {
+    while (isEnabled()) {
+        if (RISCV_event_wait_ms(&eventStart_, 500) != 0) {
+            continue;
+        }
+        RISCV_event_clear(&eventStart_);
+        if (!startReq_ || !irtldmi_ || !ifnccpu_ || !irtlbus_) {
+            startReq_ = false;
+            continue;
+        }
+        RISCV_mutex_lock(&mutexResults_);
+        results_.clear();
+        RISCV_mutex_unlock(&mutexResults_);
+
+        usePC_ = startPC_.is_integer();
+        targetPC_ = startPC_.to_uint64();
+        uint64_t target = startStep_.to_uint64();
+        bool ok = true;
+        for (uint64_t i = 0; ok && i < samples_.to_uint64(); i++) {
+            ok = runSample(target);
+            usePC_ = false;
+            target = instret() + period_.to_uint64();
+        }
+        stage_ = ok ? Stage_Done : Stage_Error;
+        startReq_ = false;
+    }
+}
+
+bool SamplingService::runSample(uint64_t target) {
+    ArchStateType st;
+    SampleType s;
+    uint64_t c0, i0, c1, i1;
+
+    if (!fastForward(target)) {
+        return false;
+    }
+    snapshot(&st);
+    if (!inject(&st)) {
+        return false;
+    }
+    // Warm-up window fills caches and predictors with the sample context
+    if (!runRtl(warmupCycles_.to_uint64())) {
+        return false;
+    }
+    if (!dmiReadReg(ICpuRiscV::CSR_mcycle, &c0)
+        || !dmiReadReg(ICpuRiscV::CSR_minsret, &i0)) {
+        return false;
+    }
+    if (!runRtl(detailCycles_.to_uint64())) {
+        return false;
+    }
+    if (!dmiReadReg(ICpuRiscV::CSR_mcycle, &c1)
+        || !dmiReadReg(ICpuRiscV::CSR_minsret, &i1)) {
+        return false;
+    }
+    s.step = st.instret;
+    s.pc = st.pc;
+    s.cycles = c1 - c0;
+    s.instret = i1 - i0;
+    RISCV_mutex_lock(&mutexResults_);
+    results_.push_back(s);
+    RISCV_mutex_unlock(&mutexResults_);
+    RISCV_info("Sample at pc=%08" RV_PRI64 "x: %" RV_PRI64 "d cycles, "
+               "%" RV_PRI64 "d instructions", s.pc, s.cycles, s.instret);
+    return true;
+}
+
+bool SamplingService::waitEvent(event_def *ev) {
+    while (isEnabled() && !abortReq_) {
+        if (RISCV_event_wait_ms(ev, 100) == 0) {
+            return !abortReq_;
+        }
+    }
+    return false;
+}
+
+/**
+ * Clock of the functional model counts cycles when its timing model is
+ * enabled, so the target is set in retired instructions and the callback
+ * is re-armed until the counter reaches it: every instruction takes at
+ * least one step, the callback never fires too late.
+ */
+bool SamplingService::fastForward(uint64_t target) {
+    uint64_t t = ifncclk_->getStepCounter();
+    uint64_t cnt = instret();
+    stage_ = Stage_FastForward;
+    targetInstret_ = target;
+    RISCV_event_clear(&eventClock_);
+    if (usePC_) {
+        // Check pc on every step until the condition is met
+        ifncclk_->registerStepCallback(static_cast<IClockListener *>(this),
+                                       t + 1);
+    } else {
+        ifncclk_->registerStepCallback(static_cast<IClockListener *>(this),
+                                       target > cnt ? t + (target - cnt)
+                                                    : t + 1);
+    }
+    if (ifncdport_->isHalted()) {
+        ifncdport_->resumereq();
+    }
+    if (!waitEvent(&eventClock_)) {
+        return false;
+    }
+    while (!ifncdport_->isHalted()) {
+        if (!isEnabled() || abortReq_) {
+            return false;
+        }
+        RISCV_sleep_ms(1);
+    }
+    return true;
+}
+
+void SamplingService::stepCallback(uint64_t t) {
+    if (stage_ == Stage_FastForward) {
+        if (usePC_ && ifnccpu_->getPC() != targetPC_ && !abortReq_) {
+            ifncclk_->registerStepCallback(
+                static_cast<IClockListener *>(this), t + 1);
+            return;
+        }
+        uint64_t cnt = instret();
+        if (!usePC_ && cnt < targetInstret_ && !abortReq_) {
+            ifncclk_->registerStepCallback(
+                static_cast<IClockListener *>(this),
+                t + (targetInstret_ - cnt));
+            return;
+        }
+        ifncdport_->haltreq();
+    }
+    RISCV_event_set(&eventClock_);
+}
+
+uint64_t SamplingService::instret() {
+    return ifncriscv_->readCSR(ICpuRiscV::CSR_minsret);
+}
+
+void SamplingService::snapshot(ArchStateType *st) {
+    st->pc = ifncriscv_->readCSR(ICpuRiscV::CSR_dpc);
+    st->instret = instret();
+    st->prv = ifnccpu_->getPrvLevel();
+    for (int i = 0; i < 32; i++) {
+        st->xreg[i] = ifncriscv_->readGPR(i);
+    }
+    // misa 'F' or 'D' extension
+    st->fpu = (ifncriscv_->readCSR(ICpuRiscV::CSR_misa) & 0x28) != 0;
+    for (int i = 0; st->fpu && i < 32; i++) {
+        st->freg[i] = ifncriscv_->readGPR(ICpuRiscV::RegFpu_Offset + i);
+    }
+    st->csr.clear();
+    for (const uint32_t *p = CSR_LIST; *p; p++) {
+        st->csr.push_back(ifncriscv_->readCSR(*p));
+    }
+}
+
+bool SamplingService::inject(const ArchStateType *st) {
+    csr_dcsr_type dcsr;
+    uint64_t val;
+
+    if (!dmiHalt()) {
+        return false;
+    }
+    if (!copyMemory()) {
+        return false;
+    }
+    for (unsigned i = 0; CSR_LIST[i]; i++) {
+        if (!dmiWriteReg(CSR_LIST[i], st->csr[i])) {
+            RISCV_error("Can't write CSR %03x", CSR_LIST[i]);
+            return false;
+        }
+    }
+    for (int i = 1; i < 32; i++) {
+        if (!dmiWriteReg(0x1000 + i, st->xreg[i])) {
+            return false;
+        }
+    }
+    if (st->fpu) {
+        if (!dmiWriteReg(ICpuRiscV::CSR_fcsr,
+                         ifncriscv_->readCSR(ICpuRiscV::CSR_fcsr))) {
+            return false;
+        }
+        for (int i = 0; i < 32; i++) {
+            if (!dmiWriteReg(0x1020 + i, st->freg[i])) {
+                return false;
+            }
+        }
+    }
+    if (!dmiWriteReg(ICpuRiscV::CSR_dpc, st->pc)
+        || !dmiReadReg(ICpuRiscV::CSR_dcsr, &val)) {
+        return false;
+    }
+    // Privilege level restored on resume, counters frozen while halted
+    dcsr.u64 = val;
+    dcsr.bits.prv = st->prv;
+    dcsr.bits.stopcount = 1;
+    return dmiWriteReg(ICpuRiscV::CSR_dcsr, dcsr.u64);
+}
+
+bool SamplingService::copyMemory() {
+    Axi4TransactionType tr;
+    memset(&tr, 0, sizeof(tr));
+    tr.xsize = 8;
+    tr.wstrb = 0xFF;
+    for (unsigned i = 0; i < memRegions_.size(); i++) {
+        AttributeType &item = memRegions_[i];
+        uint64_t addr = item[0u].to_uint64();
+        uint64_t end = addr + item[1].to_uint64();
+        for (; addr < end; addr += 8) {
+            tr.addr = addr;
+            tr.action = MemAction_Read;
+            if (ifncbus_->b_transport(&tr) != TRANS_OK) {
+                RISCV_error("Can't read %08" RV_PRI64 "x", addr);
+                return false;
+            }
+            tr.wpayload.b64[0] = tr.rpayload.b64[0];
+            tr.action = MemAction_Write;
+            irtlbus_->b_transport(&tr);
+        }
+    }
+    return true;
+}
+
+bool SamplingService::runRtl(uint64_t cycles) {
+    if (cycles == 0) {
+        return true;
+    }
+    stage_ = Stage_Detail;
+    RISCV_event_clear(&eventClock_);
+    irtlclk_->registerStepCallback(static_cast<IClockListener *>(this),
+                                   irtlclk_->getStepCounter() + cycles);
+    if (!dmiResume()) {
+        return false;
+    }
+    if (!waitEvent(&eventClock_)) {
+        return false;
+    }
+    return dmiHalt();
+}
+
+void SamplingService::nb_response(Axi4TransactionType *trans) {
+    dmiRData_ = trans->rpayload.b32[0];
+    RISCV_event_set(&eventDmi_);
+}
+
+bool SamplingService::dmiRead(uint32_t regidx, uint32_t *val) {
+    dmitr_.action = MemAction_Read;
+    dmitr_.addr = irtldmi_->getBaseAddress() + 4 * regidx;
+    dmitr_.xsize = 4;
+    dmitr_.wstrb = 0;
+    RISCV_event_clear(&eventDmi_);
+    irtldmi_->nb_transport(&dmitr_, static_cast<IAxi4NbResponse *>(this));
+    if (RISCV_event_wait_ms(&eventDmi_, 500) != 0 || abortReq_) {
+        RISCV_error("DMI read %02x timeout", regidx);
+        return false;
+    }
+    *val = dmiRData_;
+    return true;
+}
+
+bool SamplingService::dmiWrite(uint32_t regidx, uint32_t val) {
+    dmitr_.action = MemAction_Write;
+    dmitr_.addr = irtldmi_->getBaseAddress() + 4 * regidx;
+    dmitr_.xsize = 4;
+    dmitr_.wstrb = 0xF;
+    dmitr_.wpayload.b32[0] = val;
+    RISCV_event_clear(&eventDmi_);
+    irtldmi_->nb_transport(&dmitr_, static_cast<IAxi4NbResponse *>(this));
+    if (RISCV_event_wait_ms(&eventDmi_, 500) != 0 || abortReq_) {
+        RISCV_error("DMI write %02x timeout", regidx);
+        return false;
+    }
+    return true;
+}
+
+bool SamplingService::dmiHalt() {
+    IJtag::dmi_dmcontrol_type dmcontrol;
+    IJtag::dmi_dmstatus_type dmstatus;
+    if (!dmiRead(IJtag::DMI_DMSTATUS, &dmstatus.u32)) {
+        return false;
+    }
+    if (dmstatus.bits.allhalted) {
+        // haltreq on halted hart is an error
+        return true;
+    }
+    dmcontrol.u32 = 0;
+    dmcontrol.bits.dmactive = 1;
+    dmcontrol.bits.haltreq = 1;
+    if (!dmiWrite(IJtag::DMI_DMCONTROL, dmcontrol.u32)) {
+        return false;
+    }
+    do {
+        if (!dmiRead(IJtag::DMI_DMSTATUS, &dmstatus.u32)) {
+            return false;
+        }
+    } while (!dmstatus.bits.allhalted);
+    dmcontrol.bits.haltreq = 0;
+    return dmiWrite(IJtag::DMI_DMCONTROL, dmcontrol.u32);
+}
+
+bool SamplingService::dmiResume() {
+    IJtag::dmi_dmcontrol_type dmcontrol;
+    IJtag::dmi_dmstatus_type dmstatus;
+    dmcontrol.u32 = 0;
+    dmcontrol.bits.dmactive = 1;
+    dmcontrol.bits.resumereq = 1;
+    if (!dmiWrite(IJtag::DMI_DMCONTROL, dmcontrol.u32)) {
+        return false;
+    }
+    do {
+        if (!dmiRead(IJtag::DMI_DMSTATUS, &dmstatus.u32)) {
+            return false;
+        }
+    } while (!dmstatus.bits.allresumeack);
+    return true;
+}
+
+bool SamplingService::dmiCommand(uint32_t cmd) {
+    IJtag::dmi_abstractcs_type abstractcs;
+    if (!dmiWrite(IJtag::DMI_COMMAND, cmd)) {
+        return false;
+    }
+    do {
+        if (!dmiRead(IJtag::DMI_ABSTRACTCS, &abstractcs.u32)) {
+            return false;
+        }
+    } while (abstractcs.bits.busy);
+    if (abstractcs.bits.cmderr) {
+        uint32_t cmderr = abstractcs.bits.cmderr;
+        abstractcs.u32 = 0;
+        abstractcs.bits.cmderr = 1;     // W1C bit to clear sticky cmderr
+        dmiWrite(IJtag::DMI_ABSTRACTCS, abstractcs.u32);
+        RISCV_error("Abstract command %08x error %d", cmd, cmderr);
+        return false;
+    }
+    return true;
+}
+
+bool SamplingService::dmiReadReg(uint32_t regno, uint64_t *val) {
+    IJtag::dmi_command_type command;
+    Reg64Type r64;
+    command.u32 = 0;
+    command.regaccess.aarsize = IJtag::CMD_AAxSIZE_64BITS;
+    command.regaccess.transfer = 1;
+    command.regaccess.regno = regno;
+    if (!dmiCommand(command.u32)
+        || !dmiRead(IJtag::DMI_ABSTRACT_DATA0, &r64.buf32[0])
+        || !dmiRead(IJtag::DMI_ABSTRACT_DATA1, &r64.buf32[1])) {
+        return false;
+    }
+    *val = r64.val;
+    return true;
+}
+
+bool SamplingService::dmiWriteReg(uint32_t regno, uint64_t val) {
+    IJtag::dmi_command_type command;
+    Reg64Type r64;
+    r64.val = val;
+    if (!dmiWrite(IJtag::DMI_ABSTRACT_DATA0, r64.buf32[0])
+        || !dmiWrite(IJtag::DMI_ABSTRACT_DATA1, r64.buf32[1])) {
+        return false;
+    }
+    command.u32 = 0;
+    command.regaccess.aarsize = IJtag::CMD_AAxSIZE_64BITS;
+    command.regaccess.transfer = 1;
+    command.regaccess.write = 1;
+    command.regaccess.regno = regno;
+    return dmiCommand(command.u32);
+}
+
+void SamplingService::getStatus(AttributeType *res) {
+    static const char *STAGE_NAMES[] = {
+        "Idle", "FastForward", "Detail", "Done", "Error"
+    };
+    AttributeType item;
+    double sum = 0;
+    double sum2 = 0;
+
+    res->make_dict();
+    (*res)["Stage"].make_string(STAGE_NAMES[stage_]);
+    (*res)["Samples"].make_list(0);
+
+    RISCV_mutex_lock(&mutexResults_);
+    size_t n = 0;
+    for (size_t i = 0; i < results_.size(); i++) {
+        const SampleType &s = results_[i];
+        double cpi = s.instret ? static_cast<double>(s.cycles) / s.instret : 0;
+        item.make_list(5);
+        item[0u].make_uint64(s.step);
+        item[1].make_uint64(s.pc);
+        item[2].make_uint64(s.cycles);
+        item[3].make_uint64(s.instret);
+        item[4].make_floating(cpi);
+        (*res)["Samples"].add_to_list(&item);
+        if (s.instret) {
+            sum += cpi;
+            sum2 += cpi * cpi;
+            n++;
+        }
+    }
+    RISCV_mutex_unlock(&mutexResults_);
+
+    // Sample mean with 95% confidence interval of the normal approximation
+    double mean = n ? sum / n : 0;
+    double stddev = 0;
+    if (n > 1) {
+        double var = (sum2 - n * mean * mean) / (n - 1);
+        stddev = var > 0 ? sqrt(var) : 0;
+    }
+    double ci = n ? 1.96 * stddev / sqrt(static_cast<double>(n)) : 0;
+    (*res)["CPI"].make_floating(mean);
+    (*res)["StdDev"].make_floating(stddev);
+    (*res)["CI95"].make_list(2);
+    (*res)["CI95"][0u].make_floating(mean - ci);
+    (*res)["CI95"][1].make_floating(mean + ci);
+    (*res)["RelativeError"].make_floating(mean > 0 ? ci / mean : 0);
+}
+
+}  // namespace debugger
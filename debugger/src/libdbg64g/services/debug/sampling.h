@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <iclass.h>
+#include <iservice.h>
+#include "coreservices/ithread.h"
+#include "coreservices/icmdexec.h"
+#include "coreservices/iclock.h"
+#include "coreservices/imemop.h"
+#include "coreservices/idport.h"
+#include "coreservices/icpuriscv.h"
+#include "coreservices/icpufunctional.h"
+#include <vector>
+
+namespace debugger {
+
+class SamplingCmdType : public ICommand {
+ public:
+    SamplingCmdType(IService *parent) : ICommand(parent, "sample") {
+        briefDescr_.make_string("Sampled CPI measurement on RTL model.");
+        detailedDescr_.make_string(
+            "Description:\n"
+            "    Functional model fast-forwards to the start point, its\n"
+            "    architectural state and memory are transferred into the\n"
+            "    RTL model that runs warm-up and detailed windows. Sampling\n"
+            "    repeats every 'Period' retired instructions of the\n"
+            "    functional model, the response contains CPI of each\n"
+            "    sample, mean value and 95% confidence interval.\n"
+            "    Only 'MemoryRegions' are transferred: RTL model must have\n"
+            "    its own peripherals on 'RtlBus', their state is not\n"
+            "    restored between samples.\n"
+            "Usage:\n"
+            "    sample\n"
+            "    sample start\n"
+            "    sample stop\n"
+            "Example:\n"
+            "    sample start\n"
+            "    sample");
+    }
+
+    /** ICommand */
+    virtual int isValid(AttributeType *args);
+    virtual void exec(AttributeType *args, AttributeType *res);
+};
+
+
+class SamplingService : public IService,
+                        public IThread,
+                        public IClockListener,
+                        public IAxi4NbResponse {
+ public:
+    explicit SamplingService(const char *name);
+    virtual ~SamplingService();
+
+    /** IService interface */
+    virtual void postinitService() override;
+    virtual void predeleteService() override;
+
+    /** IThread */
+    virtual void stop() override;
+
+    /** IClockListener */
+    virtual void stepCallback(uint64_t t) override;
+
+    /** IAxi4NbResponse */
+    virtual void nb_response(Axi4TransactionType *trans) override;
+
+    /** Common commands access methods */
+    bool isConfigured() { return irtldmi_ && ifnccpu_ && irtlbus_; }
+    bool start();
+    void abort();
+    void getStatus(AttributeType *res);
+
+ protected:
+    /** IThread interface */
+    virtual void busyLoop() override;
+
+ private:
+    enum EStage {
+        Stage_Idle,
+        Stage_FastForward,
+        Stage_Detail,
+        Stage_Done,
+        Stage_Error
+    };
+
+    struct SampleType {
+        uint64_t step;
+        uint64_t pc;
+        uint64_t cycles;
+        uint64_t instret;
+    };
+
+    struct ArchStateType {
+        uint64_t pc;
+        uint64_t instret;
+        uint64_t prv;
+        uint64_t xreg[32];
+        uint64_t freg[32];
+        bool fpu;
+        std::vector<uint64_t> csr;      // value per entry of CSR_LIST
+    };
+
+    bool runSample(uint64_t target);
+    bool fastForward(uint64_t target);
+    uint64_t instret();
+    void snapshot(ArchStateType *st);
+    bool inject(const ArchStateType *st);
+    bool copyMemory();
+    bool runRtl(uint64_t cycles);
+    bool waitEvent(event_def *ev);
+
+    bool dmiRead(uint32_t regidx, uint32_t *val);
+    bool dmiWrite(uint32_t regidx, uint32_t val);
+    bool dmiHalt();
+    bool dmiResume();
+    bool dmiReadReg(uint32_t regno, uint64_t *val);
+    bool dmiWriteReg(uint32_t regno, uint64_t val);
+    bool dmiCommand(uint32_t cmd);
+
+    static const uint32_t CSR_LIST[];
+
+    AttributeType cmdexec_;
+    AttributeType fncCpu_;
+    AttributeType rtlCpu_;
+    AttributeType fncBus_;
+    AttributeType rtlBus_;
+    AttributeType memRegions_;
+    AttributeType startStep_;
+    AttributeType startPC_;
+    AttributeType period_;
+    AttributeType samples_;
+    AttributeType warmupCycles_;
+    AttributeType detailCycles_;
+
+    ICmdExecutor *iexec_;
+    SamplingCmdType *pcmd_;
+    IClock *ifncclk_;
+    IDPort *ifncdport_;
+    ICpuRiscV *ifncriscv_;
+    ICpuFunctional *ifnccpu_;
+    IClock *irtlclk_;
+    IMemoryOperation *irtldmi_;
+    IMemoryOperation *ifncbus_;
+    IMemoryOperation *irtlbus_;
+
+    event_def eventStart_;
+    event_def eventClock_;
+    event_def eventDmi_;
+    Axi4TransactionType dmitr_;
+    uint32_t dmiRData_;
+
+    volatile EStage stage_;
+    volatile bool startReq_;
+    volatile bool abortReq_;
+    uint64_t targetPC_;         // pc condition of the fast-forward stage
+    uint64_t targetInstret_;    // instret condition of the fast-forward stage
+    bool usePC_;
+    mutex_def mutexResults_;
+    std::vector<SampleType> results_;
+};
+
+DECLARE_CLASS(SamplingService)
+
+}  // namespace debugger
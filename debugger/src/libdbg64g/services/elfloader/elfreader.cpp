@@ -148,6 +148,8 @@ int ElfReaderService::loadSections() {
     SectionHeaderType *sh;
     uint64_t total_bytes = 0;
     AttributeType tsymb;
+    AttributeType debugSections;
+    debugSections.make_dict();
 
     for (int i = 0; i < header_->get_shnum(); i++) {
         sh = sh_tbl_[i];
@@ -209,11 +211,22 @@ int ElfReaderService::loadSections() {
             total_bytes += sh->get_size();
         } else if (sh->get_type() == SHT_SYMTAB || sh->get_type() == SHT_DYNSYM) {
             processDebugSymbol(sh);
+        } else if (sectionNames_ && sh->get_type() == SHT_PROGBITS) {
+            /** DWARF sections used for the address to line conversion */
+            const char *secname = &sectionNames_[sh->get_name()];
+            if (strcmp(secname, ".debug_line") == 0
+                || strcmp(secname, ".debug_line_str") == 0
+                || strcmp(secname, ".debug_str") == 0) {
+                debugSections[secname].make_data(
+                                    static_cast<unsigned>(sh->get_size()),
+                                    &image_[sh->get_offset()]);
+            }
         }
     }
     symbolList_.sort(LoadSh_name);
     if (isrc_) {
         isrc_->addSymbols(&symbolList_);
+        isrc_->setDebugLineInfo(&debugSections);
     }
     return static_cast<int>(total_bytes);
 }
@@ -20,50 +20,50 @@
 
 namespace debugger {
 
-CmdLoadBin::CmdLoadBin(IService *parent, IJtag *ijtag)
-    : ICommandRiscv(parent, "loadbin", ijtag) {
+CmdLoadBin::CmdLoadBin(IService *parent, IJtag *ijtag, CmdMemJob *memjob)
+    : ICommandRiscv(parent, "loadbin", ijtag), memjob_(memjob) {
 
     briefDescr_.make_string("Load binary file");
     detailedDescr_.make_string(
         "Description:\n"
         "    Load BIN-file to SOC target memory with specified address.\n"
+        "    File is read and written by 64 KB chunks. Options:\n"
+        "        nozero - skip zero chunks (target memory is cleared)\n"
+        "        diff   - read target chunk and skip it if not changed\n"
+        "        bg     - load in background, see 'memjob'\n"
+        "Usage:\n"
+        "    loadbin <file> <addr> [nozero] [diff] [bg]\n"
         "Example:\n"
-        "    loadsrec /home/hc08/image.bin 0x04000\n");
+        "    loadbin /home/hc08/image.bin 0x04000\n"
+        "    loadbin /home/ddr.bin 0x80000000 diff bg\n");
 }
 
 int CmdLoadBin::isValid(AttributeType *args) {
+    unsigned argc;
     if (!cmdName_.is_equal((*args)[0u].to_string())) {
         return CMD_INVALID;
     }
-    if (args->size() == 3) {
+    MemStreamJob::parseOptions(args, &argc);
+    if (argc == 3) {
         return CMD_VALID;
     }
     return CMD_WRONG_ARGS;
 }
 
 void CmdLoadBin::exec(AttributeType *args, AttributeType *res) {
+    unsigned argc;
     res->make_nil();
-    if (!isValid(args)) {
-        generateError(res, "Wrong argument list");
-        return;
-    }
 
+    int opts = MemStreamJob::parseOptions(args, &argc);
     const char *filename = (*args)[1].to_string();
     FILE *fp = fopen(filename, "rb");
     if (!fp) {
         generateError(res, "File not found");
         return;
     }
-    fseek(fp, 0, SEEK_END);
-    int sz = ftell(fp);
-    rewind(fp);
-    uint8_t *image = new uint8_t[sz];
-    fread(image, 1, sz, fp);
-    fclose(fp);
 
     uint64_t addr = (*args)[2].to_uint64();
-    ijtag_->write_memory(addr, sz, image);
-    delete [] image;
+    memjob_->start(new MemLoadBinJob(ijtag_, opts, fp, addr), res);
 }
 
 }  // namespace debugger
@@ -18,16 +18,20 @@
 
 #include "api_core.h"
 #include "coreservices/icommand.h"
+#include "memstream.h"
 
 namespace debugger {
 
 class CmdLoadBin : public ICommandRiscv {
  public:
-    explicit CmdLoadBin(IService *parent, IJtag *ijtag);
+    CmdLoadBin(IService *parent, IJtag *ijtag, CmdMemJob *memjob);
 
     /** ICommand interface */
     virtual int isValid(AttributeType *args);
     virtual void exec(AttributeType *args, AttributeType *res);
+
+ private:
+    CmdMemJob *memjob_;
 };
 
 }  // namespace debugger
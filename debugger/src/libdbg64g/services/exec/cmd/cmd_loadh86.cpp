@@ -16,6 +16,7 @@
 
 #include "iservice.h"
 #include "cmd_loadh86.h"
+#include "generic/hexload.h"
 #include <iostream>
 
 namespace debugger {
@@ -23,16 +24,20 @@ namespace debugger {
 //char bindata[1 << 24] = {0};
 //char flgdata[1 << 24] = {0};
 
-CmdLoadH86::CmdLoadH86(IService *parent, IJtag *ijtag)
-    : ICommandRiscv(parent, "loadh86", ijtag) {
+CmdLoadH86::CmdLoadH86(IService *parent, IJtag *ijtag, CmdMemJob *memjob)
+    : ICommandRiscv(parent, "loadh86", ijtag), memjob_(memjob) {
 
     briefDescr_.make_string("Load Intel HEX file");
     detailedDescr_.make_string(
         "Description:\n"
-        "    Load H86-file (Intel Hex) to SOC target memory.\n"
+        "    Load H86-file (Intel Hex) to SOC target memory. Contiguous\n"
+        "    records are merged and written by chunks up to 64 KB. Options\n"
+        "    'nozero', 'diff' and 'bg' are the same as for 'loadbin'.\n"
         "Arguments: This command supports conversion of h86 to binary file\n"
-        "           For this use the following argument list:"
-        "    loadh86 [ifile] [osize] [ofile]"
+        "           For this use the following argument list:\n"
+        "    loadh86 [ifile] [osize] [ofile]\n"
+        "Usage:\n"
+        "    loadh86 <file> [nozero] [diff] [bg]\n"
         "Example:\n"
         "    loadh86 /home/c166/image.h86\n"
         "    loadh86 /home/c166/image.h86 34603008 image.bin\n");
@@ -40,131 +45,134 @@ CmdLoadH86::CmdLoadH86(IService *parent, IJtag *ijtag)
 }
 
 int CmdLoadH86::isValid(AttributeType *args) {
+    unsigned argc;
     if (!cmdName_.is_equal((*args)[0u].to_string())) {
         return CMD_INVALID;
     }
-    if (args->size() == 2) {
+    MemStreamJob::parseOptions(args, &argc);
+    if (argc == 2) {
         return CMD_VALID;
     }
-    if (args->size() == 4 && (*args)[2].is_integer()) {
+    if (argc == 4 && (*args)[2].is_integer()) {
         return CMD_VALID;
     }
     return CMD_WRONG_ARGS;
 }
 
 void CmdLoadH86::exec(AttributeType *args, AttributeType *res) {
+    unsigned argc;
     res->attr_free();
     res->make_nil();
 
+    int opts = MemStreamJob::parseOptions(args, &argc);
+    if (argc == 4) {
+        convert(args, res);
+        return;
+    }
+
     const char *filename = (*args)[1].to_string();
     FILE *fp = fopen(filename, "rb");
     if (!fp) {
         generateError(res, "File not found");
         return;
     }
-    fseek(fp, 0, SEEK_END);
-    int sz = ftell(fp);
-    rewind(fp);
-    uint8_t *image = new uint8_t[sz];
-    fread(image, 1, sz, fp);
-    fclose(fp);
-
-    int off = 0;
-    uint64_t sec_addr;
-    int sec_sz;
-    uint8_t sec_data[1024];
-    int code = 0;
-    int maxadr = 0;
-
-    uint8_t *binFileBuf = 0;
-    unsigned binFileSz = 0;
-    if (args->size() == 4) {
-        // Writing to binary file
-        binFileSz =(*args)[2].to_uint32();
-        binFileBuf = new uint8_t[binFileSz];
-    }
 
     IJtag::dmi_dmcontrol_type dmcontrol;
     dmcontrol.u32 = 0;
     dmcontrol.bits.ndmreset = 1;
-    if (binFileBuf == 0) {
-        ijtag_->write_dmi(IJtag::DMI_DMCONTROL, dmcontrol.u32);
-    }
-
-    while (code != -1) {
-        code = readline(image, off, sec_addr, sec_sz, sec_data);
-        switch (code) {
-        case 0:
-            if (binFileBuf == 0) {
-                ijtag_->write_memory(sec_addr, sec_sz, sec_data);
-                //memcpy(&bindata[sec_addr & 0xFFFFFF], sec_data, sec_sz);
-                //memset(&flgdata[sec_addr & 0xFFFFFF], 0xff, sec_sz);
-            } else if ((sec_addr + sec_sz) <= binFileSz) {
-                memcpy(&binFileBuf[sec_addr], sec_data, sec_sz);
-            } else {
-                generateError(res, "Wrong file size");
-                code = -1;
-            }
-            break;
-        case 1:
-            // End of file marker. Correct ending
-            code = -1;
-            break;
-        case 4:
-            addr_msb_ = (static_cast<int>(sec_data[0]) << 8) | sec_data[1];
-            if (addr_msb_ > maxadr) {
-                maxadr = addr_msb_;
-            }
-            //if (addr_msb_ >= 0x00c0 && addr_msb_ < 0x0100) {
-                //addr_msb_ -= 0x00c0;
-                //bool st = true;
-            //}
+    ijtag_->write_dmi(IJtag::DMI_DMCONTROL, dmcontrol.u32);
+
+    memjob_->start(new MemLoadRecordJob(ijtag_, "loadh86", opts, fp,
+                                        static_cast<MemRecordParser *>(this)),
+                   res);
+}
+
+/** Writing to binary file of the specified size, gaps are filled by zeros */
+void CmdLoadH86::convert(AttributeType *args, AttributeType *res) {
+    FILE *fp = fopen((*args)[1].to_string(), "rb");
+    if (!fp) {
+        generateError(res, "File not found");
+        return;
+    }
+    FILE *fw = fopen((*args)[3].to_string(), "wb");
+    if (!fw) {
+        fclose(fp);
+        generateError(res, "Can't create output file");
+        return;
+    }
+    uint64_t binFileSz = (*args)[2].to_uint64();
+    uint8_t line[2048];
+    uint8_t sec_data[1024];
+    uint64_t sec_addr;
+    int sec_sz;
+    int code = REC_SKIP;
+
+    startRecords();
+    while (code != REC_EOF
+        && fgets(reinterpret_cast<char *>(line), sizeof(line), fp)) {
+        code = parseRecord(line, sec_addr, sec_sz, sec_data);
+        if (code == REC_ERROR) {
+            generateError(res, "Wrong file format");
             break;
-        case 5:
-            //generateError(res, "EIP not supported");
+        } else if (code != REC_DATA) {
+            continue;
+        }
+        if ((sec_addr + sec_sz) > binFileSz) {
+            generateError(res, "Wrong file size");
             break;
-        default:
-            generateError(res, "Wrong file format");
-            code = -1;
         }
+        fseek(fw, static_cast<long>(sec_addr), SEEK_SET);
+        fwrite(sec_data, 1, sec_sz, fw);
     }
 
-    if (binFileBuf) {
-        FILE *fw = fopen((*args)[3].to_string(), "wb");
-        if (fw) {
-            fwrite(binFileBuf, 1, binFileSz, fw);
-            fclose(fw);
-        }
+    fseek(fw, 0, SEEK_END);
+    if (binFileSz && static_cast<uint64_t>(ftell(fw)) < binFileSz) {
+        fseek(fw, static_cast<long>(binFileSz - 1), SEEK_SET);
+        fputc(0, fw);
     }
+    fclose(fw);
+    fclose(fp);
+}
 
-    delete [] image;
+int CmdLoadH86::parseRecord(uint8_t *line, uint64_t &addr,
+                            int &sz, uint8_t *out) {
+    int off = 0;
+    int code = readline(line, off, addr, sz, out);
+    switch (code) {
+    case 0:
+        return REC_DATA;
+    case 1:
+        // End of file marker. Correct ending
+        return REC_EOF;
+    case 4:
+        addr_msb_ = (static_cast<int>(out[0]) << 8) | out[1];
+        return REC_SKIP;
+    case 5:
+        // EIP not supported
+        return REC_SKIP;
+    default:;
+    }
+    return REC_ERROR;
 }
 
 uint8_t CmdLoadH86::str2byte(uint8_t *pair) {
-    uint8_t ret = 0;
-    for (int i = 0; i < 2; i++) {
-        ret <<= 4;
-        if (pair[i] >= '0' && pair[i] <= '9') {
-            ret |= pair[i] - '0';
-        } else if (pair[i] >= 'A' && pair[i] <= 'F') {
-            ret |= pair[i] - 'A' + 10;
-        } else if (pair[i] >= 'a' && pair[i] <= 'f') {
-            ret |= pair[i] - 'a' + 10;
-        }
-    }
-    return ret;
+    int ret = HexImage::hexbyte(reinterpret_cast<char *>(pair));
+    return ret < 0 ? 0 : static_cast<uint8_t>(ret);
 }
 
+/** Whole record is converted at once, non-hex symbols fail the check */
 bool CmdLoadH86::check_crc(uint8_t *str, int sz) {
+    uint8_t rec[512];
     uint8_t sum = 0;
-    uint8_t *cur = str;
+    if (sz < 0 || sz >= static_cast<int>(sizeof(rec))
+        || !HexImage::hex2bin(reinterpret_cast<char *>(str), sz + 1, rec)) {
+        return false;
+    }
     for (int i = 0; i < sz; i++) {
-        sum += str2byte(cur);
-        cur += 2;
+        sum += rec[i];
     }
     sum = ~sum + 1;
-    uint8_t ctrl = str2byte(cur);
-    return ctrl == sum;
+    return rec[sz] == sum;
 }
 
 int CmdLoadH86::readline(uint8_t *img, int &off,
@@ -190,9 +198,9 @@ int CmdLoadH86::readline(uint8_t *img, int &off,
     retcode = str2byte(&img[off]);
     off += 2;
 
-    for (int i = 0; i < sz; i++) {
-        out[i] = static_cast<char>(str2byte(&img[off]));
-        off += 2;
+    HexImage::hex2bin(reinterpret_cast<char *>(&img[off]), sz, out);
+    if (sz > 0) {
+        off += 2 * sz;
     }
     off += 2;  // skip checksum
     if (img[off] == '\r' && img[off + 1] == '\n') {
@@ -18,24 +18,33 @@
 
 #include "api_core.h"
 #include "coreservices/icommand.h"
+#include "memstream.h"
 
 namespace debugger {
 
-class CmdLoadH86 : public ICommandRiscv  {
+class CmdLoadH86 : public ICommandRiscv,
+                   public MemRecordParser {
  public:
-    explicit CmdLoadH86(IService *parent, IJtag *ijtag);
+    CmdLoadH86(IService *parent, IJtag *ijtag, CmdMemJob *memjob);
 
     /** ICommand interface */
     virtual int isValid(AttributeType *args);
     virtual void exec(AttributeType *args, AttributeType *res);
 
+    /** MemRecordParser */
+    virtual void startRecords() override { addr_msb_ = 0; }
+    virtual int parseRecord(uint8_t *line, uint64_t &addr,
+                            int &sz, uint8_t *out) override;
+
  private:
     uint8_t str2byte(uint8_t *pair);
     bool check_crc(uint8_t *str, int sz);
     int readline(uint8_t *img, int &off,
                  uint64_t &addr, int &sz, uint8_t *out);
+    void convert(AttributeType *args, AttributeType *res);
 
  private:
+    CmdMemJob *memjob_;
     char header_data_[1024];
     int addr_msb_;
 };
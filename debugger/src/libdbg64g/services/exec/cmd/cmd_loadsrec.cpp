@@ -16,6 +16,7 @@
 
 #include "iservice.h"
 #include "cmd_loadsrec.h"
+#include "generic/hexload.h"
 #include <iostream>
 
 namespace debugger {
@@ -85,31 +86,39 @@ void print_flash_usage() {
 }
 #endif
 
-CmdLoadSrec::CmdLoadSrec(IService *parent, IJtag *ijtag)
-    : ICommandRiscv(parent, "loadsrec", ijtag) {
+CmdLoadSrec::CmdLoadSrec(IService *parent, IJtag *ijtag, CmdMemJob *memjob)
+    : ICommandRiscv(parent, "loadsrec", ijtag), memjob_(memjob) {
 
     briefDescr_.make_string("Load SREC-file");
     detailedDescr_.make_string(
         "Description:\n"
-        "    Load SREC-file to SOC target memory.\n"
+        "    Load SREC-file to SOC target memory. Contiguous records are\n"
+        "    merged and written by chunks up to 64 KB. Options 'nozero',\n"
+        "    'diff' and 'bg' are the same as for 'loadbin'.\n"
+        "Usage:\n"
+        "    loadsrec <file> [nozero] [diff] [bg]\n"
         "Example:\n"
         "    loadsrec /home/hc08/image.s19\n");
 }
 
 int CmdLoadSrec::isValid(AttributeType *args) {
+    unsigned argc;
     if (!cmdName_.is_equal((*args)[0u].to_string())) {
         return CMD_INVALID;
     }
-    if (args->size() != 2) {
+    MemStreamJob::parseOptions(args, &argc);
+    if (argc != 2) {
         return CMD_WRONG_ARGS;
     }
     return CMD_VALID;
 }
 
 void CmdLoadSrec::exec(AttributeType *args, AttributeType *res) {
+    unsigned argc;
     res->attr_free();
     res->make_nil();
 
+    int opts = MemStreamJob::parseOptions(args, &argc);
     const char *filename = (*args)[1].to_string();
     FILE *fp = fopen(filename, "rb");
     if (!fp) {
@@ -118,64 +127,57 @@ void CmdLoadSrec::exec(AttributeType *args, AttributeType *res) {
         generateError(res, tstr);
         return;
     }
-    fseek(fp, 0, SEEK_END);
-    int sz = ftell(fp);
-    rewind(fp);
-    uint8_t *image = new uint8_t[sz];
-    fread(image, 1, sz, fp);
-    fclose(fp);
-
-    int off = check_header(image);
 
     IJtag::dmi_dmcontrol_type dmcontrol;
     dmcontrol.u32 = 0;
     dmcontrol.bits.ndmreset = 1;
     ijtag_->write_dmi(IJtag::DMI_DMCONTROL, dmcontrol.u32);
 
-    uint64_t sec_addr;
-    int sec_sz;
-    uint8_t sec_data[1024];
-    while ((off = readline(image, off, sec_addr, sec_sz, sec_data)) != 0) {
-        ijtag_->write_memory(sec_addr, sec_sz, sec_data);
+    memjob_->start(new MemLoadRecordJob(ijtag_, "loadsrec", opts, fp,
+                                        static_cast<MemRecordParser *>(this)),
+                   res);
+
 #ifdef SHOW_USAGE_INFO
-        mark_addr(sec_addr, sec_sz);
+    print_flash_usage();
 #endif
-    }
-
-//    soft_reset = 0;
-//    tap_->write(addr, 8, reinterpret_cast<uint8_t *>(&soft_reset));
-    delete [] image;
+}
 
+int CmdLoadSrec::parseRecord(uint8_t *line, uint64_t &addr,
+                             int &sz, uint8_t *out) {
+    if (line[0] == 'S' && line[1] == '0') {
+        return check_header(line) ? REC_SKIP : REC_ERROR;
+    }
+    if (line[0] != 'S' || line[1] < '1' || line[1] > '3') {
+        // termination or count record
+        return REC_EOF;
+    }
+    if (readline(line, 0, addr, sz, out) == 0) {
+        return REC_ERROR;
+    }
 #ifdef SHOW_USAGE_INFO
-    print_flash_usage();
+    mark_addr(addr, sz);
 #endif
+    return REC_DATA;
 }
 
 uint8_t CmdLoadSrec::str2byte(uint8_t *pair) {
-    uint8_t ret = 0;
-    for (int i = 0; i < 2; i++) {
-        ret <<= 4;
-        if (pair[i] >= '0' && pair[i] <= '9') {
-            ret |= pair[i] - '0';
-        } else if (pair[i] >= 'A' && pair[i] <= 'F') {
-            ret |= pair[i] - 'A' + 10;
-        } else if (pair[i] >= 'a' && pair[i] <= 'f') {
-            ret |= pair[i] - 'a' + 10;
-        }
-    }
-    return ret;
+    int ret = HexImage::hexbyte(reinterpret_cast<char *>(pair));
+    return ret < 0 ? 0 : static_cast<uint8_t>(ret);
 }
 
+/** Whole record is converted at once, non-hex symbols fail the check */
 bool CmdLoadSrec::check_crc(uint8_t *str, int sz) {
+    uint8_t rec[512];
     uint8_t sum = 0;
-    uint8_t *cur = str;
+    if (sz < 0 || sz >= static_cast<int>(sizeof(rec))
+        || !HexImage::hex2bin(reinterpret_cast<char *>(str), sz + 1, rec)) {
+        return false;
+    }
     for (int i = 0; i < sz; i++) {
-        sum += str2byte(cur);
-        cur += 2;
+        sum += rec[i];
     }
     sum = ~sum;
-    uint8_t ctrl = str2byte(cur);
-    return ctrl == sum;
+    return rec[sz] == sum;
 }
 
 int CmdLoadSrec::check_header(uint8_t *img) {
@@ -242,9 +244,9 @@ int CmdLoadSrec::readline(uint8_t *img, int off,
         sz--;
     }
 
-    for (int i = 0; i < sz; i++) {
-        out[i] = static_cast<char>(str2byte(&img[off]));
-        off += 2;
+    HexImage::hex2bin(reinterpret_cast<char *>(&img[off]), sz, out);
+    if (sz > 0) {
+        off += 2 * sz;
     }
     off += 2;  // skip checksum
     if (img[off] != '\r' || img[off + 1] != '\n') {
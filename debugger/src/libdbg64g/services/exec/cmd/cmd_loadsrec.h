@@ -18,17 +18,23 @@
 
 #include "api_core.h"
 #include "coreservices/icommand.h"
+#include "memstream.h"
 
 namespace debugger {
 
-class CmdLoadSrec : public ICommandRiscv {
+class CmdLoadSrec : public ICommandRiscv,
+                    public MemRecordParser {
  public:
-    explicit CmdLoadSrec(IService *parent, IJtag *ijtag);
+    CmdLoadSrec(IService *parent, IJtag *ijtag, CmdMemJob *memjob);
 
     /** ICommand interface */
     virtual int isValid(AttributeType *args);
     virtual void exec(AttributeType *args, AttributeType *res);
 
+    /** MemRecordParser */
+    virtual int parseRecord(uint8_t *line, uint64_t &addr,
+                            int &sz, uint8_t *out) override;
+
  private:
     uint8_t str2byte(uint8_t *pair);
     bool check_crc(uint8_t *str, int sz);
@@ -37,6 +43,7 @@ class CmdLoadSrec : public ICommandRiscv {
                  uint64_t &addr, int &sz, uint8_t *out);
 
  private:
+    CmdMemJob *memjob_;
     char header_data_[1024];
 };
 
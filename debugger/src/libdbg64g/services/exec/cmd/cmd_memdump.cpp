@@ -19,35 +19,42 @@
 
 namespace debugger {
 
-CmdMemDump::CmdMemDump(IService *parent, IJtag *ijtag)
-    : ICommandRiscv(parent, "memdump", ijtag) {
+CmdMemDump::CmdMemDump(IService *parent, IJtag *ijtag, CmdMemJob *memjob)
+    : ICommandRiscv(parent, "memdump", ijtag), memjob_(memjob) {
 
     briefDescr_.make_string("Dump memory to file");
     detailedDescr_.make_string(
         "Description:\n"
-        "    Dump memory to file (default in Binary format).\n"
+        "    Dump memory to file (default in Binary format). Memory is read\n"
+        "    and written to file by 64 KB chunks. Option 'bg' starts dump\n"
+        "    in background, use 'memjob' to check progress.\n"
         "Usage:\n"
-        "    memdump <addr> <bytes> [filepath] [bin|hex]\n"
+        "    memdump <addr> <bytes> [filepath] [bin|hex] [bg]\n"
         "Example:\n"
         "    memdump 0x0 8192 dump.bin\n"
         "    memdump 0x40000000 524288 dump.hex hex\n"
+        "    memdump 0x80000000 268435456 ddr.bin bin bg\n"
         "    memdump 0x10000000 128 \"c:/My Documents/dump.bin\"\n");
 }
 
 int CmdMemDump::isValid(AttributeType *args) {
+    unsigned argc;
     if (!cmdName_.is_equal((*args)[0u].to_string())) {
         return CMD_INVALID;
     }
-    if (args->size() == 4 || args->size() == 5) {
+    MemStreamJob::parseOptions(args, &argc);
+    if (argc == 4 || argc == 5) {
         return CMD_VALID;
     }
     return CMD_WRONG_ARGS;
 }
 
 void CmdMemDump::exec(AttributeType *args, AttributeType *res) {
+    unsigned argc;
     res->attr_free();
     res->make_nil();
 
+    int opts = MemStreamJob::parseOptions(args, &argc);
     const char *filename = (*args)[3].to_string();
     FILE *fd = fopen(filename, "wb");
     if (fd == NULL) {
@@ -57,36 +64,10 @@ void CmdMemDump::exec(AttributeType *args, AttributeType *res) {
         return;
     }
     uint64_t addr = (*args)[1].to_uint64();
-    int len = static_cast<int>((*args)[2].to_uint64());
-    res->make_data(len);
+    uint64_t len = (*args)[2].to_uint64();
+    bool hex = argc == 5 && (*args)[4].is_equal("hex");
 
-    ijtag_->read_memory(addr, len, res->data());
-    uint8_t *dumpbuf = res->data();
-
-    if (args->size() == 5 && (*args)[4].is_equal("hex")) {
-        char t1[256];
-        int t1_cnt = 0;
-        int idx;
-        for (int i = 0; i < ((len + 0xf) & ~0xf); i++) {
-            idx = (i & ~0xf) | (0xf - (i & 0xf));
-            if (idx > len) {
-                t1[t1_cnt++] = ' ';
-                t1[t1_cnt++] = ' ';
-                continue;
-            }
-            t1_cnt += RISCV_sprintf(&t1[t1_cnt], sizeof(t1) - t1_cnt, "%02x",
-                                    dumpbuf[idx]);
-            if ((i & 0xf) != 0xf) {
-                continue;
-            }
-            t1_cnt += RISCV_sprintf(&t1[t1_cnt], sizeof(t1) - t1_cnt, "\n");
-            fwrite(t1, t1_cnt, 1, fd);
-            t1_cnt = 0;
-        }
-    } else {
-        fwrite(dumpbuf, len, 1, fd);
-    }
-    fclose(fd);
+    memjob_->start(new MemDumpJob(ijtag_, opts, fd, addr, len, hex), res);
 }
 
 }  // namespace debugger
@@ -18,16 +18,20 @@
 
 #include "api_core.h"
 #include "coreservices/icommand.h"
+#include "memstream.h"
 
 namespace debugger {
 
 class CmdMemDump : public ICommandRiscv {
  public:
-    explicit CmdMemDump(IService *parent, IJtag *ijtag);
+    CmdMemDump(IService *parent, IJtag *ijtag, CmdMemJob *memjob);
 
     /** ICommand */
     virtual int isValid(AttributeType *args);
     virtual void exec(AttributeType *args, AttributeType *res);
+
+ private:
+    CmdMemJob *memjob_;
 };
 
 }  // namespace debugger
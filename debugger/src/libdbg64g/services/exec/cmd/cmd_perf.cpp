@@ -0,0 +1,196 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "cmd_perf.h"
+#include <string.h>
+
+namespace debugger {
+
+static const uint32_t CSR_mcycle = 0xB00;
+static const uint32_t CSR_minstret = 0xB02;
+static const uint32_t CSR_mhpmcounter3 = 0xB03;
+static const uint32_t CSR_mhpmevent3 = 0x323;
+
+/** Event selector values written into mhpmevent are (index + 1), must be
+    aligned with HpmEvent_* constants of the River core */
+static const char *const HPM_EVENT_NAMES[] = {
+    "icache_miss",
+    "dcache_miss",
+    "br_mispredict",
+    "stall_fetch",
+    "stall_hazard",
+    "stall_memq",
+    "stall_multi",
+    "stall_fpu",
+    0
+};
+
+static const int HPM_EVENTS_TOTAL =
+    static_cast<int>(sizeof(HPM_EVENT_NAMES) / sizeof(const char *)) - 1;
+
+CmdPerf::CmdPerf(IService *parent, IJtag *ijtag) 
+    : ICommandRiscv(parent, "perf", ijtag) {
+
+    briefDescr_.make_string("Read hardware performance-monitoring counters");
+    detailedDescr_.make_string(
+        "Description:\n"
+        "    Without arguments read CSR registers mcycle, minstret and\n"
+        "    mhpmcounter3.. with the enabled event and print their values\n"
+        "    and increments since the previous call.\n"
+        "    With arguments assign events to mhpmcounter3, mhpmcounter4, ..\n"
+        "    in the specified order and clear the counters. 'all' enables\n"
+        "    all supported events. Available events:\n"
+        "        icache_miss, dcache_miss, br_mispredict, stall_fetch,\n"
+        "        stall_hazard, stall_memq, stall_multi, stall_fpu\n"
+        "    Stall and mispredict events count lost clock cycles.\n"
+        "Output format:\n"
+        "    {'cycle':[i,i],'instret':[i,i],'cpi':d,'event1':[i,i,d],..}\n"
+        "         i - Current counter value (uint64_t).\n"
+        "         i - (Current - Previous) counter value (uint64_t).\n"
+        "         d - (delta events) per 1000 instructions (double).\n"
+        "Usage:\n"
+        "    perf\n"
+        "    perf all\n"
+        "    perf event1 event2 ..\n"
+        "Example:\n"
+        "    perf icache_miss dcache_miss stall_hazard\n"
+        "    perf\n");
+
+    cycleCnt_z = 0;
+    instrCnt_z = 0;
+    memset(hpmCnt_z, 0, sizeof(hpmCnt_z));
+}
+
+int CmdPerf::isValid(AttributeType *args) {
+    if (!cmdName_.is_equal((*args)[0u].to_string())) {
+        return CMD_INVALID;
+    }
+    if (args->size() > (HPM_COUNTERS_TOTAL + 1)) {
+        return CMD_WRONG_ARGS;
+    }
+    for (unsigned i = 1; i < args->size(); i++) {
+        if (!(*args)[i].is_string()) {
+            return CMD_WRONG_ARGS;
+        }
+        if (args->size() == 2 && (*args)[i].is_equal("all")) {
+            continue;
+        }
+        if (event2index((*args)[i].to_string()) < 0) {
+            return CMD_WRONG_ARGS;
+        }
+    }
+    return CMD_VALID;
+}
+
+int CmdPerf::event2index(const char *name) {
+    for (int i = 0; HPM_EVENT_NAMES[i]; i++) {
+        if (strcmp(name, HPM_EVENT_NAMES[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void CmdPerf::addCounter(AttributeType *res, const char *name,
+                         uint64_t val, uint64_t *prev) {
+    AttributeType &item = (*res)[name];
+    item.make_list(2);
+    item[0u].make_uint64(val);
+    item[1].make_uint64(val - *prev);
+    *prev = val;
+}
+
+void CmdPerf::exec(AttributeType *args, AttributeType *res) {
+    Reg64Type u;
+    uint64_t d_instr;
+    int evidx;
+    res->make_dict();
+
+    if (args->size() > 1) {
+        // Setup events and clear counters. Unused counters are disabled.
+        for (int i = 0; i < HPM_COUNTERS_TOTAL; i++) {
+            u.val = 0;
+            if ((*args)[1].is_equal("all")) {
+                if (i < HPM_EVENTS_TOTAL) {
+                    u.val = i + 1;
+                }
+            } else if (static_cast<unsigned>(i + 1) < args->size()) {
+                u.val = event2index((*args)[i + 1].to_string()) + 1;
+            }
+            if (ijtag_->set_reg(CSR_mhpmevent3 + i,
+                                IJtag::CMD_AAxSIZE_64BITS, &u)) {
+                generateError(res, "Cannot write mhpmevent register");
+                return;
+            }
+            u.val = 0;
+            ijtag_->set_reg(CSR_mhpmcounter3 + i,
+                            IJtag::CMD_AAxSIZE_64BITS, &u);
+            hpmCnt_z[i] = 0;
+        }
+    }
+
+    if (ijtag_->get_reg(CSR_mcycle, IJtag::CMD_AAxSIZE_64BITS, &u)) {
+        generateError(res, "Cannot read mcycle register");
+        return;
+    }
+    addCounter(res, "cycle", u.val, &cycleCnt_z);
+
+    if (ijtag_->get_reg(CSR_minstret, IJtag::CMD_AAxSIZE_64BITS, &u)) {
+        generateError(res, "Cannot read minstret register");
+        return;
+    }
+    addCounter(res, "instret", u.val, &instrCnt_z);
+
+    d_instr = (*res)["instret"][1].to_uint64();
+    if (d_instr == 0) {
+        (*res)["cpi"].make_floating(0);
+    } else {
+        (*res)["cpi"].make_floating(
+            static_cast<double>((*res)["cycle"][1].to_uint64())
+            / static_cast<double>(d_instr));
+    }
+
+    for (int i = 0; i < HPM_COUNTERS_TOTAL; i++) {
+        if (ijtag_->get_reg(CSR_mhpmevent3 + i,
+                            IJtag::CMD_AAxSIZE_64BITS, &u)) {
+            generateError(res, "Cannot read mhpmevent register");
+            return;
+        }
+        evidx = static_cast<int>(u.val) - 1;
+        if (evidx < 0 || evidx >= HPM_EVENTS_TOTAL) {
+            continue;
+        }
+        if (ijtag_->get_reg(CSR_mhpmcounter3 + i,
+                            IJtag::CMD_AAxSIZE_64BITS, &u)) {
+            generateError(res, "Cannot read mhpmcounter register");
+            return;
+        }
+        const char *name = HPM_EVENT_NAMES[evidx];
+        addCounter(res, name, u.val, &hpmCnt_z[i]);
+
+        AttributeType &item = (*res)[name];
+        item.realloc_list(3);
+        if (d_instr == 0) {
+            item[2].make_floating(0);
+        } else {
+            item[2].make_floating(
+                1000.0 * static_cast<double>(item[1].to_uint64())
+                / static_cast<double>(d_instr));
+        }
+    }
+}
+
+}  // namespace debugger
@@ -0,0 +1,49 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef __DEBUGGER_CMD_PERF_H__
+#define __DEBUGGER_CMD_PERF_H__
+
+#include "api_core.h"
+#include "coreservices/itap.h"
+#include "coreservices/icommand.h"
+
+namespace debugger {
+
+class CmdPerf : public ICommandRiscv {
+ public:
+    explicit CmdPerf(IService *parent, IJtag *ijtag);
+
+    /** ICommand */
+    virtual int isValid(AttributeType *args);
+    virtual void exec(AttributeType *args, AttributeType *res);
+
+ private:
+    int event2index(const char *name);
+    void addCounter(AttributeType *res, const char *name,
+                    uint64_t val, uint64_t *prev);
+
+ private:
+    static const int HPM_COUNTERS_TOTAL = 8;     // mhpmcounter3..10
+
+    uint64_t cycleCnt_z;
+    uint64_t instrCnt_z;
+    uint64_t hpmCnt_z[HPM_COUNTERS_TOTAL];
+};
+
+}  // namespace debugger
+
+#endif  // __DEBUGGER_CMD_PERF_H__
@@ -16,6 +16,8 @@
 
 #include "cmd_reg.h"
 #include "riscv-isa.h"
+#include <algorithm>
+#include <vector>
 
 namespace debugger {
 struct reg_default_list_type {
@@ -65,38 +67,85 @@ void CmdReg::exec(AttributeType *args, AttributeType *res) {
     res->make_dict();
 
     if (args->size() == 1) {
-        // Read Integer registers
+        // Read Integer registers: pc and then x1..x31 in one sequence
         const reg_default_list_type *preg = RISCV_INTEGER_REGLIST;
-        while (*preg->name) {
-            if (ijtag_->get_reg(preg->name, &u)) {
-                generateError(res, "Cannot read registers");
-                break;
-            }
-            (*res)[preg->name].make_uint64(u.val);
-            preg++;
+        Reg64Type xregs[31];
+        if (ijtag_->get_reg(preg->name, &u)
+            || ijtag_->get_regs(ijtag_->reg2addr("ra"), ijtag_->regsize("ra"),
+                                31, xregs)) {
+            generateError(res, "Cannot read registers");
+            return;
+        }
+        (*res)[preg->name].make_uint64(u.val);
+        for (int i = 0; i < 31; i++) {
+            (*res)[preg[i + 1].name].make_uint64(xregs[i].val);
         }
         return;
     }
 
-    const char *regname;
-    int err;
+    // Read only request (GUI register view) is sorted by address
+    std::vector<const char *> order;
+    bool rdonly = true;
     for (unsigned i = 1; i < args->size(); i++) {
-        regname = (*args)[i].to_string();
+        if ((*args)[i].is_integer()) {
+            rdonly = false;
+        }
+        order.push_back((*args)[i].to_string());
+    }
+    if (rdonly) {
+        RegAddrLess less(ijtag_);
+        std::stable_sort(order.begin(), order.end(), less);
+    }
 
-        if ((i + 1) < args->size() && (*args)[i+1].is_integer()) {
-            u.val = (*args)[i+1].to_uint64();
-            err = ijtag_->set_reg(regname, &u);
+    // Sequential reads are merged into the single DMI sequence
+    const char *rdnames[READ_BATCH_MAX];
+    unsigned rdcnt = 0;
+    const char *regname;
+    int err = 0;
+    for (unsigned i = 1; i < args->size() && !err; i++) {
+        regname = rdonly ? order[i - 1] : (*args)[i].to_string();
+
+        if (!rdonly && (i + 1) < args->size() && (*args)[i+1].is_integer()) {
+            err = readBatch(rdnames, rdcnt, res);
+            rdcnt = 0;
+            if (!err) {
+                u.val = (*args)[i+1].to_uint64();
+                err = ijtag_->set_reg(regname, &u);
+            }
             i++;
         } else {
-            err = ijtag_->get_reg(regname, &u);
-            (*res)[regname].make_uint64(u.val);
+            if (rdcnt && (rdcnt == READ_BATCH_MAX
+                || ijtag_->reg2addr(regname)
+                    != ijtag_->reg2addr(rdnames[rdcnt - 1]) + 1
+                || ijtag_->regsize(regname)
+                    != ijtag_->regsize(rdnames[0]))) {
+                err = readBatch(rdnames, rdcnt, res);
+                rdcnt = 0;
+            }
+            rdnames[rdcnt++] = regname;
         }
+    }
+    if (!err) {
+        err = readBatch(rdnames, rdcnt, res);
+    }
 
-        if (err) {
-            generateError(res, "Cannot read registers");
-            break;
-        }
+    if (err) {
+        generateError(res, "Cannot read registers");
+    }
+}
+
+int CmdReg::readBatch(const char **names, unsigned cnt, AttributeType *res) {
+    Reg64Type u[READ_BATCH_MAX];
+    int err;
+    if (cnt == 0) {
+        return 0;
+    }
+    err = ijtag_->get_regs(ijtag_->reg2addr(names[0]),
+                           ijtag_->regsize(names[0]), cnt, u);
+    for (unsigned i = 0; i < cnt; i++) {
+        (*res)[names[i]].make_uint64(u[i].val);
     }
+    return err;
 }
 
 }  // namespace debugger
@@ -30,7 +30,18 @@ class CmdReg : public ICommandRiscv  {
     virtual void exec(AttributeType *args, AttributeType *res);
 
  protected:
-
+    /** Read registers with the sequential addresses */
+    int readBatch(const char **names, unsigned cnt, AttributeType *res);
+
+    static const unsigned READ_BATCH_MAX = 64;
+
+    struct RegAddrLess {
+        explicit RegAddrLess(IJtag *ijtag) : ijtag_(ijtag) {}
+        bool operator()(const char *a, const char *b) const {
+            return ijtag_->reg2addr(a) < ijtag_->reg2addr(b);
+        }
+        IJtag *ijtag_;
+    };
 };
 
 }  // namespace debugger
@@ -0,0 +1,431 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "memstream.h"
+#include <string.h>
+
+namespace debugger {
+
+MemStreamJob::MemStreamJob(IJtag *ijtag, const char *name, int opts) {
+    ijtag_ = ijtag;
+    name_.make_string(name);
+    opts_ = opts;
+    chunk_ = new uint8_t[CHUNK_SIZE];
+    target_ = 0;
+    total_ = 0;
+    done_ = 0;
+    written_ = 0;
+    skipped_ = 0;
+    t_start_ = RISCV_get_time_ms();
+    percent_ = 0;
+}
+
+MemStreamJob::~MemStreamJob() {
+    delete [] chunk_;
+    if (target_) {
+        delete [] target_;
+    }
+}
+
+int MemStreamJob::parseOptions(AttributeType *args, unsigned *argc) {
+    int opts = 0;
+    unsigned cnt = args->size();
+    while (cnt > 1 && (*args)[cnt - 1].is_string()) {
+        AttributeType &arg = (*args)[cnt - 1];
+        if (arg.is_equal("bg")) {
+            opts |= MEMSTREAM_BACKGROUND;
+        } else if (arg.is_equal("nozero")) {
+            opts |= MEMSTREAM_SKIP_ZERO;
+        } else if (arg.is_equal("diff")) {
+            opts |= MEMSTREAM_SKIP_SAME;
+        } else {
+            break;
+        }
+        cnt--;
+    }
+    *argc = cnt;
+    return opts;
+}
+
+void MemStreamJob::setError(const char *msg) {
+    if (!isError()) {
+        error_.make_string(msg);
+    }
+}
+
+void MemStreamJob::getStatus(AttributeType *res) {
+    res->make_dict();
+    (*res)["Name"].make_string(getName());
+    (*res)["Total"].make_uint64(total_);
+    (*res)["Done"].make_uint64(done_);
+    (*res)["Written"].make_uint64(written_);
+    (*res)["Skipped"].make_uint64(skipped_);
+    (*res)["Time"].make_uint64(RISCV_get_time_ms() - t_start_);
+    if (isError()) {
+        (*res)["Error"].make_string(getError());
+    }
+}
+
+void MemStreamJob::writeChunk(uint64_t addr, uint8_t *buf, int sz) {
+    if (opts_ & MEMSTREAM_SKIP_ZERO) {
+        int i = 0;
+        while (i < sz && buf[i] == 0) {
+            i++;
+        }
+        if (i == sz) {
+            skipped_ += sz;
+            return;
+        }
+    }
+    if (opts_ & MEMSTREAM_SKIP_SAME) {
+        if (!target_) {
+            target_ = new uint8_t[CHUNK_SIZE];
+        }
+        if (ijtag_->read_memory(addr, sz, target_) == 0
+            && memcmp(target_, buf, sz) == 0) {
+            skipped_ += sz;
+            return;
+        }
+    }
+    if (ijtag_->write_memory(addr, sz, buf)) {
+        setError("Target memory write error");
+        return;
+    }
+    written_ += sz;
+}
+
+void MemStreamJob::progress(uint64_t done) {
+    done_ = done;
+    if (total_ < 4 * CHUNK_SIZE) {
+        return;
+    }
+    int percent = static_cast<int>((100 * done_) / total_);
+    if (percent / 10 == percent_ / 10) {
+        return;
+    }
+    percent_ = percent;
+    RISCV_printf(NULL, 0, "%s: %d%% (%" RV_PRI64 "d of %" RV_PRI64 "d B)",
+                 getName(), percent, done_, total_);
+}
+
+
+MemDumpJob::MemDumpJob(IJtag *ijtag, int opts, FILE *fd,
+                       uint64_t addr, uint64_t sz, bool hex)
+    : MemStreamJob(ijtag, "memdump", opts) {
+    fd_ = fd;
+    addr_ = addr;
+    hex_ = hex;
+    total_ = sz;
+}
+
+MemDumpJob::~MemDumpJob() {
+    fclose(fd_);
+}
+
+bool MemDumpJob::step() {
+    uint64_t sz = total_ - done_;
+    if (sz == 0) {
+        return false;
+    }
+    if (sz > CHUNK_SIZE) {
+        sz = CHUNK_SIZE;
+    }
+    if (ijtag_->read_memory(addr_ + done_, sz, chunk_)) {
+        setError("Target memory read error");
+        return false;
+    }
+    if (hex_) {
+        writeHex(static_cast<int>(sz));
+    } else {
+        fwrite(chunk_, 1, sz, fd_);
+    }
+    written_ += sz;
+    progress(done_ + sz);
+    return done_ < total_;
+}
+
+/** Chunk size is a multiple of 16 so each chunk is a set of whole lines */
+void MemDumpJob::writeHex(int sz) {
+    char t1[256];
+    int t1_cnt = 0;
+    int idx;
+    for (int i = 0; i < ((sz + 0xf) & ~0xf); i++) {
+        idx = (i & ~0xf) | (0xf - (i & 0xf));
+        if (idx >= sz) {
+            t1[t1_cnt++] = ' ';
+            t1[t1_cnt++] = ' ';
+        } else {
+            t1_cnt += RISCV_sprintf(&t1[t1_cnt], sizeof(t1) - t1_cnt,
+                                    "%02x", chunk_[idx]);
+        }
+        if ((i & 0xf) != 0xf) {
+            continue;
+        }
+        t1_cnt += RISCV_sprintf(&t1[t1_cnt], sizeof(t1) - t1_cnt, "\n");
+        fwrite(t1, t1_cnt, 1, fd_);
+        t1_cnt = 0;
+    }
+}
+
+
+MemLoadBinJob::MemLoadBinJob(IJtag *ijtag, int opts, FILE *fp,
+                             uint64_t addr)
+    : MemStreamJob(ijtag, "loadbin", opts) {
+    fp_ = fp;
+    addr_ = addr;
+    fseek(fp_, 0, SEEK_END);
+    total_ = ftell(fp_);
+    rewind(fp_);
+}
+
+MemLoadBinJob::~MemLoadBinJob() {
+    fclose(fp_);
+}
+
+bool MemLoadBinJob::step() {
+    int sz = static_cast<int>(fread(chunk_, 1, CHUNK_SIZE, fp_));
+    if (sz <= 0) {
+        return false;
+    }
+    writeChunk(addr_ + done_, chunk_, sz);
+    progress(done_ + sz);
+    return !isError() && done_ < total_;
+}
+
+
+MemLoadRecordJob::MemLoadRecordJob(IJtag *ijtag, const char *name, int opts,
+                                   FILE *fp, MemRecordParser *parser)
+    : MemStreamJob(ijtag, name, opts) {
+    fp_ = fp;
+    parser_ = parser;
+    chunkAddr_ = 0;
+    chunkCnt_ = 0;
+    eof_ = false;
+    fseek(fp_, 0, SEEK_END);
+    total_ = ftell(fp_);
+    rewind(fp_);
+    parser_->startRecords();
+}
+
+MemLoadRecordJob::~MemLoadRecordJob() {
+    fclose(fp_);
+}
+
+bool MemLoadRecordJob::step() {
+    uint64_t addr;
+    int sz;
+    int code;
+    bool wrong_format = false;
+
+    while (!eof_) {
+        if (!fgets(reinterpret_cast<char *>(line_), sizeof(line_), fp_)) {
+            eof_ = true;
+            break;
+        }
+        code = parser_->parseRecord(line_, addr, sz, rec_);
+        if (code == MemRecordParser::REC_EOF) {
+            eof_ = true;
+            break;
+        } else if (code == MemRecordParser::REC_ERROR) {
+            eof_ = true;
+            wrong_format = true;
+            break;
+        } else if (code != MemRecordParser::REC_DATA || sz <= 0) {
+            continue;
+        }
+
+        bool flushed = false;
+        if (chunkCnt_ != 0 && (addr != chunkAddr_ + chunkCnt_
+                            || chunkCnt_ + sz > CHUNK_SIZE)) {
+            // Not contiguous record or full chunk: one transfer per step
+            writeChunk(chunkAddr_, chunk_, chunkCnt_);
+            chunkCnt_ = 0;
+            progress(ftell(fp_));
+            flushed = true;
+        }
+        if (chunkCnt_ == 0) {
+            chunkAddr_ = addr;
+        }
+        memcpy(&chunk_[chunkCnt_], rec_, sz);
+        chunkCnt_ += sz;
+        if (flushed) {
+            return !isError();
+        }
+    }
+
+    if (chunkCnt_ != 0 && !isError()) {
+        writeChunk(chunkAddr_, chunk_, chunkCnt_);
+        chunkCnt_ = 0;
+    }
+    if (wrong_format) {
+        setError("Wrong file format");
+    }
+    progress(total_);
+    return false;
+}
+
+
+CmdMemJob::CmdMemJob(IService *parent)
+    : ICommand(parent, "memjob"), IThread() {
+
+    briefDescr_.make_string("Memory streaming job control");
+    detailedDescr_.make_string(
+        "Description:\n"
+        "    Show status of the memory job started by memdump, loadbin,\n"
+        "    loadsrec or loadh86 with the 'bg' option or abort it. Only one\n"
+        "    job is allowed at a time. Background job transfers one chunk\n"
+        "    per 'memjob step' command that is executed by the job thread,\n"
+        "    so other commands are processed between chunks.\n"
+        "Output format:\n"
+        "    {'Name':s,'State':s,'Total':i,'Done':i,'Written':i,\n"
+        "     'Skipped':i,'Time':i,'Error':s}\n"
+        "Usage:\n"
+        "    memjob\n"
+        "    memjob abort\n"
+        "Example:\n"
+        "    loadbin /home/ddr.bin 0x80000000 diff bg\n"
+        "    memjob\n");
+
+    iexec_ = 0;
+    job_ = 0;
+    running_ = false;
+}
+
+CmdMemJob::~CmdMemJob() {
+    running_ = false;
+    stop();
+    join(1000);
+    if (job_) {
+        delete job_;
+    }
+}
+
+int CmdMemJob::isValid(AttributeType *args) {
+    if (!cmdName_.is_equal((*args)[0u].to_string())) {
+        return CMD_INVALID;
+    }
+    if (args->size() == 1) {
+        return CMD_VALID;
+    }
+    if (args->size() == 2 && ((*args)[1].is_equal("abort")
+                           || (*args)[1].is_equal("step"))) {
+        return CMD_VALID;
+    }
+    return CMD_WRONG_ARGS;
+}
+
+void CmdMemJob::exec(AttributeType *args, AttributeType *res) {
+    res->attr_free();
+    res->make_nil();
+
+    if (args->size() == 2 && (*args)[1].is_equal("step")) {
+        if (running_ && !job_->step()) {
+            running_ = false;
+            finish();
+        }
+        return;
+    }
+    if (args->size() == 2 && (*args)[1].is_equal("abort")) {
+        if (running_) {
+            job_->setError("Aborted");
+            running_ = false;
+            finish();
+        }
+        return;
+    }
+    if (!job_) {
+        return;
+    }
+    job_->getStatus(res);
+    if (running_) {
+        (*res)["State"].make_string("Running");
+    } else if (job_->isError()) {
+        (*res)["State"].make_string("Error");
+    } else {
+        (*res)["State"].make_string("Done");
+    }
+}
+
+void CmdMemJob::start(MemStreamJob *job, AttributeType *res) {
+    if (running_) {
+        res->make_list(3);
+        (*res)[0u].make_string("ERROR");
+        (*res)[1].make_string(job->getName());
+        (*res)[2].make_string("Another memory job is running");
+        delete job;
+        return;
+    }
+    join(1000);     // release handle of the previous background job
+    if (job_) {
+        delete job_;
+    }
+    job_ = job;
+
+    if (job_->getOptions() & MEMSTREAM_BACKGROUND) {
+        if (!iexec_) {
+            AttributeType execlist;
+            RISCV_get_services_with_iface(IFACE_CMD_EXECUTOR, &execlist);
+            if (execlist.size()) {
+                IService *iserv =
+                    static_cast<IService *>(execlist[0u].to_iface());
+                iexec_ = static_cast<ICmdExecutor *>(
+                            iserv->getInterface(IFACE_CMD_EXECUTOR));
+            }
+        }
+        if (iexec_) {
+            running_ = true;
+            // enable loop before the thread started to avoid its immediate exit
+            RISCV_event_set(&loopEnable_);
+            run();
+            job_->getStatus(res);
+            (*res)["State"].make_string("Running");
+            return;
+        }
+    }
+
+    while (job_->step()) {}
+    finish();
+    if (job_->isError()) {
+        res->make_list(3);
+        (*res)[0u].make_string("ERROR");
+        (*res)[1].make_string(job_->getName());
+        (*res)[2].make_string(job_->getError());
+    }
+}
+
+void CmdMemJob::finish() {
+    AttributeType st;
+    job_->getStatus(&st);
+    RISCV_printf(NULL, 0, "%s: %s, %" RV_PRI64 "d B written, "
+                 "%" RV_PRI64 "d B skipped, %" RV_PRI64 "d ms",
+                 job_->getName(),
+                 job_->isError() ? job_->getError() : "done",
+                 st["Written"].to_uint64(),
+                 st["Skipped"].to_uint64(),
+                 st["Time"].to_uint64());
+}
+
+void CmdMemJob::busyLoop() {
+    AttributeType res;
+    while (isEnabled() && running_) {
+        iexec_->exec("memjob step", &res, true);
+        // let the console commands to take the executor between chunks
+        RISCV_sleep_ms(1);
+    }
+    res.attr_free();
+}
+
+}  // namespace debugger
@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include "api_core.h"
+#include "coreservices/icommand.h"
+#include "coreservices/icmdexec.h"
+#include "coreservices/ithread.h"
+
+namespace debugger {
+
+/** Options accepted as the trailing arguments of memory streaming commands */
+static const int MEMSTREAM_BACKGROUND = 0x1;    // 'bg'
+static const int MEMSTREAM_SKIP_ZERO  = 0x2;    // 'nozero'
+static const int MEMSTREAM_SKIP_SAME  = 0x4;    // 'diff'
+
+/**
+ * @brief Memory transfer split on bounded chunks.
+ *
+ * Each step() moves at most one chunk between the file and the target so
+ * the memory usage doesn't depend on the image size and a background job
+ * can be interleaved with the other JTAG commands.
+ */
+class MemStreamJob {
+ public:
+    MemStreamJob(IJtag *ijtag, const char *name, int opts);
+    virtual ~MemStreamJob();
+
+    static const int CHUNK_SIZE = 64 * 1024;
+
+    /** Get options from the end of the argument list, *argc is set to
+        the number of the remaining arguments */
+    static int parseOptions(AttributeType *args, unsigned *argc);
+
+    /** @return false when the job is completed or failed */
+    virtual bool step() = 0;
+
+    const char *getName() { return name_.to_string(); }
+    int getOptions() { return opts_; }
+    bool isError() { return error_.is_string(); }
+    const char *getError() { return error_.to_string(); }
+    void setError(const char *msg);
+    void getStatus(AttributeType *res);
+
+ protected:
+    /** Write chunk into target memory except zero or unchanged chunks */
+    void writeChunk(uint64_t addr, uint8_t *buf, int sz);
+    /** Update processed bytes counter and print every 10 % */
+    void progress(uint64_t done);
+
+ protected:
+    IJtag *ijtag_;
+    AttributeType name_;
+    AttributeType error_;
+    int opts_;
+    uint8_t *chunk_;
+    uint8_t *target_;           // target memory copy for 'diff' option
+    uint64_t total_;
+    uint64_t done_;
+    uint64_t written_;
+    uint64_t skipped_;
+    uint64_t t_start_;
+    int percent_;
+};
+
+/** Target memory to binary or hex file */
+class MemDumpJob : public MemStreamJob {
+ public:
+    MemDumpJob(IJtag *ijtag, int opts, FILE *fd,
+               uint64_t addr, uint64_t sz, bool hex);
+    virtual ~MemDumpJob();
+
+    virtual bool step() override;
+
+ private:
+    void writeHex(int sz);
+
+    FILE *fd_;
+    uint64_t addr_;
+    bool hex_;
+};
+
+/** Binary file to the target memory */
+class MemLoadBinJob : public MemStreamJob {
+ public:
+    MemLoadBinJob(IJtag *ijtag, int opts, FILE *fp, uint64_t addr);
+    virtual ~MemLoadBinJob();
+
+    virtual bool step() override;
+
+ private:
+    FILE *fp_;
+    uint64_t addr_;
+};
+
+/** Text line parser of the record based formats (SREC, Intel HEX) */
+class MemRecordParser {
+ public:
+    static const int REC_DATA = 0;
+    static const int REC_EOF = 1;
+    static const int REC_SKIP = 2;
+    static const int REC_ERROR = -1;
+
+    virtual ~MemRecordParser() {}
+    virtual void startRecords() {}
+    /** @return one of REC_* values */
+    virtual int parseRecord(uint8_t *line, uint64_t &addr,
+                            int &sz, uint8_t *out) = 0;
+};
+
+/** Records file to the target memory, contiguous records are merged */
+class MemLoadRecordJob : public MemStreamJob {
+ public:
+    MemLoadRecordJob(IJtag *ijtag, const char *name, int opts, FILE *fp,
+                     MemRecordParser *parser);
+    virtual ~MemLoadRecordJob();
+
+    virtual bool step() override;
+
+ private:
+    FILE *fp_;
+    MemRecordParser *parser_;
+    uint64_t chunkAddr_;
+    int chunkCnt_;
+    bool eof_;
+    uint8_t line_[2048];
+    uint8_t rec_[1024];
+};
+
+/**
+ * @brief Runner of the memory streaming jobs.
+ *
+ * Foreground job is processed inside of the calling command. Background
+ * job is processed by the separate thread chunk by chunk via command
+ * 'memjob step' so that JTAG accesses are serialized by the command
+ * executor with the commands from console.
+ */
+class CmdMemJob : public ICommand,
+                  public IThread {
+ public:
+    explicit CmdMemJob(IService *parent);
+    virtual ~CmdMemJob();
+
+    /** ICommand */
+    virtual int isValid(AttributeType *args);
+    virtual void exec(AttributeType *args, AttributeType *res);
+
+    /** Take ownership and run job */
+    void start(MemStreamJob *job, AttributeType *res);
+
+ protected:
+    /** IThread */
+    virtual void busyLoop() override;
+
+ private:
+    void finish();
+
+    ICmdExecutor *iexec_;
+    MemStreamJob *job_;         // running or the last finished job
+    volatile bool running_;
+};
+
+}  // namespace debugger
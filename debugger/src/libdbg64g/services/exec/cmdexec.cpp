@@ -26,6 +26,7 @@ CmdExecutor::CmdExecutor(const char *name)
     cmds_.make_list(0);
 
     RISCV_mutex_init(&mutexExec_);
+    execDepth_ = 0;
 
     tmpbuf_ = new uint8_t[tmpbuf_size_ = 4096];
     outbuf_ = new char[outbuf_size_ = 4096];
@@ -59,23 +60,35 @@ void CmdExecutor::unregisterCommand(ICommand *icmd) {
 
 void CmdExecutor::exec(const char *line, AttributeType *res, bool silent) {
     RISCV_mutex_lock(&mutexExec_);
+    execDepth_++;
 
     AttributeType cmd;
+    AttributeType listArgs(Attr_List), *cmd_parsed;
+
+    /** Arguments are freed at the end of exec(), commands that store them
+        make a copy outside of the active arena */
+    arena_.activate();
     if (line[0] == '[' || line[0] == '}') {
         cmd.from_config(line);
     } else {
         cmd.make_string(line);
     }
 
-    AttributeType listArgs(Attr_List), *cmd_parsed;
     if (cmd.is_string()) {
         splitLine(const_cast<char *>(cmd.to_string()), &listArgs);
         cmd_parsed = &listArgs;
     } else {
         cmd_parsed = &cmd;
     }
+    arena_.deactivate();
+
     processSimple(cmd_parsed, res);
 
+    cmd.attr_free();
+    listArgs.attr_free();
+    if (--execDepth_ == 0) {
+        arena_.reset();
+    }
     RISCV_mutex_unlock(&mutexExec_);
 
     /** Do not output any information into console in silent mode: */
@@ -62,6 +62,8 @@ class CmdExecutor : public TcpClient,
     AttributeType cmds_;
 
     mutex_def mutexExec_;
+    AttributeArena arena_;      // parsed command line (temporary trees)
+    int execDepth_;             // commands may call exec() recursively
 
     char cmdbuf_[4096];
     char *outbuf_;
@@ -16,6 +16,7 @@
 
 #include "api_core.h"
 #include "memsim.h"
+#include "generic/hexload.h"
 #include <iostream>
 #include <string.h>
 
@@ -49,13 +50,13 @@ void MemorySim::postinitService() {
     if (binaryFile_.to_bool()) {
         readBinFile(initFile_.to_string(), mem_, length_.to_int());
     } else if (strstr(initFile_.to_string(), ".hex")) {
-        readHexFile(initFile_.to_string(), mem_, length_.to_int());
+        HexImage::readHexLines(initFile_.to_string(), mem_, length_.to_int());
     } else {
         uint8_t *tbuf = new uint8_t[length_.to_int()];
         std::string lo = std::string(initFile_.to_string()) + "_lo.hex";
         std::string hi = std::string(initFile_.to_string()) + "_hi.hex";
-        int sz = readHexFile(lo.c_str(), tbuf, length_.to_int());
-        readHexFile(hi.c_str(), &tbuf[sz], length_.to_int() - sz);
+        int sz = HexImage::readHexLines(lo.c_str(), tbuf, length_.to_int());
+        HexImage::readHexLines(hi.c_str(), &tbuf[sz], length_.to_int() - sz);
 
         // Swap 32-bits words
         uint32_t *lsb = reinterpret_cast<uint32_t *>(tbuf);
@@ -69,42 +70,6 @@ void MemorySim::postinitService() {
     }
 }
 
-int MemorySim::readHexFile(const char *filename, uint8_t *buf, int bufsz) {
-    int ret = 0;
-    int rd_symb;
-    int linecnt = 0;
-    uint64_t lineval = 0;
-
-    FILE *fp = fopen(filename, "r");
-    if (fp == NULL) {
-        RISCV_error("Can't open '%s' file", filename);
-        return ret;
-    }
-
-    while (!feof(fp)) {
-        rd_symb = fgetc(fp);
-        if (chishex(rd_symb)) {
-            lineval <<= 4;
-            lineval |=  chtohex(rd_symb);
-            linecnt++;
-            continue;
-        }
-
-        if ((ret + linecnt/2) > bufsz) {
-            RISCV_error("HEX file tries to write out "
-                        "of allocated array\n", NULL);
-            break;
-        } 
-
-        memcpy(&buf[ret], &lineval, linecnt/2);
-        ret += linecnt/2;
-        linecnt = 0;
-        lineval = 0;
-    }
-    fclose(fp);
-    return ret;
-}
-
 int MemorySim::readBinFile(const char *filename, uint8_t *buf, int bufsz) {
     int ret = 0;
     FILE *fp = fopen(filename, "r");
@@ -124,28 +89,5 @@ int MemorySim::readBinFile(const char *filename, uint8_t *buf, int bufsz) {
     return ret;
 }
 
-bool MemorySim::chishex(int s) {
-    bool ret = false;
-    if (s >= '0' && s <= '9') {
-        ret = true;
-    } else if (s >= 'A' && s <= 'F') {
-        ret = true;
-    } else if (s >= 'a' && s <= 'f') {
-        ret = true;
-    }
-    return ret;
-}
-
-uint8_t MemorySim::chtohex(int s) {
-    if (s >= '0' && s <= '9') {
-        s -= '0';
-    } else if (s >= 'A' && s <= 'F') {
-        s = s - 'A' + 10;
-    } else if (s >= 'a' && s <= 'f') {
-        s = s - 'a' + 10;
-    }
-    return static_cast<uint8_t>(s);
-}
-
 }  // namespace debugger
 
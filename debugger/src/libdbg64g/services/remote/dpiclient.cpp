@@ -224,7 +224,7 @@ int DpiClient::createServerSocket() {
 #endif
     setsockopt(hsock_, SOL_SOCKET, SO_RCVTIMEO,
                     reinterpret_cast<char *>(&tv), sizeof(struct timeval));
-    setsockopt(hsock_, SOL_SOCKET, TCP_NODELAY,
+    setsockopt(hsock_, IPPROTO_TCP, TCP_NODELAY,
                     reinterpret_cast<char *>(&nodelay), sizeof(nodelay));
 
 
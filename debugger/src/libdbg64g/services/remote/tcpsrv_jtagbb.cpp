@@ -53,9 +53,21 @@ TcpServerJtagBitBang::ClientThread::~ClientThread() {
 }
 
 int TcpServerJtagBitBang::ClientThread::processRxBuffer(const char *cmdbuf, int bufsz) {
+    char tdobuf[4096];
+    int tdocnt = 0;
+    int osz;
     int ret = 0;
+    int i = 0;
+
+    while (i < bufsz && ret == 0) {
+        // Pin, reset and read commands go as one batch into the TAP
+        osz = 0;
+        i += ijtagbb_->bitbang(&cmdbuf[i], bufsz - i, &tdobuf[tdocnt], &osz);
+        tdocnt += osz;
+        if (i >= bufsz) {
+            break;
+        }
 
-    for (int i = 0; i < bufsz; i++) {
         switch (cmdbuf[i]) {
         case 'B':
             RISCV_debug("%s", "Blink on");
@@ -63,45 +75,6 @@ int TcpServerJtagBitBang::ClientThread::processRxBuffer(const char *cmdbuf, int
         case 'b':
             RISCV_debug("%s", "Blink off");
             break;
-        case 'r':
-            ijtagbb_->resetTAP(0, 0);
-            break;
-        case 's':
-            ijtagbb_->resetTAP(0, 1);
-            break;
-        case 't':
-            ijtagbb_->resetTAP(1, 0);
-            break;
-        case 'u':
-            ijtagbb_->resetTAP(1, 1);
-            break;
-        case '0':
-            ijtagbb_->setPins(0, 0, 0);
-            break;
-        case '1':
-            ijtagbb_->setPins(0, 0, 1);
-            break;
-        case '2':
-            ijtagbb_->setPins(0, 1, 0);
-            break;
-        case '3':
-            ijtagbb_->setPins(0, 1, 1);
-            break;
-        case '4':
-            ijtagbb_->setPins(1, 0, 0);
-            break;
-        case '5':
-            ijtagbb_->setPins(1, 0, 1);
-            break;
-        case '6':
-            ijtagbb_->setPins(1, 1, 0);
-            break;
-        case '7':
-            ijtagbb_->setPins(1, 1, 1);
-            break;
-        case 'R':
-            writeTxBuffer(ijtagbb_->getTDO() ? "1" : "0", 1);
-            break;
         case 'Q':
             ret = -1;
             break;
@@ -109,8 +82,13 @@ int TcpServerJtagBitBang::ClientThread::processRxBuffer(const char *cmdbuf, int
             RISCV_error("Unsupported command '%c'\n", cmdbuf[i]);
             ret = -1;
         }
+        i++;
     }
 
+    // All TDO responses of the received buffer in one write
+    if (tdocnt) {
+        writeTxBuffer(tdobuf, tdocnt);
+    }
     return ret;
 }
 
@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <vector>
+#include "cmd_addr2line.h"
+
+namespace debugger {
+
+CmdAddr2Line::CmdAddr2Line(IService *parent)
+    : ICommand(parent, "addr2line") {
+
+    briefDescr_.make_string("Convert addresses into symbols and source lines");
+    detailedDescr_.make_string(
+        "Description:\n"
+        "    Convert instruction addresses into the symbol name, offset\n"
+        "    and source file line using symbol table and '.debug_line'\n"
+        "    section of the loaded ELF-file. Second form converts the text\n"
+        "    file with one hex address per line in batches.\n"
+        "Response:\n"
+        "    List of [addr, 'symbol', offset, 'file', line] for each address\n"
+        "    or number of converted addresses\n"
+        "Usage:\n"
+        "    addr2line <addr> [<addr> ...]\n"
+        "    addr2line <in-file> <out-file>\n"
+        "Example:\n"
+        "    addr2line 0x10000040 0x100002a4\n"
+        "    addr2line pc_samples.txt pc_samples_src.txt\n");
+
+    isrc_ = static_cast<ISourceCode *>(
+                            parent->getInterface(IFACE_SOURCE_CODE));
+}
+
+int CmdAddr2Line::isValid(AttributeType *args) {
+    if (!cmdName_.is_equal((*args)[0u].to_string())) {
+        return CMD_INVALID;
+    }
+    if (args->size() == 3 && (*args)[1].is_string()
+        && (*args)[2].is_string()) {
+        return CMD_VALID;
+    }
+    if (args->size() < 2) {
+        return CMD_WRONG_ARGS;
+    }
+    for (unsigned i = 1; i < args->size(); i++) {
+        if (!(*args)[i].is_integer()) {
+            return CMD_WRONG_ARGS;
+        }
+    }
+    return CMD_VALID;
+}
+
+void CmdAddr2Line::exec(AttributeType *args, AttributeType *res) {
+    res->attr_free();
+    res->make_nil();
+    if (!isrc_) {
+        generateError(res, "ISource interface not found");
+        return;
+    }
+    if ((*args)[1].is_string()) {
+        convertFile((*args)[1].to_string(), (*args)[2].to_string(), res);
+        return;
+    }
+
+    unsigned cnt = args->size() - 1;
+    std::vector<uint64_t> addr(cnt);
+    std::vector<SourceLocationType> loc(cnt);
+    for (unsigned i = 0; i < cnt; i++) {
+        addr[i] = (*args)[i + 1].to_uint64();
+    }
+    isrc_->addressToSource(&addr[0], cnt, &loc[0]);
+
+    res->make_list(cnt);
+    for (unsigned i = 0; i < cnt; i++) {
+        AttributeType &item = (*res)[i];
+        item.make_list(5);
+        item[0u].make_uint64(addr[i]);
+        item[1].make_string(loc[i].symbol);
+        item[2].make_uint64(loc[i].offset);
+        item[3].make_string(loc[i].file);
+        item[4].make_int64(loc[i].line);
+    }
+}
+
+void CmdAddr2Line::writeBatch(FILE *fout, const uint64_t *addr,
+                              unsigned cnt) {
+    SourceLocationType loc[BATCH_SIZE];
+
+    isrc_->addressToSource(addr, cnt, loc);
+    for (unsigned i = 0; i < cnt; i++) {
+        fprintf(fout, "%016" RV_PRI64 "x %s+0x%" RV_PRI64 "x %s:%d\n",
+                addr[i],
+                loc[i].symbol[0] ? loc[i].symbol : "??",
+                loc[i].offset,
+                loc[i].file[0] ? loc[i].file : "??",
+                loc[i].line);
+    }
+}
+
+void CmdAddr2Line::convertFile(const char *infile, const char *outfile,
+                               AttributeType *res) {
+    uint64_t addr[BATCH_SIZE];
+    unsigned cnt = 0;
+    uint64_t total = 0;
+    char line[256];
+
+    FILE *fin = fopen(infile, "rb");
+    if (!fin) {
+        generateError(res, "Cannot open file");
+        return;
+    }
+    FILE *fout = fopen(outfile, "wb");
+    if (!fout) {
+        generateError(res, "Cannot create output file");
+        fclose(fin);
+        return;
+    }
+
+    while (fgets(line, sizeof(line), fin)) {
+        char *end;
+        uint64_t val = strtoull(line, &end, 16);
+        if (end == line) {
+            continue;
+        }
+        addr[cnt++] = val;
+        if (cnt == BATCH_SIZE) {
+            writeBatch(fout, addr, cnt);
+            total += cnt;
+            cnt = 0;
+        }
+    }
+    if (cnt) {
+        writeBatch(fout, addr, cnt);
+        total += cnt;
+    }
+    fclose(fout);
+    fclose(fin);
+    res->make_uint64(total);
+}
+
+}  // namespace debugger
@@ -0,0 +1,204 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <string.h>
+#include <riscv-isa.h>
+#include "cmd_tracebin.h"
+
+namespace debugger {
+
+extern int disasm_riscv(uint64_t pc,
+                        uint8_t *data,
+                        int offset,
+                        AttributeType *mnemonic,
+                        AttributeType *comment);
+
+CmdTraceBin::CmdTraceBin(IService *parent)
+    : ICommand(parent, "tracebin") {
+
+    briefDescr_.make_string("Decode or compare binary trace files");
+    detailedDescr_.make_string(
+        "Description:\n"
+        "    Convert binary trace file generated by functional or RTL\n"
+        "    model into the text format with the disassembled\n"
+        "    instructions. 'diff' compares two binary traces ignoring\n"
+        "    step counters and returns the first mismatching record\n"
+        "    [index, pc1, pc2], pc is 0 for the trace that ended\n"
+        "    earlier. Empty list means identical traces.\n"
+        "Usage:\n"
+        "    tracebin <bin-file> <text-file>\n"
+        "    tracebin diff <bin-file1> <bin-file2>\n"
+        "Example:\n"
+        "    tracebin trace_river_sysc0.bin trace_river_sysc0.log\n"
+        "    tracebin diff trace_river_func.bin trace_river_sysc0.bin\n");
+}
+
+int CmdTraceBin::isValid(AttributeType *args) {
+    if (!cmdName_.is_equal((*args)[0u].to_string())) {
+        return CMD_INVALID;
+    }
+    if (args->size() == 3 && (*args)[1].is_string()
+        && (*args)[2].is_string()) {
+        return CMD_VALID;
+    }
+    if (args->size() == 4 && (*args)[1].is_equal("diff")) {
+        return CMD_VALID;
+    }
+    return CMD_WRONG_ARGS;
+}
+
+void CmdTraceBin::exec(AttributeType *args, AttributeType *res) {
+    res->attr_free();
+    res->make_nil();
+    if (args->size() == 4) {
+        compare((*args)[2].to_string(), (*args)[3].to_string(), res);
+    } else {
+        decode((*args)[1].to_string(), (*args)[2].to_string(), res);
+    }
+}
+
+FILE *CmdTraceBin::openTrace(const char *filename, AttributeType *res) {
+    TraceBinHeaderType hdr;
+    FILE *fp = fopen(filename, "rb");
+    if (!fp) {
+        generateError(res, "Cannot open file");
+        return 0;
+    }
+    if (fread(&hdr, 1, sizeof(hdr), fp) != sizeof(hdr)
+        || memcmp(hdr.magic, TRACE_BIN_MAGIC, sizeof(hdr.magic)) != 0
+        || hdr.version != TRACE_BIN_VERSION
+        || hdr.record_size != sizeof(TraceBinRecordType)) {
+        generateError(res, "Wrong trace file format");
+        fclose(fp);
+        return 0;
+    }
+    return fp;
+}
+
+void CmdTraceBin::decode(const char *binfile, const char *txtfile,
+                         AttributeType *res) {
+    TraceBinRecordType rec;
+    AttributeType mnemonic, comment;
+    Reg64Type code;
+    char tstr[256];
+    int sz;
+    uint64_t total = 0;
+
+    FILE *fin = openTrace(binfile, res);
+    if (!fin) {
+        return;
+    }
+    FILE *fout = fopen(txtfile, "wb");
+    if (!fout) {
+        generateError(res, "Cannot create output file");
+        fclose(fin);
+        return;
+    }
+
+    while (fread(&rec, sizeof(rec), 1, fin) == 1) {
+        code.val = rec.instr;
+        disasm_riscv(rec.pc, code.buf, 0, &mnemonic, &comment);
+        sz = RISCV_sprintf(tstr, sizeof(tstr),
+            "%9" RV_PRI64 "d: %08" RV_PRI64 "x: %s \n",
+                rec.step_cnt,
+                rec.pc,
+                mnemonic.is_string() ? mnemonic.to_string() : "unimp");
+        fwrite(tstr, 1, sz, fout);
+
+        for (int i = 0; i < rec.memcnt && i < TRACE_BIN_MEM_MAX; i++) {
+            sz = RISCV_sprintf(tstr, sizeof(tstr),
+                "%20s [%08" RV_PRI64 "x] %s %016" RV_PRI64 "x\n",
+                    "",
+                    rec.mem[i].addr,
+                    rec.mem[i].store ? "<=" : "=>",
+                    rec.mem[i].data);
+            fwrite(tstr, 1, sz, fout);
+        }
+        for (int i = 0; i < rec.regcnt && i < TRACE_BIN_REG_MAX; i++) {
+            sz = RISCV_sprintf(tstr, sizeof(tstr),
+                "%20s %10s <= %016" RV_PRI64 "x\n",
+                    "",
+                    RISCV_IREGS_NAMES[rec.reg[i].addr & 0x3F],
+                    rec.reg[i].data);
+            fwrite(tstr, 1, sz, fout);
+        }
+        total++;
+    }
+    fclose(fout);
+    fclose(fin);
+    res->make_uint64(total);
+}
+
+bool CmdTraceBin::isEqual(const TraceBinRecordType &a,
+                          const TraceBinRecordType &b) {
+    if (a.pc != b.pc || a.instr != b.instr
+        || a.regcnt != b.regcnt || a.memcnt != b.memcnt) {
+        return false;
+    }
+    for (int i = 0; i < a.regcnt && i < TRACE_BIN_REG_MAX; i++) {
+        if (a.reg[i].addr != b.reg[i].addr
+            || a.reg[i].data != b.reg[i].data) {
+            return false;
+        }
+    }
+    for (int i = 0; i < a.memcnt && i < TRACE_BIN_MEM_MAX; i++) {
+        if (a.mem[i].addr != b.mem[i].addr
+            || a.mem[i].data != b.mem[i].data
+            || a.mem[i].store != b.mem[i].store) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CmdTraceBin::compare(const char *file1, const char *file2,
+                          AttributeType *res) {
+    TraceBinRecordType r1, r2;
+    size_t n1, n2;
+    uint64_t idx = 0;
+
+    FILE *f1 = openTrace(file1, res);
+    if (!f1) {
+        return;
+    }
+    FILE *f2 = openTrace(file2, res);
+    if (!f2) {
+        fclose(f1);
+        return;
+    }
+
+    res->make_list(0);
+    while (1) {
+        n1 = fread(&r1, sizeof(r1), 1, f1);
+        n2 = fread(&r2, sizeof(r2), 1, f2);
+        if (n1 != 1 && n2 != 1) {
+            break;
+        }
+        if (n1 != n2 || !isEqual(r1, r2)) {
+            // [record index, pc1, pc2]
+            res->make_list(3);
+            (*res)[0u].make_uint64(idx);
+            (*res)[1].make_uint64(n1 == 1 ? r1.pc : 0);
+            (*res)[2].make_uint64(n2 == 1 ? r2.pc : 0);
+            break;
+        }
+        idx++;
+    }
+    fclose(f1);
+    fclose(f2);
+}
+
+}  // namespace debugger
@@ -0,0 +1,41 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <api_core.h>
+#include <iservice.h>
+#include "coreservices/icommand.h"
+#include "generic/trace_bin.h"
+
+namespace debugger {
+
+class CmdTraceBin : public ICommand {
+ public:
+    explicit CmdTraceBin(IService *parent);
+
+    /** ICommand */
+    virtual int isValid(AttributeType *args);
+    virtual void exec(AttributeType *args, AttributeType *res);
+
+ private:
+    FILE *openTrace(const char *filename, AttributeType *res);
+    void decode(const char *binfile, const char *txtfile, AttributeType *res);
+    void compare(const char *file1, const char *file2, AttributeType *res);
+    bool isEqual(const TraceBinRecordType &a, const TraceBinRecordType &b);
+};
+
+}  // namespace debugger
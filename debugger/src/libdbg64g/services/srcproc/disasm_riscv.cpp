@@ -18,945 +18,158 @@
 #include <attribute.h>
 #include <api_core.h>
 #include "coreservices/icpuriscv.h"
+#include "generic/riscv_decoder.h"
 #include <inttypes.h>
-#include <iostream>
+#include <ctype.h>
 
 namespace debugger {
 
 static const char *const *RN = RISCV_IREGS_NAMES;
 static const char *const *RF = &RISCV_IREGS_NAMES[ICpuRiscV::RegFpu_Offset];
 
-typedef int (*disasm_opcode_f)(uint64_t pc, uint32_t code,
-                              AttributeType *mnemonic, AttributeType *comment);
-
-typedef int (*disasm_opcode16_f)(uint64_t pc,
-                                Reg16Type code, AttributeType *mnemonic,
-                                AttributeType *comment);
-
-int opcode_0x00(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x01(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x03(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x04(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x05(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x06(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x08(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x09(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x0B(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x0C(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x0D(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x0E(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x14(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x18(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x19(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x1B(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-int opcode_0x1C(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment);
-
-int C_ADDI16SP_LUI(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_ADDI4SPN(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_BEQZ(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_BNEZ(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_J(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_JAL_ADDIW(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_JR_MV_EBREAK_JALR_ADD(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_LD(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_LI(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_LDSP(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_LW(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_LWSP(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_MATH(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_NOP_ADDI(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_SD(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_SDSP(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_SLLI(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_SW(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-int C_SWSP(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment);
-
-
-static const disasm_opcode_f tblOpcode1_[32] = {
-    &opcode_0x00, // 0
-    &opcode_0x01, // 1
-    0, // 2
-    &opcode_0x03, // 3
-    &opcode_0x04, // 4
-    &opcode_0x05, // 5
-    &opcode_0x06, // 6
-    0, // 7
-    &opcode_0x08, // 8
-    &opcode_0x09, // 9
-    0, // 0x0A
-    &opcode_0x0B, // 0x0B
-    &opcode_0x0C, // 0x0C
-    &opcode_0x0D, // 0x0D
-    &opcode_0x0E, // 0x0E
-    0, // 0x0F
-    0, // 0x10
-    0, // 0x11
-    0, // 0x12
-    0, // 0x13
-    &opcode_0x14, // 0x14
-    0, // 0x15
-    0, // 0x16
-    0, // 0x17
-    &opcode_0x18, // 0x18
-    &opcode_0x19, // 0x19
-    0, // 0x1A
-    &opcode_0x1B, // 0x1B
-    &opcode_0x1C, // 0x1C
-    0, // 0x1D
-    0, // 0x1E
-    0 // 0x1F
-};
-
-static const disasm_opcode16_f tblCompressed_[32] = {
-    &C_ADDI4SPN, // 0x00
-    &C_NOP_ADDI, // 0x01
-    &C_SLLI, // 0x02
-    0, // 0x03
-    0, // 0x04
-    &C_JAL_ADDIW, // 0x05
-    0, // 0x06
-    0, // 0x07
-    &C_LW, // 0x08
-    &C_LI, // 0x09
-    &C_LWSP, // 0x0A
-    0, // 0x0B
-    &C_LD, // 0x0C
-    &C_ADDI16SP_LUI, // 0x0D
-    &C_LDSP, // 0x0E
-    0, // 0x0F
-    0, // 0x10
-    &C_MATH, // 0x11
-    &C_JR_MV_EBREAK_JALR_ADD, // 0x12
-    0, // 0x13
-    0, // 0x14
-    &C_J, // 0x15
-    0, // 0x16
-    0, // 0x17
-    &C_SW, // 0x18
-    &C_BEQZ, // 0x19
-    &C_SWSP, // 0x1A
-    0, // 0x1B
-    &C_SD, // 0x1C
-    &C_BNEZ, // 0x1D
-    &C_SDSP, // 0x1E
-    0 // 0x1F
-};
-
-int disasm_riscv(uint64_t pc,
-                uint8_t *data,
-                int offset,
-                AttributeType *mnemonic,
-                AttributeType *comment) {
-    int oplen;
-    if ((data[offset] & 0x3) < 3) {
-        Reg16Type val;
-        uint32_t hash;
-        val.word = *reinterpret_cast<uint16_t*>(&data[offset]);
-        hash = ((val.word >> 11) & 0x1C) | (val.word & 0x3);
-        oplen = 2;
-        if (tblCompressed_[hash]) {
-            return tblCompressed_[hash](pc + static_cast<uint64_t>(offset),
-                                        val,
-                                        mnemonic,
-                                        comment);
-        }
-    } else if ((data[offset] & 0x3) == 0x3) {
-        uint32_t val = *reinterpret_cast<uint32_t*>(&data[offset]);
-        uint32_t opcode1 = (val >> 2) & 0x1f;
-        oplen = 4;
-        if (tblOpcode1_[opcode1]) {
-            return tblOpcode1_[opcode1](pc + static_cast<uint64_t>(offset),
-                                        val,
-                                        mnemonic,
-                                        comment);
-        }
-    }
+/**
+ * Operands formatter of the instruction group.
+ * @param op Mnemonic of the decoded instruction
+ */
+typedef void (*disasm_format_f)(const char *op, uint64_t pc, uint32_t code,
+                                char *tstr, size_t sz);
 
-    mnemonic->make_string("unimpl");
-    comment->make_string("");
-    return oplen;
+static void fmt_none(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
+    RISCV_sprintf(tstr, sz, "%s", op);
 }
 
+static void fmt_r(const char *op, uint64_t pc, uint32_t code,
+                  char *tstr, size_t sz) {
+    ISA_R_type r;
+    r.value = code;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%s",
+        op, RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
+}
 
-int opcode_0x00(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
+static void fmt_i(const char *op, uint64_t pc, uint32_t code,
+                  char *tstr, size_t sz) {
     ISA_I_type i;
-    int32_t imm;
-
     i.value = code;
-    imm = static_cast<int32_t>(code) >> 20;
-    switch (i.bits.funct3) {
-    case 0:
-        RISCV_sprintf(tstr, sizeof(tstr), "lb      %s,%d(%s)",
-            RN[i.bits.rd], imm, RN[i.bits.rs1]);
-        break;
-    case 1:
-        RISCV_sprintf(tstr, sizeof(tstr), "lh      %s,%d(%s)",
-            RN[i.bits.rd], imm, RN[i.bits.rs1]);
-        break;
-    case 2:
-        RISCV_sprintf(tstr, sizeof(tstr), "lw      %s,%d(%s)",
-            RN[i.bits.rd], imm, RN[i.bits.rs1]);
-        break;
-    case 3:
-        RISCV_sprintf(tstr, sizeof(tstr), "ld      %s,%d(%s)",
-            RN[i.bits.rd], imm, RN[i.bits.rs1]);
-        break;
-    case 4:
-        RISCV_sprintf(tstr, sizeof(tstr), "lbu     %s,%d(%s)",
-            RN[i.bits.rd], imm, RN[i.bits.rs1]);
-        break;
-    case 5:
-        RISCV_sprintf(tstr, sizeof(tstr), "lhu     %s,%d(%s)",
-            RN[i.bits.rd], imm, RN[i.bits.rs1]);
-        break;
-    case 6:
-        RISCV_sprintf(tstr, sizeof(tstr), "lwu     %s,%d(%s)",
-            RN[i.bits.rd], imm, RN[i.bits.rs1]);
-        break;
-    default:;
-    }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
+    int32_t imm = static_cast<int32_t>(code) >> 20;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%d",
+        op, RN[i.bits.rd], RN[i.bits.rs1], imm);
 }
 
-int opcode_0x01(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
+static void fmt_addi(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
     ISA_I_type i;
-    int32_t imm;
-
     i.value = code;
-    imm = static_cast<int32_t>(code) >> 20;
-    switch (i.bits.funct3) {
-    case 3:
-        RISCV_sprintf(tstr, sizeof(tstr), "fld     %s,%d(%s)",
-            RF[i.bits.rd], imm, RN[i.bits.rs1]);
-        break;
-    default:;
-    }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
-}
-
-int opcode_0x03(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
-    ISA_R_type r;
-
-    r.value = code;
-    switch (r.bits.funct3) {
-    case 0:
-        RISCV_sprintf(tstr, sizeof(tstr), "%s", "fence");
-        break;
-    case 1:
-        RISCV_sprintf(tstr, sizeof(tstr), "%s", "fence_i");
-        break;
-    default:;
+    int32_t imm = static_cast<int32_t>(code) >> 20;
+    if (imm == 0) {
+        RISCV_sprintf(tstr, sz, "mv      %s,%s",
+            RN[i.bits.rd], RN[i.bits.rs1]);
+    } else if (i.bits.rs1 == 0) {
+        RISCV_sprintf(tstr, sz, "li      %s,%d", RN[i.bits.rd], imm);
+    } else {
+        fmt_i(op, pc, code, tstr, sz);
     }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
 }
 
-int opcode_0x04(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
+static void fmt_shift(const char *op, uint64_t pc, uint32_t code,
+                      char *tstr, size_t sz) {
     ISA_I_type i;
-    int32_t imm;
-
     i.value = code;
-    imm = static_cast<int32_t>(code) >> 20;
-    switch (i.bits.funct3) {
-    case 0:
-        if (imm == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "mv      %s,%s",
-                RN[i.bits.rd], RN[i.bits.rs1]);
-        } else if (i.bits.rs1 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "li      %s,%d",
-                RN[i.bits.rd], imm);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "addi    %s,%s,%d",
-                RN[i.bits.rd], RN[i.bits.rs1], imm);
-        }
-        break;
-    case 1:
-        RISCV_sprintf(tstr, sizeof(tstr), "slli    %s,%s,%d",
-            RN[i.bits.rd], RN[i.bits.rs1], imm);
-        break;
-    case 2:
-        RISCV_sprintf(tstr, sizeof(tstr), "slti    %s,%s,%d",
-            RN[i.bits.rd], RN[i.bits.rs1], imm);
-        break;
-    case 3:
-        RISCV_sprintf(tstr, sizeof(tstr), "sltiu   %s,%s,%d",
-            RN[i.bits.rd], RN[i.bits.rs1], imm);
-        break;
-    case 4:
-        RISCV_sprintf(tstr, sizeof(tstr), "xori    %s,%s,%d",
-            RN[i.bits.rd], RN[i.bits.rs1], imm);
-        break;
-    case 5:
-        if ((code >> 26) == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "srli    %s,%s,%d",
-                RN[i.bits.rd], RN[i.bits.rs1], imm);
-        } else if ((code >> 26) == 0x20) {
-            RISCV_sprintf(tstr, sizeof(tstr), "srai    %s,%s,%d",
-                RN[i.bits.rd], RN[i.bits.rs1], imm);
-        }
-        break;
-    case 6:
-        RISCV_sprintf(tstr, sizeof(tstr), "ori     %s,%s,%d",
-            RN[i.bits.rd], RN[i.bits.rs1], imm);
-        break;
-    case 7:
-        RISCV_sprintf(tstr, sizeof(tstr), "andi    %s,%s,%d",
-            RN[i.bits.rd], RN[i.bits.rs1], imm);
-        break;
-    default:;
-    }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%d",
+        op, RN[i.bits.rd], RN[i.bits.rs1], (code >> 20) & 0x3F);
 }
 
-int opcode_0x05(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
-    ISA_U_type u;
-    uint64_t imm64;
-
-    u.value = code;
-    imm64 = u.bits.imm31_12 << 12;
-    if (imm64 & (1LL << 31)) {
-        imm64 |= EXT_SIGN_32;
-    }
-    RISCV_sprintf(tstr, sizeof(tstr), "auipc   %s,0x%" RV_PRI64 "x",
-        RN[u.bits.rd], imm64);
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
+static void fmt_load(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
+    ISA_I_type i;
+    i.value = code;
+    int32_t imm = static_cast<int32_t>(code) >> 20;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(%s)",
+        op, RN[i.bits.rd], imm, RN[i.bits.rs1]);
 }
 
-int opcode_0x06(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
+static void fmt_fload(const char *op, uint64_t pc, uint32_t code,
+                      char *tstr, size_t sz) {
     ISA_I_type i;
-    int32_t imm;
-
     i.value = code;
-    imm = static_cast<int32_t>(code) >> 20;
-    switch (i.bits.funct3) {
-    case 0:
-        RISCV_sprintf(tstr, sizeof(tstr), "addiw   %s,%s,%d",
-            RN[i.bits.rd], RN[i.bits.rs1], imm);
-        break;
-    case 1:
-        RISCV_sprintf(tstr, sizeof(tstr), "slliw   %s,%s,%d",
-            RN[i.bits.rd], RN[i.bits.rs1], imm);
-        break;
-    case 5:
-        if ((code >> 25) == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "srliw   %s,%s,%d",
-                RN[i.bits.rd], RN[i.bits.rs1], imm);
-        } else if ((code >> 25) == 0x20) {
-            RISCV_sprintf(tstr, sizeof(tstr), "sraiw   %s,%s,%d",
-                RN[i.bits.rd], RN[i.bits.rs1], imm);
-        }
-        break;
-    default:;
-    }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
+    int32_t imm = static_cast<int32_t>(code) >> 20;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(%s)",
+        op, RF[i.bits.rd], imm, RN[i.bits.rs1]);
 }
 
-int opcode_0x08(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
+static int32_t imm_store(uint32_t code) {
     ISA_S_type s;
-    int32_t imm;
     s.value = code;
-    imm = (s.bits.imm11_5 << 5) | s.bits.imm4_0;
+    int32_t imm = (s.bits.imm11_5 << 5) | s.bits.imm4_0;
     if (imm & 0x800) {
         imm |= EXT_SIGN_12;
     }
-    switch (s.bits.funct3) {
-    case 0:
-        RISCV_sprintf(tstr, sizeof(tstr), "sb      %s,%d(%s)",
-            RN[s.bits.rs2], imm, RN[s.bits.rs1]);
-        break;
-    case 1:
-        RISCV_sprintf(tstr, sizeof(tstr), "sh      %s,%d(%s)",
-            RN[s.bits.rs2], imm, RN[s.bits.rs1]);
-        break;
-    case 2:
-        RISCV_sprintf(tstr, sizeof(tstr), "sw      %s,%d(%s)",
-            RN[s.bits.rs2], imm, RN[s.bits.rs1]);
-        break;
-    case 3:
-        RISCV_sprintf(tstr, sizeof(tstr), "sd      %s,%d(%s)",
-            RN[s.bits.rs2], imm, RN[s.bits.rs1]);
-        break;
-    default:;
-    }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
+    return imm;
 }
 
-int opcode_0x09(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
+static void fmt_store(const char *op, uint64_t pc, uint32_t code,
+                      char *tstr, size_t sz) {
     ISA_S_type s;
-    int32_t imm;
     s.value = code;
-    imm = (s.bits.imm11_5 << 5) | s.bits.imm4_0;
-    if (imm & 0x800) {
-        imm |= EXT_SIGN_12;
-    }
-    switch (s.bits.funct3) {
-    case 3:
-        RISCV_sprintf(tstr, sizeof(tstr), "fsd     %s,%d(%s)",
-            RF[s.bits.rs2], imm, RN[s.bits.rs1]);
-        break;
-    default:;
-    }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(%s)",
+        op, RN[s.bits.rs2], imm_store(code), RN[s.bits.rs1]);
 }
 
-// Atomic Memory Operations (AMO)
-int opcode_0x0B(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
-    const char *aquired[2] = {"", ".aq"};
-    const char *released[2] = {"", ".rl"};
-    size_t tlen = 0;
-    ISA_R_type r;
-    r.value = code;
-    switch (r.amobits.funct3) {
-    case 2: // 32-bits
-        switch (r.amobits.funct5) {
-        case 0x00:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amoadd_w");
-            break;
-        case 0x01:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amoswap_w");
-            break;
-        case 0x02:
-            if (r.amobits.rs2 == 0) {
-                tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "lr_w");
-            }
-            break;
-        case 0x03:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "sc_w");
-            break;
-        case 0x04:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amoxor_w");
-            break;
-        case 0x08:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amoor_w");
-            break;
-        case 0x0C:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amoand_w");
-            break;
-        case 0x10:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amomin_w");
-            break;
-        case 0x14:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amomax_w");
-            break;
-        case 0x18:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amominu_w");
-            break;
-        case 0x1C:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amomaxu_w");
-            break;
-        default:;
-        }
-        break;
-    case 3: // RV64 only
-        switch (r.amobits.funct5) {
-        case 0x00:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amoadd_d");
-            break;
-        case 0x01:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amoswap_d");
-            break;
-        case 0x02:
-            if (r.amobits.rs2 == 0) {
-                tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "lr_d");
-            }
-            break;
-        case 0x03:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "sc_d");
-            break;
-        case 0x04:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amoxor_d");
-            break;
-        case 0x08:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amoor_d");
-            break;
-        case 0x0C:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amoand_d");
-            break;
-        case 0x10:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amomin_d");
-            break;
-        case 0x14:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amomax_d");
-            break;
-        case 0x18:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amominu_d");
-            break;
-        case 0x1C:
-            tlen = RISCV_sprintf(tstr, sizeof(tstr), "%s", "amomaxu_d");
-            break;
-        default:;
-        }
-        break;
-    default:;
-    }
-    if (tlen) {
-        RISCV_sprintf(&tstr[tlen], sizeof(tstr)-tlen, "%s%s %s,%s,(%s)",
-            aquired[r.amobits.aq],
-            released[r.amobits.rl],
-            RN[r.amobits.rd], RN[r.amobits.rs2], RN[r.amobits.rs1]);
-    }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
-}
-
-int opcode_0x0C(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
-    ISA_R_type r;
-    r.value = code;
-    switch (r.bits.funct3) {
-    case 0:
-        if (r.bits.funct7 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "add     %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "mul     %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 0x20) {
-            RISCV_sprintf(tstr, sizeof(tstr), "sub     %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        }
-        break;
-    case 1:
-        RISCV_sprintf(tstr, sizeof(tstr), "sll     %s,%s,%s",
-            RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        break;
-    case 2:
-        RISCV_sprintf(tstr, sizeof(tstr), "slt     %s,%s,%s",
-            RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        break;
-    case 3:
-        RISCV_sprintf(tstr, sizeof(tstr), "sltu     %s,%s,%s",
-            RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        break;
-    case 4:
-        if (r.bits.funct7 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "xor     %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "div     %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        }
-        break;
-    case 5:
-        if (r.bits.funct7 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "srl     %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "divu    %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 0x20) {
-            RISCV_sprintf(tstr, sizeof(tstr), "sra     %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        }
-        break;
-    case 6:
-        if (r.bits.funct7 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "or      %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "rem     %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        }
-        break;
-    case 7:
-        if (r.bits.funct7 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "and     %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "remu    %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        }
-        break;
-    default:;
-    }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
+static void fmt_fstore(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
+    ISA_S_type s;
+    s.value = code;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(%s)",
+        op, RF[s.bits.rs2], imm_store(code), RN[s.bits.rs1]);
 }
 
-int opcode_0x0D(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
+static void fmt_lui(const char *op, uint64_t pc, uint32_t code,
+                    char *tstr, size_t sz) {
     ISA_U_type u;
     u.value = code;
-    RISCV_sprintf(tstr, sizeof(tstr), "lui     %s,0x%x",
-        RN[u.bits.rd], u.bits.imm31_12);
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
+    RISCV_sprintf(tstr, sz, "%-7s %s,0x%x",
+        op, RN[u.bits.rd], u.bits.imm31_12);
 }
 
-int opcode_0x0E(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
-    ISA_R_type r;
-
-    r.value = code;
-    switch (r.bits.funct3) {
-    case 0:
-        if (r.bits.funct7 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "addw    %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "mulw    %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 0x20) {
-            RISCV_sprintf(tstr, sizeof(tstr), "subw    %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        }
-        break;
-    case 1:
-        RISCV_sprintf(tstr, sizeof(tstr), "sllw    %s,%s,%s",
-            RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        break;
-    case 4:
-        if (r.bits.funct7 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "divw    %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        }
-        break;
-    case 5:
-        if (r.bits.funct7 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "srlw    %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "divuw   %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        } else if (r.bits.funct7 == 0x20) {
-            RISCV_sprintf(tstr, sizeof(tstr), "sraw    %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        }
-        break;
-    case 6:
-        if (r.bits.funct7 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "remw    %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        }
-        break;
-    case 7:
-        if (r.bits.funct7 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "remuw   %s,%s,%s",
-                RN[r.bits.rd], RN[r.bits.rs1], RN[r.bits.rs2]);
-        }
-        break;
-    default:;
-    }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
-}
-
-int opcode_0x14(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
-    ISA_R_type u;
+static void fmt_auipc(const char *op, uint64_t pc, uint32_t code,
+                      char *tstr, size_t sz) {
+    ISA_U_type u;
     u.value = code;
-
-    switch (u.bits.funct7) {
-    case 0x1:
-        RISCV_sprintf(tstr, sizeof(tstr), "fadd.d  %s,%s,%s",
-            RF[u.bits.rd], RF[u.bits.rs1], RF[u.bits.rs2]);
-        break;
-    case 0x5:
-        RISCV_sprintf(tstr, sizeof(tstr), "fsub.d  %s,%s,%s",
-            RF[u.bits.rd], RF[u.bits.rs1], RF[u.bits.rs2]);
-        break;
-    case 0x9:
-        RISCV_sprintf(tstr, sizeof(tstr), "fmul.d  %s,%s,%s",
-            RF[u.bits.rd], RF[u.bits.rs1], RF[u.bits.rs2]);
-        break;
-    case 0xd:
-        RISCV_sprintf(tstr, sizeof(tstr), "fdiv.d  %s,%s,%s",
-            RF[u.bits.rd], RF[u.bits.rs1], RF[u.bits.rs2]);
-        break;
-    case 0x15:
-        if (u.bits.funct3 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fmin.d  %s,%s,%s",
-                RF[u.bits.rd], RF[u.bits.rs1], RF[u.bits.rs2]);
-        } else if (u.bits.funct3 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fmax.d  %s,%s,%s",
-                RF[u.bits.rd], RF[u.bits.rs1], RF[u.bits.rs2]);
-        }
-        break;
-    case 0x2d:
-        if (u.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fsqrt.d %s,%s",
-                RF[u.bits.rd], RF[u.bits.rs1]);
-        }
-        break;
-    case 0x51:
-        if (u.bits.funct3 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fle.d   %s,%s,%s",
-                RN[u.bits.rd], RF[u.bits.rs1], RF[u.bits.rs2]);
-        } else if (u.bits.funct3 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "flt.d   %s,%s,%s",
-                RN[u.bits.rd], RF[u.bits.rs1], RF[u.bits.rs2]);
-        } else if (u.bits.funct3 == 2) {
-            RISCV_sprintf(tstr, sizeof(tstr), "feq.d   %s,%s,%s",
-                RN[u.bits.rd], RF[u.bits.rs1], RF[u.bits.rs2]);
-        }
-        break;
-    case 0x61:
-        if (u.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fcvt.w.d  %s,%s",
-                RN[u.bits.rd], RF[u.bits.rs1]);
-        } else if (u.bits.rs2 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fcvt.wu.d  %s,%s",
-                RN[u.bits.rd], RF[u.bits.rs1]);
-        } else if (u.bits.rs2 == 2) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fcvt.l.d  %s,%s",
-                RN[u.bits.rd], RF[u.bits.rs1]);
-        } else if (u.bits.rs2 == 3) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fcvt.lu.d  %s,%s",
-                RN[u.bits.rd], RF[u.bits.rs1]);
-        }
-        break;
-    case 0x69:
-        if (u.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fcvt.d.w  %s,%s",
-                RF[u.bits.rd], RN[u.bits.rs1]);
-        } else if (u.bits.rs2 == 1) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fcvt.d.wu %s,%s",
-                RF[u.bits.rd], RN[u.bits.rs1]);
-        } else if (u.bits.rs2 == 2) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fcvt.d.l  %s,%s",
-                RF[u.bits.rd], RN[u.bits.rs1]);
-        } else if (u.bits.rs2 == 3) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fcvt.d.lu %s,%s",
-                RF[u.bits.rd], RN[u.bits.rs1]);
-        }
-        break;
-    case 0x71:
-        if (u.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fmv.x.d %s,%s",
-                RN[u.bits.rd], RF[u.bits.rs1]);
-        }
-        break;
-    case 0x79:
-        if (u.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "fmv.d.x %s,%s",
-                RF[u.bits.rd], RN[u.bits.rs1]);
-        }
-        break;
-    default:;
+    uint64_t imm64 = u.bits.imm31_12 << 12;
+    if (imm64 & (1LL << 31)) {
+        imm64 |= EXT_SIGN_32;
     }
-
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
+    RISCV_sprintf(tstr, sz, "%-7s %s,0x%" RV_PRI64 "x",
+        op, RN[u.bits.rd], imm64);
 }
 
-int opcode_0x18(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
+/** Comparision with zero register is shown as 'beqz', 'bnez' etc. */
+static void fmt_branch(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
     ISA_SB_type sb;
-    uint64_t imm64;
-
+    char opz[16];
     sb.value = code;
-    imm64 = (sb.bits.imm12 << 12) | (sb.bits.imm11 << 11)
+    uint64_t imm64 = (sb.bits.imm12 << 12) | (sb.bits.imm11 << 11)
                 | (sb.bits.imm10_5 << 5) | (sb.bits.imm4_1 << 1);
     if (sb.bits.imm12) {
         imm64 |= EXT_SIGN_12;
     }
     imm64 += pc;
-    switch (sb.bits.funct3) {
-    case 0:
-        if (sb.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "beqz    %s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], imm64);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "beq     %s,%s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], RN[sb.bits.rs2], imm64);
-        }
-        break;
-    case 1:
-        if (sb.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "bnez    %s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], imm64);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "bne     %s,%s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], RN[sb.bits.rs2], imm64);
-        }
-        break;
-    case 4:
-        if (sb.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "bltz    %s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], imm64);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "blt     %s,%s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], RN[sb.bits.rs2], imm64);
-        }
-        break;
-    case 5:
-        if (sb.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "bgez    %s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], imm64);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "bge     %s,%s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], RN[sb.bits.rs2], imm64);
-        }
-        break;
-    case 6:
-        if (sb.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "bltuz   %s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], imm64);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "bltu    %s,%s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], RN[sb.bits.rs2], imm64);
-        }
-        break;
-    case 7:
-        if (sb.bits.rs2 == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "bgeuz   %s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], imm64);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "bgeu    %s,%s,%08" RV_PRI64 "x",
-                RN[sb.bits.rs1], RN[sb.bits.rs2], imm64);
-        }
-        break;
-    default:;
-    }
-
-    /*if (isrc) {
-        AttributeType info;
-        isrc->addressToSymbol(imm64, &info);
-        if (info[0u].size()) {
-            if (info[1].to_uint32() == 0) {
-                RISCV_sprintf(tcomm, sizeof(tcomm), "%s",
-                        info[0u].to_string());
-            } else {
-                RISCV_sprintf(tcomm, sizeof(tcomm), "%s+%xh",
-                        info[0u].to_string(), info[1].to_uint32());
-            }
-        }
-    }*/
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
-}
-
-int opcode_0x19(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
-    ISA_I_type i;
-    uint64_t imm64;
-
-    i.value = code;
-    imm64 = static_cast<int32_t>(code) >> 20;
-    if (imm64 == 0) {
-        if (i.bits.rs1 == ICpuRiscV::Reg_ra) {
-            RISCV_sprintf(tstr, sizeof(tstr), "%s", "ret");
-        } else if (i.bits.rd == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "jr      %s",
-                RN[i.bits.rs1]);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "jalr    %s",
-                RN[i.bits.rs1]);
-        }
+    if (sb.bits.rs2 == 0) {
+        RISCV_sprintf(opz, sizeof(opz), "%sz", op);
+        RISCV_sprintf(tstr, sz, "%-7s %s,%08" RV_PRI64 "x",
+            opz, RN[sb.bits.rs1], imm64);
     } else {
-        RISCV_sprintf(tstr, sizeof(tstr), "jalr    %" RV_PRI64 "d,(%s)",
-            imm64, RN[i.bits.rs1]);
+        RISCV_sprintf(tstr, sz, "%-7s %s,%s,%08" RV_PRI64 "x",
+            op, RN[sb.bits.rs1], RN[sb.bits.rs2], imm64);
     }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
 }
 
-int opcode_0x1B(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
+static void fmt_jal(const char *op, uint64_t pc, uint32_t code,
+                    char *tstr, size_t sz) {
     ISA_UJ_type uj;
-    uint64_t imm64;
-
     uj.value = code;
-    imm64 = 0;
+    uint64_t imm64 = 0;
     if (uj.bits.imm20) {
         imm64 = 0xfffffffffff00000LL;
     }
@@ -964,546 +177,634 @@ int opcode_0x1B(uint64_t pc, uint32_t code,
     imm64 |= (uj.bits.imm11 << 11);
     imm64 |= (uj.bits.imm10_1 << 1);
     if (uj.bits.rd) {
-        RISCV_sprintf(tstr, sizeof(tstr), "jal     ra,%08" RV_PRI64 "x",
-            pc + imm64);
+        RISCV_sprintf(tstr, sz, "%-7s %s,%08" RV_PRI64 "x",
+            op, RN[uj.bits.rd], pc + imm64);
     } else {
-        RISCV_sprintf(tstr, sizeof(tstr), "j       %08" RV_PRI64 "x",
-            pc + imm64);
+        RISCV_sprintf(tstr, sz, "j       %08" RV_PRI64 "x", pc + imm64);
     }
-
-    /*if (isrc) {
-        AttributeType info;
-        isrc->addressToSymbol(pc + imm64, &info);
-        if (info[0u].size()) {
-            if (info[1].to_uint32() == 0) {
-                RISCV_sprintf(tcomm, sizeof(tcomm), "%s",
-                        info[0u].to_string());
-            } else {
-                RISCV_sprintf(tcomm, sizeof(tcomm), "%s+%xh",
-                        info[0u].to_string(), info[1].to_uint32());
-            }
-        }
-    }*/
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
 }
 
-int opcode_0x1C(uint64_t pc, uint32_t code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
+static void fmt_jalr(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
     ISA_I_type i;
-    uint32_t imm;
-
     i.value = code;
-    imm = static_cast<int32_t>(code) >> 20;
-
-    switch (i.bits.funct3) {
-    case 0:
-        if (code == 0x00000073) {
-            RISCV_sprintf(tstr, sizeof(tstr), "%s", "ecall");
-        } else if (code == 0x00100073) {
-            RISCV_sprintf(tstr, sizeof(tstr), "%s", "ebreak");
-        } else if (code == 0x00200073) {
-            RISCV_sprintf(tstr, sizeof(tstr), "%s", "uret");
-        } else if (code == 0x10200073) {
-            RISCV_sprintf(tstr, sizeof(tstr), "%s", "sret");
-        } else if (code == 0x20200073) {
-            RISCV_sprintf(tstr, sizeof(tstr), "%s", "hret");
-        } else if (code == 0x30200073) {
-            RISCV_sprintf(tstr, sizeof(tstr), "%s", "mret");
-        }
-        break;
-    case 1:
-        if (i.bits.rd == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "csrw    0x%x,%s",
-                imm, RN[i.bits.rs1]);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "csrrw   %s,0x%x,%s",
-                RN[i.bits.rd], imm, RN[i.bits.rs1]);
-        }
-        break;
-    case 2:
-        if (i.bits.rs1 == 0) {
-            // Read
-            RISCV_sprintf(tstr, sizeof(tstr), "csrr    %s,0x%x",
-                RN[i.bits.rd], imm);
-        } else if (i.bits.rd == 0) {
-            // Set
-            RISCV_sprintf(tstr, sizeof(tstr), "csrs    0x%x,%s",
-                imm, RN[i.bits.rs1]);
-        } else {
-            // Read and set
-            RISCV_sprintf(tstr, sizeof(tstr), "csrrs   %s,0x%x,%s",
-                RN[i.bits.rd], imm, RN[i.bits.rs1]);
-        }
-        break;
-    case 3:
-        if (i.bits.rd == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "csrc    0x%x,%s",
-                imm, RN[i.bits.rs1]);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "csrrc   %s,0x%x,%s",
-                RN[i.bits.rd], imm, RN[i.bits.rs1]);
-        }
-        break;
-    case 5:
-        if (i.bits.rd == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "csrwi   0x%x,0x%x",
-                imm, i.bits.rs1);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "csrrwi  %s,0x%x,0x%x",
-                RN[i.bits.rd], imm, i.bits.rs1);
-        }
-        break;
-    case 6:
-        if (i.bits.rd == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "csrsi   0x%x,0x%x",
-                imm, i.bits.rs1);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "csrrsi  %s,0x%x,0x%x",
-                RN[i.bits.rd], imm, i.bits.rs1);
-        }
-        break;
-    case 7:
-        if (i.bits.rd == 0) {
-            RISCV_sprintf(tstr, sizeof(tstr), "csrci   0x%x,0x%x",
-                imm, i.bits.rs1);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "csrrci  %s,0x%x,0x%x",
-                RN[i.bits.rd], imm, i.bits.rs1);
-        }
-        break;
-    default:;
+    int32_t imm = static_cast<int32_t>(code) >> 20;
+    if (imm != 0) {
+        RISCV_sprintf(tstr, sz, "%-7s %d,(%s)", op, imm, RN[i.bits.rs1]);
+    } else if (i.bits.rs1 == ICpuRiscV::Reg_ra && i.bits.rd == 0) {
+        RISCV_sprintf(tstr, sz, "%s", "ret");
+    } else if (i.bits.rd == 0) {
+        RISCV_sprintf(tstr, sz, "jr      %s", RN[i.bits.rs1]);
+    } else {
+        RISCV_sprintf(tstr, sz, "%-7s %s", op, RN[i.bits.rs1]);
     }
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 4;
 }
 
-/**
- * C-extension  disassembler
- */
-int C_JR_MV_EBREAK_JALR_ADD(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
-    ISA_CR_type u;
-    u.value = code.word;
-    if (u.bits.funct4 == 0x8) {
-        if (u.bits.rdrs1 && !u.bits.rs2) {
-            if (u.bits.rdrs1 == 1) {
-                RISCV_sprintf(tstr, sizeof(tstr), "%s", "ret");
-            } else {
-                RISCV_sprintf(tstr, sizeof(tstr), "jr      %s",
-                    RN[u.bits.rdrs1]);
-            }
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "mv      %s,%s",
-                RN[u.bits.rdrs1], RN[u.bits.rs2]);
-        }
+/** Without destination register: 'csrw', 'csrs', 'csrc', read: 'csrr' */
+static void fmt_csr(const char *op, uint64_t pc, uint32_t code,
+                    char *tstr, size_t sz) {
+    ISA_I_type i;
+    char alias[16];
+    i.value = code;
+    uint32_t csr = code >> 20;
+    if (i.bits.rd == 0) {
+        RISCV_sprintf(alias, sizeof(alias), "csr%s", &op[4]);
+        RISCV_sprintf(tstr, sz, "%-7s 0x%x,%s", alias, csr, RN[i.bits.rs1]);
+    } else if (i.bits.rs1 == 0 && i.bits.funct3 == 2) {
+        RISCV_sprintf(tstr, sz, "csrr    %s,0x%x", RN[i.bits.rd], csr);
     } else {
-        if (!u.bits.rdrs1 && !u.bits.rs2) {
-            RISCV_sprintf(tstr, sizeof(tstr), "%s", "ebreak");
-        } else if (u.bits.rdrs1 && !u.bits.rs2) {
-            RISCV_sprintf(tstr, sizeof(tstr), "jalr    ra,%s,0",
-                RN[u.bits.rdrs1]);
-        } else {
-            RISCV_sprintf(tstr, sizeof(tstr), "add     %s,%s,%s",
-                RN[u.bits.rdrs1], RN[u.bits.rdrs1], RN[u.bits.rs2]);
-        }
+        RISCV_sprintf(tstr, sz, "%-7s %s,0x%x,%s",
+            op, RN[i.bits.rd], csr, RN[i.bits.rs1]);
     }
-
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
 }
 
-int C_NOP_ADDI(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
-    ISA_CI_type u;
-    u.value = code.word;
-    uint64_t imm = u.bits.imm;
-    if (u.bits.imm6) {
-        imm |= EXT_SIGN_6;
-    }
-    if (u.value == 0x1) {
-        RISCV_sprintf(tstr, sizeof(tstr), "%s", "nop");
+static void fmt_csri(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
+    ISA_I_type i;
+    char alias[16];
+    i.value = code;
+    uint32_t csr = code >> 20;
+    if (i.bits.rd == 0) {
+        RISCV_sprintf(alias, sizeof(alias), "csr%s", &op[4]);
+        RISCV_sprintf(tstr, sz, "%-7s 0x%x,0x%x", alias, csr, i.bits.rs1);
     } else {
-        RISCV_sprintf(tstr, sizeof(tstr), "addi    %s,%s,%" RV_PRI64 "d",
-            RN[u.bits.rdrs], RN[u.bits.rdrs], imm);
+        RISCV_sprintf(tstr, sz, "%-7s %s,0x%x,0x%x",
+            op, RN[i.bits.rd], csr, i.bits.rs1);
     }
-
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
 }
 
-int C_ADDI16SP_LUI(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
-    ISA_CI_type u;
-    u.value = code.word;
-    if (u.spbits.sp == 0x2) {
-        uint64_t imm = (u.spbits.imm8_7 << 3) | (u.spbits.imm6 << 2)
-                    | (u.spbits.imm5 << 1) | u.spbits.imm4;
-        if (u.spbits.imm9) {
-            imm |= EXT_SIGN_6;
-        }
-        imm <<= 4;
-        RISCV_sprintf(tstr, sizeof(tstr), "addi    sp,sp,%" RV_PRI64 "d",
-            imm);
-    } else {
-        uint64_t imm = u.bits.imm;
-        if (u.bits.imm6) {
-            imm |= EXT_SIGN_6;
-        }
-        imm <<= 12;
-        RISCV_sprintf(tstr, sizeof(tstr), "lui     %s,0x%x",
-            RN[u.bits.rdrs], static_cast<uint32_t>(imm));
-
-    }
+static void fmt_sfence(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
+    ISA_R_type r;
+    r.value = code;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s",
+        op, RN[r.bits.rs1], RN[r.bits.rs2]);
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+static void fmt_amo(const char *op, uint64_t pc, uint32_t code,
+                    char *tstr, size_t sz) {
+    const char *aquired[2] = {"", ".aq"};
+    const char *released[2] = {"", ".rl"};
+    ISA_R_type r;
+    char opfull[32];
+    r.value = code;
+    RISCV_sprintf(opfull, sizeof(opfull), "%s%s%s",
+        op, aquired[r.amobits.aq], released[r.amobits.rl]);
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,(%s)",
+        opfull, RN[r.amobits.rd], RN[r.amobits.rs2], RN[r.amobits.rs1]);
 }
 
-int C_ADDI4SPN(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimp";
-    char tcomm[128] = "";
-    ISA_CIW_type u;
-    u.value = code.word;
-    uint64_t imm = (u.bits.imm9_6 << 4) | (u.bits.imm5_4 << 2)
-                | (u.bits.imm3 << 1) | u.bits.imm2;
-    imm <<= 2;
-    if (code.word) {
-        RISCV_sprintf(tstr, sizeof(tstr), "addi    %s,sp,%" RV_PRI64 "d",
-            RN[8 + u.bits.rd], imm);
-    }
+static void fmt_lr(const char *op, uint64_t pc, uint32_t code,
+                   char *tstr, size_t sz) {
+    const char *aquired[2] = {"", ".aq"};
+    const char *released[2] = {"", ".rl"};
+    ISA_R_type r;
+    char opfull[32];
+    r.value = code;
+    RISCV_sprintf(opfull, sizeof(opfull), "%s%s%s",
+        op, aquired[r.amobits.aq], released[r.amobits.rl]);
+    RISCV_sprintf(tstr, sz, "%-7s %s,(%s)",
+        opfull, RN[r.amobits.rd], RN[r.amobits.rs1]);
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+static void fmt_fr(const char *op, uint64_t pc, uint32_t code,
+                   char *tstr, size_t sz) {
+    ISA_R_type r;
+    r.value = code;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%s",
+        op, RF[r.bits.rd], RF[r.bits.rs1], RF[r.bits.rs2]);
 }
 
-int C_JAL_ADDIW(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
-    ISA_CI_type u;
-    u.value = code.word;
-    int64_t imm = u.bits.imm;
-    if (u.bits.imm6) {
-        imm |= EXT_SIGN_6;
-    }
-    // JAL is th RV32C only instruction
-    RISCV_sprintf(tstr, sizeof(tstr), "addiw   %s,%s,%" RV_PRI64 "d",
-        RN[u.bits.rdrs], RN[u.bits.rdrs], imm);
+static void fmt_fr1(const char *op, uint64_t pc, uint32_t code,
+                    char *tstr, size_t sz) {
+    ISA_R_type r;
+    r.value = code;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s", op, RF[r.bits.rd], RF[r.bits.rs1]);
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+static void fmt_fcmp(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
+    ISA_R_type r;
+    r.value = code;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%s",
+        op, RN[r.bits.rd], RF[r.bits.rs1], RF[r.bits.rs2]);
 }
 
-int C_LD(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
-    ISA_CL_type u;
-    u.value = code.word;
-    uint32_t off = (u.bits.imm27 << 4) | (u.bits.imm6 << 3) | u.bits.imm5_3;
-    off <<= 3;
+/** Floating point source, integer destination */
+static void fmt_f2x(const char *op, uint64_t pc, uint32_t code,
+                    char *tstr, size_t sz) {
+    ISA_R_type r;
+    r.value = code;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s", op, RN[r.bits.rd], RF[r.bits.rs1]);
+}
 
-    RISCV_sprintf(tstr, sizeof(tstr), "ld      %s,%d(%s)",
-        RN[8 + u.bits.rd], off, RN[8 + u.bits.rs1]);
+/** Integer source, floating point destination */
+static void fmt_x2f(const char *op, uint64_t pc, uint32_t code,
+                    char *tstr, size_t sz) {
+    ISA_R_type r;
+    r.value = code;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s", op, RF[r.bits.rd], RN[r.bits.rs1]);
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+/**
+ * C-extension: shown as the equivalent uncompressed instructions
+ */
+static void fmt_c_add(const char *op, uint64_t pc, uint32_t code,
+                      char *tstr, size_t sz) {
+    ISA_CR_type u;
+    u.value = static_cast<uint16_t>(code);
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%s",
+        op, RN[u.bits.rdrs1], RN[u.bits.rdrs1], RN[u.bits.rs2]);
 }
 
-int C_LDSP(uint64_t pc, Reg16Type code,
-           AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
-    ISA_CI_type u;
-    u.value = code.word;
-    uint32_t off = (u.ldspbits.off8_6 << 3) | (u.ldspbits.off5 << 2)
-                    | u.ldspbits.off4_3;
-    off <<= 3;
+static void fmt_c_mv(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
+    ISA_CR_type u;
+    u.value = static_cast<uint16_t>(code);
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s",
+        op, RN[u.bits.rdrs1], RN[u.bits.rs2]);
+}
 
-    RISCV_sprintf(tstr, sizeof(tstr), "ld      %s,%d(sp)",
-        RN[u.ldspbits.rd], off);
+static void fmt_c_jr(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
+    ISA_CR_type u;
+    u.value = static_cast<uint16_t>(code);
+    if (u.bits.rdrs1 == ICpuRiscV::Reg_ra) {
+        RISCV_sprintf(tstr, sz, "%s", "ret");
+    } else {
+        RISCV_sprintf(tstr, sz, "%-7s %s", op, RN[u.bits.rdrs1]);
+    }
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+static void fmt_c_jalr(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
+    ISA_CR_type u;
+    u.value = static_cast<uint16_t>(code);
+    RISCV_sprintf(tstr, sz, "%-7s ra,%s,0", op, RN[u.bits.rdrs1]);
 }
 
-int C_LI(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
+static int64_t imm_ci(uint32_t code) {
     ISA_CI_type u;
-    u.value = code.word;
+    u.value = static_cast<uint16_t>(code);
     int64_t imm = u.bits.imm;
     if (u.bits.imm6) {
         imm |= EXT_SIGN_6;
     }
-
-    RISCV_sprintf(tstr, sizeof(tstr), "li      %s,%" RV_PRI64 "d",
-        RN[u.bits.rdrs], imm);
-
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+    return imm;
 }
 
-int C_LW(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
-    ISA_CL_type u;
-    u.value = code.word;
-    uint32_t off = (u.bits.imm6 << 4) | (u.bits.imm5_3 << 1) | u.bits.imm27;
-    off <<= 2;
-
-    RISCV_sprintf(tstr, sizeof(tstr), "lw      %s,%d(%s)",
-        RN[8 + u.bits.rd], off, RN[8 + u.bits.rs1]);
+/** 'addi', 'addiw' and 'slli' with the same source and destination */
+static void fmt_c_addi(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
+    ISA_CI_type u;
+    u.value = static_cast<uint16_t>(code);
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%" RV_PRI64 "d",
+        op, RN[u.bits.rdrs], RN[u.bits.rdrs], imm_ci(code));
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+static void fmt_c_slli(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
+    ISA_CI_type u;
+    u.value = static_cast<uint16_t>(code);
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%d",
+        op, RN[u.bits.rdrs], RN[u.bits.rdrs], (u.bits.imm6 << 5) | u.bits.imm);
 }
 
-int C_LWSP(uint64_t pc, Reg16Type code,
-           AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
+static void fmt_c_li(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
     ISA_CI_type u;
-    u.value = code.word;
-    uint32_t off = (u.lwspbits.off7_6 << 4) | (u.lwspbits.off5 << 3)
-                     | u.lwspbits.off4_2;
-    off <<= 2;
+    u.value = static_cast<uint16_t>(code);
+    RISCV_sprintf(tstr, sz, "%-7s %s,%" RV_PRI64 "d",
+        op, RN[u.bits.rdrs], imm_ci(code));
+}
 
-    RISCV_sprintf(tstr, sizeof(tstr), "lw      %s,%d(sp)",
-        RN[u.lwspbits.rd], off);
+static void fmt_c_lui(const char *op, uint64_t pc, uint32_t code,
+                      char *tstr, size_t sz) {
+    ISA_CI_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint64_t imm = static_cast<uint64_t>(imm_ci(code)) << 12;
+    RISCV_sprintf(tstr, sz, "%-7s %s,0x%x",
+        op, RN[u.bits.rdrs], static_cast<uint32_t>(imm));
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+static void fmt_c_addi16sp(const char *op, uint64_t pc, uint32_t code,
+                           char *tstr, size_t sz) {
+    ISA_CI_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint64_t imm = (u.spbits.imm8_7 << 3) | (u.spbits.imm6 << 2)
+                | (u.spbits.imm5 << 1) | u.spbits.imm4;
+    if (u.spbits.imm9) {
+        imm |= EXT_SIGN_6;
+    }
+    imm <<= 4;
+    RISCV_sprintf(tstr, sz, "%-7s sp,sp,%" RV_PRI64 "d", op, imm);
 }
 
-int C_MATH(uint64_t pc, Reg16Type code,
-           AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128] = "unimpl";
-    char tcomm[128] = "";
-    ISA_CB_type u;
-    u.value = code.word;
-    uint32_t shamt = (u.shbits.shamt5 << 5) | u.shbits.shamt;
-    uint32_t imm = (u.bits.off7_6 << 3) | (u.bits.off2_1 << 1)  | u.bits.off5;
-
-    if (u.bits.off4_3 == 0) {
-        RISCV_sprintf(tstr, sizeof(tstr), "srli    %s,%s,%d",
-            RN[8 + u.shbits.rd], RN[8 + u.shbits.rd], shamt);
-    } else if (u.bits.off4_3 == 1) {
-        RISCV_sprintf(tstr, sizeof(tstr), "srai    %s,%s,%d",
-            RN[8 + u.shbits.rd], RN[8 + u.shbits.rd], shamt);
-    } else if (u.bits.off4_3 == 2) {
-        RISCV_sprintf(tstr, sizeof(tstr), "andi    %s,%s,%d",
-            RN[8 + u.shbits.rd], RN[8 + u.shbits.rd], imm);
-    } else if (u.bits.off8 == 0) {
-        ISA_CS_type u2;
-        u2.value = code.word;
-        switch (u.bits.off7_6) {
-        case 0:
-            RISCV_sprintf(tstr, sizeof(tstr), "sub     %s,%s,%s",
-                RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs2]);
-            break;
-        case 1:
-            RISCV_sprintf(tstr, sizeof(tstr), "xor     %s,%s,%s",
-                RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs2]);
-            break;
-        case 2:
-            RISCV_sprintf(tstr, sizeof(tstr), "or      %s,%s,%s",
-                RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs2]);
-            break;
-        default:
-            RISCV_sprintf(tstr, sizeof(tstr), "and     %s,%s,%s",
-                RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs2]);
-        }
+static void fmt_c_addi4spn(const char *op, uint64_t pc, uint32_t code,
+                           char *tstr, size_t sz) {
+    ISA_CIW_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint64_t imm = (u.bits.imm9_6 << 4) | (u.bits.imm5_4 << 2)
+                | (u.bits.imm3 << 1) | u.bits.imm2;
+    imm <<= 2;
+    if (code) {
+        RISCV_sprintf(tstr, sz, "%-7s %s,sp,%" RV_PRI64 "d",
+            op, RN[8 + u.bits.rd], imm);
     } else {
-        ISA_CS_type u2;
-        u2.value = code.word;
-        switch (u.bits.off7_6) {
-        case 0:
-            RISCV_sprintf(tstr, sizeof(tstr), "subw    %s,%s,%s",
-                RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs2]);
-            break;
-        case 1:
-            RISCV_sprintf(tstr, sizeof(tstr), "addw    %s,%s,%s",
-                RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs1], RN[8 + u2.bits.rs2]);
-            break;
-        default:;
-        }
+        RISCV_sprintf(tstr, sz, "%s", "unimp");
     }
-
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
 }
 
-int C_J(uint64_t pc, Reg16Type code,
-        AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
-    ISA_CJ_type u;
-    u.value = code.word;
-    uint64_t off = (u.bits.off10 << 9) | (u.bits.off9_8 << 7)
-                    | (u.bits.off7 << 6) | (u.bits.off6 << 5)
-                    | (u.bits.off5 << 4) | (u.bits.off4 << 3)
-                    | u.bits.off3_1;
-    off <<= 1;
-    if (u.bits.off11) {
-        off |= EXT_SIGN_11;
-    }
-    RISCV_sprintf(tstr, sizeof(tstr), "j       %" RV_PRI64 "x", pc + off);
+/** 'srli', 'srai' and 'andi' with the compact register */
+static void fmt_c_shift(const char *op, uint64_t pc, uint32_t code,
+                        char *tstr, size_t sz) {
+    ISA_CB_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint32_t shamt = (u.shbits.shamt5 << 5) | u.shbits.shamt;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%d",
+        op, RN[8 + u.shbits.rd], RN[8 + u.shbits.rd], shamt);
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+static void fmt_c_andi(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
+    ISA_CB_type u;
+    u.value = static_cast<uint16_t>(code);
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%" RV_PRI64 "d",
+        op, RN[8 + u.shbits.rd], RN[8 + u.shbits.rd], imm_ci(code));
 }
 
-int C_SD(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
+static void fmt_c_arith(const char *op, uint64_t pc, uint32_t code,
+                        char *tstr, size_t sz) {
     ISA_CS_type u;
-    u.value = code.word;
-    uint32_t off = (u.bits.imm27 << 4) | (u.bits.imm6 << 3) | u.bits.imm5_3;
-    off <<= 3;
-
-    RISCV_sprintf(tstr, sizeof(tstr), "sd      %s,%d(%s)",
-        RN[8 + u.bits.rs2], off, RN[8 + u.bits.rs1]);
+    u.value = static_cast<uint16_t>(code);
+    RISCV_sprintf(tstr, sz, "%-7s %s,%s,%s",
+        op, RN[8 + u.bits.rs1], RN[8 + u.bits.rs1], RN[8 + u.bits.rs2]);
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+static void fmt_c_lw(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
+    ISA_CL_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint32_t off = (u.bits.imm6 << 4) | (u.bits.imm5_3 << 1) | u.bits.imm27;
+    off <<= 2;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(%s)",
+        op, RN[8 + u.bits.rd], off, RN[8 + u.bits.rs1]);
 }
 
-int C_SDSP(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
-    ISA_CSS_type u;
-    u.value = code.word;
-    uint32_t off = (u.dbits.imm8_6 << 3) | u.dbits.imm5_3;
+static void fmt_c_ld(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
+    ISA_CL_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint32_t off = (u.bits.imm27 << 4) | (u.bits.imm6 << 3) | u.bits.imm5_3;
     off <<= 3;
-
-    RISCV_sprintf(tstr, sizeof(tstr), "sd      %s,%d(sp)",
-        RN[u.dbits.rs2], off);
-
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(%s)",
+        op, RN[8 + u.bits.rd], off, RN[8 + u.bits.rs1]);
 }
 
-int C_SW(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
+static void fmt_c_sw(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
     ISA_CS_type u;
-    u.value = code.word;
+    u.value = static_cast<uint16_t>(code);
     uint32_t off = (u.bits.imm6 << 4) | (u.bits.imm5_3 << 1) | u.bits.imm27;
     off <<= 2;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(%s)",
+        op, RN[8 + u.bits.rs2], off, RN[8 + u.bits.rs1]);
+}
 
-    RISCV_sprintf(tstr, sizeof(tstr), "sw      %s,%d(%s)",
-        RN[8 + u.bits.rs2], off, RN[8 + u.bits.rs1]);
+static void fmt_c_sd(const char *op, uint64_t pc, uint32_t code,
+                     char *tstr, size_t sz) {
+    ISA_CS_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint32_t off = (u.bits.imm27 << 4) | (u.bits.imm6 << 3) | u.bits.imm5_3;
+    off <<= 3;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(%s)",
+        op, RN[8 + u.bits.rs2], off, RN[8 + u.bits.rs1]);
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+static void fmt_c_lwsp(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
+    ISA_CI_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint32_t off = (u.lwspbits.off7_6 << 4) | (u.lwspbits.off5 << 3)
+                     | u.lwspbits.off4_2;
+    off <<= 2;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(sp)", op, RN[u.lwspbits.rd], off);
 }
 
-int C_SWSP(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
+static void fmt_c_ldsp(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
+    ISA_CI_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint32_t off = (u.ldspbits.off8_6 << 3) | (u.ldspbits.off5 << 2)
+                    | u.ldspbits.off4_3;
+    off <<= 3;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(sp)", op, RN[u.ldspbits.rd], off);
+}
+
+static void fmt_c_swsp(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
     ISA_CSS_type u;
-    u.value = code.word;
+    u.value = static_cast<uint16_t>(code);
     uint32_t off = (u.wbits.imm7_6 << 4) | u.wbits.imm5_2;
     off <<= 2;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(sp)", op, RN[u.wbits.rs2], off);
+}
 
-    RISCV_sprintf(tstr, sizeof(tstr), "sw      %s,%d(sp)",
-        RN[u.dbits.rs2], off);
+static void fmt_c_sdsp(const char *op, uint64_t pc, uint32_t code,
+                       char *tstr, size_t sz) {
+    ISA_CSS_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint32_t off = (u.dbits.imm8_6 << 3) | u.dbits.imm5_3;
+    off <<= 3;
+    RISCV_sprintf(tstr, sz, "%-7s %s,%d(sp)", op, RN[u.dbits.rs2], off);
+}
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+static void fmt_c_j(const char *op, uint64_t pc, uint32_t code,
+                    char *tstr, size_t sz) {
+    ISA_CJ_type u;
+    u.value = static_cast<uint16_t>(code);
+    uint64_t off = (u.bits.off10 << 9) | (u.bits.off9_8 << 7)
+                    | (u.bits.off7 << 6) | (u.bits.off6 << 5)
+                    | (u.bits.off5 << 4) | (u.bits.off4 << 3)
+                    | u.bits.off3_1;
+    off <<= 1;
+    if (u.bits.off11) {
+        off |= EXT_SIGN_11;
+    }
+    RISCV_sprintf(tstr, sz, "%-7s %08" RV_PRI64 "x", op, pc + off);
 }
 
-int C_BEQZ(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
+static void fmt_c_branch(const char *op, uint64_t pc, uint32_t code,
+                         char *tstr, size_t sz) {
     ISA_CB_type u;
-    u.value = code.word;
+    u.value = static_cast<uint16_t>(code);
     uint64_t imm = (u.bits.off7_6 << 5) | (u.bits.off5 << 4)
             | (u.bits.off4_3 << 2) | u.bits.off2_1;
     imm <<= 1;
     if (u.bits.off8) {
         imm |= EXT_SIGN_9;
     }
+    RISCV_sprintf(tstr, sz, "%-7s %s,%08" RV_PRI64 "x",
+        op, RN[8 + u.bits.rs1], pc + imm);
+}
 
-    RISCV_sprintf(tstr, sizeof(tstr), "beqz    %s,%" RV_PRI64 "x",
-        RN[8 + u.bits.rs1], pc + imm);
+/**
+ * Formatter per RISCV_ENCODINGS name. Mnemonic is the lower case name with
+ * '.' instead of '_' if not specified.
+ */
+struct DisasmFormatType {
+    const char *name;
+    const char *mnemonic;
+    disasm_format_f fmt;
+};
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
-}
+static const DisasmFormatType DISASM_FORMATS[] = {
+    {"ADD", 0, &fmt_r},
+    {"ADDI", 0, &fmt_addi},
+    {"ADDIW", 0, &fmt_i},
+    {"ADDW", 0, &fmt_r},
+    {"AND", 0, &fmt_r},
+    {"ANDI", 0, &fmt_i},
+    {"AUIPC", 0, &fmt_auipc},
+    {"BEQ", 0, &fmt_branch},
+    {"BGE", 0, &fmt_branch},
+    {"BGEU", 0, &fmt_branch},
+    {"BLT", 0, &fmt_branch},
+    {"BLTU", 0, &fmt_branch},
+    {"BNE", 0, &fmt_branch},
+    {"JAL", 0, &fmt_jal},
+    {"JALR", 0, &fmt_jalr},
+    {"LD", 0, &fmt_load},
+    {"LW", 0, &fmt_load},
+    {"LWU", 0, &fmt_load},
+    {"LH", 0, &fmt_load},
+    {"LHU", 0, &fmt_load},
+    {"LB", 0, &fmt_load},
+    {"LBU", 0, &fmt_load},
+    {"LUI", 0, &fmt_lui},
+    {"OR", 0, &fmt_r},
+    {"ORI", 0, &fmt_i},
+    {"SLL", 0, &fmt_r},
+    {"SLLI", 0, &fmt_shift},
+    {"SLLIW", 0, &fmt_shift},
+    {"SLLW", 0, &fmt_r},
+    {"SLT", 0, &fmt_r},
+    {"SLTI", 0, &fmt_i},
+    {"SLTU", 0, &fmt_r},
+    {"SLTIU", 0, &fmt_i},
+    {"SRA", 0, &fmt_r},
+    {"SRAI", 0, &fmt_shift},
+    {"SRAIW", 0, &fmt_shift},
+    {"SRAW", 0, &fmt_r},
+    {"SRL", 0, &fmt_r},
+    {"SRLI", 0, &fmt_shift},
+    {"SRLIW", 0, &fmt_shift},
+    {"SRLW", 0, &fmt_r},
+    {"SUB", 0, &fmt_r},
+    {"SUBW", 0, &fmt_r},
+    {"SD", 0, &fmt_store},
+    {"SW", 0, &fmt_store},
+    {"SH", 0, &fmt_store},
+    {"SB", 0, &fmt_store},
+    {"XOR", 0, &fmt_r},
+    {"XORI", 0, &fmt_i},
+
+    {"CSRRC", 0, &fmt_csr},
+    {"CSRRCI", 0, &fmt_csri},
+    {"CSRRS", 0, &fmt_csr},
+    {"CSRRSI", 0, &fmt_csri},
+    {"CSRRW", 0, &fmt_csr},
+    {"CSRRWI", 0, &fmt_csri},
+    {"URET", 0, &fmt_none},
+    {"SRET", 0, &fmt_none},
+    {"HRET", 0, &fmt_none},
+    {"MRET", 0, &fmt_none},
+    {"FENCE", 0, &fmt_none},
+    {"FENCE_I", 0, &fmt_none},
+    {"SFENCE_VMA", 0, &fmt_sfence},
+    {"ECALL", 0, &fmt_none},
+    {"EBREAK", 0, &fmt_none},
+
+    {"DIV", 0, &fmt_r},
+    {"DIVU", 0, &fmt_r},
+    {"DIVUW", 0, &fmt_r},
+    {"DIVW", 0, &fmt_r},
+    {"MUL", 0, &fmt_r},
+    {"MULH", 0, &fmt_r},
+    {"MULHSU", 0, &fmt_r},
+    {"MULHU", 0, &fmt_r},
+    {"MULW", 0, &fmt_r},
+    {"REM", 0, &fmt_r},
+    {"REMU", 0, &fmt_r},
+    {"REMW", 0, &fmt_r},
+    {"REMUW", 0, &fmt_r},
+
+    {"AMOADD_W", 0, &fmt_amo},
+    {"AMOXOR_W", 0, &fmt_amo},
+    {"AMOOR_W", 0, &fmt_amo},
+    {"AMOAND_W", 0, &fmt_amo},
+    {"AMOMIN_W", 0, &fmt_amo},
+    {"AMOMAX_W", 0, &fmt_amo},
+    {"AMOMINU_W", 0, &fmt_amo},
+    {"AMOMAXU_W", 0, &fmt_amo},
+    {"AMOSWAP_W", 0, &fmt_amo},
+    {"LR_W", 0, &fmt_lr},
+    {"SC_W", 0, &fmt_amo},
+    {"AMOADD_D", 0, &fmt_amo},
+    {"AMOXOR_D", 0, &fmt_amo},
+    {"AMOOR_D", 0, &fmt_amo},
+    {"AMOAND_D", 0, &fmt_amo},
+    {"AMOMIN_D", 0, &fmt_amo},
+    {"AMOMAX_D", 0, &fmt_amo},
+    {"AMOMINU_D", 0, &fmt_amo},
+    {"AMOMAXU_D", 0, &fmt_amo},
+    {"AMOSWAP_D", 0, &fmt_amo},
+    {"LR_D", 0, &fmt_lr},
+    {"SC_D", 0, &fmt_amo},
+
+    {"C_ADD", "add", &fmt_c_add},
+    {"C_ADDI", "addi", &fmt_c_addi},
+    {"C_ADDI16SP", "addi", &fmt_c_addi16sp},
+    {"C_ADDI4SPN", "addi", &fmt_c_addi4spn},
+    {"C_ADDIW", "addiw", &fmt_c_addi},
+    {"C_ADDW", "addw", &fmt_c_arith},
+    {"C_AND", "and", &fmt_c_arith},
+    {"C_ANDI", "andi", &fmt_c_andi},
+    {"C_BEQZ", "beqz", &fmt_c_branch},
+    {"C_BNEZ", "bnez", &fmt_c_branch},
+    {"C_EBREAK", "ebreak", &fmt_none},
+    {"C_J", "j", &fmt_c_j},
+    {"C_JAL", "jal", &fmt_c_j},
+    {"C_JALR", "jalr", &fmt_c_jalr},
+    {"C_JR", "jr", &fmt_c_jr},
+    {"C_LD", "ld", &fmt_c_ld},
+    {"C_LDSP", "ld", &fmt_c_ldsp},
+    {"C_LWSP", "lw", &fmt_c_lwsp},
+    {"C_LI", "li", &fmt_c_li},
+    {"C_LUI", "lui", &fmt_c_lui},
+    {"C_LW", "lw", &fmt_c_lw},
+    {"C_MV", "mv", &fmt_c_mv},
+    {"C_NOP", "nop", &fmt_none},
+    {"C_OR", "or", &fmt_c_arith},
+    {"C_SD", "sd", &fmt_c_sd},
+    {"C_SDSP", "sd", &fmt_c_sdsp},
+    {"C_SLLI", "slli", &fmt_c_slli},
+    {"C_SRAI", "srai", &fmt_c_shift},
+    {"C_SRLI", "srli", &fmt_c_shift},
+    {"C_SUB", "sub", &fmt_c_arith},
+    {"C_SUBW", "subw", &fmt_c_arith},
+    {"C_SW", "sw", &fmt_c_sw},
+    {"C_SWSP", "sw", &fmt_c_swsp},
+    {"C_XOR", "xor", &fmt_c_arith},
+
+    {"FADD_D", 0, &fmt_fr},
+    {"FCVT_D_L", 0, &fmt_x2f},
+    {"FCVT_D_LU", 0, &fmt_x2f},
+    {"FCVT_D_W", 0, &fmt_x2f},
+    {"FCVT_D_WU", 0, &fmt_x2f},
+    {"FCVT_L_D", 0, &fmt_f2x},
+    {"FCVT_LU_D", 0, &fmt_f2x},
+    {"FCVT_W_D", 0, &fmt_f2x},
+    {"FCVT_WU_D", 0, &fmt_f2x},
+    {"FDIV_D", 0, &fmt_fr},
+    {"FEQ_D", 0, &fmt_fcmp},
+    {"FLD", 0, &fmt_fload},
+    {"FLE_D", 0, &fmt_fcmp},
+    {"FLT_D", 0, &fmt_fcmp},
+    {"FMAX_D", 0, &fmt_fr},
+    {"FMIN_D", 0, &fmt_fr},
+    {"FMOV_D_X", "fmv.d.x", &fmt_x2f},
+    {"FMOV_X_D", "fmv.x.d", &fmt_f2x},
+    {"FMUL_D", 0, &fmt_fr},
+    {"FSD", 0, &fmt_fstore},
+    {"FSUB_D", 0, &fmt_fr},
+    {"FSQRT_D", 0, &fmt_fr1},
+};
 
-int C_BNEZ(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
-    char tstr[128];
-    char tcomm[128] = "";
-    ISA_CB_type u;
-    u.value = code.word;
-    uint64_t imm = (u.bits.off7_6 << 5) | (u.bits.off5 << 4)
-            | (u.bits.off4_3 << 2) | u.bits.off2_1;
-    imm <<= 1;
-    if (u.bits.off8) {
-        imm |= EXT_SIGN_9;
+/**
+ * Instruction is decoded by the same decision tree as used by the
+ * functional model and its index selects the formatter, so both agree on
+ * what instruction the opcode is.
+ */
+class DisasmTable {
+ public:
+    DisasmTable() {
+        for (int i = 0; i < RISCV_ENCODINGS_MAX; i++) {
+            fmt_[i] = 0;
+            mnemonic_[i][0] = '\0';
+        }
+        for (int i = 0; i < RISCV_ENCODINGS_TOTAL; i++) {
+            setMnemonic(i, 0);
+        }
+        int total = static_cast<int>(sizeof(DISASM_FORMATS)
+                                   / sizeof(DisasmFormatType));
+        for (int i = 0; i < total; i++) {
+            int idx = decoder_.findIndex(DISASM_FORMATS[i].name);
+            if (idx < 0) {
+                continue;
+            }
+            fmt_[idx] = DISASM_FORMATS[i].fmt;
+            setMnemonic(idx, DISASM_FORMATS[i].mnemonic);
+        }
     }
 
-    RISCV_sprintf(tstr, sizeof(tstr), "bnez    %s,%" RV_PRI64 "x",
-        RN[8 + u.bits.rs1], pc + imm);
+    int decode(uint32_t code) const { return decoder_.decode(code); }
+    disasm_format_f getFormat(int idx) const { return fmt_[idx]; }
+    const char *getMnemonic(int idx) const { return mnemonic_[idx]; }
 
-    mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
-}
+ private:
+    void setMnemonic(int idx, const char *mnemonic) {
+        char *dst = mnemonic_[idx];
+        int i = 0;
+        if (mnemonic) {
+            RISCV_sprintf(dst, sizeof(mnemonic_[idx]), "%s", mnemonic);
+            return;
+        }
+        const char *name = RISCV_ENCODINGS[idx].name;
+        for (; name[i] && i < static_cast<int>(sizeof(mnemonic_[idx])) - 1;
+            i++) {
+            dst[i] = name[i] == '_' ? '.'
+                   : static_cast<char>(tolower(name[i]));
+        }
+        dst[i] = '\0';
+    }
+
+    RiscvDecoder decoder_;
+    disasm_format_f fmt_[RISCV_ENCODINGS_MAX];
+    char mnemonic_[RISCV_ENCODINGS_MAX][16];
+};
+
+static const DisasmTable disasm_;
 
-int C_SLLI(uint64_t pc, Reg16Type code,
-                AttributeType *mnemonic, AttributeType *comment) {
+int disasm_riscv(uint64_t pc,
+                uint8_t *data,
+                int offset,
+                AttributeType *mnemonic,
+                AttributeType *comment) {
     char tstr[128];
-    char tcomm[128] = "";
-    ISA_CB_type u;
-    u.value = code.word;
-    uint32_t shamt = (u.shbits.shamt5 << 5) | u.shbits.shamt;
-    uint32_t idx = (u.shbits.funct2 << 3) | u.shbits.rd;
-    RISCV_sprintf(tstr, sizeof(tstr), "slli    %s,%s,%d",
-        RN[idx], RN[idx], shamt);
+    uint32_t code;
+    int oplen;
+    if ((data[offset] & 0x3) < 3) {
+        code = *reinterpret_cast<uint16_t*>(&data[offset]);
+        oplen = 2;
+    } else {
+        code = *reinterpret_cast<uint32_t*>(&data[offset]);
+        oplen = 4;
+    }
 
+    int idx = disasm_.decode(code);
+    if (idx < 0) {
+        RISCV_sprintf(tstr, sizeof(tstr), "%s", "unimpl");
+    } else if (disasm_.getFormat(idx)) {
+        disasm_.getFormat(idx)(disasm_.getMnemonic(idx),
+                               pc + static_cast<uint64_t>(offset),
+                               code, tstr, sizeof(tstr));
+    } else {
+        RISCV_sprintf(tstr, sizeof(tstr), "%s", disasm_.getMnemonic(idx));
+    }
     mnemonic->make_string(tstr);
-    comment->make_string(tcomm);
-    return 2;
+    comment->make_string("");
+    return oplen;
 }
 
 }  // namespace debugger
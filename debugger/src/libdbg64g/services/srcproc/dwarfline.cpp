@@ -0,0 +1,494 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include "dwarfline.h"
+
+namespace debugger {
+
+/** Standard opcodes of the line number program */
+enum EDwarfLineOpcode {
+    DW_LNS_copy = 1,
+    DW_LNS_advance_pc = 2,
+    DW_LNS_advance_line = 3,
+    DW_LNS_set_file = 4,
+    DW_LNS_set_column = 5,
+    DW_LNS_negate_stmt = 6,
+    DW_LNS_set_basic_block = 7,
+    DW_LNS_const_add_pc = 8,
+    DW_LNS_fixed_advance_pc = 9,
+    DW_LNS_set_prologue_end = 10,
+    DW_LNS_set_epilogue_begin = 11,
+    DW_LNS_set_isa = 12
+};
+
+enum EDwarfLineExtOpcode {
+    DW_LNE_end_sequence = 1,
+    DW_LNE_set_address = 2,
+    DW_LNE_define_file = 3,
+    DW_LNE_set_discriminator = 4
+};
+
+/** Entry formats of DWARF5 directory and file tables */
+enum EDwarfForm {
+    DW_FORM_data2 = 0x05,
+    DW_FORM_data4 = 0x06,
+    DW_FORM_data8 = 0x07,
+    DW_FORM_string = 0x08,
+    DW_FORM_block = 0x09,
+    DW_FORM_data1 = 0x0b,
+    DW_FORM_strp = 0x0e,
+    DW_FORM_udata = 0x0f,
+    DW_FORM_data16 = 0x1e,
+    DW_FORM_line_strp = 0x1f
+};
+
+enum EDwarfLineContent {
+    DW_LNCT_path = 1,
+    DW_LNCT_directory_index = 2
+};
+
+struct DwarfLineTable::UnitType {
+    const uint8_t *p;           // read pointer
+    const uint8_t *end;         // end of the unit
+    bool error;
+    bool dwarf64;
+    int version;
+    uint8_t min_inst_len;
+    int8_t line_base;
+    uint8_t line_range;
+    uint8_t opcode_base;
+    uint8_t std_len[256];
+    std::vector<std::string> dirs;
+    std::vector<uint32_t> files;    // unit file index to files_ index
+
+    uint64_t u(int sz) {
+        uint64_t ret = 0;
+        if (p + sz > end) {
+            error = true;
+            p = end;
+            return 0;
+        }
+        for (int i = 0; i < sz; i++) {
+            ret |= static_cast<uint64_t>(p[i]) << (8 * i);
+        }
+        p += sz;
+        return ret;
+    }
+
+    uint64_t uleb() {
+        uint64_t ret = 0;
+        int shift = 0;
+        while (p < end) {
+            uint8_t b = *p++;
+            if (shift < 64) {
+                ret |= static_cast<uint64_t>(b & 0x7f) << shift;
+            }
+            shift += 7;
+            if ((b & 0x80) == 0) {
+                return ret;
+            }
+        }
+        error = true;
+        return ret;
+    }
+
+    int64_t sleb() {
+        int64_t ret = 0;
+        int shift = 0;
+        while (p < end) {
+            uint8_t b = *p++;
+            if (shift < 64) {
+                ret |= static_cast<int64_t>(b & 0x7f) << shift;
+            }
+            shift += 7;
+            if ((b & 0x80) == 0) {
+                if (shift < 64 && (b & 0x40)) {
+                    ret |= -(static_cast<int64_t>(1) << shift);
+                }
+                return ret;
+            }
+        }
+        error = true;
+        return ret;
+    }
+
+    const char *str() {
+        const char *ret = reinterpret_cast<const char *>(p);
+        while (p < end && *p) {
+            p++;
+        }
+        if (p >= end) {
+            error = true;
+            return "";
+        }
+        p++;
+        return ret;
+    }
+};
+
+DwarfLineTable::DwarfLineTable() {
+    RISCV_mutex_init(&mutexParse_);
+    clear();
+}
+
+DwarfLineTable::~DwarfLineTable() {
+    RISCV_mutex_destroy(&mutexParse_);
+}
+
+void DwarfLineTable::clear() {
+    sections_.make_dict();
+    rows_.clear();
+    files_.clear();
+    fileIds_.clear();
+    parsed_ = false;
+}
+
+void DwarfLineTable::setSections(AttributeType *sections) {
+    clear();
+    sections_.clone(sections);
+}
+
+bool DwarfLineTable::rowLess(const RowType &a, const RowType &b) {
+    if (a.addr != b.addr) {
+        return a.addr < b.addr;
+    }
+    // End of the previous sequence before the start of the next one
+    return a.file == FILE_END_SEQUENCE && b.file != FILE_END_SEQUENCE;
+}
+
+void DwarfLineTable::parse() {
+    RISCV_mutex_lock(&mutexParse_);
+    if (!parsed_ && sections_.has_key(".debug_line")) {
+        AttributeType &sec = sections_[".debug_line"];
+        const uint8_t *p = sec.data();
+        const uint8_t *end = p + sec.size();
+        while (p && p < end) {
+            p = parseUnit(p, end);
+        }
+        std::stable_sort(rows_.begin(), rows_.end(), rowLess);
+        RISCV_printf(0, LOG_DEBUG, "Line table: %d rows, %d files",
+                     static_cast<int>(rows_.size()),
+                     static_cast<int>(files_.size()));
+    }
+    parsed_ = true;
+    RISCV_mutex_unlock(&mutexParse_);
+}
+
+const uint8_t *DwarfLineTable::parseUnit(const uint8_t *p,
+                                         const uint8_t *end) {
+    UnitType unit;
+    unit.p = p;
+    unit.end = end;
+    unit.error = false;
+    unit.dwarf64 = false;
+
+    uint64_t unit_len = unit.u(4);
+    if (unit_len == 0xffffffffull) {
+        unit.dwarf64 = true;
+        unit_len = unit.u(8);
+    }
+    if (unit.error || unit_len > static_cast<uint64_t>(end - unit.p)) {
+        return 0;
+    }
+    unit.end = unit.p + unit_len;
+    const uint8_t *next = unit.end;
+
+    unit.version = static_cast<int>(unit.u(2));
+    if (unit.version < 2 || unit.version > 5) {
+        return next;
+    }
+    if (unit.version >= 5) {
+        unit.u(1);      // address_size
+        unit.u(1);      // segment_selector_size
+    }
+    uint64_t hdr_len = unit.u(unit.dwarf64 ? 8 : 4);
+    if (hdr_len > static_cast<uint64_t>(unit.end - unit.p)) {
+        return next;
+    }
+    const uint8_t *prog = unit.p + hdr_len;
+
+    unit.min_inst_len = static_cast<uint8_t>(unit.u(1));
+    if (unit.version >= 4) {
+        unit.u(1);      // maximum_operations_per_instruction
+    }
+    unit.u(1);          // default_is_stmt
+    unit.line_base = static_cast<int8_t>(unit.u(1));
+    unit.line_range = static_cast<uint8_t>(unit.u(1));
+    unit.opcode_base = static_cast<uint8_t>(unit.u(1));
+    memset(unit.std_len, 0, sizeof(unit.std_len));
+    for (int i = 1; i < unit.opcode_base; i++) {
+        unit.std_len[i] = static_cast<uint8_t>(unit.u(1));
+    }
+    if (unit.line_range == 0 || unit.opcode_base == 0) {
+        return next;
+    }
+
+    if (unit.version >= 5) {
+        if (!parseHeaderV5(&unit)) {
+            return next;
+        }
+    } else {
+        // Index 0 is the compilation directory
+        unit.dirs.push_back("");
+        while (unit.p < unit.end && *unit.p) {
+            unit.dirs.push_back(unit.str());
+        }
+        unit.u(1);
+        // File indexes start from 1
+        unit.files.push_back(addFile("", "??"));
+        while (unit.p < unit.end && *unit.p) {
+            const char *name = unit.str();
+            uint64_t dir = unit.uleb();
+            unit.uleb();    // modification time
+            unit.uleb();    // file length
+            if (dir >= unit.dirs.size()) {
+                dir = 0;
+            }
+            unit.files.push_back(addFile(unit.dirs[dir].c_str(), name));
+        }
+    }
+    if (unit.error) {
+        return next;
+    }
+
+    unit.p = prog;
+    runProgram(&unit);
+    return next;
+}
+
+bool DwarfLineTable::parseHeaderV5(UnitType *unit) {
+    uint64_t fmt[2][256][2];
+    for (int tbl = 0; tbl < 2; tbl++) {
+        int fmt_cnt = static_cast<int>(unit->u(1));
+        for (int i = 0; i < fmt_cnt; i++) {
+            fmt[tbl][i][0] = unit->uleb();      // content type
+            fmt[tbl][i][1] = unit->uleb();      // form
+        }
+        uint64_t cnt = unit->uleb();
+        for (uint64_t n = 0; n < cnt && !unit->error; n++) {
+            const char *path = "";
+            uint64_t dir = 0;
+            for (int i = 0; i < fmt_cnt; i++) {
+                const char *str = 0;
+                uint64_t val = 0;
+                if (!readForm(unit, fmt[tbl][i][1], &str, &val)) {
+                    return false;
+                }
+                if (fmt[tbl][i][0] == DW_LNCT_path && str) {
+                    path = str;
+                } else if (fmt[tbl][i][0] == DW_LNCT_directory_index) {
+                    dir = val;
+                }
+            }
+            if (tbl == 0) {
+                unit->dirs.push_back(path);
+            } else {
+                const char *dirname = "";
+                if (dir < unit->dirs.size()) {
+                    dirname = unit->dirs[dir].c_str();
+                }
+                unit->files.push_back(addFile(dirname, path));
+            }
+        }
+    }
+    return !unit->error;
+}
+
+bool DwarfLineTable::readForm(UnitType *unit, uint64_t form,
+                              const char **str, uint64_t *val) {
+    switch (form) {
+    case DW_FORM_string:
+        *str = unit->str();
+        break;
+    case DW_FORM_line_strp:
+        *str = sectionString(".debug_line_str",
+                             unit->u(unit->dwarf64 ? 8 : 4));
+        break;
+    case DW_FORM_strp:
+        *str = sectionString(".debug_str", unit->u(unit->dwarf64 ? 8 : 4));
+        break;
+    case DW_FORM_udata:
+        *val = unit->uleb();
+        break;
+    case DW_FORM_data1:
+        *val = unit->u(1);
+        break;
+    case DW_FORM_data2:
+        *val = unit->u(2);
+        break;
+    case DW_FORM_data4:
+        *val = unit->u(4);
+        break;
+    case DW_FORM_data8:
+        *val = unit->u(8);
+        break;
+    case DW_FORM_data16:
+        unit->u(8);
+        unit->u(8);
+        break;
+    case DW_FORM_block:
+        *val = unit->uleb();
+        if (*val > static_cast<uint64_t>(unit->end - unit->p)) {
+            return false;
+        }
+        unit->p += *val;
+        break;
+    default:
+        // Indexed strings require .debug_str_offsets of the CU
+        return false;
+    }
+    return !unit->error;
+}
+
+const char *DwarfLineTable::sectionString(const char *section,
+                                          uint64_t off) {
+    if (!sections_.has_key(section)) {
+        return "";
+    }
+    AttributeType &sec = sections_[section];
+    if (off >= sec.size()) {
+        return "";
+    }
+    // String must be terminated inside of the section
+    const uint8_t *p = &sec.data()[off];
+    if (!memchr(p, 0, sec.size() - off)) {
+        return "";
+    }
+    return reinterpret_cast<const char *>(p);
+}
+
+uint32_t DwarfLineTable::addFile(const char *dir, const char *name) {
+    std::string path(name);
+    if (dir[0] && name[0] != '/' && !(name[0] && name[1] == ':')) {
+        path = std::string(dir) + "/" + name;
+    }
+    std::map<std::string, uint32_t>::iterator it = fileIds_.find(path);
+    if (it != fileIds_.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(files_.size());
+    files_.push_back(path);
+    fileIds_[path] = id;
+    return id;
+}
+
+void DwarfLineTable::runProgram(UnitType *unit) {
+    RowType row;
+    uint64_t addr = 0;
+    uint64_t file = 1;
+    int64_t line = 1;
+    uint32_t unknown = addFile("", "??");
+
+    while (unit->p < unit->end && !unit->error) {
+        uint8_t op = *unit->p++;
+        bool emit = false;
+        if (op >= unit->opcode_base) {
+            // Special opcode
+            int adj = op - unit->opcode_base;
+            addr += (adj / unit->line_range) * unit->min_inst_len;
+            line += unit->line_base + (adj % unit->line_range);
+            emit = true;
+        } else if (op == 0) {
+            uint64_t len = unit->uleb();
+            if (len == 0 || len > static_cast<uint64_t>(unit->end - unit->p)) {
+                break;
+            }
+            const uint8_t *next = unit->p + len;
+            switch (*unit->p++) {
+            case DW_LNE_end_sequence:
+                row.addr = addr;
+                row.file = FILE_END_SEQUENCE;
+                row.line = 0;
+                rows_.push_back(row);
+                addr = 0;
+                file = 1;
+                line = 1;
+                break;
+            case DW_LNE_set_address:
+                // Operand wider than 8 bytes is skipped with 'next'
+                addr = unit->u(len - 1 > 8 ? 8 : static_cast<int>(len - 1));
+                break;
+            default:;
+            }
+            unit->p = next;
+        } else {
+            switch (op) {
+            case DW_LNS_copy:
+                emit = true;
+                break;
+            case DW_LNS_advance_pc:
+                addr += unit->uleb() * unit->min_inst_len;
+                break;
+            case DW_LNS_advance_line:
+                line += unit->sleb();
+                break;
+            case DW_LNS_set_file:
+                file = unit->uleb();
+                break;
+            case DW_LNS_const_add_pc:
+                addr += ((255 - unit->opcode_base) / unit->line_range)
+                        * unit->min_inst_len;
+                break;
+            case DW_LNS_fixed_advance_pc:
+                addr += unit->u(2);
+                break;
+            default:
+                // Skip operands of the unused opcodes
+                for (int i = 0; i < unit->std_len[op]; i++) {
+                    unit->uleb();
+                }
+            }
+        }
+
+        if (emit) {
+            row.addr = addr;
+            row.file = file < unit->files.size()
+                     ? unit->files[static_cast<size_t>(file)] : unknown;
+            row.line = static_cast<uint32_t>(line);
+            rows_.push_back(row);
+        }
+    }
+}
+
+bool DwarfLineTable::find(uint64_t addr, const char **file, int *line) {
+    if (!parsed_) {
+        parse();
+    }
+    if (rows_.empty() || addr < rows_[0].addr) {
+        return false;
+    }
+    size_t lo = 0;
+    size_t hi = rows_.size();
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (addr < rows_[mid].addr) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    const RowType &row = rows_[lo];
+    if (row.file == FILE_END_SEQUENCE) {
+        return false;
+    }
+    *file = files_[row.file].c_str();
+    *line = static_cast<int>(row.line);
+    return true;
+}
+
+}  // namespace debugger
@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <api_core.h>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace debugger {
+
+/**
+ * @brief Address to source line table from DWARF '.debug_line' section.
+ *
+ * Sections are stored on load and the line number programs of all units
+ * (DWARF versions 2 to 5) are executed on the first request into the flat
+ * array of rows sorted by address.
+ */
+class DwarfLineTable {
+ public:
+    DwarfLineTable();
+    ~DwarfLineTable();
+
+    void clear();
+    /** Dictionary of section name to data: '.debug_line',
+        '.debug_line_str', '.debug_str' */
+    void setSections(AttributeType *sections);
+    bool isEmpty() { return !sections_.has_key(".debug_line"); }
+
+    /** @return false if no line information for address */
+    bool find(uint64_t addr, const char **file, int *line);
+
+ private:
+    struct UnitType;
+
+    void parse();
+    const uint8_t *parseUnit(const uint8_t *p, const uint8_t *end);
+    bool parseHeaderV5(UnitType *unit);
+    bool readForm(UnitType *unit, uint64_t form,
+                  const char **str, uint64_t *val);
+    const char *sectionString(const char *section, uint64_t off);
+    uint32_t addFile(const char *dir, const char *name);
+    void runProgram(UnitType *unit);
+
+    static const uint32_t FILE_END_SEQUENCE = ~0u;
+
+    struct RowType {
+        uint64_t addr;
+        uint32_t file;      // index in files_ or FILE_END_SEQUENCE
+        uint32_t line;
+    };
+    static bool rowLess(const RowType &a, const RowType &b);
+
+    AttributeType sections_;
+    volatile bool parsed_;
+    mutex_def mutexParse_;
+    std::vector<RowType> rows_;
+    std::vector<std::string> files_;
+    std::map<std::string, uint32_t> fileIds_;
+};
+
+}  // namespace debugger
@@ -41,15 +41,18 @@ RiscvSourceService::RiscvSourceService(const char *name) : IService(name),
     registerAttribute("CmdExecutor", &cmdexec_);
 
     pcmdBr_ = new CmdBrRiscv(this);
-
+    pcmdTraceBin_ = new CmdTraceBin(this);
+    pcmdAddr2Line_ = new CmdAddr2Line(this);
 
     brList_.make_list(0);
     symbolListSortByName_.make_list(0);
-    symbolListSortByAddr_.make_list(0);
+    symbolListChanged_ = false;
 }
 
 RiscvSourceService::~RiscvSourceService() {
     delete pcmdBr_;
+    delete pcmdTraceBin_;
+    delete pcmdAddr2Line_;
 }
 
 void RiscvSourceService::postinitService() {
@@ -60,12 +63,16 @@ void RiscvSourceService::postinitService() {
                     cmdexec_.to_string());
     } else {
         icmdexec_->registerCommand(pcmdBr_);
+        icmdexec_->registerCommand(pcmdTraceBin_);
+        icmdexec_->registerCommand(pcmdAddr2Line_);
     }
 }
 
 void RiscvSourceService::predeleteService() {
     if (icmdexec_) {
         icmdexec_->unregisterCommand(pcmdBr_);
+        icmdexec_->unregisterCommand(pcmdTraceBin_);
+        icmdexec_->unregisterCommand(pcmdAddr2Line_);
     }
 }
 
@@ -81,117 +88,106 @@ void RiscvSourceService::hapTriggered(EHapType type,
 
 void RiscvSourceService::addFileSymbol(const char *name, uint64_t addr,
                                        int sz) {
-    AttributeType symb(Attr_List);
-    symb.make_list(Symbol_Total);
-    symb[Symbol_Name].make_string(name);
-    symb[Symbol_Addr].make_uint64(addr);
-    symb[Symbol_Size].make_int64(sz);
-
-    symbolListSortByName_.add_to_list(&symb);
-    symbolListSortByName_.sort(Symbol_Name);
-
-    symbolListSortByAddr_.add_to_list(&symb);
-    symbolListSortByAddr_.sort(Symbol_Addr);
+    symbols_.add(name, addr, sz, SYMBOL_TYPE_FILE);
+    symbolListChanged_ = true;
 }
 
 void RiscvSourceService::addFunctionSymbol(const char *name,
                                       uint64_t addr, int sz) {
-    addFileSymbol(name, addr, sz);
+    symbols_.add(name, addr, sz, SYMBOL_TYPE_FUNCTION);
+    symbolListChanged_ = true;
 }
 
 void RiscvSourceService::addDataSymbol(const char *name, uint64_t addr,
                                        int sz) {
-    addFileSymbol(name, addr, sz);
+    symbols_.add(name, addr, sz, SYMBOL_TYPE_DATA);
+    symbolListChanged_ = true;
 }
 
 void RiscvSourceService::clearSymbols() {
+    symbols_.clear();
+    lines_.clear();
     symbolListSortByName_.make_list(0);
-    symbolListSortByAddr_.make_list(0);
+    symbolListChanged_ = false;
 }
 
 void RiscvSourceService::addSymbols(AttributeType *list) {
     for (unsigned i = 0; i < list->size(); i++) {
         AttributeType &item = (*list)[i];
-        symbolListSortByName_.add_to_list(&item);
-        symbolListSortByAddr_.add_to_list(&item);
+        uint64_t type = 0;
+        if (item.size() > Symbol_Type) {
+            type = item[Symbol_Type].to_uint64();
+        }
+        symbols_.add(item[Symbol_Name].to_string(),
+                     item[Symbol_Addr].to_uint64(),
+                     item[Symbol_Size].to_uint64(),
+                     type);
     }
-    symbolListSortByName_.sort(Symbol_Name);
-    symbolListSortByAddr_.sort(Symbol_Addr);
+    symbolListChanged_ = true;
 }
 
-void RiscvSourceService::addressToSymbol(uint64_t addr, AttributeType *info) {
-    uint64_t sadr, send;
-    int sz = static_cast<int>(symbolListSortByAddr_.size());
+void RiscvSourceService::getSymbols(AttributeType *list) {
+    if (symbolListChanged_) {
+        symbols_.getSortedByName(&symbolListSortByName_);
+        symbolListChanged_ = false;
+    }
+    *list = symbolListSortByName_;
+}
 
+void RiscvSourceService::addressToSymbol(uint64_t addr, AttributeType *info) {
     info->make_list(SymbInfo_Total);
-    (*info)[SymbInfo_Name].make_string("");
-    (*info)[SymbInfo_Address].make_uint64(0);
-    if (sz == 0) {
+    int idx = symbols_.findAddress(addr);
+    if (idx < 0) {
+        (*info)[SymbInfo_Name].make_string("");
+        (*info)[SymbInfo_Address].make_uint64(0);
         return;
     }
-    sadr = symbolListSortByAddr_[0u][Symbol_Addr].to_uint64();
-    if (addr < sadr) {
-        return;
+    (*info)[SymbInfo_Name].make_string(symbols_.getName(idx));
+    (*info)[SymbInfo_Address].make_uint64(addr - symbols_.getAddress(idx));
+}
+
+int RiscvSourceService::symbol2Address(const char *name, uint64_t *addr) {
+    int idx = symbols_.findName(name);
+    if (idx < 0) {
+        return -1;
     }
+    *addr = symbols_.getAddress(idx);
+    return 0;
+}
 
-    bool search = true;
-    int dist, pos = sz / 2;
-    dist = pos;
-    while (search) {
-        AttributeType &symb = symbolListSortByAddr_[pos];
-        sadr = symb[Symbol_Addr].to_uint64();
-        if (pos < static_cast<int>(symbolListSortByAddr_.size()) - 1) {
-            send = symbolListSortByAddr_[pos + 1][Symbol_Addr].to_uint64();
-        } else {
-            send = sadr + symb[Symbol_Size].to_uint64();
-        }
-        if (sadr <= addr && addr < send) {
-            (*info)[SymbInfo_Name] = symb[Symbol_Name];
-            (*info)[SymbInfo_Address].make_uint64(addr - sadr);
-            return;
-        }
-        
-        if (addr < sadr) {
-            if (dist == 0 || pos == 0) {
-                search = false;
-            } else if (dist == 1) {
-                dist = 0;
-                pos--;
+void RiscvSourceService::setDebugLineInfo(AttributeType *sections) {
+    lines_.setSections(sections);
+}
+
+void RiscvSourceService::addressToSource(const uint64_t *addr, unsigned cnt,
+                                         SourceLocationType *loc) {
+    // Sampled addresses are mostly sequential, keep the last symbol range
+    int idx = -1;
+    uint64_t sadr = 1;
+    uint64_t send = 0;
+    for (unsigned i = 0; i < cnt; i++) {
+        if (addr[i] < sadr || addr[i] >= send) {
+            idx = symbols_.findAddress(addr[i]);
+            if (idx >= 0) {
+                sadr = symbols_.getAddress(idx);
+                send = symbols_.getRangeEnd(idx);
             } else {
-                int incr = dist / 2;
-                pos -= incr;
-                dist = (dist / 2) + (dist & 0x1);
-                if (pos < 0) {
-                    pos = 0;
-                }
+                sadr = 1;
+                send = 0;
             }
+        }
+        if (idx >= 0) {
+            loc[i].symbol = symbols_.getName(idx);
+            loc[i].offset = addr[i] - sadr;
         } else {
-            if (dist == 0 || pos == (sz - 1)) {
-                search = false;
-            } else if (dist == 1) {
-                dist = 0;
-                pos++;
-            } else {
-                int incr = dist / 2;
-                pos += incr;
-                dist = (dist / 2) + (dist & 0x1);
-                if (pos >= sz) {
-                    pos = sz - 1;
-                }
-            }
+            loc[i].symbol = "";
+            loc[i].offset = 0;
         }
-    }
-}
-
-int RiscvSourceService::symbol2Address(const char *name, uint64_t *addr) {
-    for (unsigned i = 0; i < symbolListSortByName_.size(); i++) {
-        AttributeType &item = symbolListSortByName_[i];
-        if (item[Symbol_Name].is_equal(name)) {
-            *addr = item[Symbol_Addr].to_uint64();
-            return 0;
+        if (!lines_.find(addr[i], &loc[i].file, &loc[i].line)) {
+            loc[i].file = "";
+            loc[i].line = 0;
         }
     }
-    return -1;
 }
 
 void RiscvSourceService::addBreakpoint(uint64_t addr, uint64_t flags) {
@@ -23,6 +23,10 @@
 #include "coreservices/isrccode.h"
 #include "coreservices/icmdexec.h"
 #include "cmd_br.h"
+#include "cmd_tracebin.h"
+#include "cmd_addr2line.h"
+#include "symbindex.h"
+#include "dwarfline.h"
 
 namespace debugger {
 
@@ -54,14 +58,17 @@ public:
 
     virtual void clearSymbols();
 
-    virtual void getSymbols(AttributeType *list) {
-        *list = symbolListSortByName_;
-    }
+    virtual void getSymbols(AttributeType *list);
 
     virtual void addressToSymbol(uint64_t addr, AttributeType *info);
 
     virtual int symbol2Address(const char *name, uint64_t *addr);
 
+    virtual void setDebugLineInfo(AttributeType *sections);
+
+    virtual void addressToSource(const uint64_t *addr, unsigned cnt,
+                                 SourceLocationType *loc);
+
     virtual void disasm(int mode,
                         uint64_t pc,
                         AttributeType *idata,
@@ -81,10 +88,14 @@ private:
     ICmdExecutor *icmdexec_;
 
     CmdBrRiscv *pcmdBr_;
+    CmdTraceBin *pcmdTraceBin_;
+    CmdAddr2Line *pcmdAddr2Line_;
 
     AttributeType brList_;
-    AttributeType symbolListSortByName_;
-    AttributeType symbolListSortByAddr_;
+    SymbolIndex symbols_;
+    DwarfLineTable lines_;
+    AttributeType symbolListSortByName_;    // cache for getSymbols()
+    bool symbolListChanged_;
 };
 
 DECLARE_CLASS(RiscvSourceService)
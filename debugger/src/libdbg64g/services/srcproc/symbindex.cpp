@@ -0,0 +1,226 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include "symbindex.h"
+#include "coreservices/isrccode.h"
+
+namespace debugger {
+
+SymbolIndex::SymbolIndex() {
+    RISCV_mutex_init(&mutexBuild_);
+    clear();
+}
+
+SymbolIndex::~SymbolIndex() {
+    RISCV_mutex_destroy(&mutexBuild_);
+}
+
+void SymbolIndex::clear() {
+    entries_.clear();
+    names_.clear();
+    nameTbl_.clear();
+    internTbl_.assign(1024, 0);
+    internCnt_ = 0;
+    sorted_ = true;
+}
+
+uint32_t SymbolIndex::hash(const char *s) {
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= static_cast<uint8_t>(*s++);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+void SymbolIndex::rehashNames(unsigned sz) {
+    std::vector<uint32_t> old;
+    old.swap(internTbl_);
+    internTbl_.assign(sz, 0);
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i] == 0) {
+            continue;
+        }
+        uint32_t n = hash(&names_[old[i] - 1]) & (sz - 1);
+        while (internTbl_[n]) {
+            n = (n + 1) & (sz - 1);
+        }
+        internTbl_[n] = old[i];
+    }
+}
+
+uint32_t SymbolIndex::intern(const char *name) {
+    if (2 * (internCnt_ + 1) > internTbl_.size()) {
+        rehashNames(2 * static_cast<unsigned>(internTbl_.size()));
+    }
+    uint32_t mask = static_cast<uint32_t>(internTbl_.size()) - 1;
+    uint32_t n = hash(name) & mask;
+    while (internTbl_[n]) {
+        if (strcmp(&names_[internTbl_[n] - 1], name) == 0) {
+            return internTbl_[n] - 1;
+        }
+        n = (n + 1) & mask;
+    }
+    uint32_t off = static_cast<uint32_t>(names_.size());
+    names_.insert(names_.end(), name, name + strlen(name) + 1);
+    internTbl_[n] = off + 1;
+    internCnt_++;
+    return off;
+}
+
+void SymbolIndex::add(const char *name, uint64_t addr, uint64_t sz,
+                      uint64_t type) {
+    EntryType e;
+    e.addr = addr;
+    e.size = sz;
+    e.name = intern(name);
+    e.type = static_cast<uint32_t>(type);
+    if (entries_.size() && entries_.back().addr > addr) {
+        sorted_ = false;
+    }
+    entries_.push_back(e);
+    nameTbl_.clear();
+}
+
+bool SymbolIndex::addrLess(const EntryType &a, const EntryType &b) {
+    return a.addr < b.addr;
+}
+
+/** Sorting of the symbol indexes by the interned names */
+struct NameLess {
+    NameLess(const char *pool, const std::vector<uint32_t> &off)
+        : pool_(pool), off_(off) {}
+    bool operator()(uint32_t a, uint32_t b) const {
+        return strcmp(&pool_[off_[a]], &pool_[off_[b]]) < 0;
+    }
+    const char *pool_;
+    const std::vector<uint32_t> &off_;
+};
+
+void SymbolIndex::build() {
+    RISCV_mutex_lock(&mutexBuild_);
+    if (!sorted_) {
+        std::stable_sort(entries_.begin(), entries_.end(), addrLess);
+        nameTbl_.clear();
+        sorted_ = true;
+    }
+    if (nameTbl_.empty() && entries_.size()) {
+        unsigned sz = 16;
+        while (sz < 2 * entries_.size()) {
+            sz <<= 1;
+        }
+        std::vector<uint32_t> tbl(sz, 0);
+        for (size_t i = 0; i < entries_.size(); i++) {
+            const char *name = &names_[entries_[i].name];
+            uint32_t n = hash(name) & (sz - 1);
+            bool duplicate = false;
+            while (tbl[n]) {
+                // Names are interned so offsets comparison is enough
+                if (entries_[tbl[n] - 1].name == entries_[i].name) {
+                    duplicate = true;
+                    break;
+                }
+                n = (n + 1) & (sz - 1);
+            }
+            if (!duplicate) {
+                tbl[n] = static_cast<uint32_t>(i + 1);
+            }
+        }
+        nameTbl_.swap(tbl);
+    }
+    RISCV_mutex_unlock(&mutexBuild_);
+}
+
+int SymbolIndex::findAddress(uint64_t addr) {
+    if (!sorted_) {
+        build();
+    }
+    if (entries_.empty() || addr < entries_[0].addr) {
+        return -1;
+    }
+    // Last symbol with the start address not greater than addr
+    size_t lo = 0;
+    size_t hi = entries_.size();
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (addr < entries_[mid].addr) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    int idx = static_cast<int>(lo);
+    if (addr >= getRangeEnd(idx)) {
+        return -1;
+    }
+    return idx;
+}
+
+uint64_t SymbolIndex::getRangeEnd(int idx) {
+    if (static_cast<size_t>(idx + 1) < entries_.size()) {
+        return entries_[idx + 1].addr;
+    }
+    return entries_[idx].addr + entries_[idx].size;
+}
+
+int SymbolIndex::findName(const char *name) {
+    if (!sorted_ || nameTbl_.empty()) {
+        build();
+    }
+    if (nameTbl_.empty()) {
+        return -1;
+    }
+    uint32_t mask = static_cast<uint32_t>(nameTbl_.size()) - 1;
+    uint32_t n = hash(name) & mask;
+    while (nameTbl_[n]) {
+        int idx = static_cast<int>(nameTbl_[n] - 1);
+        if (strcmp(getName(idx), name) == 0) {
+            return idx;
+        }
+        n = (n + 1) & mask;
+    }
+    return -1;
+}
+
+void SymbolIndex::getSortedByName(AttributeType *list) {
+    if (!sorted_) {
+        build();
+    }
+    std::vector<uint32_t> order(entries_.size());
+    std::vector<uint32_t> nameoff(entries_.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = static_cast<uint32_t>(i);
+        nameoff[i] = entries_[i].name;
+    }
+    const char *pool = names_.data();
+    std::stable_sort(order.begin(), order.end(), NameLess(pool, nameoff));
+
+    list->make_list(static_cast<unsigned>(order.size()));
+    for (size_t i = 0; i < order.size(); i++) {
+        AttributeType &symb = (*list)[static_cast<unsigned>(i)];
+        const EntryType &e = entries_[order[i]];
+        symb.make_list(Symbol_Total);
+        symb[Symbol_Name].make_string(&pool[e.name]);
+        symb[Symbol_Addr].make_uint64(e.addr);
+        symb[Symbol_Size].make_uint64(e.size);
+        symb[Symbol_Type].make_uint64(e.type);
+    }
+}
+
+}  // namespace debugger
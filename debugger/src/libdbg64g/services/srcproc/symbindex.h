@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2023 Sergey Khabarov, sergeykhbr@gmail.com
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <api_core.h>
+#include <vector>
+
+namespace debugger {
+
+/**
+ * @brief Compact symbol table.
+ *
+ * Names are interned into the single character pool, symbols are kept in
+ * the flat array sorted by address and indexed by name with the open
+ * addressing hash table. Sorting is postponed until the first search so
+ * that adding of the symbols one by one doesn't re-sort the table.
+ */
+class SymbolIndex {
+ public:
+    SymbolIndex();
+    ~SymbolIndex();
+
+    void clear();
+    void add(const char *name, uint64_t addr, uint64_t sz, uint64_t type);
+
+    unsigned size() { return static_cast<unsigned>(entries_.size()); }
+
+    /** @return index of the symbol containing address or -1 */
+    int findAddress(uint64_t addr);
+    /** @return index of the symbol with the specified name or -1 */
+    int findName(const char *name);
+
+    const char *getName(int idx) { return &names_[entries_[idx].name]; }
+    uint64_t getAddress(int idx) { return entries_[idx].addr; }
+    uint64_t getSize(int idx) { return entries_[idx].size; }
+    uint64_t getType(int idx) { return entries_[idx].type; }
+    /** Next symbol address or the end of the last symbol */
+    uint64_t getRangeEnd(int idx);
+
+    /** Symbols sorted by name in ISourceCode list format */
+    void getSortedByName(AttributeType *list);
+
+ private:
+    void build();
+    uint32_t intern(const char *name);
+    void rehashNames(unsigned sz);
+    static uint32_t hash(const char *s);
+
+    struct EntryType {
+        uint64_t addr;
+        uint64_t size;
+        uint32_t name;      // offset in names_ pool
+        uint32_t type;
+    };
+    static bool addrLess(const EntryType &a, const EntryType &b);
+
+    std::vector<EntryType> entries_;
+    std::vector<char> names_;
+    std::vector<uint32_t> internTbl_;   // name offset + 1, 0 is empty slot
+    unsigned internCnt_;
+    std::vector<uint32_t> nameTbl_;     // symbol index + 1, 0 is empty slot
+    volatile bool sorted_;
+    mutex_def mutexBuild_;
+};
+
+}  // namespace debugger
@@ -21,6 +21,11 @@ namespace debugger {
 
 DDR::DDR(const char *name) : IService(name) {
     registerInterface(static_cast<IMemoryOperation *>(this));
+    registerAttribute("CmdExecutor", &cmdexec_);
+    registerAttribute("DirtyPageSize", &dirtyPageSize_);
+    dirtyPageSize_.make_uint64(0);
+    icmdexec_ = 0;
+    pcmdDirty_ = 0;
     mem_.bid = 0;
     mem_.prv = 0;
     mem_.nxt = 0;
@@ -38,6 +43,28 @@ DDR::~DDR() {
 }
 
 void DDR::postinitService() {
+    dirty_.init(length_.to_uint64(), dirtyPageSize_.to_uint64());
+    if (dirty_.isEnabled() && cmdexec_.is_string() && cmdexec_.size()) {
+        icmdexec_ = static_cast<ICmdExecutor *>(
+            RISCV_get_service_iface(cmdexec_.to_string(), IFACE_CMD_EXECUTOR));
+        if (!icmdexec_) {
+            RISCV_error("ICmdExecutor interface '%s' not found",
+                        cmdexec_.to_string());
+        } else {
+            pcmdDirty_ = new MemDirtyCmdType(static_cast<IService *>(this),
+                                             getObjName(), &dirty_,
+                                             getBaseAddress());
+            icmdexec_->registerCommand(pcmdDirty_);
+        }
+    }
+}
+
+void DDR::predeleteService() {
+    if (icmdexec_ && pcmdDirty_) {
+        icmdexec_->unregisterCommand(pcmdDirty_);
+        delete pcmdDirty_;
+        pcmdDirty_ = 0;
+    }
 }
 
 ETransStatus DDR::b_transport(Axi4TransactionType *trans) {
@@ -47,6 +74,7 @@ ETransStatus DDR::b_transport(Axi4TransactionType *trans) {
         memcpy(trans->rpayload.b8, data, trans->xsize);
     } else {
         memcpy(data, trans->wpayload.b8, trans->xsize);
+        dirty_.mark(off, trans->xsize);
     }
     return TRANS_OK;
 }
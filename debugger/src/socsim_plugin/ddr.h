@@ -19,6 +19,8 @@
 #include "iclass.h"
 #include "iservice.h"
 #include "coreservices/imemop.h"
+#include "coreservices/icmdexec.h"
+#include "generic/mem_dirty.h"
 
 namespace debugger {
 
@@ -30,6 +32,7 @@ class DDR : public IService,
 
     /** IService interface */
     virtual void postinitService() override;
+    virtual void predeleteService() override;
 
     /** IMemoryOperation */
     virtual ETransStatus b_transport(Axi4TransactionType *trans);
@@ -40,6 +43,13 @@ class DDR : public IService,
  protected:
     static const int BLOCK_SIZE = 1024*1024;
 
+    AttributeType cmdexec_;
+    AttributeType dirtyPageSize_;
+
+    ICmdExecutor *icmdexec_;
+    MemDirtyTracker dirty_;
+    MemDirtyCmdType *pcmdDirty_;
+
     struct MemBlockType {
         MemBlockType *nxt;
         MemBlockType *prv;
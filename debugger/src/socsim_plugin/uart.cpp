@@ -16,8 +16,14 @@
 
 #include "api_core.h"
 #include "uart.h"
-
-#define FAST_UART_SIM
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <termios.h>
+    #include <stdlib.h>
+    #include <errno.h>
+#endif
 
 namespace debugger {
 
@@ -38,7 +44,17 @@ UART::UART(const char *name) : RegMemBankGeneric(name),
     registerAttribute("IrqIdTx", &irqidtx_);
     registerAttribute("Clock", &clock_);
     registerAttribute("CmdExecutor", &cmdexec_);
-
+    registerAttribute("Mode", &mode_);
+    registerAttribute("TxFile", &txFile_);
+    registerAttribute("RxFile", &rxFile_);
+    registerAttribute("HostPty", &hostPty_);
+    registerAttribute("FlushPeriod", &flushPeriod_);
+
+    mode_.make_string("throughput");
+    txFile_.make_string("");
+    rxFile_.make_string("");
+    hostPty_.make_boolean(false);
+    flushPeriod_.make_uint64(100000);
     listeners_.make_list(0);
     RISCV_mutex_init(&mutexListeners_);
 
@@ -48,10 +64,21 @@ UART::UART(const char *name) : RegMemBankGeneric(name),
 
     tx_total_ = 0;
     tx_wcnt_ = 0;
+    tx_rcnt_ = 0;
     t_cb_cnt_ = 0;
+
+    accurate_ = false;
+    cb_pending_ = false;
+    txbuf_cnt_ = 0;
+    rxbuf_rd_ = 0;
+    rxbuf_cnt_ = 0;
+    txfile_ = 0;
+    rxfile_ = 0;
+    pty_ = -1;
 }
 
 UART::~UART() {
+    closeHostIO();
     RISCV_mutex_destroy(&mutexListeners_);
     if (rxfifo_) {
         delete [] rxfifo_;
@@ -96,23 +123,127 @@ void UART::postinitService() {
                                 getObjName());
         icmdexec_->registerCommand(pcmd_);
     }
+
+    if (mode_.is_equal("accurate")) {
+        accurate_ = true;
+    } else if (!mode_.is_equal("throughput")) {
+        RISCV_error("Unknown mode '%s', use 'throughput'",
+                    mode_.to_string());
+    }
+
+    if (txFile_.size()) {
+        txfile_ = fopen(txFile_.to_string(), "wb");
+        if (!txfile_) {
+            RISCV_error("Can't open TxFile %s", txFile_.to_string());
+        }
+    }
+    if (rxFile_.size()) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+        rxfile_ = fopen(rxFile_.to_string(), "rb");
+#else
+        /** Named pipe shouldn't block simulation until writer opened */
+        int fd = open(rxFile_.to_string(), O_RDONLY | O_NONBLOCK);
+        if (fd >= 0) {
+            rxfile_ = fdopen(fd, "rb");
+        }
+#endif
+        if (!rxfile_) {
+            RISCV_error("Can't open RxFile %s", rxFile_.to_string());
+        }
+    }
+    if (hostPty_.to_bool() && !openHostPty()) {
+        RISCV_error("Can't create host pseudo-terminal", NULL);
+    }
+    if (iclk_ && (rxfile_ || pty_ >= 0)) {
+        scheduleCallback(iclk_->getStepCounter());
+    }
 }
 
 void UART::predeleteService() {
     if (icmdexec_) {
         icmdexec_->unregisterCommand(pcmd_);
     }
+    flushTx();
 }
 
-uint32_t UART::getScaler() {
-#ifdef FAST_UART_SIM
-    return 100;
+bool UART::openHostPty() {
+#if defined(_WIN32) || defined(__CYGWIN__)
+    return false;
+#else
+    pty_ = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty_ < 0) {
+        return false;
+    }
+    if (grantpt(pty_) != 0 || unlockpt(pty_) != 0) {
+        ::close(pty_);
+        pty_ = -1;
+        return false;
+    }
+    struct termios tio;
+    if (tcgetattr(pty_, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(pty_, TCSANOW, &tio);
+    }
+    fcntl(pty_, F_SETFL, fcntl(pty_, F_GETFL, 0) | O_NONBLOCK);
+    RISCV_info("Host pseudo-terminal %s", ptsname(pty_));
+    return true;
+#endif
+}
+
+void UART::closeHostIO() {
+    if (txfile_) {
+        fclose(txfile_);
+        txfile_ = 0;
+    }
+    if (rxfile_) {
+        fclose(rxfile_);
+        rxfile_ = 0;
+    }
+#if defined(_WIN32) || defined(__CYGWIN__)
 #else
-    return 2*scaler_.getValue().val;
+    if (pty_ >= 0) {
+        ::close(pty_);
+        pty_ = -1;
+    }
 #endif
 }
 
+/** Bit period in clock cycles: scaler = SYS_HZ / baudrate / 2 */
+uint32_t UART::getScaler() {
+    if (!accurate_) {
+        return 100;
+    }
+    uint32_t ret = 2 * scaler_.getValue().val;
+    if (ret == 0) {
+        ret = 1;
+    }
+    return ret;
+}
+
+/** Start bit, 8 data bits and 1 or 2 stop bits */
+uint64_t UART::getFramePeriod() {
+    uint64_t bits = 10 + txctrl_.getTyped().b.nstop;
+    return bits * getScaler();
+}
+
+void UART::scheduleCallback(uint64_t t) {
+    if (cb_pending_) {
+        return;
+    }
+    cb_pending_ = true;
+    if (accurate_) {
+        t += getFramePeriod();
+    } else {
+        t += flushPeriod_.to_uint64();
+    }
+    iclk_->moveStepCallback(static_cast<IClockListener *>(this), t);
+}
+
 int UART::writeData(const char *buf, int sz) {
+    return pushRx(buf, sz);
+}
+
+int UART::pushRx(const char *buf, int sz) {
     if (rxfifo_ == 0) {
         return 0;
     }
@@ -120,15 +251,23 @@ int UART::writeData(const char *buf, int sz) {
         (fifoSize_.to_uint32() - rx_total_)) {
         sz = (fifoSize_.to_uint32() - rx_total_);
     }
-    for (int i = 0; i < sz; i++) {
-        rx_total_++;
-        *p_rx_wr_ = buf[i];
-        if ((++p_rx_wr_) >= (rxfifo_ + fifoSize_.to_int())) {
+    char *pend = rxfifo_ + fifoSize_.to_int();
+    int done = 0;
+    while (done < sz) {
+        int chunk = sz - done;
+        if (chunk > static_cast<int>(pend - p_rx_wr_)) {
+            chunk = static_cast<int>(pend - p_rx_wr_);
+        }
+        memcpy(p_rx_wr_, &buf[done], chunk);
+        p_rx_wr_ += chunk;
+        if (p_rx_wr_ >= pend) {
             p_rx_wr_ = rxfifo_;
         }
+        done += chunk;
     }
+    rx_total_ += sz;
 
-    if (ie_.getTyped().b.rxwm
+    if (sz && ie_.getTyped().b.rxwm
         && rx_total_ > rxctrl_.getTyped().b.rxcnt) {
         iirq_->requestInterrupt(static_cast<IService *>(this),
                               irqidrx_.to_int());
@@ -136,6 +275,49 @@ int UART::writeData(const char *buf, int sz) {
     return sz;
 }
 
+int UART::readRxSource(char *buf, int sz) {
+    int ret = 0;
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+    if (pty_ >= 0) {
+        ret = static_cast<int>(::read(pty_, buf, sz));
+        if (ret > 0) {
+            return ret;
+        }
+        ret = 0;
+    }
+#endif
+    if (rxfile_) {
+        ret = static_cast<int>(fread(buf, 1, sz, rxfile_));
+        if (ret < sz) {
+            // EOF of the pipe without writer or no data yet, poll later
+            clearerr(rxfile_);
+        }
+    }
+    return ret;
+}
+
+void UART::injectRx(int sz) {
+    int free = static_cast<int>(fifoSize_.to_uint32() - rx_total_);
+    if (sz > free) {
+        sz = free;
+    }
+    while (sz > 0) {
+        if (rxbuf_cnt_ == 0) {
+            rxbuf_rd_ = 0;
+            rxbuf_cnt_ = readRxSource(rxbuf_, RXBUF_SZ);
+            if (rxbuf_cnt_ == 0) {
+                break;
+            }
+        }
+        int chunk = sz < rxbuf_cnt_ ? sz : rxbuf_cnt_;
+        pushRx(&rxbuf_[rxbuf_rd_], chunk);
+        rxbuf_rd_ += chunk;
+        rxbuf_cnt_ -= chunk;
+        sz -= chunk;
+    }
+}
+
 void UART::registerRawListener(IFace *listener) {
     AttributeType lstn(listener);
     RISCV_mutex_lock(&mutexListeners_);
@@ -166,48 +348,94 @@ int UART::openPort(const char *port, AttributeType settings) {
 void UART::closePort() {
 }
 
-void UART::stepCallback(uint64_t t) {
-    bool sent = false;
-    if (tx_total_) {
-        sent = true;
-        tx_total_--;
+/** Firmware reads empty FIFO: don't wait for the flush timer */
+void UART::pollRx() {
+    if (!accurate_ && (rxfile_ || pty_ >= 0)) {
+        injectRx(fifoSize_.to_int());
     }
+}
 
-    if (sent && ie_.getTyped().b.txwm
-        && tx_total_ < txctrl_.getTyped().b.txcnt) {
-        iirq_->requestInterrupt(static_cast<IService*>(this),
-                                irqidtx_.to_int());
+void UART::stepCallback(uint64_t t) {
+    cb_pending_ = false;
+    if (accurate_) {
+        /** One frame per period in each direction */
+        if (tx_total_) {
+            outputByte(tx_fifo_[tx_rcnt_]);
+            tx_rcnt_ = (tx_rcnt_ + 1) % FIFOSZ;
+            tx_total_--;
+            if (tx_total_ == 0) {
+                flushTx();
+            }
+            if (ie_.getTyped().b.txwm
+                && tx_total_ < txctrl_.getTyped().b.txcnt) {
+                iirq_->requestInterrupt(static_cast<IService*>(this),
+                                        irqidtx_.to_int());
+            }
+        }
+        injectRx(1);
     } else {
-        iclk_->moveStepCallback(static_cast<IClockListener *>(this),
-                                t + getScaler());
+        flushTx();
+        injectRx(fifoSize_.to_int());
+    }
+
+    if (tx_total_ || txbuf_cnt_ || rxfile_ || pty_ >= 0) {
+        scheduleCallback(t);
     }
 }
 
 void UART::putByte(char v) {
-    char tbuf[2] = {v};
-    uint64_t t = iclk_->getStepCounter();
-    RISCV_info("[%" RV_PRI64 "d]Set data = %s", t, tbuf);
+    if (!accurate_) {
+        outputByte(v);
+        if (txbuf_cnt_) {
+            scheduleCallback(iclk_->getStepCounter());
+        }
+        return;
+    }
+    if (tx_total_ < FIFOSZ) {
+        tx_fifo_[tx_wcnt_] = v;
+        tx_wcnt_ = (tx_wcnt_ + 1) % FIFOSZ;
+        tx_total_++;
+    }
+    scheduleCallback(iclk_->getStepCounter());
+}
+
+void UART::outputByte(char v) {
+    txbuf_[txbuf_cnt_++] = v;
+    if (v == '\n' || txbuf_cnt_ == TXBUF_SZ) {
+        flushTx();
+    }
+}
+
+void UART::flushTx() {
+    if (txbuf_cnt_ == 0) {
+        return;
+    }
+    RISCV_debug("[%" RV_PRI64 "d]Tx %d bytes",
+                iclk_->getStepCounter(), txbuf_cnt_);
 
     RISCV_mutex_lock(&mutexListeners_);
     for (unsigned n = 0; n < listeners_.size(); n++) {
         IRawListener *lstn = static_cast<IRawListener *>(
                             listeners_[n].to_iface());
 
-        lstn->updateData(&v, 1);
+        lstn->updateData(txbuf_, txbuf_cnt_);
     }
     RISCV_mutex_unlock(&mutexListeners_);
 
-#if 0
-    // temporary disabled it but physically correct. Implement big enough UART buffer to compare with simulation
-    if (tx_total_ < FIFOSZ) {
-        tx_fifo_[tx_wcnt_] = v;
-        tx_wcnt_ = (tx_wcnt_ + 1) % FIFOSZ;
-        tx_total_++;
+    if (txfile_) {
+        fwrite(txbuf_, 1, txbuf_cnt_, txfile_);
+        fflush(txfile_);
+    }
+#if defined(_WIN32) || defined(__CYGWIN__)
+#else
+    if (pty_ >= 0) {
+        // Data is dropped when nobody reads the terminal
+        if (::write(pty_, txbuf_, txbuf_cnt_) < 0 && errno != EAGAIN) {
+            RISCV_error("Host pty write error %d", errno);
+        }
     }
-
-    iclk_->moveStepCallback(static_cast<IClockListener *>(this),
-                            t + getScaler());
 #endif
+    txbuf_cnt_ = 0;
 }
 
 char UART::getByte() {
@@ -255,6 +483,11 @@ uint32_t UART::TXDATA_TYPE::aboutToWrite(uint32_t new_val) {
 
 uint32_t UART::RXDATA_TYPE::aboutToRead(uint32_t cur_val) {
     UART *p = static_cast<UART *>(parent_);
+    // Firmware waits for input, so show everything printed before
+    p->flushTx();
+    if (p->getRxTotal() == 0) {
+        p->pollRx();
+    }
     cur_val = 0;
     if (p->getRxTotal() == 0) {
         cur_val |= 1ull << 31;  // RX FIFO empty flag
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <stdio.h>
 #include "iclass.h"
 #include "iservice.h"
 #include "coreservices/imemop.h"
@@ -66,6 +67,16 @@ class UartCmdType : public ICommand {
     ISerial *iserial_;
 };
 
+/**
+ * @brief UART model with the selectable host transport.
+ *
+ * Mode 'throughput' (default) accumulates transmitted bytes and passes
+ * them to the listeners, TxFile and host pty as one block by the flush
+ * timer, end of line or when the buffer is full. Mode 'accurate' models
+ * TX FIFO and transmits one symbol per frame time computed from the
+ * programmed scaler register. RxFile or host pty data is injected into
+ * RX FIFO by chunks limited by the free space of FIFO.
+ */
 class UART : public RegMemBankGeneric,
              public ISerial,
              public IClockListener {
@@ -90,6 +101,7 @@ class UART : public RegMemBankGeneric,
 
     /** Common methods */
     uint32_t getScaler();
+    uint64_t getFramePeriod();
     int getFifoSize() { return fifoSize_.to_int(); }
     uint32_t getRxTotal() { return rx_total_; }
     uint32_t getTxTotal() { return tx_total_; }
@@ -97,6 +109,8 @@ class UART : public RegMemBankGeneric,
     uint32_t getRxWatermark() { return rxctrl_.getTyped().b.rxcnt; }
     void putByte(char v);
     char getByte();
+    void flushTx();
+    void pollRx();
 
  protected:
     class TXCTRL_TYPE : public MappedReg32Type {
@@ -220,6 +234,15 @@ class UART : public RegMemBankGeneric,
         virtual uint32_t aboutToRead(uint32_t cur_val) override;
     };
 
+ private:
+    void scheduleCallback(uint64_t t);
+    void outputByte(char v);
+    int pushRx(const char *buf, int sz);
+    void injectRx(int sz);
+    int readRxSource(char *buf, int sz);
+    bool openHostPty();
+    void closeHostIO();
+
  private:
     AttributeType fifoSize_;
     AttributeType irqctrl_;
@@ -227,6 +250,11 @@ class UART : public RegMemBankGeneric,
     AttributeType irqidtx_;
     AttributeType clock_;
     AttributeType cmdexec_;
+    AttributeType mode_;
+    AttributeType txFile_;
+    AttributeType rxFile_;
+    AttributeType hostPty_;
+    AttributeType flushPeriod_;
     AttributeType listeners_;  // non-registering attribute
 
     ICmdExecutor *icmdexec_;
@@ -241,8 +269,22 @@ class UART : public RegMemBankGeneric,
     static const int FIFOSZ = 15;
     char tx_fifo_[FIFOSZ];
     uint32_t tx_wcnt_;
+    uint32_t tx_rcnt_;
     uint32_t tx_total_;
 
+    static const int TXBUF_SZ = 4096;
+    static const int RXBUF_SZ = 4096;
+    bool accurate_;
+    bool cb_pending_;
+    char txbuf_[TXBUF_SZ];      // bytes to pass to the host
+    int txbuf_cnt_;
+    char rxbuf_[RXBUF_SZ];      // bytes read from the host
+    int rxbuf_rd_;
+    int rxbuf_cnt_;
+    FILE *txfile_;
+    FILE *rxfile_;
+    int pty_;
+
     mutex_def mutexListeners_;
     UartCmdType *pcmd_;
 
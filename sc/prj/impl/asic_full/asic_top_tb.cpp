@@ -0,0 +1,438 @@
+// 
+//  Copyright 2022 Sergey Khabarov, sergeykhbr@gmail.com
+// 
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+// 
+
+#include "asic_top_tb.h"
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <vector>
+
+namespace debugger {
+
+// Little-endian ELF64 only (RISC-V 64-bits images):
+struct tb_elf64_ehdr {
+    uint8_t e_ident[16];
+    uint16_t e_type;
+    uint16_t e_machine;
+    uint32_t e_version;
+    uint64_t e_entry;
+    uint64_t e_phoff;
+    uint64_t e_shoff;
+    uint32_t e_flags;
+    uint16_t e_ehsize;
+    uint16_t e_phentsize;
+    uint16_t e_phnum;
+    uint16_t e_shentsize;
+    uint16_t e_shnum;
+    uint16_t e_shstrndx;
+};
+
+struct tb_elf64_phdr {
+    uint32_t p_type;
+    uint32_t p_flags;
+    uint64_t p_offset;
+    uint64_t p_vaddr;
+    uint64_t p_paddr;
+    uint64_t p_filesz;
+    uint64_t p_memsz;
+    uint64_t p_align;
+};
+
+struct tb_elf64_shdr {
+    uint32_t sh_name;
+    uint32_t sh_type;
+    uint64_t sh_flags;
+    uint64_t sh_addr;
+    uint64_t sh_offset;
+    uint64_t sh_size;
+    uint32_t sh_link;
+    uint32_t sh_info;
+    uint64_t sh_addralign;
+    uint64_t sh_entsize;
+};
+
+struct tb_elf64_sym {
+    uint32_t st_name;
+    uint8_t st_info;
+    uint8_t st_other;
+    uint16_t st_shndx;
+    uint64_t st_value;
+    uint64_t st_size;
+};
+
+static const uint32_t TB_PT_LOAD = 1;
+static const uint32_t TB_SHT_SYMTAB = 2;
+
+asic_top_tb::asic_top_tb(sc_module_name name,
+                         uint64_t max_cycles,
+                         int uart_bit_clocks)
+    : sc_module(name),
+    clk("clk", 25, SC_NS) {
+
+    max_cycles_ = max_cycles;
+    clk_cnt_ = 0;
+    tohost_ = 0;
+    tohost_shadow_ = 0;
+    stmon_cnt_ = 0;
+    exit_code_ = 0;
+
+    prci0 = new apb_prci("prci0", CFG_ASYNC_RESET);
+    prci0->i_clk(clk);
+    prci0->i_pwrreset(w_pwrreset);
+    prci0->i_dmireset(w_dmreset);
+    prci0->i_sys_locked(w_one);
+    prci0->i_ddr_locked(w_one);
+    prci0->o_sys_rst(w_sys_rst);
+    prci0->o_sys_nrst(w_sys_nrst);
+    prci0->o_dbg_nrst(w_dbg_nrst);
+    prci0->i_mapinfo(prci_pmapinfo);
+    prci0->o_cfg(prci_dev_cfg);
+    prci0->i_apbi(prci_apbi);
+    prci0->o_apbo(prci_apbo);
+
+    soc0 = new riscv_soc("soc0", CFG_BOOTROM_FILE_HEX, TB_SIM_UART_SPEEDUP_RATE);
+    soc0->i_sys_nrst(w_sys_nrst);
+    soc0->i_sys_clk(clk);
+    soc0->i_dbg_nrst(w_dbg_nrst);
+    soc0->i_ddr_nrst(w_sys_nrst);
+    soc0->i_ddr_clk(clk);
+    soc0->i_gpio(wb_gpio_in);
+    soc0->o_gpio(wb_gpio_out);
+    soc0->o_gpio_dir(wb_gpio_dir);
+    soc0->i_jtag_trst(w_zero);
+    soc0->i_jtag_tck(w_zero);
+    soc0->i_jtag_tms(w_zero);
+    soc0->i_jtag_tdi(w_zero);
+    soc0->o_jtag_tdo(w_jtag_tdo);
+    soc0->o_jtag_vref(w_jtag_vref);
+    soc0->i_uart1_rd(w_one);
+    soc0->o_uart1_td(w_uart1_td);
+    soc0->o_spi_cs(w_spi_cs);
+    soc0->o_spi_sclk(w_spi_sclk);
+    soc0->o_spi_mosi(w_spi_mosi);
+    soc0->i_spi_miso(w_one);
+    soc0->i_sd_detected(w_one);
+    soc0->i_sd_protect(w_zero);
+    soc0->o_dmreset(w_dmreset);
+    soc0->o_prci_pmapinfo(prci_pmapinfo);
+    soc0->i_prci_pdevcfg(prci_dev_cfg);
+    soc0->o_prci_apbi(prci_apbi);
+    soc0->i_prci_apbo(prci_apbo);
+    soc0->o_ddr_pmapinfo(ddr_pmapinfo);
+    soc0->i_ddr_pdevcfg(ddr_pdev_cfg);
+    soc0->o_ddr_apbi(ddr_apbi);
+    soc0->i_ddr_apbo(ddr_apbo);
+    soc0->o_ddr_xmapinfo(ddr_xmapinfo);
+    soc0->i_ddr_xdevcfg(ddr_xdev_cfg);
+    soc0->o_ddr_xslvi(ddr_xslvi);
+    soc0->i_ddr_xslvo(ddr_xslvo);
+
+    // DDR controller always calibrated
+    pctrl0 = new apb_ddr("pctrl0", CFG_ASYNC_RESET);
+    pctrl0->i_clk(clk);
+    pctrl0->i_nrst(w_sys_nrst);
+    pctrl0->i_mapinfo(ddr_pmapinfo);
+    pctrl0->o_cfg(ddr_pdev_cfg);
+    pctrl0->i_apbi(ddr_apbi);
+    pctrl0->o_apbo(ddr_apbo);
+    pctrl0->i_pll_locked(w_one);
+    pctrl0->i_init_calib_done(w_one);
+    pctrl0->i_device_temp(wb_ddr_temp);
+    pctrl0->i_sr_active(w_zero);
+    pctrl0->i_ref_ack(w_zero);
+    pctrl0->i_zq_ack(w_zero);
+
+    ddr0 = new axi_sram<TB_DDR_LOG2_SIZE>("ddr0", CFG_ASYNC_RESET);
+    ddr0->i_clk(clk);
+    ddr0->i_nrst(w_sys_nrst);
+    ddr0->i_mapinfo(ddr_xmapinfo);
+    ddr0->o_cfg(ddr_xdev_cfg);
+    ddr0->i_xslvi(ddr_xslvi);
+    ddr0->o_xslvo(ddr_xslvo);
+
+    uart0 = new sim_uart_rx("uart0", uart_bit_clocks);
+    uart0->i_clk(clk);
+    uart0->i_nrst(w_sys_nrst);
+    uart0->i_rx(w_uart1_td);
+
+    w_one.write(1);
+    w_zero.write(0);
+    w_pwrreset.write(1);
+    // The same as in SV testbench: GPIO[3:0] pulled up
+    wb_gpio_in.write(0x00F);
+    wb_ddr_temp.write(0);
+
+    SC_METHOD(registers);
+    sensitive << clk.posedge_event();
+}
+
+asic_top_tb::~asic_top_tb() {
+    if (prci0) {
+        delete prci0;
+    }
+    if (soc0) {
+        delete soc0;
+    }
+    if (pctrl0) {
+        delete pctrl0;
+    }
+    if (ddr0) {
+        delete ddr0;
+    }
+    if (uart0) {
+        delete uart0;
+    }
+}
+
+void asic_top_tb::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
+    if (o_vcd) {
+        sc_trace(o_vcd, w_pwrreset, w_pwrreset.name());
+        sc_trace(o_vcd, w_sys_nrst, w_sys_nrst.name());
+        sc_trace(o_vcd, w_uart1_td, w_uart1_td.name());
+    }
+    prci0->generateVCD(i_vcd, o_vcd);
+    soc0->generateVCD(i_vcd, o_vcd);
+    pctrl0->generateVCD(i_vcd, o_vcd);
+    ddr0->generateVCD(i_vcd, o_vcd);
+}
+
+template <class T>
+static T *tb_find_port(const char *path, int cpu, const char *port) {
+    char tstr[256];
+    snprintf(tstr, sizeof(tstr), "%s.soc0.group0.cpux%d.river0.proc0.%s",
+             path, cpu, port);
+    return dynamic_cast<T *>(sc_find_object(tstr));
+}
+
+void asic_top_tb::end_of_elaboration() {
+    for (int i = 0; i < CFG_CPU_NUM; i++) {
+        StoreMonitorType *p = &stmon_[stmon_cnt_];
+        p->valid = tb_find_port<sc_out<bool>>(name(), i, "o_req_data_valid");
+        p->ready = tb_find_port<sc_in<bool>>(name(), i, "i_req_data_ready");
+        p->type = tb_find_port<sc_out<sc_uint<MemopType_Total>>>(
+                name(), i, "o_req_data_type");
+        p->addr = tb_find_port<sc_out<sc_uint<RISCV_ARCH>>>(
+                name(), i, "o_req_data_addr");
+        p->wdata = tb_find_port<sc_out<sc_uint<64>>>(
+                name(), i, "o_req_data_wdata");
+        p->wstrb = tb_find_port<sc_out<sc_uint<8>>>(
+                name(), i, "o_req_data_wstrb");
+        if (!p->valid || !p->ready || !p->type || !p->addr
+            || !p->wdata || !p->wstrb) {
+            fprintf(stderr, "asic_top_tb: cpu%d data port not found, "
+                    "'tohost' is polled in memory\n", i);
+            continue;
+        }
+        stmon_cnt_++;
+    }
+}
+
+void asic_top_tb::registers() {
+    clk_cnt_++;
+    if (clk_cnt_ == RESET_CLOCKS) {
+        w_pwrreset.write(0);
+    }
+
+    if (tohost_ && monitorToHost()) {
+        sc_stop();
+        return;
+    }
+    if (tohost_ && (clk_cnt_ % TOHOST_POLL_CLOCKS) == 0 && checkToHost()) {
+        sc_stop();
+        return;
+    }
+
+    if (max_cycles_ && clk_cnt_ >= max_cycles_) {
+        fprintf(stderr, "\nasic_top_tb: timeout %" PRIu64 " cycles\n",
+                clk_cnt_);
+        exit_code_ = TB_EXIT_TIMEOUT;
+        sc_stop();
+    }
+}
+
+bool asic_top_tb::monitorToHost() {
+    // Handshake registered on the previous clock edge
+    bool wr = false;
+    for (int i = 0; i < stmon_cnt_; i++) {
+        StoreMonitorType *p = &stmon_[i];
+        if (!p->valid->read() || !p->ready->read()
+            || !p->type->read()[MemopType_Store]) {
+            continue;
+        }
+        if ((p->addr->read().to_uint64() & ~0x7ull) != (tohost_ & ~0x7ull)) {
+            continue;
+        }
+        uint64_t wdata = p->wdata->read().to_uint64();
+        uint8_t wstrb = static_cast<uint8_t>(p->wstrb->read().to_uint());
+        for (int n = 0; n < 8; n++) {
+            if (wstrb & (1 << n)) {
+                uint64_t mask = 0xFFull << (8 * n);
+                tohost_shadow_ = (tohost_shadow_ & ~mask) | (wdata & mask);
+            }
+        }
+        wr = true;
+    }
+    if (!wr || tohost_shadow_ == 0) {
+        return false;
+    }
+    reportToHost(tohost_shadow_);
+    return true;
+}
+
+bool asic_top_tb::checkToHost() {
+    uint64_t val = 0;
+    uint8_t t;
+    for (int i = 0; i < 8; i++) {
+        if (!backdoorRead(tohost_ + i, &t)) {
+            return false;
+        }
+        val |= static_cast<uint64_t>(t) << (8 * i);
+    }
+    if (val == 0) {
+        return false;
+    }
+    reportToHost(val);
+    return true;
+}
+
+void asic_top_tb::reportToHost(uint64_t val) {
+    if (val == 1) {
+        fprintf(stderr, "\nasic_top_tb: PASS at %" PRIu64 " cycles\n",
+                clk_cnt_);
+        exit_code_ = 0;
+    } else {
+        // Keep zero for pass only
+        exit_code_ = static_cast<int>((val >> 1) & 0xFF);
+        if (exit_code_ == 0) {
+            exit_code_ = 1;
+        }
+        fprintf(stderr, "\nasic_top_tb: FAIL test %" PRIu64 " at %" PRIu64
+                " cycles\n", val >> 1, clk_cnt_);
+    }
+}
+
+bool asic_top_tb::backdoorWrite(uint64_t addr, uint8_t v) {
+    const mapinfo_type &ddr = CFG_BUS0_MAP[CFG_BUS0_XSLV_DDR];
+    if (addr >= ddr.addr_start && addr < ddr.addr_end) {
+        uint64_t off = addr - ddr.addr_start;
+        if (off >= (1ull << TB_DDR_LOG2_SIZE)) {
+            return false;
+        }
+        ddr0->backdoorWrite(off, v);
+        return true;
+    }
+    return soc0->backdoorWrite(addr, v);
+}
+
+bool asic_top_tb::backdoorRead(uint64_t addr, uint8_t *v) {
+    const mapinfo_type &ddr = CFG_BUS0_MAP[CFG_BUS0_XSLV_DDR];
+    if (addr >= ddr.addr_start && addr < ddr.addr_end) {
+        uint64_t off = addr - ddr.addr_start;
+        if (off >= (1ull << TB_DDR_LOG2_SIZE)) {
+            return false;
+        }
+        *v = ddr0->backdoorRead(off);
+        return true;
+    }
+    return soc0->backdoorRead(addr, v);
+}
+
+bool asic_top_tb::loadElf(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        fprintf(stderr, "asic_top_tb: cannot open %s\n", filename);
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    std::vector<uint8_t> img(sz > 0 ? sz : 0);
+    size_t rdcnt = img.size() ? fread(&img[0], 1, img.size(), f) : 0;
+    fclose(f);
+
+    if (rdcnt != img.size() || rdcnt < sizeof(tb_elf64_ehdr)) {
+        fprintf(stderr, "asic_top_tb: cannot read %s\n", filename);
+        return false;
+    }
+    const tb_elf64_ehdr *eh = reinterpret_cast<const tb_elf64_ehdr *>(&img[0]);
+    if (memcmp(eh->e_ident, "\x7f" "ELF", 4) != 0
+        || eh->e_ident[4] != 2 || eh->e_ident[5] != 1) {
+        fprintf(stderr, "asic_top_tb: %s isn't ELF64 little-endian\n",
+                filename);
+        return false;
+    }
+
+    // Program header: data as it should be placed in physical memory
+    for (unsigned i = 0; i < eh->e_phnum; i++) {
+        uint64_t phoff = eh->e_phoff + i * eh->e_phentsize;
+        if (phoff + sizeof(tb_elf64_phdr) > img.size()) {
+            break;
+        }
+        const tb_elf64_phdr *ph =
+            reinterpret_cast<const tb_elf64_phdr *>(&img[phoff]);
+        if (ph->p_type != TB_PT_LOAD || ph->p_memsz == 0) {
+            continue;
+        }
+        if (ph->p_offset + ph->p_filesz > img.size()) {
+            fprintf(stderr, "asic_top_tb: wrong segment %d\n", i);
+            return false;
+        }
+        for (uint64_t n = 0; n < ph->p_memsz; n++) {
+            uint8_t v = n < ph->p_filesz ? img[ph->p_offset + n] : 0;
+            if (!backdoorWrite(ph->p_paddr + n, v)) {
+                fprintf(stderr, "asic_top_tb: segment %d address %"
+                        PRIx64 " isn't mapped on memory\n",
+                        i, ph->p_paddr + n);
+                return false;
+            }
+        }
+    }
+
+    // Optional symbol 'tohost' to detect end of simulation
+    for (unsigned i = 0; i < eh->e_shnum && !tohost_; i++) {
+        uint64_t shoff = eh->e_shoff + i * eh->e_shentsize;
+        if (shoff + sizeof(tb_elf64_shdr) > img.size()) {
+            break;
+        }
+        const tb_elf64_shdr *sh =
+            reinterpret_cast<const tb_elf64_shdr *>(&img[shoff]);
+        if (sh->sh_type != TB_SHT_SYMTAB || sh->sh_link >= eh->e_shnum) {
+            continue;
+        }
+        const tb_elf64_shdr *strsh = reinterpret_cast<const tb_elf64_shdr *>(
+            &img[eh->e_shoff + sh->sh_link * eh->e_shentsize]);
+        if (sh->sh_offset + sh->sh_size > img.size()
+            || strsh->sh_offset + strsh->sh_size > img.size()) {
+            continue;
+        }
+        for (uint64_t off = 0; off + sizeof(tb_elf64_sym) <= sh->sh_size;
+             off += sizeof(tb_elf64_sym)) {
+            const tb_elf64_sym *sym = reinterpret_cast<const tb_elf64_sym *>(
+                &img[sh->sh_offset + off]);
+            if (sym->st_name + sizeof("tohost") > strsh->sh_size) {
+                continue;
+            }
+            if (strcmp(reinterpret_cast<const char *>(
+                    &img[strsh->sh_offset + sym->st_name]), "tohost") == 0) {
+                tohost_ = sym->st_value;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace debugger
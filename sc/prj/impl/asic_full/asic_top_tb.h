@@ -0,0 +1,134 @@
+// 
+//  Copyright 2022 Sergey Khabarov, sergeykhbr@gmail.com
+// 
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+// 
+#pragma once
+
+#include <systemc.h>
+#include "config_target.h"
+#include "riscv_soc.h"
+#include "misclib/apb_prci.h"
+#include "misclib/apb_ddr.h"
+#include "misclib/axi_sram.h"
+#include "sim_uart_rx.h"
+
+namespace debugger {
+
+// Behavioral DDR stand-in size (aliased inside of the DDR slot):
+static const int TB_DDR_LOG2_SIZE = 22;                     // 22=4 MB
+
+// UART bit period in clocks: firmware sets scaler SYS_HZ/115200/2 that
+// is divided by 2^sim_uart_speedup_rate (40 MHz clock, speedup 3):
+static const int TB_SIM_UART_SPEEDUP_RATE = 3;
+static const int TB_UART_BIT_CLOCKS = 2 * ((40000000 / 115200 / 2) >> TB_SIM_UART_SPEEDUP_RATE);
+
+// Exit code when the simulation reached the cycles limit
+static const int TB_EXIT_TIMEOUT = 124;
+
+// Headless full SoC simulation without JTAG:
+//   - Memories preloaded from ELF-file directly into the tech arrays;
+//   - UART1 output is redirected into stdout;
+//   - Simulation ends when the firmware writes non-zero value into 'tohost'
+//     (riscv-tests convention: 1 = pass, (code << 1) | 1 = fail).
+// D-cache is write-back and the riscv-tests keep the 'tohost' line dirty in
+// L1, so the stores are caught on the core to D-cache request port of every
+// CPU. Backdoor polling stays as the fallback when the ports aren't found.
+SC_MODULE(asic_top_tb) {
+ public:
+    void registers();
+
+    SC_HAS_PROCESS(asic_top_tb);
+
+    asic_top_tb(sc_module_name name,
+                uint64_t max_cycles,
+                int uart_bit_clocks);
+    virtual ~asic_top_tb();
+
+    void generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd);
+    virtual void end_of_elaboration();
+
+    // Copy PT_LOAD segments into ROM/SRAM/DDR, find 'tohost' symbol
+    bool loadElf(const char *filename);
+    void setToHost(uint64_t addr) { tohost_ = addr; }
+    int exitCode() { return exit_code_; }
+    uint64_t cycles() { return clk_cnt_; }
+
+    bool backdoorWrite(uint64_t addr, uint8_t v);
+    bool backdoorRead(uint64_t addr, uint8_t *v);
+
+ private:
+    static const int RESET_CLOCKS = 10;
+    static const int TOHOST_POLL_CLOCKS = 1024;
+
+    // Core data request ports, bare-metal tests: virtual = physical address
+    struct StoreMonitorType {
+        sc_out<bool> *valid;
+        sc_in<bool> *ready;
+        sc_out<sc_uint<MemopType_Total>> *type;
+        sc_out<sc_uint<RISCV_ARCH>> *addr;
+        sc_out<sc_uint<64>> *wdata;
+        sc_out<sc_uint<8>> *wstrb;
+    };
+
+    bool monitorToHost();
+    bool checkToHost();
+    void reportToHost(uint64_t val);
+
+    uint64_t max_cycles_;
+    uint64_t clk_cnt_;
+    uint64_t tohost_;                                       // 0 = not used
+    uint64_t tohost_shadow_;                                // bytes stored by cores
+    int stmon_cnt_;
+    StoreMonitorType stmon_[CFG_CPU_NUM];
+    int exit_code_;
+
+    sc_clock clk;
+    sc_signal<bool> w_pwrreset;
+    sc_signal<bool> w_sys_rst;
+    sc_signal<bool> w_sys_nrst;
+    sc_signal<bool> w_dbg_nrst;
+    sc_signal<bool> w_dmreset;
+    sc_signal<bool> w_one;
+    sc_signal<bool> w_zero;
+    sc_signal<sc_uint<12>> wb_gpio_in;
+    sc_signal<sc_uint<12>> wb_gpio_out;
+    sc_signal<sc_uint<12>> wb_gpio_dir;
+    sc_signal<sc_uint<12>> wb_ddr_temp;
+    sc_signal<bool> w_jtag_tdo;
+    sc_signal<bool> w_jtag_vref;
+    sc_signal<bool> w_uart1_td;
+    sc_signal<bool> w_spi_cs;
+    sc_signal<bool> w_spi_sclk;
+    sc_signal<bool> w_spi_mosi;
+    sc_signal<mapinfo_type> prci_pmapinfo;
+    sc_signal<dev_config_type> prci_dev_cfg;
+    sc_signal<apb_in_type> prci_apbi;
+    sc_signal<apb_out_type> prci_apbo;
+    sc_signal<mapinfo_type> ddr_pmapinfo;
+    sc_signal<dev_config_type> ddr_pdev_cfg;
+    sc_signal<apb_in_type> ddr_apbi;
+    sc_signal<apb_out_type> ddr_apbo;
+    sc_signal<mapinfo_type> ddr_xmapinfo;
+    sc_signal<dev_config_type> ddr_xdev_cfg;
+    sc_signal<axi4_slave_in_type> ddr_xslvi;
+    sc_signal<axi4_slave_out_type> ddr_xslvo;
+
+    apb_prci *prci0;
+    riscv_soc *soc0;
+    apb_ddr *pctrl0;
+    axi_sram<TB_DDR_LOG2_SIZE> *ddr0;
+    sim_uart_rx *uart0;
+};
+
+}  // namespace debugger
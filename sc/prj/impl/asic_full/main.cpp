@@ -0,0 +1,91 @@
+// 
+//  Copyright 2022 Sergey Khabarov, sergeykhbr@gmail.com
+// 
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+// 
+
+#include <systemc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asic_top_tb.h"
+
+using namespace debugger;
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+        "Usage: %s <elf-file> [-t max_cycles] [-uart_bit clocks]"
+        " [-vcd file] [-tohost hex_addr]\n"
+        "    -t         cycles limit, exit code %d on timeout (0 = none)\n"
+        "    -uart_bit  UART1 bit period in clocks (default %d)\n"
+        "    -vcd       output VCD-file name without extension\n"
+        "    -tohost    address polled to end simulation instead of\n"
+        "               'tohost' symbol of the ELF-file\n",
+        prog, TB_EXIT_TIMEOUT, TB_UART_BIT_CLOCKS);
+}
+
+int sc_main(int argc, char *argv[]) {
+    const char *elffile = 0;
+    const char *vcdfile = 0;
+    uint64_t max_cycles = 0;
+    uint64_t tohost = 0;
+    int uart_bit = TB_UART_BIT_CLOCKS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            max_cycles = strtoull(argv[++i], 0, 0);
+        } else if (strcmp(argv[i], "-uart_bit") == 0 && i + 1 < argc) {
+            uart_bit = static_cast<int>(strtol(argv[++i], 0, 0));
+        } else if (strcmp(argv[i], "-vcd") == 0 && i + 1 < argc) {
+            vcdfile = argv[++i];
+        } else if (strcmp(argv[i], "-tohost") == 0 && i + 1 < argc) {
+            tohost = strtoull(argv[++i], 0, 16);
+        } else if (argv[i][0] != '-' && elffile == 0) {
+            elffile = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (elffile == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    sc_set_default_time_unit(1, SC_NS);
+
+    asic_top_tb *tb = new asic_top_tb("tb", max_cycles, uart_bit);
+    if (tohost) {
+        tb->setToHost(tohost);
+    }
+    if (!tb->loadElf(elffile)) {
+        delete tb;
+        return 1;
+    }
+
+    sc_trace_file *o_vcd = 0;
+    if (vcdfile) {
+        o_vcd = sc_create_vcd_trace_file(vcdfile);
+        o_vcd->set_time_unit(1, SC_PS);
+    }
+    tb->generateVCD(0, o_vcd);
+
+    sc_start();
+
+    if (o_vcd) {
+        sc_close_vcd_trace_file(o_vcd);
+    }
+    int ret = tb->exitCode();
+    delete tb;
+    return ret;
+}
@@ -0,0 +1,85 @@
+// 
+//  Copyright 2022 Sergey Khabarov, sergeykhbr@gmail.com
+// 
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+// 
+
+#include "sim_uart_rx.h"
+#include <stdio.h>
+
+namespace debugger {
+
+sim_uart_rx::sim_uart_rx(sc_module_name name,
+                         int bit_clocks)
+    : sc_module(name),
+    i_clk("i_clk"),
+    i_nrst("i_nrst"),
+    i_rx("i_rx") {
+
+    bit_clocks_ = bit_clocks > 1 ? bit_clocks : 2;
+    busy_ = false;
+    cnt_ = 0;
+    bitidx_ = 0;
+    shift_ = 0;
+
+    SC_METHOD(registers);
+    sensitive << i_clk.pos();
+}
+
+void sim_uart_rx::registers() {
+    if (!i_nrst.read()) {
+        busy_ = false;
+        return;
+    }
+
+    if (!busy_) {
+        if (i_rx.read() == 0) {
+            // Start bit edge: sample it again in the middle
+            busy_ = true;
+            cnt_ = bit_clocks_ / 2 - 1;
+            bitidx_ = 0;
+            shift_ = 0;
+        }
+        return;
+    }
+
+    if (cnt_ != 0) {
+        cnt_--;
+        return;
+    }
+    cnt_ = bit_clocks_ - 1;
+
+    if (bitidx_ == 0) {
+        if (i_rx.read() != 0) {
+            // glitch, not a start bit
+            busy_ = false;
+        }
+    } else if (bitidx_ <= 8) {
+        shift_ >>= 1;
+        if (i_rx.read()) {
+            shift_ |= 0x80;
+        }
+    } else {
+        // Stop bit position, output even if it is a framing error
+        if (shift_ != '\r') {
+            putchar(shift_);
+            if (shift_ == '\n') {
+                fflush(stdout);
+            }
+        }
+        busy_ = false;
+    }
+    bitidx_++;
+}
+
+}  // namespace debugger
@@ -0,0 +1,45 @@
+// 
+//  Copyright 2022 Sergey Khabarov, sergeykhbr@gmail.com
+// 
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+// 
+#pragma once
+
+#include <systemc.h>
+
+namespace debugger {
+
+// Behavioral UART receiver: 8 data bits, no parity, 1 stop bit.
+// Received characters are printed into stdout ('\r' is dropped).
+SC_MODULE(sim_uart_rx) {
+ public:
+    sc_in<bool> i_clk;
+    sc_in<bool> i_nrst;                                     // Reset: active LOW
+    sc_in<bool> i_rx;
+
+    void registers();
+
+    SC_HAS_PROCESS(sim_uart_rx);
+
+    sim_uart_rx(sc_module_name name,
+                int bit_clocks);
+
+ private:
+    int bit_clocks_;                                        // Bit period in clocks
+    bool busy_;
+    int cnt_;                                               // clocks to the next sample point
+    int bitidx_;
+    uint8_t shift_;
+};
+
+}  // namespace debugger
@@ -45,6 +45,14 @@ SC_MODULE(axi_rom) {
 
     void generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd);
 
+    // Simulation only: preload and check content without bus transactions
+    void backdoorWrite(uint64_t off, uint8_t v) {
+        tech0->backdoorWrite(off & ((1ull << abits) - 1), v);
+    }
+    uint8_t backdoorRead(uint64_t off) {
+        return tech0->backdoorRead(off & ((1ull << abits) - 1));
+    }
+
  private:
     bool async_reset_;
     std::string filename_;
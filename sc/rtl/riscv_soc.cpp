@@ -429,6 +429,32 @@ void riscv_soc::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
     }
 }
 
+bool riscv_soc::backdoorWrite(uint64_t addr, uint8_t v) {
+    const mapinfo_type &rom = CFG_BUS0_MAP[CFG_BUS0_XSLV_BOOTROM];
+    const mapinfo_type &sram = CFG_BUS0_MAP[CFG_BUS0_XSLV_SRAM];
+    if (addr >= rom.addr_start && addr < rom.addr_end) {
+        rom0->backdoorWrite(addr - rom.addr_start, v);
+    } else if (addr >= sram.addr_start && addr < sram.addr_end) {
+        sram0->backdoorWrite(addr - sram.addr_start, v);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool riscv_soc::backdoorRead(uint64_t addr, uint8_t *v) {
+    const mapinfo_type &rom = CFG_BUS0_MAP[CFG_BUS0_XSLV_BOOTROM];
+    const mapinfo_type &sram = CFG_BUS0_MAP[CFG_BUS0_XSLV_SRAM];
+    if (addr >= rom.addr_start && addr < rom.addr_end) {
+        *v = rom0->backdoorRead(addr - rom.addr_start);
+    } else if (addr >= sram.addr_start && addr < sram.addr_end) {
+        *v = sram0->backdoorRead(addr - sram.addr_start);
+    } else {
+        return false;
+    }
+    return true;
+}
+
 void riscv_soc::comb() {
     sc_uint<1> v_gnd1;                                      // 1
     sc_biguint<SOC_PLIC_IRQ_TOTAL> vb_ext_irqs;
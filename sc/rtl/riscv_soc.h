@@ -94,6 +94,11 @@ SC_MODULE(riscv_soc) {
 
     void generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd);
 
+    // Simulation only: access to the internal ROM and SRAM without bus
+    // transactions, returns false if the address isn't mapped on them
+    bool backdoorWrite(uint64_t addr, uint8_t v);
+    bool backdoorRead(uint64_t addr, uint8_t *v);
+
  private:
     std::string bootfile_;
     int sim_uart_speedup_rate_;
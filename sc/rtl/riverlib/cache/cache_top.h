@@ -60,10 +60,10 @@ SC_MODULE(CacheTop) {
     sc_out<sc_uint<3>> o_req_mem_size;                      // request size: 0=1 B;...; 7=128 B
     sc_out<sc_uint<CFG_CPU_ADDR_BITS>> o_req_mem_addr;      // AXI memory request address
     sc_out<sc_uint<L1CACHE_BYTES_PER_LINE>> o_req_mem_strob;// Writing strob. 1 bit per Byte (uncached only)
-    sc_out<sc_biguint<L1CACHE_LINE_BITS>> o_req_mem_data;   // Writing data
+    sc_out<bitvec<L1CACHE_LINE_BITS>> o_req_mem_data;   // Writing data
     sc_in<bool> i_resp_mem_valid;                           // AXI response is valid
     sc_in<bool> i_resp_mem_path;                            // 0=ctrl; 1=data path
-    sc_in<sc_biguint<L1CACHE_LINE_BITS>> i_resp_mem_data;   // Read data
+    sc_in<bitvec<L1CACHE_LINE_BITS>> i_resp_mem_data;   // Read data
     sc_in<bool> i_resp_mem_load_fault;                      // data load error
     sc_in<bool> i_resp_mem_store_fault;                     // data store error
     // PMP interface:
@@ -80,7 +80,7 @@ SC_MODULE(CacheTop) {
     sc_in<sc_uint<CFG_CPU_ADDR_BITS>> i_req_snoop_addr;
     sc_in<bool> i_resp_snoop_ready;
     sc_out<bool> o_resp_snoop_valid;
-    sc_out<sc_biguint<L1CACHE_LINE_BITS>> o_resp_snoop_data;
+    sc_out<bitvec<L1CACHE_LINE_BITS>> o_resp_snoop_data;
     sc_out<sc_uint<DTAG_FL_TOTAL>> o_resp_snoop_flags;
     // Debug signals:
     sc_in<bool> i_flushi_valid;                             // address to clear icache is valid
@@ -126,7 +126,7 @@ SC_MODULE(CacheTop) {
         sc_signal<sc_uint<3>> req_mem_size;
         sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> req_mem_addr;
         sc_signal<sc_uint<L1CACHE_BYTES_PER_LINE>> req_mem_strob;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> req_mem_wdata;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> req_mem_wdata;
         sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> mpu_addr;
         sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> resp_addr;
     };
@@ -140,12 +140,12 @@ SC_MODULE(CacheTop) {
     CacheOutputType d;
     // Memory Control interface:
     sc_signal<bool> w_ctrl_resp_mem_data_valid;
-    sc_signal<sc_biguint<L1CACHE_LINE_BITS>> wb_ctrl_resp_mem_data;
+    sc_signal<bitvec<L1CACHE_LINE_BITS>> wb_ctrl_resp_mem_data;
     sc_signal<bool> w_ctrl_resp_mem_load_fault;
     sc_signal<bool> w_ctrl_req_ready;
     // Memory Data interface:
     sc_signal<bool> w_data_resp_mem_data_valid;
-    sc_signal<sc_biguint<L1CACHE_LINE_BITS>> wb_data_resp_mem_data;
+    sc_signal<bitvec<L1CACHE_LINE_BITS>> wb_data_resp_mem_data;
     sc_signal<bool> w_data_resp_mem_load_fault;
     sc_signal<bool> w_data_req_ready;
     sc_signal<bool> w_pma_icached;
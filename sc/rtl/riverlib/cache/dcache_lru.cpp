@@ -255,11 +255,11 @@ void DCacheLru::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
 }
 
 void DCacheLru::comb() {
-    sc_biguint<L1CACHE_LINE_BITS> vb_cache_line_i_modified;
-    sc_biguint<L1CACHE_LINE_BITS> vb_line_rdata_o_modified;
+    bitvec<L1CACHE_LINE_BITS> vb_cache_line_i_modified;
+    bitvec<L1CACHE_LINE_BITS> vb_line_rdata_o_modified;
     sc_uint<L1CACHE_BYTES_PER_LINE> vb_line_rdata_o_wstrb;
     bool v_req_ready;
-    sc_biguint<L1CACHE_LINE_BITS> t_cache_line_i;
+    bitvec<L1CACHE_LINE_BITS> t_cache_line_i;
     sc_uint<64> vb_cached_data;
     sc_uint<64> vb_uncached_data;
     bool v_resp_valid;
@@ -272,7 +272,7 @@ void DCacheLru::comb() {
     bool v_line_cs_read;
     bool v_line_cs_write;
     sc_uint<CFG_CPU_ADDR_BITS> vb_line_addr;
-    sc_biguint<L1CACHE_LINE_BITS> vb_line_wdata;
+    bitvec<L1CACHE_LINE_BITS> vb_line_wdata;
     sc_uint<L1CACHE_BYTES_PER_LINE> vb_line_wstrb;
     sc_uint<64> vb_req_mask;
     sc_uint<DTAG_FL_TOTAL> v_line_wflags;
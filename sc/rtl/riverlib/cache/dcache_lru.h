@@ -46,9 +46,9 @@ SC_MODULE(DCacheLru) {
     sc_out<sc_uint<3>> o_req_mem_size;
     sc_out<sc_uint<CFG_CPU_ADDR_BITS>> o_req_mem_addr;
     sc_out<sc_uint<L1CACHE_BYTES_PER_LINE>> o_req_mem_strob;
-    sc_out<sc_biguint<L1CACHE_LINE_BITS>> o_req_mem_data;
+    sc_out<bitvec<L1CACHE_LINE_BITS>> o_req_mem_data;
     sc_in<bool> i_mem_data_valid;
-    sc_in<sc_biguint<L1CACHE_LINE_BITS>> i_mem_data;
+    sc_in<bitvec<L1CACHE_LINE_BITS>> i_mem_data;
     sc_in<bool> i_mem_load_fault;
     sc_in<bool> i_mem_store_fault;
     // Mpu interface
@@ -63,7 +63,7 @@ SC_MODULE(DCacheLru) {
     sc_in<sc_uint<CFG_CPU_ADDR_BITS>> i_req_snoop_addr;
     sc_in<bool> i_resp_snoop_ready;
     sc_out<bool> o_resp_snoop_valid;
-    sc_out<sc_biguint<L1CACHE_LINE_BITS>> o_resp_snoop_data;
+    sc_out<bitvec<L1CACHE_LINE_BITS>> o_resp_snoop_data;
     sc_out<sc_uint<DTAG_FL_TOTAL>> o_resp_snoop_flags;
     // Debug interface
     sc_in<sc_uint<CFG_CPU_ADDR_BITS>> i_flush_address;
@@ -135,8 +135,8 @@ SC_MODULE(DCacheLru) {
         sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> req_flush_addr;// [0]=1 flush all
         sc_signal<sc_uint<32>> req_flush_cnt;
         sc_signal<sc_uint<32>> flush_cnt;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> cache_line_i;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> cache_line_o;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> cache_line_i;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> cache_line_o;
         sc_signal<sc_uint<SNOOP_REQ_TYPE_BITS>> req_snoop_type;
         sc_signal<bool> snoop_flags_valid;
         sc_signal<bool> snoop_restore_wait_resp;
@@ -179,11 +179,11 @@ SC_MODULE(DCacheLru) {
     sc_signal<bool> line_re_i;
     sc_signal<bool> line_we_i;
     sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> line_addr_i;
-    sc_signal<sc_biguint<L1CACHE_LINE_BITS>> line_wdata_i;
+    sc_signal<bitvec<L1CACHE_LINE_BITS>> line_wdata_i;
     sc_signal<sc_uint<L1CACHE_BYTES_PER_LINE>> line_wstrb_i;
     sc_signal<sc_uint<DTAG_FL_TOTAL>> line_wflags_i;
     sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> line_raddr_o;
-    sc_signal<sc_biguint<L1CACHE_LINE_BITS>> line_rdata_o;
+    sc_signal<bitvec<L1CACHE_LINE_BITS>> line_rdata_o;
     sc_signal<sc_uint<DTAG_FL_TOTAL>> line_rflags_o;
     sc_signal<bool> line_hit_o;
     // Snoop signals:
@@ -179,7 +179,7 @@ void ICacheLru::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
 }
 
 void ICacheLru::comb() {
-    sc_biguint<L1CACHE_LINE_BITS> t_cache_line_i;
+    bitvec<L1CACHE_LINE_BITS> t_cache_line_i;
     bool v_req_ready;
     bool v_resp_valid;
     sc_uint<64> vb_cached_data;
@@ -191,7 +191,7 @@ void ICacheLru::comb() {
     bool v_line_cs_read;
     bool v_line_cs_write;
     sc_uint<CFG_CPU_ADDR_BITS> vb_line_addr;
-    sc_biguint<L1CACHE_LINE_BITS> vb_line_wdata;
+    bitvec<L1CACHE_LINE_BITS> vb_line_wdata;
     sc_uint<L1CACHE_BYTES_PER_LINE> vb_line_wstrb;
     sc_uint<ITAG_FL_TOTAL> v_line_wflags;
     int sel_cached;
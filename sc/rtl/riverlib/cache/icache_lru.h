@@ -41,9 +41,9 @@ SC_MODULE(ICacheLru) {
     sc_out<sc_uint<3>> o_req_mem_size;
     sc_out<sc_uint<CFG_CPU_ADDR_BITS>> o_req_mem_addr;
     sc_out<sc_uint<L1CACHE_BYTES_PER_LINE>> o_req_mem_strob;// unused
-    sc_out<sc_biguint<L1CACHE_LINE_BITS>> o_req_mem_data;
+    sc_out<bitvec<L1CACHE_LINE_BITS>> o_req_mem_data;
     sc_in<bool> i_mem_data_valid;
-    sc_in<sc_biguint<L1CACHE_LINE_BITS>> i_mem_data;
+    sc_in<bitvec<L1CACHE_LINE_BITS>> i_mem_data;
     sc_in<bool> i_mem_load_fault;
     // Mpu interface
     sc_out<sc_uint<CFG_CPU_ADDR_BITS>> o_mpu_addr;
@@ -107,7 +107,7 @@ SC_MODULE(ICacheLru) {
         sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> req_flush_addr;// [0]=1 flush all
         sc_signal<sc_uint<32>> req_flush_cnt;
         sc_signal<sc_uint<32>> flush_cnt;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> cache_line_i;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> cache_line_i;
     } v, r;
 
     void ICacheLru_r_reset(ICacheLru_registers &iv) {
@@ -133,11 +133,11 @@ SC_MODULE(ICacheLru) {
     sc_signal<bool> line_re_i;
     sc_signal<bool> line_we_i;
     sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> line_addr_i;
-    sc_signal<sc_biguint<L1CACHE_LINE_BITS>> line_wdata_i;
+    sc_signal<bitvec<L1CACHE_LINE_BITS>> line_wdata_i;
     sc_signal<sc_uint<(1 << CFG_LOG2_L1CACHE_BYTES_PER_LINE)>> line_wstrb_i;
     sc_signal<sc_uint<ITAG_FL_TOTAL>> line_wflags_i;
     sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> line_raddr_o;
-    sc_signal<sc_biguint<(L1CACHE_LINE_BITS + 32)>> line_rdata_o;
+    sc_signal<bitvec<(L1CACHE_LINE_BITS + 32)>> line_rdata_o;
     sc_signal<sc_uint<ITAG_FL_TOTAL>> line_rflags_o;
     sc_signal<bool> line_hit_o;
     sc_signal<bool> line_hit_next_o;
@@ -33,10 +33,10 @@ SC_MODULE(TagMem) {
     sc_in<bool> i_nrst;                                     // Reset: active LOW
     sc_in<sc_uint<abus>> i_addr;
     sc_in<sc_uint<(1 << lnbits)>> i_wstrb;
-    sc_in<sc_biguint<(8 * (1 << lnbits))>> i_wdata;
+    sc_in<bitvec<(8 * (1 << lnbits))>> i_wdata;
     sc_in<sc_uint<flbits>> i_wflags;
     sc_out<sc_uint<abus>> o_raddr;
-    sc_out<sc_biguint<(8 * (1 << lnbits))>> o_rdata;
+    sc_out<bitvec<(8 * (1 << lnbits))>> o_rdata;
     sc_out<sc_uint<flbits>> o_rflags;
     sc_out<bool> o_hit;
     // L2 snoop port, active when snoop = 1
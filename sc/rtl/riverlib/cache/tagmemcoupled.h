@@ -35,11 +35,11 @@ SC_MODULE(TagMemCoupled) {
     sc_in<bool> i_re;
     sc_in<bool> i_we;
     sc_in<sc_uint<abus>> i_addr;
-    sc_in<sc_biguint<(8 * (1 << lnbits))>> i_wdata;
+    sc_in<bitvec<(8 * (1 << lnbits))>> i_wdata;
     sc_in<sc_uint<(1 << lnbits)>> i_wstrb;
     sc_in<sc_uint<flbits>> i_wflags;
     sc_out<sc_uint<abus>> o_raddr;
-    sc_out<sc_biguint<((8 * (1 << lnbits)) + 32)>> o_rdata;
+    sc_out<bitvec<((8 * (1 << lnbits)) + 32)>> o_rdata;
     sc_out<sc_uint<flbits>> o_rflags;
     sc_out<bool> o_hit;
     sc_out<bool> o_hit_next;
@@ -68,7 +68,7 @@ SC_MODULE(TagMemCoupled) {
         sc_signal<bool> re;
         sc_signal<bool> we;
         sc_signal<sc_uint<abus>> addr;
-        sc_signal<sc_biguint<(8 * (1 << lnbits))>> wdata;
+        sc_signal<bitvec<(8 * (1 << lnbits))>> wdata;
         sc_signal<sc_uint<(1 << lnbits)>> wstrb;
         sc_signal<sc_uint<flbits>> wflags;
         sc_signal<sc_uint<abus>> snoop_addr;
@@ -76,7 +76,7 @@ SC_MODULE(TagMemCoupled) {
 
     struct tagmem_out_type {
         sc_signal<sc_uint<abus>> raddr;
-        sc_signal<sc_biguint<(8 * (1 << lnbits))>> rdata;
+        sc_signal<bitvec<(8 * (1 << lnbits))>> rdata;
         sc_signal<sc_uint<flbits>> rflags;
         sc_signal<bool> hit;
         sc_signal<bool> snoop_ready;
@@ -203,7 +203,7 @@ void TagMemCoupled<abus, waybits, ibits, lnbits, flbits>::comb() {
     sc_uint<abus> vb_addr_tag_next;
     sc_uint<abus> vb_raddr_tag;
     sc_uint<abus> vb_o_raddr;
-    sc_biguint<((8 * (1 << lnbits)) + 32)> vb_o_rdata;
+    bitvec<((8 * (1 << lnbits)) + 32)> vb_o_rdata;
     bool v_o_hit;
     bool v_o_hit_next;
     sc_uint<flbits> vb_o_rflags;
@@ -37,11 +37,11 @@ SC_MODULE(TagMemNWay) {
     sc_in<bool> i_re;
     sc_in<bool> i_we;
     sc_in<sc_uint<abus>> i_addr;
-    sc_in<sc_biguint<(8 * (1 << lnbits))>> i_wdata;
+    sc_in<bitvec<(8 * (1 << lnbits))>> i_wdata;
     sc_in<sc_uint<(1 << lnbits)>> i_wstrb;
     sc_in<sc_uint<flbits>> i_wflags;
     sc_out<sc_uint<abus>> o_raddr;
-    sc_out<sc_biguint<(8 * (1 << lnbits))>> o_rdata;
+    sc_out<bitvec<(8 * (1 << lnbits))>> o_rdata;
     sc_out<sc_uint<flbits>> o_rflags;
     sc_out<bool> o_hit;
     // L2 snoop port, active when snoop = 1
@@ -69,14 +69,14 @@ SC_MODULE(TagMemNWay) {
     struct WayInType {
         sc_signal<sc_uint<abus>> addr;
         sc_signal<sc_uint<(1 << lnbits)>> wstrb;
-        sc_signal<sc_biguint<(8 * (1 << lnbits))>> wdata;
+        sc_signal<bitvec<(8 * (1 << lnbits))>> wdata;
         sc_signal<sc_uint<flbits>> wflags;
         sc_signal<sc_uint<abus>> snoop_addr;
     };
 
     struct WayOutType {
         sc_signal<sc_uint<abus>> raddr;
-        sc_signal<sc_biguint<(8 * (1 << lnbits))>> rdata;
+        sc_signal<bitvec<(8 * (1 << lnbits))>> rdata;
         sc_signal<sc_uint<flbits>> rflags;
         sc_signal<bool> hit;
         sc_signal<sc_uint<flbits>> snoop_flags;
@@ -265,7 +265,7 @@ void TagMemNWay<abus, waybits, ibits, lnbits, flbits, snoop>::generateVCD(sc_tra
 template<int abus, int waybits, int ibits, int lnbits, int flbits, int snoop>
 void TagMemNWay<abus, waybits, ibits, lnbits, flbits, snoop>::comb() {
     sc_uint<abus> vb_raddr;
-    sc_biguint<(8 * (1 << lnbits))> vb_rdata;
+    bitvec<(8 * (1 << lnbits))> vb_rdata;
     sc_uint<flbits> vb_rflags;
     bool v_hit;
     sc_uint<waybits> vb_hit_idx;
@@ -49,6 +49,7 @@ CsrRegs::CsrRegs(sc_module_name name,
     i_m_idle("i_m_idle"),
     i_flushd_end("i_flushd_end"),
     i_mtimer("i_mtimer"),
+    i_hpm_events("i_hpm_events"),
     o_executed_cnt("o_executed_cnt"),
     o_step("o_step"),
     i_dbg_progbuf_ena("i_dbg_progbuf_ena"),
@@ -94,6 +95,7 @@ CsrRegs::CsrRegs(sc_module_name name,
     sensitive << i_m_idle;
     sensitive << i_flushd_end;
     sensitive << i_mtimer;
+    sensitive << i_hpm_events;
     sensitive << i_dbg_progbuf_ena;
     for (int i = 0; i < 4; i++) {
         sensitive << r.xmode[i].xepc;
@@ -116,6 +118,10 @@ CsrRegs::CsrRegs(sc_module_name name,
         sensitive << r.pmp[i].addr;
         sensitive << r.pmp[i].mask;
     }
+    for (int i = 0; i < CFG_HPM_COUNTERS_TOTAL; i++) {
+        sensitive << r.hpm[i].cnt;
+        sensitive << r.hpm[i].event;
+    }
     sensitive << r.state;
     sensitive << r.fencestate;
     sensitive << r.irq_pending;
@@ -202,6 +208,7 @@ void CsrRegs::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
         sc_trace(o_vcd, i_m_idle, i_m_idle.name());
         sc_trace(o_vcd, i_flushd_end, i_flushd_end.name());
         sc_trace(o_vcd, i_mtimer, i_mtimer.name());
+        sc_trace(o_vcd, i_hpm_events, i_hpm_events.name());
         sc_trace(o_vcd, o_executed_cnt, o_executed_cnt.name());
         sc_trace(o_vcd, o_step, o_step.name());
         sc_trace(o_vcd, i_dbg_progbuf_ena, i_dbg_progbuf_ena.name());
@@ -265,6 +272,13 @@ void CsrRegs::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
             RISCV_sprintf(tstr, sizeof(tstr), "%s.r_pmp%d_mask", pn.c_str(), i);
             sc_trace(o_vcd, r.pmp[i].mask, tstr);
         }
+        for (int i = 0; i < CFG_HPM_COUNTERS_TOTAL; i++) {
+            char tstr[1024];
+            RISCV_sprintf(tstr, sizeof(tstr), "%s.r_hpm%d_cnt", pn.c_str(), i);
+            sc_trace(o_vcd, r.hpm[i].cnt, tstr);
+            RISCV_sprintf(tstr, sizeof(tstr), "%s.r_hpm%d_event", pn.c_str(), i);
+            sc_trace(o_vcd, r.hpm[i].event, tstr);
+        }
         sc_trace(o_vcd, r.state, pn + ".r_state");
         sc_trace(o_vcd, r.fencestate, pn + ".r_fencestate");
         sc_trace(o_vcd, r.irq_pending, pn + ".r_irq_pending");
@@ -358,6 +372,7 @@ void CsrRegs::comb() {
     bool v_napot_shift;
     int t_pmpdataidx;
     int t_pmpcfgidx;
+    int t_hpmidx;
 
     iM = PRV_M;
     iH = PRV_H;
@@ -394,6 +409,7 @@ void CsrRegs::comb() {
     v_napot_shift = 0;
     t_pmpdataidx = 0;
     t_pmpcfgidx = 0;
+    t_hpmidx = 0;
 
     for (int i = 0; i < 4; i++) {
         v.xmode[i].xepc = r.xmode[i].xepc;
@@ -416,6 +432,10 @@ void CsrRegs::comb() {
         v.pmp[i].addr = r.pmp[i].addr;
         v.pmp[i].mask = r.pmp[i].mask;
     }
+    for (int i = 0; i < CFG_HPM_COUNTERS_TOTAL; i++) {
+        v.hpm[i].cnt = r.hpm[i].cnt;
+        v.hpm[i].event = r.hpm[i].event;
+    }
     v.state = r.state;
     v.fencestate = r.fencestate;
     v.irq_pending = r.irq_pending;
@@ -474,6 +494,7 @@ void CsrRegs::comb() {
     vb_pmp_upd_ena = r.pmp_upd_ena;
     t_pmpdataidx = (r.cmd_addr.read().to_int() - 0x3B0);
     t_pmpcfgidx = (8 * r.cmd_addr.read()(3, 1).to_int());
+    t_hpmidx = (r.cmd_addr.read()(4, 0).to_int() - 3);
     vb_pmp_napot_mask = 0x7;
 
     vb_xtvec_off_edeleg = r.xmode[iM].xtvec_off;
@@ -1041,7 +1062,7 @@ void CsrRegs::comb() {
                 v.pmp[t_pmpdataidx].mask = vb_pmp_napot_mask;
             }
         }
-    } else if (r.cmd_addr.read() <= 0x3EF) {                // pmpaddr63: [MRW] Physical memory protection address register
+    } else if (r.cmd_addr.read() == 0x3EF) {                // pmpaddr63: [MRW] Physical memory protection address register
     } else if (r.cmd_addr.read() == 0xB00) {                // mcycle: [MRW] Machine cycle counter
         vb_rdata = r.mcycle_cnt;
         if (v_csr_wena) {
@@ -1057,9 +1078,24 @@ void CsrRegs::comb() {
         if (v_csr_wena == 1) {
             v.mcountinhibit = r.cmd_data.read()(15, 0);
         }
-    } else if (r.cmd_addr.read() == 0x323) {                // mpevent3: [MRW] Machine performance-monitoring event selector
-    } else if (r.cmd_addr.read() == 0x324) {                // mpevent4: [MRW] Machine performance-monitoring event selector
-    } else if (r.cmd_addr.read() == 0x33F) {                // mpevent31: [MRW] Machine performance-monitoring event selector
+    } else if ((r.cmd_addr.read() >= 0xB03)
+                && (r.cmd_addr.read() <= 0xB1F)) {
+        // mhpmcounter3..31: [MRW] Machine performance-monitoring counter
+        if (t_hpmidx < CFG_HPM_COUNTERS_TOTAL) {
+            vb_rdata = r.hpm[t_hpmidx].cnt;
+            if (v_csr_wena == 1) {
+                v.hpm[t_hpmidx].cnt = r.cmd_data;
+            }
+        }
+    } else if ((r.cmd_addr.read() >= 0x323)
+                && (r.cmd_addr.read() <= 0x33F)) {
+        // mhpmevent3..31: [MRW] Machine performance-monitoring event selector
+        if (t_hpmidx < CFG_HPM_COUNTERS_TOTAL) {
+            vb_rdata(7, 0) = r.hpm[t_hpmidx].event;
+            if ((v_csr_wena == 1) && (r.cmd_data.read() <= HpmEvent_Total)) {
+                v.hpm[t_hpmidx].event = r.cmd_data.read()(7, 0);
+            }
+        }
     } else if (r.cmd_addr.read() == 0x7A0) {                // tselect: [MRW] Debug/Trace trigger register select
     } else if (r.cmd_addr.read() == 0x7A1) {                // tdata1: [MRW] First Debug/Trace trigger data register
     } else if (r.cmd_addr.read() == 0x7A2) {                // tdata2: [MRW] Second Debug/Trace trigger data register
@@ -1274,6 +1310,15 @@ void CsrRegs::comb() {
             && (r.mcountinhibit.read()[2] == 0)) {
         v.minstret_cnt = (r.minstret_cnt.read() + 1);
     }
+    for (int i = 0; i < CFG_HPM_COUNTERS_TOTAL; i++) {
+        if ((r.hpm[i].event.read() != 0)
+                && (i_hpm_events.read()[(r.hpm[i].event.read().to_int() - 1)] == 1)
+                && (i_e_halted.read() == 0)
+                && (r.dcsr_stopcount.read() == 0)
+                && (r.mcountinhibit.read()[(3 + i)] == 0)) {
+            v.hpm[i].cnt = (r.hpm[i].cnt.read() + 1);
+        }
+    }
 
     if (!async_reset_ && i_nrst.read() == 0) {
         for (int i = 0; i < 4; i++) {
@@ -1297,6 +1342,10 @@ void CsrRegs::comb() {
             v.pmp[i].addr = 0ull;
             v.pmp[i].mask = 0ull;
         }
+        for (int i = 0; i < CFG_HPM_COUNTERS_TOTAL; i++) {
+            v.hpm[i].cnt = 0ull;
+            v.hpm[i].event = 0;
+        }
         v.state = State_Idle;
         v.fencestate = Fence_None;
         v.irq_pending = 0;
@@ -1407,6 +1456,10 @@ void CsrRegs::registers() {
             r.pmp[i].addr = 0ull;
             r.pmp[i].mask = 0ull;
         }
+        for (int i = 0; i < CFG_HPM_COUNTERS_TOTAL; i++) {
+            r.hpm[i].cnt = 0ull;
+            r.hpm[i].event = 0;
+        }
         r.state = State_Idle;
         r.fencestate = Fence_None;
         r.irq_pending = 0;
@@ -1482,6 +1535,10 @@ void CsrRegs::registers() {
             r.pmp[i].addr = v.pmp[i].addr;
             r.pmp[i].mask = v.pmp[i].mask;
         }
+        for (int i = 0; i < CFG_HPM_COUNTERS_TOTAL; i++) {
+            r.hpm[i].cnt = v.hpm[i].cnt;
+            r.hpm[i].event = v.hpm[i].event;
+        }
         r.state = v.state;
         r.fencestate = v.fencestate;
         r.irq_pending = v.irq_pending;
@@ -46,7 +46,7 @@ SC_MODULE(DbgPort) {
     sc_out<bool> o_csr_resp_ready;
     sc_in<sc_uint<RISCV_ARCH>> i_csr_resp_data;             // Region 0: CSR read value
     sc_in<bool> i_csr_resp_exception;                       // Exception on CSR access
-    sc_in<sc_biguint<(32 * CFG_PROGBUF_REG_TOTAL)>> i_progbuf;// progam buffer
+    sc_in<bitvec<(32 * CFG_PROGBUF_REG_TOTAL)>> i_progbuf;// progam buffer
     sc_out<bool> o_progbuf_ena;                             // Execution from the progbuffer is in progress
     sc_out<sc_uint<RISCV_ARCH>> o_progbuf_pc;               // prog buffer instruction counter
     sc_out<sc_uint<64>> o_progbuf_instr;                    // prog buffer instruction opcode
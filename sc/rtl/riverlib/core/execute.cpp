@@ -106,7 +106,8 @@ InstrExecute::InstrExecute(sc_module_name name,
     o_call("o_call"),
     o_ret("o_ret"),
     o_jmp("o_jmp"),
-    o_halted("o_halted") {
+    o_halted("o_halted"),
+    o_hpm_events("o_hpm_events") {
 
     async_reset_ = async_reset;
     fpu_ena_ = fpu_ena;
@@ -446,6 +447,7 @@ void InstrExecute::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
         sc_trace(o_vcd, o_ret, o_ret.name());
         sc_trace(o_vcd, o_jmp, o_jmp.name());
         sc_trace(o_vcd, o_halted, o_halted.name());
+        sc_trace(o_vcd, o_hpm_events, o_hpm_events.name());
         sc_trace(o_vcd, r.state, pn + ".r_state");
         sc_trace(o_vcd, r.csrstate, pn + ".r_csrstate");
         sc_trace(o_vcd, r.amostate, pn + ".r_amostate");
@@ -594,6 +596,7 @@ void InstrExecute::comb() {
     bool v_dbg_mem_req_error;
     bool v_halted;
     bool v_idle;
+    sc_uint<HpmEvent_Total> vb_hpm_events;
     input_mux_type mux;
     sc_uint<RISCV_ARCH> vb_o_npc;
     int t_radr1;
@@ -653,6 +656,7 @@ void InstrExecute::comb() {
     v_dbg_mem_req_error = 0;
     v_halted = 0;
     v_idle = 0;
+    vb_hpm_events = 0;
     mux.radr1 = 0;
     mux.radr2 = 0;
     mux.waddr = 0;
@@ -1195,7 +1199,18 @@ void InstrExecute::comb() {
     case State_Idle:
         if ((r.memop_valid.read() == 1) && (i_memop_ready.read() == 0)) {
             // Do nothing, previous memaccess request wasn't accepted. queue is full.
-        } else if ((v_d_valid == 1) && (w_hazard1.read() == 0) && (w_hazard2.read() == 0)) {
+            vb_hpm_events[HpmEvent_StallMemQueue] = 1;
+        } else if (v_d_valid == 0) {
+            // Decoder still holds the last executed instruction: fetcher is late.
+            // Otherwise it provides instruction from the mispredicted path.
+            if (i_d_pc.read() == r.pc.read()) {
+                vb_hpm_events[HpmEvent_StallFetch] = 1;
+            } else {
+                vb_hpm_events[HpmEvent_BranchMispredict] = 1;
+            }
+        } else if ((w_hazard1.read() == 1) || (w_hazard2.read() == 1)) {
+            vb_hpm_events[HpmEvent_StallHazard] = 1;
+        } else {
             v_latch_input = 1;
             // opencocd doesn't clear 'step' value in dcsr after step has been done
             v.stepdone = (i_step && (!i_dbg_progbuf_ena));
@@ -1381,6 +1396,11 @@ void InstrExecute::comb() {
         break;
     case State_WaitMulti:
         // Wait end of multiclock instructions
+        if (r.select.read()[Res_FPU] == 1) {
+            vb_hpm_events[HpmEvent_StallFpu] = 1;
+        } else {
+            vb_hpm_events[HpmEvent_StallMulticycle] = 1;
+        }
         if ((wb_select[Res_IMul].valid
                 || wb_select[Res_IDiv].valid
                 || wb_select[Res_FPU].valid) == 1) {
@@ -1630,6 +1650,7 @@ void InstrExecute::comb() {
     o_ret = r.ret;
     o_jmp = r.jmp;
     o_halted = v_halted;
+    o_hpm_events = vb_hpm_events;
 
     // Debug rtl only:!!
     for (int i = 0; i < INTREGS_TOTAL; i++) {
@@ -112,6 +112,7 @@ SC_MODULE(InstrExecute) {
     sc_out<bool> o_ret;                                     // RET pseudoinstruction detected (hw stack tracing)
     sc_out<bool> o_jmp;                                     // Jump was executed
     sc_out<bool> o_halted;
+    sc_out<sc_uint<HpmEvent_Total>> o_hpm_events;           // Performance-monitoring events: stalls and mispredicts
 
     void comb();
     void registers();
@@ -76,7 +76,8 @@ Processor::Processor(sc_module_name name,
     o_flushi_addr("o_flushi_addr"),
     o_flushd_valid("o_flushd_valid"),
     o_flushd_addr("o_flushd_addr"),
-    i_flushd_end("i_flushd_end") {
+    i_flushd_end("i_flushd_end"),
+    i_hpm_cache_events("i_hpm_cache_events") {
 
     async_reset_ = async_reset;
     hartid_ = hartid;
@@ -286,6 +287,7 @@ Processor::Processor(sc_module_name name,
     exec0->o_ret(w.e.ret);
     exec0->o_jmp(w.e.jmp);
     exec0->o_halted(w.e.halted);
+    exec0->o_hpm_events(w.e.hpm_events);
 
 
     mem0 = new MemAccess("mem0", async_reset);
@@ -510,6 +512,7 @@ Processor::Processor(sc_module_name name,
     csr0->i_m_idle(w.m.idle);
     csr0->i_flushd_end(i_flushd_end);
     csr0->i_mtimer(i_mtimer);
+    csr0->i_hpm_events(wb_hpm_events);
     csr0->o_executed_cnt(csr.executed_cnt);
     csr0->o_step(csr.step);
     csr0->i_dbg_progbuf_ena(dbg.progbuf_ena);
@@ -643,6 +646,7 @@ Processor::Processor(sc_module_name name,
     sensitive << i_dport_resp_ready;
     sensitive << i_progbuf;
     sensitive << i_flushd_end;
+    sensitive << i_hpm_cache_events;
     sensitive << w.f.instr_load_fault;
     sensitive << w.f.instr_page_fault_x;
     sensitive << w.f.requested_pc;
@@ -700,6 +704,7 @@ Processor::Processor(sc_module_name name,
     sensitive << w.e.ret;
     sensitive << w.e.jmp;
     sensitive << w.e.halted;
+    sensitive << w.e.hpm_events;
     sensitive << w.e.dbg_mem_req_ready;
     sensitive << w.e.dbg_mem_req_error;
     sensitive << w.m.memop_ready;
@@ -853,6 +858,7 @@ Processor::Processor(sc_module_name name,
     sensitive << unused_immu_core_req_wstrb;
     sensitive << unused_immu_core_req_size;
     sensitive << unused_immu_mem_resp_store_fault;
+    sensitive << wb_hpm_events;
 }
 
 Processor::~Processor() {
@@ -944,6 +950,7 @@ void Processor::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
         sc_trace(o_vcd, o_flushd_valid, o_flushd_valid.name());
         sc_trace(o_vcd, o_flushd_addr, o_flushd_addr.name());
         sc_trace(o_vcd, i_flushd_end, i_flushd_end.name());
+        sc_trace(o_vcd, i_hpm_cache_events, i_hpm_cache_events.name());
     }
 
     if (fetch0) {
@@ -1013,6 +1020,7 @@ void Processor::comb() {
     o_flushd_addr = ~0ull;
     o_flushd_valid = w.m.flushd;
     o_halted = w.e.halted;
+    wb_hpm_events = (w.e.hpm_events.read() | i_hpm_cache_events.read());
 }
 
 }  // namespace debugger
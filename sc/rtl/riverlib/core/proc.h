@@ -81,7 +81,7 @@ SC_MODULE(Processor) {
     sc_out<bool> o_dport_resp_valid;                        // Response is valid
     sc_out<bool> o_dport_resp_error;                        // Something wrong during command execution
     sc_out<sc_uint<RISCV_ARCH>> o_dport_rdata;              // Response value
-    sc_in<sc_biguint<(32 * CFG_PROGBUF_REG_TOTAL)>> i_progbuf;// progam buffer
+    sc_in<bitvec<(32 * CFG_PROGBUF_REG_TOTAL)>> i_progbuf;// progam buffer
     sc_out<bool> o_halted;                                  // CPU halted via debug interface
     // Cache debug signals:
     sc_out<bool> o_flushi_valid;                            // Remove address from ICache is valid
@@ -89,6 +89,7 @@ SC_MODULE(Processor) {
     sc_out<bool> o_flushd_valid;                            // Remove address from D$ is valid
     sc_out<sc_uint<RISCV_ARCH>> o_flushd_addr;              // Address of instruction to remove from D$
     sc_in<bool> i_flushd_end;
+    sc_in<sc_uint<HpmEvent_Total>> i_hpm_cache_events;      // Performance-monitoring events from L1 caches
 
     void comb();
 
@@ -185,6 +186,7 @@ SC_MODULE(Processor) {
         sc_signal<bool> ret;                                // pseudo-instruction RET
         sc_signal<bool> jmp;                                // jump was executed
         sc_signal<bool> halted;
+        sc_signal<sc_uint<HpmEvent_Total>> hpm_events;      // stalls and mispredicts
         sc_signal<bool> dbg_mem_req_ready;
         sc_signal<bool> dbg_mem_req_error;
     };
@@ -359,6 +361,7 @@ SC_MODULE(Processor) {
     sc_signal<sc_uint<8>> unused_immu_core_req_wstrb;
     sc_signal<sc_uint<2>> unused_immu_core_req_size;
     sc_signal<bool> unused_immu_mem_resp_store_fault;
+    sc_signal<sc_uint<HpmEvent_Total>> wb_hpm_events;       // all performance-monitoring events
 
     InstrFetch *fetch0;
     InstrDecoder *dec0;
@@ -16,6 +16,8 @@
 
 #include "tracer.h"
 #include "api_core.h"
+#include "iservice.h"
+#include <string.h>
 
 namespace debugger {
 
@@ -119,11 +121,24 @@ Tracer::Tracer(sc_module_name name,
     trace_file_ = trace_file;
     // initial
     char tstr[256];
-    RISCV_sprintf(tstr, sizeof(tstr), "%s%d.log",
-            trace_file_.c_str(),
-            hartid_);
-    trfilename = std::string(tstr);
-    fl = fopen(trfilename.c_str(), "wb");
+    fl = 0;
+    binwr = 0;
+    iretire = 0;
+    iretire_checked = false;
+    if (CFG_TRACER_BINARY) {
+        RISCV_sprintf(tstr, sizeof(tstr), "%s%d.bin",
+                trace_file_.c_str(),
+                hartid_);
+        trfilename = std::string(tstr);
+        binwr = new TraceBinWriter();
+        binwr->open(trfilename.c_str());
+    } else {
+        RISCV_sprintf(tstr, sizeof(tstr), "%s%d.log",
+                trace_file_.c_str(),
+                hartid_);
+        trfilename = std::string(tstr);
+        fl = fopen(trfilename.c_str(), "wb");
+    }
 
     // end initial
 
@@ -183,6 +198,15 @@ Tracer::Tracer(sc_module_name name,
     sensitive << i_clk.pos();
 }
 
+Tracer::~Tracer() {
+    if (binwr) {
+        delete binwr;
+    }
+    if (fl) {
+        fclose(fl);
+    }
+}
+
 void Tracer::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
     std::string pn(name());
     if (o_vcd) {
@@ -1258,6 +1282,34 @@ std::string Tracer::TraceOutput(sc_uint<TRACE_TBL_ABITS> rcnt) {
     return ostr;
 }
 
+void Tracer::TraceOutputBin(sc_uint<TRACE_TBL_ABITS> rcnt, TraceBinRecordType *rec) {
+    int ircnt = rcnt.to_int();
+
+    memset(rec, 0, sizeof(TraceBinRecordType));
+    rec->step_cnt = r.trace_tbl[ircnt].exec_cnt.read().to_uint64();
+    rec->pc = r.trace_tbl[ircnt].pc.read().to_uint64();
+    rec->instr = r.trace_tbl[ircnt].instr.read().to_uint();
+
+    for (int i = 0; i < r.trace_tbl[ircnt].memactioncnt.read().to_int(); i++) {
+        if (r.trace_tbl[ircnt].memaction[i].ignored.read() == 0
+            && rec->memcnt < TRACE_BIN_MEM_MAX) {
+            TraceBinMemType *m = &rec->mem[rec->memcnt++];
+            m->addr = r.trace_tbl[ircnt].memaction[i].memaddr.read().to_uint64();
+            m->data = r.trace_tbl[ircnt].memaction[i].data.read().to_uint64();
+            m->store = r.trace_tbl[ircnt].memaction[i].store.read();
+            m->size = 1u << r.trace_tbl[ircnt].memaction[i].size.read().to_uint();
+        }
+    }
+
+    for (int i = 0; i < r.trace_tbl[ircnt].regactioncnt.read().to_int(); i++) {
+        if (rec->regcnt < TRACE_BIN_REG_MAX) {
+            TraceBinRegType *g = &rec->reg[rec->regcnt++];
+            g->addr = r.trace_tbl[ircnt].regaction[i].waddr.read().to_uint();
+            g->data = r.trace_tbl[ircnt].regaction[i].wres.read().to_uint64();
+        }
+    }
+}
+
 void Tracer::comb() {
     int wcnt;
     int xcnt;
@@ -1283,6 +1335,19 @@ void Tracer::comb() {
     entry_valid = 0;
     rcnt_inc = 0;
 
+    if (!iretire_checked) {
+        // Services are created after the constructor, search on first call.
+        // The listener keeps a separate queue per hart: (src, hartid_).
+        AttributeType lstServ;
+        RISCV_get_services_with_iface(IFACE_RETIRE_LISTENER, &lstServ);
+        if (lstServ.size() != 0) {
+            IService *iserv = static_cast<IService *>(lstServ[0u].to_iface());
+            iretire = static_cast<IRetireListener *>(
+                            iserv->getInterface(IFACE_RETIRE_LISTENER));
+        }
+        iretire_checked = true;
+    }
+
     for (int i = 0; i < TRACE_TBL_SZ; i++) {
         v.trace_tbl[i].exec_cnt = r.trace_tbl[i].exec_cnt;
         v.trace_tbl[i].pc = r.trace_tbl[i].pc;
@@ -1401,6 +1466,7 @@ void Tracer::comb() {
     entry_valid = 1;
     rcnt_inc = r.tr_rcnt;
     outstr = "";
+    outrec.clear();
     while ((entry_valid == 1) && (rcnt_inc != r.tr_wcnt.read())) {
         for (int i = 0; i < r.trace_tbl[rcnt_inc].memactioncnt.read().to_int(); i++) {
             if (r.trace_tbl[rcnt_inc].memaction[i].complete == 0) {
@@ -1408,8 +1474,14 @@ void Tracer::comb() {
             }
         }
         if (entry_valid == 1) {
-            tracestr = TraceOutput(rcnt_inc);
-            outstr += tracestr;
+            if (binwr || iretire) {
+                outrec.resize(outrec.size() + 1);
+                TraceOutputBin(rcnt_inc, &outrec.back());
+            }
+            if (fl) {
+                tracestr = TraceOutput(rcnt_inc);
+                outstr += tracestr;
+            }
             rcnt_inc = (rcnt_inc + 1);
         }
     }
@@ -1509,6 +1581,15 @@ void Tracer::registers() {
         fwrite(outstr.c_str(), 1, outstr.size(), fl);
     }
     outstr = "";
+    for (size_t i = 0; i < outrec.size(); i++) {
+        if (binwr) {
+            binwr->write(&outrec[i]);
+        }
+        if (iretire) {
+            iretire->retired(RetireSrc_Dut, hartid_, &outrec[i]);
+        }
+    }
+    outrec.clear();
 }
 
 }  // namespace debugger
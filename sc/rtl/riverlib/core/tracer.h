@@ -17,7 +17,10 @@
 
 #include <systemc.h>
 #include <string>
+#include <vector>
 #include "../river_cfg.h"
+#include "generic/trace_bin.h"
+#include "coreservices/iretire.h"
 
 namespace debugger {
 
@@ -55,6 +58,7 @@ SC_MODULE(Tracer) {
            bool async_reset,
            uint32_t hartid,
            std::string trace_file);
+    virtual ~Tracer();
 
     void generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd);
 
@@ -68,6 +72,7 @@ SC_MODULE(Tracer) {
 
     std::string TaskDisassembler(sc_uint<32> instr);
     std::string TraceOutput(sc_uint<TRACE_TBL_ABITS> rcnt);
+    void TraceOutputBin(sc_uint<TRACE_TBL_ABITS> rcnt, TraceBinRecordType *rec);
 
     struct MemopActionType {
         sc_signal<bool> store;                              // 0=load;1=store
@@ -110,6 +115,10 @@ SC_MODULE(Tracer) {
     std::string outstr;
     std::string tracestr;
     FILE *fl;
+    TraceBinWriter *binwr;                                  // binary sink with the background writer
+    std::vector<TraceBinRecordType> outrec;
+    IRetireListener *iretire;                               // lockstep comparator if any
+    bool iretire_checked;
 
 
 };
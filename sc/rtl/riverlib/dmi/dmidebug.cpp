@@ -268,7 +268,7 @@ void dmidebug::comb() {
     bool v_cdc_dmi_req_ready;
     sc_uint<64> vb_arg1;
     sc_uint<32> t_command;
-    sc_biguint<(32 * CFG_PROGBUF_REG_TOTAL)> t_progbuf;
+    bitvec<(32 * CFG_PROGBUF_REG_TOTAL)> t_progbuf;
     int t_idx;
 
     vcfg = dev_config_none;
@@ -57,7 +57,7 @@ SC_MODULE(dmidebug) {
     sc_in<bool> i_dport_resp_valid;                         // Response is valid
     sc_in<bool> i_dport_resp_error;                         // Something goes wrong
     sc_in<sc_uint<RISCV_ARCH>> i_dport_rdata;               // Response value or error code
-    sc_out<sc_biguint<(32 * CFG_PROGBUF_REG_TOTAL)>> o_progbuf;
+    sc_out<bitvec<(32 * CFG_PROGBUF_REG_TOTAL)>> o_progbuf;
 
     void comb();
     void registers();
@@ -129,7 +129,7 @@ SC_MODULE(dmidebug) {
         sc_signal<sc_uint<32>> data1;
         sc_signal<sc_uint<32>> data2;
         sc_signal<sc_uint<32>> data3;
-        sc_signal<sc_biguint<(32 * CFG_PROGBUF_REG_TOTAL)>> progbuf_data;
+        sc_signal<bitvec<(32 * CFG_PROGBUF_REG_TOTAL)>> progbuf_data;
         sc_signal<bool> dport_req_valid;
         sc_signal<sc_uint<RISCV_ARCH>> dport_addr;
         sc_signal<sc_uint<RISCV_ARCH>> dport_wdata;
@@ -86,7 +86,7 @@ void ic_axi4_to_l1::comb() {
     sc_uint<(CFG_LOG2_L1CACHE_BYTES_PER_LINE - 3)> idx;     // request always 64 bits
     sc_uint<XSIZE_TOTAL> vb_req_xbytes;
     sc_uint<64> vb_req_mask;
-    sc_biguint<L1CACHE_LINE_BITS> vb_r_data_modified;
+    bitvec<L1CACHE_LINE_BITS> vb_r_data_modified;
     sc_uint<L1CACHE_BYTES_PER_LINE> vb_line_wstrb;
     sc_uint<64> vb_resp_data;
     sc_uint<CFG_SYSBUS_ADDR_BITS> t_req_addr;
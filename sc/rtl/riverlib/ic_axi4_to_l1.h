@@ -68,7 +68,7 @@ SC_MODULE(ic_axi4_to_l1) {
         sc_signal<sc_uint<3>> req_prot;
         sc_signal<bool> writing;
         sc_signal<bool> read_modify_write;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> line_data;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> line_data;
         sc_signal<sc_uint<L1CACHE_BYTES_PER_LINE>> line_wstrb;
         sc_signal<sc_uint<64>> resp_data;
     } v, r;
@@ -33,8 +33,8 @@ SC_MODULE(L2Amba) {
     sc_in<sc_uint<3>> i_req_prot;
     sc_in<sc_uint<CFG_CPU_ADDR_BITS>> i_req_addr;
     sc_in<sc_uint<L2CACHE_BYTES_PER_LINE>> i_req_strob;
-    sc_in<sc_biguint<L2CACHE_LINE_BITS>> i_req_data;
-    sc_out<sc_biguint<L2CACHE_LINE_BITS>> o_resp_data;
+    sc_in<bitvec<L2CACHE_LINE_BITS>> i_req_data;
+    sc_out<bitvec<L2CACHE_LINE_BITS>> o_resp_data;
     sc_out<bool> o_resp_valid;
     sc_out<bool> o_resp_ack;
     sc_out<bool> o_resp_load_fault;
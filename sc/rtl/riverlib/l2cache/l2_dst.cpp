@@ -16,6 +16,7 @@
 
 #include "l2_dst.h"
 #include "api_core.h"
+#include <string.h>
 
 namespace debugger {
 
@@ -39,6 +40,22 @@ L2Destination::L2Destination(sc_module_name name,
     o_req_wstrb("o_req_wstrb") {
 
     async_reset_ = async_reset;
+    sf0 = 0;
+    clearSnoopStat();
+
+    // generate
+    if (CFG_L2_SNOOP_FILTER_ENABLE) {
+        sf0 = new ram_tech<CFG_L2_SNOOP_FILTER_LOG2_SIZE,
+                           SF_ENTRY_BITS>("sf0");
+        sf0->i_clk(i_clk);
+        sf0->i_addr(wb_sf_addr);
+        sf0->i_wena(w_sf_wena);
+        sf0->i_wdata(wb_sf_wdata);
+        sf0->o_rdata(wb_sf_rdata);
+    } else {
+        wb_sf_rdata = 0;
+    }
+    // endgenerate
 
     SC_METHOD(comb);
     sensitive << i_nrst;
@@ -61,10 +78,24 @@ L2Destination::L2Destination(sc_module_name name,
     sensitive << r.ac_valid;
     sensitive << r.cr_ready;
     sensitive << r.cd_ready;
+    sensitive << wb_sf_rdata;
 
     SC_METHOD(registers);
     sensitive << i_nrst;
     sensitive << i_clk.pos();
+
+    SC_METHOD(snoopStat);
+    sensitive << i_clk.pos();
+}
+
+L2Destination::~L2Destination() {
+    if (sf0) {
+        delete sf0;
+    }
+}
+
+void L2Destination::clearSnoopStat() {
+    memset(stat_, 0, sizeof(stat_));
 }
 
 void L2Destination::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
@@ -93,6 +124,9 @@ void L2Destination::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
         sc_trace(o_vcd, r.ac_valid, pn + ".r_ac_valid");
         sc_trace(o_vcd, r.cr_ready, pn + ".r_cr_ready");
         sc_trace(o_vcd, r.cd_ready, pn + ".r_cd_ready");
+        sc_trace(o_vcd, wb_sf_addr, pn + ".wb_sf_addr");
+        sc_trace(o_vcd, w_sf_wena, pn + ".w_sf_wena");
+        sc_trace(o_vcd, wb_sf_rdata, pn + ".wb_sf_rdata");
     }
 
 }
@@ -110,6 +144,13 @@ void L2Destination::comb() {
     sc_uint<3> vb_srcid;
     bool v_req_valid;
     sc_uint<L2_REQ_TYPE_BITS> vb_req_type;
+    sc_uint<CFG_L2_SNOOP_FILTER_LOG2_SIZE> vb_sf_addr;
+    bool v_sf_wena;
+    sc_uint<SF_ENTRY_BITS> vb_sf_wdata;
+    bool v_sf_hit;
+    bool v_sf_lossy;
+    sc_uint<CFG_SLOT_L1_TOTAL> vb_sf_sharers;
+    sc_uint<CFG_SLOT_L1_TOTAL> vb_sf_src;
 
     for (int i = 0; i < (CFG_SLOT_L1_TOTAL + 1); i++) {
         vcoreo[i] = axi4_l1_out_none;
@@ -127,6 +168,13 @@ void L2Destination::comb() {
     vb_srcid = 0;
     v_req_valid = 0;
     vb_req_type = 0;
+    vb_sf_addr = 0;
+    v_sf_wena = 0;
+    vb_sf_wdata = 0;
+    v_sf_hit = 0;
+    v_sf_lossy = 0;
+    vb_sf_sharers = 0;
+    vb_sf_src = 0;
 
     v = r;
 
@@ -166,6 +214,9 @@ void L2Destination::comb() {
     vb_broadband_mask = vb_broadband_mask_full;
     vb_broadband_mask[vb_srcid.to_int()] = 0;               // exclude source
 
+    // Snoop filter entry of the current request
+    vb_sf_addr = r.req_addr.read()((SF_TAG_ADDR_OFF - 1), SF_INDEX_OFF);
+
     switch (r.state.read()) {
     case Idle:
         vb_req_type = 0;
@@ -178,6 +229,7 @@ void L2Destination::comb() {
             v.req_addr = vcoreo[vb_srcid.to_int()].aw_bits.addr;
             v.req_size = vcoreo[vb_srcid.to_int()].aw_bits.size;
             v.req_prot = vcoreo[vb_srcid.to_int()].aw_bits.prot;
+            vb_sf_addr = vcoreo[vb_srcid.to_int()].aw_bits.addr((SF_TAG_ADDR_OFF - 1), SF_INDEX_OFF);
             vb_req_type[L2_REQ_TYPE_WRITE] = 1;
             if (vcoreo[vb_srcid.to_int()].aw_bits.cache[0] == 1) {
                 vb_req_type[L2_REQ_TYPE_CACHED] = 1;
@@ -186,7 +238,11 @@ void L2Destination::comb() {
                     v.ac_valid = vb_broadband_mask;
                     v.cr_ready = 0;
                     v.cd_ready = 0;
-                    v.state = snoop_ac;
+                    if (CFG_L2_SNOOP_FILTER_ENABLE) {
+                        v.state = SnoopFilter;
+                    } else {
+                        v.state = snoop_ac;
+                    }
                 }
             }
         } else if (vb_src_ar.or_reduce() == 1) {
@@ -197,6 +253,7 @@ void L2Destination::comb() {
             v.req_addr = vcoreo[vb_srcid.to_int()].ar_bits.addr;
             v.req_size = vcoreo[vb_srcid.to_int()].ar_bits.size;
             v.req_prot = vcoreo[vb_srcid.to_int()].ar_bits.prot;
+            vb_sf_addr = vcoreo[vb_srcid.to_int()].ar_bits.addr((SF_TAG_ADDR_OFF - 1), SF_INDEX_OFF);
             if (vcoreo[vb_srcid.to_int()].ar_bits.cache[0] == 1) {
                 vb_req_type[L2_REQ_TYPE_CACHED] = 1;
                 if (vcoreo[vb_srcid.to_int()].ar_snoop == ARSNOOP_READ_MAKE_UNIQUE) {
@@ -211,7 +268,11 @@ void L2Destination::comb() {
                 }
                 v.cr_ready = 0;
                 v.cd_ready = 0;
-                v.state = snoop_ac;
+                if (CFG_L2_SNOOP_FILTER_ENABLE) {
+                    v.state = SnoopFilter;
+                } else {
+                    v.state = snoop_ac;
+                }
             }
         }
         v.req_type = vb_req_type;
@@ -259,6 +320,54 @@ void L2Destination::comb() {
             v.state = Idle;                                 // Wouldn't implement wait to accept because L1 is always ready
         }
         break;
+    case SnoopFilter:
+        // Entry was read in Idle state. Miss of the not lossy entry means
+        // that the line isn't in any L1, lossy miss is unknown: broadcast.
+        vb_sf_src[r.srcid.read().to_int()] = 1;
+        v_sf_lossy = wb_sf_rdata.read()[SF_FL_LOSSY];
+        vb_sf_sharers = wb_sf_rdata.read()((SF_TAG_OFF - 1), SF_SHARERS_OFF);
+        if ((wb_sf_rdata.read()[SF_FL_VALID] == 1)
+                && (wb_sf_rdata.read()((SF_ENTRY_BITS - 1), SF_TAG_OFF)
+                        == r.req_addr.read()((CFG_CPU_ADDR_BITS - 1), SF_TAG_ADDR_OFF))) {
+            v_sf_hit = 1;
+        }
+
+        if (v_sf_hit == 1) {
+            vb_ac_valid = (r.ac_valid.read() & vb_sf_sharers);
+        } else if (v_sf_lossy == 0) {
+            vb_ac_valid = 0;
+            vb_sf_sharers = 0;
+        } else {
+            vb_ac_valid = r.ac_valid;
+            vb_sf_sharers = ~0ull;
+        }
+        if ((v_sf_hit == 0)
+                && (wb_sf_rdata.read()[SF_FL_VALID] == 1)
+                && (wb_sf_rdata.read()((SF_TAG_OFF - 1), SF_SHARERS_OFF).or_reduce() == 1)) {
+            // Replaced line could stay in L1 without entry
+            v_sf_lossy = 1;
+        }
+        if (r.req_type.read()[L2_REQ_TYPE_UNIQUE] == 1) {
+            vb_sf_sharers = vb_sf_src;                      // others are invalidated
+        } else {
+            vb_sf_sharers = (vb_sf_sharers | vb_sf_src);
+        }
+
+        v_sf_wena = 1;
+        vb_sf_wdata((SF_ENTRY_BITS - 1), SF_TAG_OFF) = r.req_addr.read()((CFG_CPU_ADDR_BITS - 1), SF_TAG_ADDR_OFF);
+        vb_sf_wdata((SF_TAG_OFF - 1), SF_SHARERS_OFF) = vb_sf_sharers;
+        vb_sf_wdata[SF_FL_LOSSY] = v_sf_lossy;
+        vb_sf_wdata[SF_FL_VALID] = 1;
+
+        v.ac_valid = vb_ac_valid;
+        if (vb_ac_valid.or_reduce() == 1) {
+            v.state = snoop_ac;
+        } else if (r.req_type.read()[L2_REQ_TYPE_WRITE] == 1) {
+            v.state = CacheWriteReq;
+        } else {
+            v.state = CacheReadReq;
+        }
+        break;
     case snoop_ac:
         for (int i = 0; i < CFG_SLOT_L1_TOTAL; i++) {
             vlxi[i].ac_valid = r.ac_valid.read()[i];
@@ -336,6 +445,10 @@ void L2Destination::comb() {
         o_l1i[i] = vlxi[i];                                 // vector should be assigned in cycle in systemc
     }
 
+    wb_sf_addr = vb_sf_addr;
+    w_sf_wena = v_sf_wena;
+    wb_sf_wdata = vb_sf_wdata;
+
     o_req_valid = v_req_valid;
     o_req_type = r.req_type;
     o_req_addr = r.req_addr;
@@ -345,6 +458,48 @@ void L2Destination::comb() {
     o_req_wstrb = r.req_wstrb;
 }
 
+void L2Destination::snoopStat() {
+    axi4_l1_out_type vcoreo;
+
+    if (i_nrst.read() == 0) {
+        return;
+    }
+    for (int i = 0; i < CFG_SLOT_L1_TOTAL; i++) {
+        vcoreo = i_l1o[i];
+        switch (r.state.read()) {
+        case SnoopFilter:
+            if ((r.ac_valid.read()[i] == 1) && (v.ac_valid.read()[i] == 0)) {
+                stat_[i].filtered++;
+            }
+            break;
+        case snoop_ac:
+            if ((r.ac_valid.read()[i] == 1) && (vcoreo.ac_ready == 1)) {
+                stat_[i].requests++;
+            }
+            break;
+        case snoop_cr:
+            if ((r.cr_ready.read()[i] == 1) && (vcoreo.cr_valid == 1)) {
+                if (vcoreo.cr_resp[0] == 1) {
+                    stat_[i].hits++;
+                    if (r.req_type.read()[L2_REQ_TYPE_UNIQUE] == 1) {
+                        stat_[i].invalidations++;
+                    }
+                } else {
+                    stat_[i].misses++;
+                }
+            }
+            break;
+        case snoop_cd:
+            if ((r.cd_ready.read()[i] == 1) && (vcoreo.cd_valid == 1)) {
+                stat_[i].writebacks++;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
 void L2Destination::registers() {
     if (async_reset_ && i_nrst.read() == 0) {
         L2Destination_r_reset(r);
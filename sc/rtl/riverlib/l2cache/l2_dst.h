@@ -19,6 +19,7 @@
 #include "../river_cfg.h"
 #include "../../ambalib/types_amba.h"
 #include "../types_river.h"
+#include "../../techmap/mem/ram_tech.h"
 
 namespace debugger {
 
@@ -27,7 +28,7 @@ SC_MODULE(L2Destination) {
     sc_in<bool> i_clk;                                      // CPU clock
     sc_in<bool> i_nrst;                                     // Reset: active LOW
     sc_in<bool> i_resp_valid;
-    sc_in<sc_biguint<L1CACHE_LINE_BITS>> i_resp_rdata;
+    sc_in<bitvec<L1CACHE_LINE_BITS>> i_resp_rdata;
     sc_in<sc_uint<2>> i_resp_status;
     sc_vector<sc_in<axi4_l1_out_type>> i_l1o;
     sc_vector<sc_out<axi4_l1_in_type>> o_l1i;
@@ -38,7 +39,7 @@ SC_MODULE(L2Destination) {
     sc_out<sc_uint<CFG_CPU_ADDR_BITS>> o_req_addr;
     sc_out<sc_uint<3>> o_req_size;
     sc_out<sc_uint<3>> o_req_prot;
-    sc_out<sc_biguint<L1CACHE_LINE_BITS>> o_req_wdata;
+    sc_out<bitvec<L1CACHE_LINE_BITS>> o_req_wdata;
     sc_out<sc_uint<L1CACHE_BYTES_PER_LINE>> o_req_wstrb;
 
     void comb();
@@ -48,12 +49,36 @@ SC_MODULE(L2Destination) {
 
     L2Destination(sc_module_name name,
                   bool async_reset);
+    virtual ~L2Destination();
 
     void generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd);
 
+    // Simulation only: snoop channel statistic per L1 slot
+    struct SnoopStatType {
+        uint64_t requests;                                  // AC handshakes
+        uint64_t hits;                                      // CR with data transfer
+        uint64_t misses;                                    // CR without data
+        uint64_t invalidations;                             // hits on ReadUnique
+        uint64_t writebacks;                                // CD handshakes
+        uint64_t filtered;                                  // snoops removed by filter
+    };
+    void snoopStat();
+    void getSnoopStat(int slot, SnoopStatType *p) { *p = stat_[slot]; }
+    void clearSnoopStat();
+
  private:
     bool async_reset_;
 
+    // Snoop filter entry: [tag][sharers][lossy][valid]
+    static const int SF_FL_VALID = 0;
+    static const int SF_FL_LOSSY = 1;                       // replaced entry had sharers
+    static const int SF_SHARERS_OFF = 2;
+    static const int SF_TAG_OFF = (SF_SHARERS_OFF + CFG_SLOT_L1_TOTAL);
+    static const int SF_INDEX_OFF = CFG_LOG2_L1CACHE_BYTES_PER_LINE;
+    static const int SF_TAG_ADDR_OFF = (SF_INDEX_OFF + CFG_L2_SNOOP_FILTER_LOG2_SIZE);
+    static const int SF_TAG_BITS = (CFG_CPU_ADDR_BITS - SF_TAG_ADDR_OFF);
+    static const int SF_ENTRY_BITS = (SF_TAG_OFF + SF_TAG_BITS);
+
     static const uint8_t Idle = 0;
     static const uint8_t CacheReadReq = 1;
     static const uint8_t CacheWriteReq = 2;
@@ -62,16 +87,17 @@ SC_MODULE(L2Destination) {
     static const uint8_t snoop_ac = 5;
     static const uint8_t snoop_cr = 6;
     static const uint8_t snoop_cd = 7;
+    static const uint8_t SnoopFilter = 8;
 
     struct L2Destination_registers {
-        sc_signal<sc_uint<3>> state;
+        sc_signal<sc_uint<4>> state;
         sc_signal<sc_uint<3>> srcid;
         sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> req_addr;
         sc_signal<sc_uint<3>> req_size;
         sc_signal<sc_uint<3>> req_prot;
         sc_signal<sc_uint<5>> req_src;
         sc_signal<sc_uint<L2_REQ_TYPE_BITS>> req_type;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> req_wdata;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> req_wdata;
         sc_signal<sc_uint<L1CACHE_BYTES_PER_LINE>> req_wstrb;
         sc_signal<sc_uint<(CFG_SLOT_L1_TOTAL + 1)>> ac_valid;
         sc_signal<sc_uint<(CFG_SLOT_L1_TOTAL + 1)>> cr_ready;
@@ -93,6 +119,14 @@ SC_MODULE(L2Destination) {
         iv.cd_ready = 0;
     }
 
+    sc_signal<sc_uint<CFG_L2_SNOOP_FILTER_LOG2_SIZE>> wb_sf_addr;
+    sc_signal<bool> w_sf_wena;
+    sc_signal<sc_uint<SF_ENTRY_BITS>> wb_sf_wdata;
+    sc_signal<sc_uint<SF_ENTRY_BITS>> wb_sf_rdata;
+
+    ram_tech<CFG_L2_SNOOP_FILTER_LOG2_SIZE, SF_ENTRY_BITS> *sf0;
+
+    SnoopStatType stat_[CFG_SLOT_L1_TOTAL];
 };
 
 }  // namespace debugger
@@ -44,6 +44,11 @@ SC_MODULE(L2Top) {
 
     void generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd);
 
+    void getSnoopStat(int slot, L2Destination::SnoopStatType *p) {
+        dst0->getSnoopStat(slot, p);
+    }
+    void clearSnoopStat() { dst0->clearSnoopStat(); }
+
  private:
     bool async_reset_;
     uint32_t waybits_;
@@ -55,10 +60,10 @@ SC_MODULE(L2Top) {
     sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> wb_req_addr;
     sc_signal<sc_uint<3>> wb_req_size;
     sc_signal<sc_uint<3>> wb_req_prot;
-    sc_signal<sc_biguint<L1CACHE_LINE_BITS>> wb_req_wdata;
+    sc_signal<bitvec<L1CACHE_LINE_BITS>> wb_req_wdata;
     sc_signal<sc_uint<L1CACHE_BYTES_PER_LINE>> wb_req_wstrb;
     sc_signal<bool> w_cache_valid;
-    sc_signal<sc_biguint<L1CACHE_LINE_BITS>> wb_cache_rdata;
+    sc_signal<bitvec<L1CACHE_LINE_BITS>> wb_cache_rdata;
     sc_signal<sc_uint<2>> wb_cache_status;
     // Memory interface:
     sc_signal<bool> w_req_mem_ready;
@@ -68,10 +73,10 @@ SC_MODULE(L2Top) {
     sc_signal<sc_uint<3>> wb_req_mem_prot;
     sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> wb_req_mem_addr;
     sc_signal<sc_uint<L2CACHE_BYTES_PER_LINE>> wb_req_mem_strob;
-    sc_signal<sc_biguint<L2CACHE_LINE_BITS>> wb_req_mem_data;
+    sc_signal<bitvec<L2CACHE_LINE_BITS>> wb_req_mem_data;
     sc_signal<bool> w_mem_data_valid;
     sc_signal<bool> w_mem_data_ack;
-    sc_signal<sc_biguint<L2CACHE_LINE_BITS>> wb_mem_data;
+    sc_signal<bitvec<L2CACHE_LINE_BITS>> wb_mem_data;
     sc_signal<bool> w_mem_load_fault;
     sc_signal<bool> w_mem_store_fault;
     // Flush interface
@@ -211,15 +211,15 @@ void L2CacheLru::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
 }
 
 void L2CacheLru::comb() {
-    sc_biguint<L2CACHE_LINE_BITS> vb_cache_line_i_modified;
-    sc_biguint<L2CACHE_LINE_BITS> vb_line_rdata_o_modified;
+    bitvec<L2CACHE_LINE_BITS> vb_cache_line_i_modified;
+    bitvec<L2CACHE_LINE_BITS> vb_line_rdata_o_modified;
     sc_uint<L2CACHE_BYTES_PER_LINE> vb_line_rdata_o_wstrb;
     bool v_req_ready;
-    sc_biguint<L2CACHE_LINE_BITS> t_cache_line_i;
-    sc_biguint<L1CACHE_LINE_BITS> vb_cached_data;
-    sc_biguint<L1CACHE_LINE_BITS> vb_uncached_data;
+    bitvec<L2CACHE_LINE_BITS> t_cache_line_i;
+    bitvec<L1CACHE_LINE_BITS> vb_cached_data;
+    bitvec<L1CACHE_LINE_BITS> vb_uncached_data;
     bool v_resp_valid;
-    sc_biguint<L1CACHE_LINE_BITS> vb_resp_rdata;
+    bitvec<L1CACHE_LINE_BITS> vb_resp_rdata;
     sc_uint<L2_REQ_TYPE_BITS> vb_resp_status;
     bool v_direct_access;
     bool v_invalidate;
@@ -227,9 +227,9 @@ void L2CacheLru::comb() {
     bool v_line_cs_read;
     bool v_line_cs_write;                                   // 'cs' should be active when write line and there's no new request
     sc_uint<CFG_CPU_ADDR_BITS> vb_line_addr;
-    sc_biguint<L2CACHE_LINE_BITS> vb_line_wdata;
+    bitvec<L2CACHE_LINE_BITS> vb_line_wdata;
     sc_uint<L2CACHE_BYTES_PER_LINE> vb_line_wstrb;
-    sc_biguint<L1CACHE_LINE_BITS> vb_req_mask;
+    bitvec<L1CACHE_LINE_BITS> vb_req_mask;
     sc_uint<L2TAG_FL_TOTAL> v_line_wflags;
     int ridx;
     bool v_req_same_line;
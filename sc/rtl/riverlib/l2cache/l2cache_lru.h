@@ -30,11 +30,11 @@ SC_MODULE(L2CacheLru) {
     sc_in<sc_uint<3>> i_req_size;
     sc_in<sc_uint<3>> i_req_prot;
     sc_in<sc_uint<CFG_CPU_ADDR_BITS>> i_req_addr;
-    sc_in<sc_biguint<L1CACHE_LINE_BITS>> i_req_wdata;
+    sc_in<bitvec<L1CACHE_LINE_BITS>> i_req_wdata;
     sc_in<sc_uint<L1CACHE_BYTES_PER_LINE>> i_req_wstrb;
     sc_out<bool> o_req_ready;
     sc_out<bool> o_resp_valid;
-    sc_out<sc_biguint<L1CACHE_LINE_BITS>> o_resp_rdata;
+    sc_out<bitvec<L1CACHE_LINE_BITS>> o_resp_rdata;
     sc_out<sc_uint<2>> o_resp_status;
     // Memory interface:
     sc_in<bool> i_req_mem_ready;
@@ -44,9 +44,9 @@ SC_MODULE(L2CacheLru) {
     sc_out<sc_uint<3>> o_req_mem_prot;
     sc_out<sc_uint<CFG_CPU_ADDR_BITS>> o_req_mem_addr;
     sc_out<sc_uint<L2CACHE_BYTES_PER_LINE>> o_req_mem_strob;
-    sc_out<sc_biguint<L2CACHE_LINE_BITS>> o_req_mem_data;
+    sc_out<bitvec<L2CACHE_LINE_BITS>> o_req_mem_data;
     sc_in<bool> i_mem_data_valid;
-    sc_in<sc_biguint<L2CACHE_LINE_BITS>> i_mem_data;
+    sc_in<bitvec<L2CACHE_LINE_BITS>> i_mem_data;
     sc_in<bool> i_mem_data_ack;
     sc_in<bool> i_mem_load_fault;
     sc_in<bool> i_mem_store_fault;
@@ -100,7 +100,7 @@ SC_MODULE(L2CacheLru) {
         sc_signal<sc_uint<3>> req_size;
         sc_signal<sc_uint<3>> req_prot;
         sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> req_addr;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> req_wdata;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> req_wdata;
         sc_signal<sc_uint<L1CACHE_BYTES_PER_LINE>> req_wstrb;
         sc_signal<sc_uint<4>> state;
         sc_signal<bool> req_mem_valid;
@@ -115,8 +115,8 @@ SC_MODULE(L2CacheLru) {
         sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> req_flush_addr;// [0]=1 flush all
         sc_signal<sc_uint<32>> req_flush_cnt;
         sc_signal<sc_uint<32>> flush_cnt;
-        sc_signal<sc_biguint<L2CACHE_LINE_BITS>> cache_line_i;
-        sc_signal<sc_biguint<L2CACHE_LINE_BITS>> cache_line_o;
+        sc_signal<bitvec<L2CACHE_LINE_BITS>> cache_line_i;
+        sc_signal<bitvec<L2CACHE_LINE_BITS>> cache_line_o;
     } v, r;
 
     void L2CacheLru_r_reset(L2CacheLru_registers &iv) {
@@ -148,11 +148,11 @@ SC_MODULE(L2CacheLru) {
     sc_signal<bool> line_re_i;
     sc_signal<bool> line_we_i;
     sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> line_addr_i;
-    sc_signal<sc_biguint<L2CACHE_LINE_BITS>> line_wdata_i;
+    sc_signal<bitvec<L2CACHE_LINE_BITS>> line_wdata_i;
     sc_signal<sc_uint<L2CACHE_BYTES_PER_LINE>> line_wstrb_i;
     sc_signal<sc_uint<L2TAG_FL_TOTAL>> line_wflags_i;
     sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> line_raddr_o;
-    sc_signal<sc_biguint<L2CACHE_LINE_BITS>> line_rdata_o;
+    sc_signal<bitvec<L2CACHE_LINE_BITS>> line_rdata_o;
     sc_signal<sc_uint<L2TAG_FL_TOTAL>> line_rflags_o;
     sc_signal<bool> line_hit_o;
     // Snoop signals:
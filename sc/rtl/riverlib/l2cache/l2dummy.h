@@ -63,9 +63,9 @@ SC_MODULE(L2Dummy) {
         sc_signal<bool> req_lock;
         sc_signal<sc_uint<CFG_CPU_ID_BITS>> req_id;
         sc_signal<sc_uint<CFG_CPU_USER_BITS>> req_user;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> req_wdata;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> req_wdata;
         sc_signal<sc_uint<L1CACHE_BYTES_PER_LINE>> req_wstrb;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> rdata;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> rdata;
         sc_signal<sc_uint<2>> resp;
     } v, r;
 
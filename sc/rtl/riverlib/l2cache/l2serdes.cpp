@@ -101,14 +101,14 @@ sc_uint<3> L2SerDes::size2size(sc_uint<3> size) {
 void L2SerDes::comb() {
     bool v_req_mem_ready;
     sc_uint<busw> vb_r_data;
-    sc_biguint<linew> vb_line_o;
+    bitvec<linew> vb_line_o;
     bool v_r_valid;
     bool v_w_valid;
     bool v_w_last;
     bool v_w_ready;
     sc_uint<8> vb_len;
     sc_uint<3> vb_size;
-    sc_biguint<linew> t_line;
+    bitvec<linew> t_line;
     sc_uint<lineb> t_wstrb;
     axi4_l2_in_type vl2i;
     axi4_master_out_type vmsto;
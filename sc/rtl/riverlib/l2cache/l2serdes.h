@@ -60,7 +60,7 @@ SC_MODULE(L2SerDes) {
         sc_signal<sc_uint<2>> state;
         sc_signal<sc_uint<8>> req_len;
         sc_signal<bool> b_wait;
-        sc_signal<sc_biguint<linew>> line;
+        sc_signal<bitvec<linew>> line;
         sc_signal<sc_uint<lineb>> wstrb;
         sc_signal<sc_uint<SERDES_BURST_LEN>> rmux;
     } v, r;
@@ -259,7 +259,7 @@ void RiverAmba::comb() {
     bool v_cr_valid;
     sc_uint<5> vb_cr_resp;
     bool v_cd_valid;
-    sc_biguint<L1CACHE_LINE_BITS> vb_cd_data;
+    bitvec<L1CACHE_LINE_BITS> vb_cd_data;
 
     v_resp_mem_valid = 0;
     v_mem_er_load_fault = 0;
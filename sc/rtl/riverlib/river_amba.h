@@ -36,7 +36,7 @@ SC_MODULE(RiverAmba) {
     sc_out<bool> o_flush_l2;                                // Flush L2 after D$ has been finished
     sc_out<bool> o_halted;                                  // CPU halted via debug interface
     sc_out<bool> o_available;                               // CPU was instantitated of stubbed
-    sc_in<sc_biguint<(32 * CFG_PROGBUF_REG_TOTAL)>> i_progbuf;// progam buffer
+    sc_in<bitvec<(32 * CFG_PROGBUF_REG_TOTAL)>> i_progbuf;// progam buffer
 
     void comb();
     void registers();
@@ -89,7 +89,7 @@ SC_MODULE(RiverAmba) {
         sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> req_addr;
         sc_signal<bool> req_path;
         sc_signal<sc_uint<4>> req_cached;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> req_wdata;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> req_wdata;
         sc_signal<sc_uint<L1CACHE_BYTES_PER_LINE>> req_wstrb;
         sc_signal<sc_uint<3>> req_size;
         sc_signal<sc_uint<3>> req_prot;
@@ -100,7 +100,7 @@ SC_MODULE(RiverAmba) {
         sc_signal<sc_uint<4>> ac_snoop;                     // Table C3-19
         sc_signal<sc_uint<5>> cr_resp;
         sc_signal<sc_uint<SNOOP_REQ_TYPE_BITS>> req_snoop_type;
-        sc_signal<sc_biguint<L1CACHE_LINE_BITS>> resp_snoop_data;
+        sc_signal<bitvec<L1CACHE_LINE_BITS>> resp_snoop_data;
         sc_signal<bool> cache_access;
     } v, r;
 
@@ -131,8 +131,8 @@ SC_MODULE(RiverAmba) {
     sc_signal<sc_uint<3>> req_mem_size_o;
     sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> req_mem_addr_o;
     sc_signal<sc_uint<L1CACHE_BYTES_PER_LINE>> req_mem_strob_o;
-    sc_signal<sc_biguint<L1CACHE_LINE_BITS>> req_mem_data_o;
-    sc_signal<sc_biguint<L1CACHE_LINE_BITS>> resp_mem_data_i;
+    sc_signal<bitvec<L1CACHE_LINE_BITS>> req_mem_data_o;
+    sc_signal<bitvec<L1CACHE_LINE_BITS>> resp_mem_data_i;
     sc_signal<bool> resp_mem_valid_i;
     sc_signal<bool> resp_mem_load_fault_i;
     sc_signal<bool> resp_mem_store_fault_i;
@@ -143,7 +143,7 @@ SC_MODULE(RiverAmba) {
     sc_signal<sc_uint<CFG_CPU_ADDR_BITS>> req_snoop_addr_i;
     sc_signal<bool> resp_snoop_ready_i;
     sc_signal<bool> resp_snoop_valid_o;
-    sc_signal<sc_biguint<L1CACHE_LINE_BITS>> resp_snoop_data_o;
+    sc_signal<bitvec<L1CACHE_LINE_BITS>> resp_snoop_data_o;
     sc_signal<sc_uint<DTAG_FL_TOTAL>> resp_snoop_flags_o;
     sc_signal<bool> w_dporti_haltreq;
     sc_signal<bool> w_dporti_resumereq;
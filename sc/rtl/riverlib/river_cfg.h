@@ -16,6 +16,7 @@
 #pragma once
 
 #include <systemc.h>
+#include "../techmap/bitvec/bitvec.h"
 
 namespace debugger {
 
@@ -23,6 +24,7 @@ static const uint32_t CFG_VENDOR_ID = 0x000000F1;
 static const uint32_t CFG_IMPLEMENTATION_ID = 0x20220813;
 static const bool CFG_HW_FPU_ENABLE = true;
 static const bool CFG_TRACER_ENABLE = false;
+static const bool CFG_TRACER_BINARY = false;     // binary records, see generic/trace_bin.h
 
 // Architectural size definition
 static const int RISCV_ARCH = 64;
@@ -102,6 +104,13 @@ static const int L2_REQ_TYPE_UNIQUE = 2;
 static const int L2_REQ_TYPE_SNOOP = 3;                     // Use data received through snoop channel (no memory request)
 static const int L2_REQ_TYPE_BITS = 4;
 
+// 
+// L2 snoop filter: direct mapped table with presence bits of L1 slots,
+// snoops are sent only to the possible sharers of the line
+// 
+static const bool CFG_L2_SNOOP_FILTER_ENABLE = true;
+static const int CFG_L2_SNOOP_FILTER_LOG2_SIZE = 10;        // 1024 lines
+
 // PMP config
 static const int CFG_PMP_TBL_WIDTH = 3;                     // [1:0]  log2(MPU_TBL_SIZE)
 static const int CFG_PMP_TBL_SIZE = (1 << CFG_PMP_TBL_WIDTH);
@@ -113,6 +122,20 @@ static const int CFG_PMP_FL_L = 3;
 static const int CFG_PMP_FL_V = 4;
 static const int CFG_PMP_FL_TOTAL = 5;
 
+// Hardware performance-monitoring counters mhpmcounter3.. and mhpmevent3..
+// Event selector value: 0=disabled; N=HpmEvent index + 1
+static const int CFG_HPM_COUNTERS_TOTAL = 8;
+
+static const int HpmEvent_ICacheMiss = 0;                   // I$ line request to memory
+static const int HpmEvent_DCacheMiss = 1;                   // D$ line read request to memory
+static const int HpmEvent_BranchMispredict = 2;             // executor waits fetching of the new pc
+static const int HpmEvent_StallFetch = 3;                   // executor waits instruction of the expected pc
+static const int HpmEvent_StallHazard = 4;                  // data hazard on source registers
+static const int HpmEvent_StallMemQueue = 5;                // memaccess queue is full
+static const int HpmEvent_StallMulticycle = 6;              // waiting integer multi-cycle instruction
+static const int HpmEvent_StallFpu = 7;                     // waiting FPU instruction
+static const int HpmEvent_Total = 8;
+
 // MMU config. Fetch and Data pathes have its own MMU block
 static const int CFG_MMU_TLB_AWIDTH = 6;                    // TLB memory address bus width
 static const int CFG_MMU_TLB_SIZE = (1 << CFG_MMU_TLB_AWIDTH);// Number of PTE entries in a table
@@ -137,6 +137,7 @@ RiverTop::RiverTop(sc_module_name name,
     proc0->o_flushd_valid(w_flushd_valid);
     proc0->o_flushd_addr(wb_flushd_addr);
     proc0->i_flushd_end(w_flushd_end);
+    proc0->i_hpm_cache_events(wb_hpm_cache_events);
 
 
     cache0 = new CacheTop("cache0", async_reset,
@@ -169,9 +170,9 @@ RiverTop::RiverTop(sc_module_name name,
     cache0->o_resp_data_store_fault(w_resp_data_store_fault);
     cache0->i_resp_data_ready(w_resp_data_ready);
     cache0->i_req_mem_ready(i_req_mem_ready);
-    cache0->o_req_mem_path(o_req_mem_path);
-    cache0->o_req_mem_valid(o_req_mem_valid);
-    cache0->o_req_mem_type(o_req_mem_type);
+    cache0->o_req_mem_path(w_req_mem_path);
+    cache0->o_req_mem_valid(w_req_mem_valid);
+    cache0->o_req_mem_type(wb_req_mem_type);
     cache0->o_req_mem_size(o_req_mem_size);
     cache0->o_req_mem_addr(o_req_mem_addr);
     cache0->o_req_mem_strob(o_req_mem_strob);
@@ -258,6 +259,10 @@ RiverTop::RiverTop(sc_module_name name,
     sensitive << w_flushd_valid;
     sensitive << wb_flushd_addr;
     sensitive << w_flushd_end;
+    sensitive << w_req_mem_path;
+    sensitive << w_req_mem_valid;
+    sensitive << wb_req_mem_type;
+    sensitive << wb_hpm_cache_events;
 }
 
 RiverTop::~RiverTop() {
@@ -320,7 +325,27 @@ void RiverTop::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
 }
 
 void RiverTop::comb() {
+    sc_uint<HpmEvent_Total> vb_hpm_cache_events;
+
+    vb_hpm_cache_events = 0;
+
+    // Cached read request of the whole line means L1 miss. Uncached
+    // accesses and D$ write-backs are not counted.
+    if ((w_req_mem_valid.read() == 1) && (i_req_mem_ready.read() == 1)
+            && (wb_req_mem_type.read()[REQ_MEM_TYPE_CACHED] == 1)
+            && (wb_req_mem_type.read()[REQ_MEM_TYPE_WRITE] == 0)) {
+        if (w_req_mem_path.read() == 0) {
+            vb_hpm_cache_events[HpmEvent_ICacheMiss] = 1;
+        } else {
+            vb_hpm_cache_events[HpmEvent_DCacheMiss] = 1;
+        }
+    }
+
+    o_req_mem_path = w_req_mem_path;
+    o_req_mem_valid = w_req_mem_valid;
+    o_req_mem_type = wb_req_mem_type;
     o_flush_l2 = w_flushd_end;
+    wb_hpm_cache_events = vb_hpm_cache_events;
 }
 
 }  // namespace debugger
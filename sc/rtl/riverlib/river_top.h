@@ -35,10 +35,10 @@ SC_MODULE(RiverTop) {
     sc_out<sc_uint<3>> o_req_mem_size;                      // request size: 0=1 B;...; 7=128 B
     sc_out<sc_uint<CFG_CPU_ADDR_BITS>> o_req_mem_addr;      // AXI memory request address
     sc_out<sc_uint<L1CACHE_BYTES_PER_LINE>> o_req_mem_strob;// Writing strob. 1 bit per Byte (uncached only)
-    sc_out<sc_biguint<L1CACHE_LINE_BITS>> o_req_mem_data;   // Writing data
+    sc_out<bitvec<L1CACHE_LINE_BITS>> o_req_mem_data;   // Writing data
     sc_in<bool> i_resp_mem_valid;                           // AXI response is valid
     sc_in<bool> i_resp_mem_path;                            // 0=ctrl; 1=data path
-    sc_in<sc_biguint<L1CACHE_LINE_BITS>> i_resp_mem_data;   // Read data
+    sc_in<bitvec<L1CACHE_LINE_BITS>> i_resp_mem_data;   // Read data
     sc_in<bool> i_resp_mem_load_fault;                      // data load error
     sc_in<bool> i_resp_mem_store_fault;                     // data store error
     // $D Snoop interface:
@@ -48,7 +48,7 @@ SC_MODULE(RiverTop) {
     sc_in<sc_uint<CFG_CPU_ADDR_BITS>> i_req_snoop_addr;
     sc_in<bool> i_resp_snoop_ready;
     sc_out<bool> o_resp_snoop_valid;
-    sc_out<sc_biguint<L1CACHE_LINE_BITS>> o_resp_snoop_data;
+    sc_out<bitvec<L1CACHE_LINE_BITS>> o_resp_snoop_data;
     sc_out<sc_uint<DTAG_FL_TOTAL>> o_resp_snoop_flags;
     sc_out<bool> o_flush_l2;                                // Flush L2 after D$ has been finished
     // Interrupt lines:
@@ -66,7 +66,7 @@ SC_MODULE(RiverTop) {
     sc_out<bool> o_dport_resp_valid;                        // Response is valid
     sc_out<bool> o_dport_resp_error;                        // Something wrong during command execution
     sc_out<sc_uint<RISCV_ARCH>> o_dport_rdata;              // Response value
-    sc_in<sc_biguint<(32 * CFG_PROGBUF_REG_TOTAL)>> i_progbuf;// progam buffer
+    sc_in<bitvec<(32 * CFG_PROGBUF_REG_TOTAL)>> i_progbuf;// progam buffer
     sc_out<bool> o_halted;                                  // CPU halted via debug interface
 
     void comb();
@@ -132,6 +132,10 @@ SC_MODULE(RiverTop) {
     sc_signal<bool> w_flushd_valid;
     sc_signal<sc_uint<RISCV_ARCH>> wb_flushd_addr;
     sc_signal<bool> w_flushd_end;
+    sc_signal<bool> w_req_mem_path;
+    sc_signal<bool> w_req_mem_valid;
+    sc_signal<sc_uint<REQ_MEM_TYPE_BITS>> wb_req_mem_type;
+    sc_signal<sc_uint<HpmEvent_Total>> wb_hpm_cache_events; // L1 misses: line requests accepted by the System Bus
 
     Processor *proc0;
     CacheTop *cache0;
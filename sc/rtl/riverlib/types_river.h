@@ -435,7 +435,7 @@ class axi4_l1_out_type {
     sc_uint<CFG_CPU_ID_BITS> aw_id;
     sc_uint<CFG_SYSBUS_USER_BITS> aw_user;
     bool w_valid;
-    sc_biguint<L1CACHE_LINE_BITS> w_data;
+    bitvec<L1CACHE_LINE_BITS> w_data;
     bool w_last;
     sc_uint<L1CACHE_BYTES_PER_LINE> w_strb;
     sc_uint<CFG_CPU_USER_BITS> w_user;
@@ -456,7 +456,7 @@ class axi4_l1_out_type {
     bool cr_valid;
     sc_uint<5> cr_resp;
     bool cd_valid;
-    sc_biguint<L1CACHE_LINE_BITS> cd_data;
+    bitvec<L1CACHE_LINE_BITS> cd_data;
     bool cd_last;
     bool rack;
     bool wack;
@@ -595,7 +595,7 @@ class axi4_l1_in_type {
     bool ar_ready;
     bool r_valid;
     sc_uint<4> r_resp;
-    sc_biguint<L1CACHE_LINE_BITS> r_data;
+    bitvec<L1CACHE_LINE_BITS> r_data;
     bool r_last;
     sc_uint<CFG_CPU_ID_BITS> r_id;
     sc_uint<CFG_SYSBUS_USER_BITS> r_user;
@@ -799,7 +799,7 @@ class axi4_l2_out_type {
     sc_uint<CFG_CPU_ID_BITS> aw_id;
     sc_uint<CFG_SYSBUS_USER_BITS> aw_user;
     bool w_valid;
-    sc_biguint<L2CACHE_LINE_BITS> w_data;
+    bitvec<L2CACHE_LINE_BITS> w_data;
     bool w_last;
     sc_uint<L2CACHE_BYTES_PER_LINE> w_strb;
     sc_uint<CFG_CPU_USER_BITS> w_user;
@@ -914,7 +914,7 @@ class axi4_l2_in_type {
     bool ar_ready;
     bool r_valid;
     sc_uint<2> r_resp;
-    sc_biguint<L2CACHE_LINE_BITS> r_data;
+    bitvec<L2CACHE_LINE_BITS> r_data;
     bool r_last;
     sc_uint<CFG_CPU_ID_BITS> r_id;
     sc_uint<CFG_SYSBUS_USER_BITS> r_user;
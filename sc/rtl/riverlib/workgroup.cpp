@@ -372,6 +372,22 @@ void Workgroup::generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd) {
     }
 }
 
+bool Workgroup::getSnoopStat(int slot, L2Destination::SnoopStatType *p) {
+    if (l2cache == 0 || slot < 0 || slot >= CFG_SLOT_L1_TOTAL) {
+        return false;
+    }
+    l2cache->getSnoopStat(slot, p);
+    return true;
+}
+
+bool Workgroup::clearSnoopStat() {
+    if (l2cache == 0) {
+        return false;
+    }
+    l2cache->clearSnoopStat();
+    return true;
+}
+
 void Workgroup::comb() {
     dev_config_type vb_xmst_cfg;
     bool v_flush_l2;
@@ -77,6 +77,10 @@ SC_MODULE(Workgroup) {
 
     void generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd);
 
+    // L2 snoop filter counters, false when L2-cache is disabled
+    bool getSnoopStat(int slot, L2Destination::SnoopStatType *p);
+    bool clearSnoopStat();
+
  private:
     bool async_reset_;
     uint32_t cpu_num_;
@@ -118,7 +122,7 @@ SC_MODULE(Workgroup) {
     sc_signal<bool> w_ic_dport_resp_valid;
     sc_signal<bool> w_ic_dport_resp_error;
     sc_signal<sc_uint<RISCV_ARCH>> wb_ic_dport_rdata;
-    sc_signal<sc_biguint<(32 * CFG_PROGBUF_REG_TOTAL)>> wb_progbuf;
+    sc_signal<bitvec<(32 * CFG_PROGBUF_REG_TOTAL)>> wb_progbuf;
     sc_signal<bool> w_flush_l2;
 
     dmidebug *dmi0;
@@ -0,0 +1,385 @@
+//
+//  Copyright 2022 Sergey Khabarov, sergeykhbr@gmail.com
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+#pragma once
+
+#include <systemc.h>
+#include <string>
+#include <type_traits>
+
+// @brief Use fixed width native bit-vector instead of sc_biguint.
+// @details Build with -DCFG_SYSC_NATIVE_BITVEC=0 to get back reference
+//          sc_biguint implementation. Both give the same bit values.
+#ifndef CFG_SYSC_NATIVE_BITVEC
+#define CFG_SYSC_NATIVE_BITVEC 1
+#endif
+
+namespace debugger {
+
+// Widest vector implemented natively, sc_biguint is used above it.
+static const int BITVEC_NATIVE_MAX_BITS = 512;
+
+template<int W> class bitvec_native;
+
+// Read-only part select [hi:lo] of the bit-vector
+template<int W>
+class bitvec_subref_r {
+ public:
+    bitvec_subref_r(const bitvec_native<W> *p, int hi, int lo)
+        : p_(const_cast<bitvec_native<W> *>(p)), hi_(hi), lo_(lo) {}
+
+    int length() const { return hi_ - lo_ + 1; }
+    int lo() const { return lo_; }
+    const bitvec_native<W> &parent() const { return *p_; }
+
+    sc_dt::uint64 to_uint64() const {
+        return p_->extract(lo_, length() < 64 ? length() : 64);
+    }
+    unsigned to_uint() const { return static_cast<unsigned>(to_uint64()); }
+    int to_int() const { return static_cast<int>(to_uint64()); }
+    operator sc_dt::uint64() const { return to_uint64(); }
+
+    bool or_reduce() const {
+        for (int i = 0; i < length(); i += 64) {
+            int n = length() - i < 64 ? length() - i : 64;
+            if (p_->extract(lo_ + i, n)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // {hi, lo} with the left part not wider than its parent vector
+    template<int N>
+    friend bitvec_native<W + N> operator , (const bitvec_subref_r &hi,
+                                            const bitvec_native<N> &lo) {
+        bitvec_native<W + N> ret(lo);
+        ret.insert_bits(N, hi);
+        return ret;
+    }
+
+    template<int N>
+    friend bitvec_native<W + N> operator , (
+            const bitvec_subref_r &hi,
+            const sc_core::sc_signal_in_if<bitvec_native<N>> &lo) {
+        return (hi, lo.read());
+    }
+
+    friend bitvec_native<W + 1> operator , (bool hi,
+                                            const bitvec_subref_r &lo) {
+        bitvec_native<W + 1> ret(lo);
+        ret.insert(lo.length(), 1, hi);
+        return ret;
+    }
+
+ protected:
+    bitvec_native<W> *p_;
+    int hi_;
+    int lo_;
+};
+
+// Writable part select [hi:lo], assigned value is truncated or zero-extended
+template<int W>
+class bitvec_subref : public bitvec_subref_r<W> {
+ public:
+    bitvec_subref(bitvec_native<W> *p, int hi, int lo)
+        : bitvec_subref_r<W>(p, hi, lo) {}
+
+    bitvec_subref &operator = (sc_dt::uint64 v) {
+        this->p_->insert(this->lo_, this->length() < 64 ? this->length() : 64, v);
+        for (int i = 64; i < this->length(); i += 64) {
+            int n = this->length() - i < 64 ? this->length() - i : 64;
+            this->p_->insert(this->lo_ + i, n, 0);
+        }
+        return *this;
+    }
+
+    bitvec_subref &operator = (const sc_dt::sc_uint_base &v) {
+        return operator = (v.to_uint64());
+    }
+
+    template<int N>
+    bitvec_subref &operator = (const bitvec_native<N> &v) {
+        bitvec_subref_r<N> all(&v, N - 1, 0);
+        return operator = (all);
+    }
+
+    template<int N>
+    bitvec_subref &operator = (const bitvec_subref_r<N> &v) {
+        // Source may overlap with the destination: copy through temporary
+        bitvec_native<N> t(v);
+        for (int i = 0; i < this->length(); i += 64) {
+            int n = this->length() - i < 64 ? this->length() - i : 64;
+            this->p_->insert(this->lo_ + i, n, i < N ? t.extract(i, n < N - i ? n : N - i) : 0);
+        }
+        return *this;
+    }
+
+    bitvec_subref &operator = (const bitvec_subref &v) {
+        return operator = (static_cast<const bitvec_subref_r<W> &>(v));
+    }
+};
+
+// Single bit select
+template<int W>
+class bitvec_bitref {
+ public:
+    bitvec_bitref(bitvec_native<W> *p, int idx) : p_(p), idx_(idx) {}
+
+    operator bool() const { return p_->extract(idx_, 1) != 0; }
+    bitvec_bitref &operator = (bool v) {
+        p_->insert(idx_, 1, v);
+        return *this;
+    }
+    bitvec_bitref &operator = (const bitvec_bitref &v) {
+        return operator = (static_cast<bool>(v));
+    }
+
+ private:
+    bitvec_native<W> *p_;
+    int idx_;
+};
+
+// Fixed width unsigned vector stored in the array of 64-bits words.
+// Covers the sc_biguint operations used on the cache lines and the
+// program buffer: part select, concatenation, bitwise logic, shifts,
+// compare, tracing and printing.
+template<int W>
+class bitvec_native {
+ public:
+    static const int WORDS = (W + 63) / 64;
+
+    bitvec_native() {
+        for (int i = 0; i < WORDS; i++) {
+            w_[i] = 0;
+        }
+    }
+
+    template<typename T>
+    bitvec_native(T v, typename std::enable_if<std::is_integral<T>::value>::type * = 0) {
+        sc_dt::uint64 ext = (std::is_signed<T>::value && v < 0) ? ~0ull : 0;
+        w_[0] = static_cast<sc_dt::uint64>(v);
+        for (int i = 1; i < WORDS; i++) {
+            w_[i] = ext;
+        }
+        mask();
+    }
+
+    bitvec_native(const sc_dt::sc_uint_base &v) {
+        *this = bitvec_native(v.to_uint64());
+    }
+
+    bitvec_native(const sc_dt::sc_int_base &v) {
+        *this = bitvec_native(v.to_int64());
+    }
+
+    template<int N>
+    bitvec_native(const bitvec_native<N> &v) {
+        for (int i = 0; i < WORDS; i++) {
+            w_[i] = i < bitvec_native<N>::WORDS ? v.word(i) : 0;
+        }
+        mask();
+    }
+
+    template<int N>
+    bitvec_native(const bitvec_subref_r<N> &v) {
+        for (int i = 0; i < WORDS; i++) {
+            int n = v.length() - 64 * i;
+            w_[i] = n <= 0 ? 0 : v.parent().extract(v.lo() + 64 * i, n < 64 ? n : 64);
+        }
+        mask();
+    }
+
+    int length() const { return W; }
+    sc_dt::uint64 word(int idx) const { return w_[idx]; }
+
+    sc_dt::uint64 to_uint64() const { return w_[0]; }
+    sc_dt::int64 to_int64() const { return static_cast<sc_dt::int64>(w_[0]); }
+    unsigned to_uint() const { return static_cast<unsigned>(w_[0]); }
+    int to_int() const { return static_cast<int>(w_[0]); }
+
+    bool or_reduce() const {
+        for (int i = 0; i < WORDS; i++) {
+            if (w_[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool and_reduce() const { return (~(*this)).or_reduce() == false; }
+
+    bitvec_subref<W> operator () (int hi, int lo) {
+        return bitvec_subref<W>(this, hi, lo);
+    }
+    bitvec_subref_r<W> operator () (int hi, int lo) const {
+        return bitvec_subref_r<W>(this, hi, lo);
+    }
+    bitvec_subref<W> range(int hi, int lo) { return operator () (hi, lo); }
+    bitvec_subref_r<W> range(int hi, int lo) const { return operator () (hi, lo); }
+
+    bitvec_bitref<W> operator [] (int idx) {
+        return bitvec_bitref<W>(this, idx);
+    }
+    bool operator [] (int idx) const { return extract(idx, 1) != 0; }
+
+    // n-bits field (n <= 64) starting from bit 'lo'
+    sc_dt::uint64 extract(int lo, int n) const {
+        int wi = lo >> 6;
+        int sh = lo & 63;
+        sc_dt::uint64 v = w_[wi] >> sh;
+        if (sh && (sh + n) > 64) {
+            v |= w_[wi + 1] << (64 - sh);
+        }
+        return n < 64 ? v & ((1ull << n) - 1) : v;
+    }
+
+    void insert(int lo, int n, sc_dt::uint64 v) {
+        sc_dt::uint64 m = n < 64 ? (1ull << n) - 1 : ~0ull;
+        int wi = lo >> 6;
+        int sh = lo & 63;
+        v &= m;
+        w_[wi] = (w_[wi] & ~(m << sh)) | (v << sh);
+        if (sh && (sh + n) > 64) {
+            w_[wi + 1] = (w_[wi + 1] & ~(m >> (64 - sh))) | (v >> (64 - sh));
+        }
+        mask();
+    }
+
+    // Place part select bits starting from position 'lo'
+    template<int N>
+    void insert_bits(int lo, const bitvec_subref_r<N> &v) {
+        for (int i = 0; i < v.length() && lo + i < W; i += 64) {
+            int n = v.length() - i < 64 ? v.length() - i : 64;
+            if (lo + i + n > W) {
+                n = W - lo - i;
+            }
+            insert(lo + i, n, v.parent().extract(v.lo() + i, n));
+        }
+    }
+
+    bitvec_native operator ~ () const {
+        bitvec_native ret;
+        for (int i = 0; i < WORDS; i++) {
+            ret.w_[i] = ~w_[i];
+        }
+        ret.mask();
+        return ret;
+    }
+
+    friend bitvec_native operator & (const bitvec_native &a, const bitvec_native &b) {
+        bitvec_native ret;
+        for (int i = 0; i < WORDS; i++) {
+            ret.w_[i] = a.w_[i] & b.w_[i];
+        }
+        return ret;
+    }
+
+    friend bitvec_native operator | (const bitvec_native &a, const bitvec_native &b) {
+        bitvec_native ret;
+        for (int i = 0; i < WORDS; i++) {
+            ret.w_[i] = a.w_[i] | b.w_[i];
+        }
+        return ret;
+    }
+
+    friend bitvec_native operator ^ (const bitvec_native &a, const bitvec_native &b) {
+        bitvec_native ret;
+        for (int i = 0; i < WORDS; i++) {
+            ret.w_[i] = a.w_[i] ^ b.w_[i];
+        }
+        return ret;
+    }
+
+    bitvec_native operator << (int sh) const {
+        bitvec_native ret;
+        int ws = sh >> 6;
+        int bs = sh & 63;
+        for (int i = WORDS - 1; i >= ws; i--) {
+            ret.w_[i] = w_[i - ws] << bs;
+            if (bs && i - ws - 1 >= 0) {
+                ret.w_[i] |= w_[i - ws - 1] >> (64 - bs);
+            }
+        }
+        ret.mask();
+        return ret;
+    }
+
+    bitvec_native operator >> (int sh) const {
+        bitvec_native ret;
+        int ws = sh >> 6;
+        int bs = sh & 63;
+        for (int i = 0; i + ws < WORDS; i++) {
+            ret.w_[i] = w_[i + ws] >> bs;
+            if (bs && i + ws + 1 < WORDS) {
+                ret.w_[i] |= w_[i + ws + 1] << (64 - bs);
+            }
+        }
+        return ret;
+    }
+
+    friend bool operator == (const bitvec_native &a, const bitvec_native &b) {
+        for (int i = 0; i < WORDS; i++) {
+            if (a.w_[i] != b.w_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator != (const bitvec_native &a, const bitvec_native &b) {
+        return !(a == b);
+    }
+
+    inline friend ostream &operator << (ostream &os, const bitvec_native &v) {
+        static const char hex[] = "0123456789abcdef";
+        std::string s = "0x";
+        for (int i = 4 * ((W + 3) / 4) - 4; i >= 0; i -= 4) {
+            s += hex[v.extract(i, (W - i) < 4 ? (W - i) : 4)];
+        }
+        os << s;
+        return os;
+    }
+
+    // Traced as 64-bits words: name_w0 = [63:0], name_w1 = [127:64], ..
+    inline friend void sc_trace(sc_trace_file *tf, const bitvec_native &v,
+                                const std::string &NN) {
+        if (WORDS == 1) {
+            sc_core::sc_trace(tf, v.w_[0], NN, W);
+            return;
+        }
+        for (int i = 0; i < WORDS; i++) {
+            sc_core::sc_trace(tf, v.w_[i], NN + "_w" + std::to_string(i),
+                              (W - 64 * i) < 64 ? (W - 64 * i) : 64);
+        }
+    }
+
+ private:
+    void mask() {
+        if (W & 63) {
+            w_[WORDS - 1] &= (1ull << (W & 63)) - 1;
+        }
+    }
+
+    sc_dt::uint64 w_[WORDS];
+};
+
+// Wide vector type of the River signals
+template<int W>
+using bitvec = typename std::conditional<(CFG_SYSC_NATIVE_BITVEC && W <= BITVEC_NATIVE_MAX_BITS),
+                                         bitvec_native<W>,
+                                         sc_biguint<W>>::type;
+
+}  // namespace debugger
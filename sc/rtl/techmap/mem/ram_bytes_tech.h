@@ -38,6 +38,14 @@ SC_MODULE(ram_bytes_tech) {
 
     ram_bytes_tech(sc_module_name name);
 
+    // Simulation only: byte access by the offset without clocking
+    void backdoorWrite(uint64_t off, uint8_t v) {
+        mem[off & (dbytes - 1)]->backdoorWrite(backdoorIndex(off), v);
+    }
+    uint8_t backdoorRead(uint64_t off) {
+        return static_cast<uint8_t>(
+            mem[off & (dbytes - 1)]->backdoorRead(backdoorIndex(off)).to_uint());
+    }
 
  private:
     static const int dbytes = (1 << log2_dbytes);
@@ -50,6 +58,11 @@ SC_MODULE(ram_bytes_tech) {
 
     ram_tech<(abits - log2_dbytes), 8> *mem[dbytes];
 
+    int backdoorIndex(uint64_t off) {
+        return static_cast<int>((off >> log2_dbytes)
+                                & ((1ull << (abits - log2_dbytes)) - 1));
+    }
+
 };
 
 template<int abits, int log2_dbytes>
@@ -17,6 +17,7 @@
 
 #include <systemc.h>
 #include "ram_tech.h"
+#include "../bitvec/bitvec.h"
 #include "api_core.h"
 
 namespace debugger {
@@ -28,8 +29,8 @@ SC_MODULE(ram_cache_bwe_tech) {
     sc_in<bool> i_clk;                                      // CPU clock
     sc_in<sc_uint<abits>> i_addr;
     sc_in<sc_uint<(dbits / 8)>> i_wena;
-    sc_in<sc_biguint<dbits>> i_wdata;
-    sc_out<sc_biguint<dbits>> o_rdata;
+    sc_in<bitvec<dbits>> i_wdata;
+    sc_out<bitvec<dbits>> o_rdata;
 
     void comb();
 
@@ -91,7 +92,7 @@ ram_cache_bwe_tech<abits, dbits>::ram_cache_bwe_tech(sc_module_name name)
 
 template<int abits, int dbits>
 void ram_cache_bwe_tech<abits, dbits>::comb() {
-    sc_biguint<dbits> vb_rdata;
+    bitvec<dbits> vb_rdata;
 
     vb_rdata = 0;
 
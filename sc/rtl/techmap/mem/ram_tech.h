@@ -36,6 +36,9 @@ SC_MODULE(ram_tech) {
 
     ram_tech(sc_module_name name);
 
+    // Simulation only: memory content access without clocking
+    void backdoorWrite(int adr, sc_uint<dbits> v) { mem[adr] = v; }
+    sc_uint<dbits> backdoorRead(int adr) { return mem[adr]; }
 
  private:
     static const int DEPTH = (1 << abits);
@@ -35,6 +35,15 @@ SC_MODULE(rom_inferred_2x32) {
     rom_inferred_2x32(sc_module_name name,
                       std::string filename);
 
+    // Simulation only: 64-bits word access without clocking
+    void backdoorWrite(int adr, uint64_t v) {
+        mem0[adr] = static_cast<uint32_t>(v);
+        mem1[adr] = static_cast<uint32_t>(v >> 32);
+    }
+    uint64_t backdoorRead(int adr) {
+        return (static_cast<uint64_t>(mem1[adr].to_uint()) << 32)
+                | mem0[adr].to_uint();
+    }
 
  private:
     std::string filename_;
@@ -40,7 +40,25 @@ SC_MODULE(rom_tech) {
 
     void generateVCD(sc_trace_file *i_vcd, sc_trace_file *o_vcd);
 
+    // Simulation only: byte access by the offset without clocking
+    void backdoorWrite(uint64_t off, uint8_t v) {
+        int adr = backdoorIndex(off);
+        int sh = static_cast<int>(8 * (off & 7));
+        uint64_t w = inf0->backdoorRead(adr);
+        w = (w & ~(0xFFull << sh)) | (static_cast<uint64_t>(v) << sh);
+        inf0->backdoorWrite(adr, w);
+    }
+    uint8_t backdoorRead(uint64_t off) {
+        return static_cast<uint8_t>(
+            inf0->backdoorRead(backdoorIndex(off)) >> (8 * (off & 7)));
+    }
+
  private:
+    int backdoorIndex(uint64_t off) {
+        return static_cast<int>((off >> 3)
+                                & ((1ull << (abits - log2_dbytes)) - 1));
+    }
+
     std::string filename_;
 
     static const int dbits = (8 * (1 << log2_dbytes));